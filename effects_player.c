@@ -0,0 +1,226 @@
+#include "effects_player.h"
+#include "board_config.h"
+#include "flash_io.h"
+#include "perf.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <string.h>
+
+// Frame in board channel order, big enough for a full board
+static uint8_t g_frame[PB_MAX_STRINGS * PB_MAX_PIXELS * 3];
+
+static effects_t g_fx;
+static bool g_tables_ready = false;
+
+// Wire byte order by pb_color_order_t: source byte (R=0, G=1, B=2) of each
+// byte sent
+static const uint8_t k_wire_order[][3] = {
+    [PB_COLOR_ORDER_GRB] = {1, 0, 2},
+    [PB_COLOR_ORDER_RGB] = {0, 1, 2},
+    [PB_COLOR_ORDER_BGR] = {2, 1, 0},
+    [PB_COLOR_ORDER_RBG] = {0, 2, 1},
+    [PB_COLOR_ORDER_GBR] = {1, 2, 0},
+    [PB_COLOR_ORDER_BRG] = {2, 0, 1},
+};
+
+// The driver has one color order for every string (string 0's). Strings
+// configured otherwise are rearranged in g_frame around each encode.
+static pb_color_order_t g_driver_order;
+static pb_color_order_t g_string_order[BOARD_CONFIG_MAX_STRINGS];
+
+// GPIO base for driver creation
+static uint g_gpio_base = 0;
+
+static void perf_lap(uint8_t stage) {
+    perf_ring_lap(&perf_play, stage, perf_cycles());
+}
+
+// Create driver with the board_config layout (same as FSEQ playback)
+static bool create_driver(effects_player_t *ctx) {
+    if (ctx->driver) {
+        return true;  // Already created
+    }
+
+    uint8_t num_strings = 0;
+    uint16_t max_pixels = 0;
+    uint16_t lengths[BOARD_CONFIG_MAX_STRINGS];
+
+    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
+        lengths[i] = board_config_get_pixel_count(i);
+        g_string_order[i] = board_config_get_color_order(i);
+        if (lengths[i] > 0) {
+            num_strings = i + 1;
+            if (lengths[i] > max_pixels) {
+                max_pixels = lengths[i];
+            }
+        }
+    }
+
+    if (num_strings == 0 || max_pixels == 0) {
+        printf("Effects: No strings configured in board_config\n");
+        return false;
+    }
+    g_driver_order = g_string_order[0];
+
+    pb_driver_config_t config = {
+        .board_id = g_board_config.board_id,
+        .num_boards = 1,
+        .gpio_base = g_gpio_base,
+        .num_strings = num_strings,
+        .max_pixel_length = max_pixels,
+        .frequency_hz = 800000,
+        .color_order = g_driver_order,
+        .reset_us = 200,
+        .pio_index = 1,  // Use PIO1
+    };
+
+    for (int i = 0; i < num_strings; i++) {
+        config.strings[i].length = lengths[i];
+        config.strings[i].enabled = (lengths[i] > 0);
+    }
+
+    ctx->driver = pb_driver_init(&config);
+    if (ctx->driver == NULL) {
+        printf("Effects: Failed to create pb_driver\n");
+        return false;
+    }
+
+    pb_power_config_t power;
+    board_config_power(&g_board_config, &power);
+    pb_set_power_config(ctx->driver, &power);
+
+    // Render layout matches the driver's, so the frame encodes as is
+    effects_init(&g_fx, lengths, num_strings, (uint32_t)time_us_64());
+
+    printf("Effects: Driver created (%d strings, max %d pixels)\n",
+           num_strings, max_pixels);
+    return true;
+}
+
+// Rearrange the pixels of strings whose color order differs from the
+// driver's so the driver's reorder produces the string's own. With
+// restore, undo it (effects like twinkle build on the previous frame).
+static void remap_color_orders(uint8_t *frame, bool restore) {
+    const uint8_t *drv = k_wire_order[g_driver_order];
+
+    for (uint8_t s = 0; s < g_fx.num_strings; s++) {
+        if (g_string_order[s] == g_driver_order) continue;
+        const uint8_t *own = k_wire_order[g_string_order[s]];
+
+        uint8_t *p = frame + g_fx.offsets[s];
+        for (uint16_t i = 0; i < g_fx.lengths[s]; i++, p += 3) {
+            uint8_t px[3] = {p[0], p[1], p[2]};
+            for (int ch = 0; ch < 3; ch++) {
+                if (restore) {
+                    p[own[ch]] = px[drv[ch]];
+                } else {
+                    p[drv[ch]] = px[own[ch]];
+                }
+            }
+        }
+    }
+}
+
+bool effects_player_init(effects_player_t *ctx, uint first_pin) {
+    if (!ctx) {
+        return false;
+    }
+
+    memset(ctx, 0, sizeof(effects_player_t));
+    g_gpio_base = first_pin;
+    return true;
+}
+
+bool effects_player_start(effects_player_t *ctx, uint8_t effect) {
+    if (!ctx) {
+        return false;
+    }
+
+    if (!g_tables_ready) {
+        effects_init_tables();
+        g_tables_ready = true;
+    }
+
+    if (!create_driver(ctx)) {
+        return false;
+    }
+
+    memset(g_frame, 0, g_fx.frame_bytes);
+    ctx->effect = effect;
+    ctx->fps = 0;
+    ctx->running = true;
+
+    printf("Effects: Started (%s)\n", effects_name(effect));
+    return true;
+}
+
+void effects_player_run_loop(effects_player_t *ctx, effects_player_stop_check_fn stop_check) {
+    if (!ctx || !ctx->running || !ctx->driver) {
+        return;
+    }
+
+    uint64_t start_us = time_us_64();
+    uint8_t effect = ctx->effect;
+
+    perf_ring_reset(&perf_play, perf_cycles());
+
+    while (!(stop_check && stop_check())) {
+        // Twinkle builds on the previous frame, so start each effect dark
+        if (ctx->effect != effect) {
+            effect = ctx->effect;
+            memset(g_frame, 0, g_fx.frame_bytes);
+            printf("Effects: %s\n", effects_name(effect));
+        }
+
+        uint32_t now_ms = (uint32_t)((time_us_64() - start_us) / 1000);
+        effects_render(&g_fx, (effect_id_t)effect, now_ms, g_frame);
+        perf_lap(PERF_PLAY_PARSE);
+
+        remap_color_orders(g_frame, false);
+        pb_set_frame_lerp(ctx->driver, 0, g_frame, g_frame, 0);
+        remap_color_orders(g_frame, true);
+        perf_lap(PERF_PLAY_ENCODE);
+
+        pb_show_wait(ctx->driver);
+        perf_lap(PERF_PLAY_DMA);
+        pb_show_with_fps(ctx->driver, EFFECTS_TARGET_FPS);
+
+        uint32_t now = perf_cycles();
+        perf_ring_lap(&perf_play, PERF_PLAY_PACE, now);
+        perf_ring_commit(&perf_play, now);
+
+        ctx->fps = pb_get_fps(ctx->driver);
+        if (flash_io_pending()) {
+            pb_show_wait(ctx->driver);  // Flash writes go after the frame is out
+            flash_io_service();
+        }
+    }
+
+    printf("Effects: Stopped\n");
+}
+
+void effects_player_stop(effects_player_t *ctx) {
+    if (!ctx) return;
+
+    if (ctx->driver) {
+        pb_show_wait(ctx->driver);
+        pb_clear_all(ctx->driver, 0x000000);
+        pb_show(ctx->driver);
+        pb_show_wait(ctx->driver);
+        pb_driver_deinit(ctx->driver);
+        ctx->driver = NULL;
+    }
+
+    ctx->running = false;
+    ctx->fps = 0;
+}
+
+void effects_player_set_effect(effects_player_t *ctx, uint8_t effect) {
+    if (ctx && effect < EFFECT_COUNT) {
+        ctx->effect = effect;
+    }
+}
+
+uint16_t effects_player_get_fps(const effects_player_t *ctx) {
+    return ctx ? ctx->fps : 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/types.h"
+#include "pb_led_driver.h"
+#include "effects.h"
+
+// Procedural effects on the board_config layout, no SD card needed.
+//
+// Each frame is rendered into a board-order frame buffer and encoded with
+// pb_set_frame_lerp, the same fast path FSEQ playback uses. Frame telemetry
+// goes into perf_play: rendering counts as PARSE, the encode as ENCODE.
+
+#define EFFECTS_TARGET_FPS 60
+
+// Stop check callback type - returns true if the effect should stop
+typedef bool (*effects_player_stop_check_fn)(void);
+
+typedef struct {
+    pb_driver_t *driver;
+    volatile bool running;
+    volatile uint8_t effect;       // effect_id_t, may change while running
+    uint16_t fps;
+} effects_player_t;
+
+// Initialize the player context
+bool effects_player_init(effects_player_t *ctx, uint first_pin);
+
+// Start effect (creates driver, clears the frame)
+// Called from Core 1 task manager
+bool effects_player_start(effects_player_t *ctx, uint8_t effect);
+
+// Render and output frames until stop_check returns true
+// Called from Core 1 task manager
+void effects_player_run_loop(effects_player_t *ctx, effects_player_stop_check_fn stop_check);
+
+// Clear LEDs and destroy the driver
+// Called from Core 1 task manager
+void effects_player_stop(effects_player_t *ctx);
+
+// Switch effect (takes effect on the next frame)
+void effects_player_set_effect(effects_player_t *ctx, uint8_t effect);
+
+// Get current FPS
+uint16_t effects_player_get_fps(const effects_player_t *ctx);
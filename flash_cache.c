@@ -0,0 +1,237 @@
+#include "flash_cache.h"
+#include "flash_layout.h"
+#include "flash_io.h"
+#include "fseq_parser.h"
+#include "board_config.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "ff.h"
+#include <stdio.h>
+#include <string.h>
+
+// Frames are read through the no-allocate XIP alias so streaming a sequence
+// doesn't evict code from the XIP cache
+#define FLASH_CACHE_XIP_ADDR (XIP_NOCACHE_NOALLOC_BASE + FLASH_LAYOUT_SEQ_CACHE_OFFSET)
+
+#define FSEQ_MAGIC 0x51455350  // "PSEQ"
+
+// Cache directory (Core 1 writes during install, both cores read)
+static seq_cache_t g_cache;
+
+// False when the firmware image runs into the cache partition. The cache is
+// then never mounted, read or written.
+static bool g_cache_usable;
+
+// Install buffers - static to keep them off the Core 1 stack
+static FIL g_install_file;
+static uint8_t g_install_buf[512];
+
+// Partition-relative flash backend
+static bool cache_erase(void *user, uint32_t offset, uint32_t len) {
+    (void)user;
+    return flash_io_erase(FLASH_LAYOUT_SEQ_CACHE_OFFSET + offset, len);
+}
+
+static bool cache_program(void *user, uint32_t offset, const uint8_t *data, uint32_t len) {
+    (void)user;
+    return flash_io_program(FLASH_LAYOUT_SEQ_CACHE_OFFSET + offset, data, len);
+}
+
+// Current layout: frame size in bytes and layout hash
+static uint32_t current_layout(uint32_t *layout_hash) {
+    uint16_t lengths[BOARD_CONFIG_MAX_STRINGS];
+    uint8_t num_strings = 0;
+    uint32_t pixels = 0;
+    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
+        lengths[i] = board_config_get_pixel_count(i);
+        if (lengths[i] > 0) {
+            num_strings = i + 1;
+            pixels += lengths[i];
+        }
+    }
+    *layout_hash = seq_cache_layout_hash(lengths, num_strings);
+    return pixels * 3;
+}
+
+void flash_cache_init(flash_cache_t *ctx) {
+    memset(ctx, 0, sizeof(flash_cache_t));
+    ctx->status = FLASH_CACHE_IDLE;
+    ctx->message = "";
+
+    if (!flash_layout_firmware_fits()) {
+        printf("FlashCache: Firmware is %lu KB, over the %lu KB region - cache disabled\n",
+               (unsigned long)(flash_layout_firmware_bytes() / 1024),
+               (unsigned long)(FLASH_LAYOUT_FIRMWARE_SIZE / 1024));
+        return;
+    }
+
+    seq_cache_flash_t flash = {
+        .base = (const uint8_t *)FLASH_CACHE_XIP_ADDR,
+        .size = FLASH_LAYOUT_SEQ_CACHE_SIZE,
+        .erase = cache_erase,
+        .program = cache_program,
+        .user = NULL,
+    };
+    seq_cache_mount(&g_cache, &flash);
+    g_cache_usable = true;
+
+    printf("FlashCache: %u sequences, %lu KB free\n",
+           seq_cache_count(&g_cache), (unsigned long)flash_cache_free_kb());
+}
+
+static const char *install_file(flash_cache_t *ctx, const char *filename,
+                                flash_cache_stop_check_fn stop_check) {
+    char path[40];
+    snprintf(path, sizeof(path), "/%s", filename);
+
+    if (f_open(&g_install_file, path, FA_READ) != FR_OK) {
+        return "Open failed";
+    }
+
+    fseq_header_t header;
+    UINT bytes_read;
+    FRESULT fr = f_read(&g_install_file, &header, sizeof(header), &bytes_read);
+    if (fr != FR_OK || bytes_read != sizeof(header) ||
+        header.magic != FSEQ_MAGIC || header.major_version != 2) {
+        f_close(&g_install_file);
+        return "Invalid FSEQ";
+    }
+    if (header.compression_type != 0) {
+        f_close(&g_install_file);
+        return "Compressed FSEQ";
+    }
+    if (header.frame_count == 0 || header.channel_count == 0) {
+        f_close(&g_install_file);
+        return "Empty FSEQ";
+    }
+
+    uint32_t layout_hash;
+    uint32_t frame_size = current_layout(&layout_hash);
+    if (frame_size == 0) {
+        f_close(&g_install_file);
+        return "No strings";
+    }
+
+    seq_cache_result_t r = seq_cache_begin(&g_cache, filename, frame_size,
+                                           header.frame_count, header.step_time_ms,
+                                           layout_hash);
+    if (r != SEQ_CACHE_OK) {
+        f_close(&g_install_file);
+        return r == SEQ_CACHE_ERR_FULL ? "Cache full" : "Bad name";
+    }
+
+    printf("FlashCache: Installing %s (%lu frames x %lu bytes)\n", filename,
+           (unsigned long)header.frame_count, (unsigned long)frame_size);
+
+    // Copy this board's channels of each frame (same mapping as SD playback:
+    // channel 0 onwards), zero-padding if the file has fewer channels
+    uint32_t file_bytes = header.channel_count < frame_size ? header.channel_count : frame_size;
+    for (uint32_t frame = 0; frame < header.frame_count; frame++) {
+        if (stop_check && stop_check()) {
+            seq_cache_abort(&g_cache);
+            f_close(&g_install_file);
+            return "Cancelled";
+        }
+
+        FSIZE_t frame_offset = header.channel_data_offset +
+                               (FSIZE_t)frame * header.channel_count;
+        if (f_lseek(&g_install_file, frame_offset) != FR_OK) {
+            seq_cache_abort(&g_cache);
+            f_close(&g_install_file);
+            return "Read error";
+        }
+
+        uint32_t done = 0;
+        while (done < frame_size) {
+            uint32_t n = frame_size - done;
+            if (n > sizeof(g_install_buf)) n = sizeof(g_install_buf);
+
+            if (done < file_bytes) {
+                if (n > file_bytes - done) n = file_bytes - done;
+                fr = f_read(&g_install_file, g_install_buf, n, &bytes_read);
+                if (fr != FR_OK || bytes_read != n) {
+                    seq_cache_abort(&g_cache);
+                    f_close(&g_install_file);
+                    return "Read error";
+                }
+            } else {
+                memset(g_install_buf, 0, n);
+            }
+
+            if (seq_cache_write(&g_cache, g_install_buf, n) != SEQ_CACHE_OK) {
+                seq_cache_abort(&g_cache);
+                f_close(&g_install_file);
+                return "Flash error";
+            }
+            done += n;
+        }
+
+        ctx->progress = (uint8_t)(((frame + 1) * 100ull) / header.frame_count);
+    }
+
+    f_close(&g_install_file);
+
+    r = seq_cache_commit(&g_cache);
+    if (r != SEQ_CACHE_OK) {
+        return r == SEQ_CACHE_ERR_VERIFY ? "Verify failed" : "Flash error";
+    }
+    return NULL;
+}
+
+bool flash_cache_install(flash_cache_t *ctx, const char *filename,
+                         flash_cache_stop_check_fn stop_check) {
+    if (!ctx || !filename) return false;
+
+    ctx->progress = 0;
+    const char *error = g_cache_usable ? install_file(ctx, filename, stop_check)
+                                       : "Firmware too big";
+
+    ctx->message = error ? error : "Installed";
+    __dmb();
+    ctx->status = error ? FLASH_CACHE_FAILED : FLASH_CACHE_DONE;
+    __dmb();
+
+    printf("FlashCache: %s: %s\n", filename, ctx->message);
+    return error == NULL;
+}
+
+bool flash_cache_clear(flash_cache_t *ctx) {
+    bool ok = g_cache_usable && seq_cache_clear(&g_cache) == SEQ_CACHE_OK;
+    if (ctx) {
+        ctx->message = ok ? "Cleared" : "Flash error";
+        ctx->status = ok ? FLASH_CACHE_DONE : FLASH_CACHE_FAILED;
+    }
+    printf("FlashCache: Clear %s\n", ok ? "done" : "failed");
+    return ok;
+}
+
+const seq_cache_entry_t *flash_cache_lookup(const char *filename) {
+    if (!g_cache_usable) return NULL;
+    const seq_cache_entry_t *entry = seq_cache_find(&g_cache, filename);
+    if (!entry) return NULL;
+
+    uint32_t layout_hash;
+    uint32_t frame_size = current_layout(&layout_hash);
+    if (entry->frame_size != frame_size || entry->layout_hash != layout_hash) {
+        return NULL;  // Installed for a different config.csv
+    }
+    return entry;
+}
+
+const uint8_t *flash_cache_frame(const seq_cache_entry_t *entry, uint32_t frame) {
+    return seq_cache_frame(&g_cache, entry, frame);
+}
+
+uint8_t flash_cache_count(void) {
+    return seq_cache_count(&g_cache);
+}
+
+const char *flash_cache_name(uint8_t index) {
+    if (index >= seq_cache_count(&g_cache)) return "";
+    return g_cache.dir.entries[index].name;
+}
+
+uint32_t flash_cache_free_kb(void) {
+    if (!g_cache_usable) return 0;
+    return seq_cache_largest_free(&g_cache) / 1024;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "seq_cache.h"
+
+// Sequences installed into flash for SD-free playback.
+//
+// Installing copies this board's channels of an uncompressed FSEQ file from
+// the SD card into the sequence cache partition (see flash_layout.h). The
+// FSEQ player then streams frames straight from XIP whenever the file has a
+// cache entry that matches the current string layout.
+
+// Stop check callback type - returns true if the install should be abandoned
+typedef bool (*flash_cache_stop_check_fn)(void);
+
+typedef enum {
+    FLASH_CACHE_IDLE = 0,
+    FLASH_CACHE_INSTALLING,
+    FLASH_CACHE_DONE,
+    FLASH_CACHE_FAILED,
+} flash_cache_status_t;
+
+typedef struct {
+    volatile flash_cache_status_t status;
+    volatile uint8_t progress;          // Install progress 0-100
+    const char *volatile message;       // Result of the last install/clear
+} flash_cache_t;
+
+// Mount the cache directory (call once from main at boot)
+void flash_cache_init(flash_cache_t *ctx);
+
+// Copy a file from the SD card into flash
+// Called from Core 1 task manager
+bool flash_cache_install(flash_cache_t *ctx, const char *filename,
+                         flash_cache_stop_check_fn stop_check);
+
+// Erase all cached sequences (Core 1 must be idle)
+bool flash_cache_clear(flash_cache_t *ctx);
+
+// Cache entry for filename, or NULL if not cached or installed for a
+// different string layout
+const seq_cache_entry_t *flash_cache_lookup(const char *filename);
+
+// Frame data in XIP flash (entry->frame_size bytes)
+const uint8_t *flash_cache_frame(const seq_cache_entry_t *entry, uint32_t frame);
+
+// Number of cached sequences
+uint8_t flash_cache_count(void);
+
+// Name of cached sequence index (0 .. count-1)
+const char *flash_cache_name(uint8_t index);
+
+// Largest free space in KB
+uint32_t flash_cache_free_kb(void);
@@ -1,6 +1,15 @@
 #include "fseq_player.h"
 #include "fseq_parser.h"
 #include "board_config.h"
+#include "crossfade.h"
+#include "fseq_index.h"
+#include "chase.h"
+#include "frame_diff.h"
+#include "play_stats.h"
+#include "perf.h"
+#include "trace.h"
+#include "flash_cache.h"
+#include "flash_io.h"
 #include "pico/stdlib.h"
 #include "hardware/sync.h"
 #include "ff.h"
@@ -12,14 +21,120 @@
 // Notify Core 1 task manager of loop completion (defined in core1_task.c)
 extern void core1_notify_fseq_loop(void);
 
+// Notify Core 1 task manager that a queued show took over (defined in core1_task.c)
+extern void core1_notify_fseq_switch(uint32_t seq);
+
+// Chase mode timecode samples from Core 0 (defined in core1_task.c)
+extern bool core1_chase_enabled(void);
+extern bool core1_take_chase_sample(uint32_t *master_ms, uint64_t *local_us);
+
+// Frame interpolation switch from Core 0 (defined in core1_task.c)
+extern bool core1_interpolation_enabled(void);
+
+// Upcoming show is opened this many frames before the crossfade into it
+#define FSEQ_PREOPEN_FRAMES 16
+
+// Crossfade length
+#define FSEQ_CROSSFADE_MS        1000
+
+// Largest frame (board channels) the blend and interpolation frames hold:
+// a full board, as for the effects frame
+#define FSEQ_FRAME_MAX_BYTES     (PB_MAX_STRINGS * PB_MAX_PIXELS * 3)
+
+// Sustained SD read rate a crossfade may plan on (SPI mode, 512-byte reads)
+#define FSEQ_SD_READ_BYTES_PER_SEC 1000000
+
+// Most frames output per sequence frame when interpolating
+#define FSEQ_INTERP_MAX_STEPS 4
+
+// SD reads during playback: at most this much, ending on frame boundaries
+#define FSEQ_SD_CHUNK_BYTES 512
+
+// File handles: the one playing and the pre-opened next show
+static FIL g_files[2];
+
 // File handle and parser state (persists across start/run_loop/cleanup)
-static FIL g_fseq_file;
+static FIL *g_fseq_file = &g_files[0];
 static bool g_file_open = false;
 static fseq_parser_ctx_t *g_parser = NULL;
 static fseq_header_t g_header;
 
+// Frame index of the SD file playing, kept while the same file is replayed
+static fseq_index_t g_index;
+static uint8_t g_index_header[FSEQ_INDEX_HEADER_SIZE];
+static char g_index_name[32];
+static bool g_index_valid = false;
+
+// Flash cache entry when playing from XIP instead of the SD card (NULL otherwise)
+static const seq_cache_entry_t *g_cached = NULL;
+
 // Parser layout - MUST be static so pointer remains valid after start() returns
 static uint16_t g_string_lengths[BOARD_CONFIG_MAX_STRINGS];
+static uint8_t g_num_strings = 0;
+
+// Blend frame in board channel order (strings back to back, as in the flash
+// cache): offset of each string and the total size in bytes
+static uint32_t g_string_offsets[BOARD_CONFIG_MAX_STRINGS];
+static uint32_t g_frame_bytes = 0;
+static uint8_t g_fade_frame[FSEQ_FRAME_MAX_BYTES];
+
+// Where the parser pixel callback puts pixels
+static enum {
+    DECODE_TO_DRIVER,   // Normal playback
+    DECODE_TO_FRAME,    // Outgoing show during a crossfade
+    DECODE_BLEND,       // Incoming show, mixed in at g_fade_weight
+} g_decode_mode = DECODE_TO_DRIVER;
+static uint16_t g_fade_weight = 0;
+
+// Smoothed time spent decoding a frame (between shows), for fade planning
+static uint32_t g_decode_us = 0;
+
+// Frame interpolation: the previous sequence frame (SD playback decodes into
+// the blend frame, so output runs one frame behind), and how many outputs
+// the current frame interval is split into (1 = not interpolating)
+static uint8_t g_interp_frame[FSEQ_FRAME_MAX_BYTES];
+static bool g_interp_primed = false;
+static uint32_t g_sub_steps = 1;
+static uint32_t g_interp_logged = 0;  // Last rate reported (0 = switched off)
+
+// Unchanged chunks / frames of SD playback (cached playback compares frames
+// in flash directly and only uses the stats)
+static frame_diff_t g_diff;
+
+// Late frames, SD rate and Core 1 load for the Perf view
+static play_tracker_t g_play;
+
+// Frame the loop starts at after a switch (the fade already played some)
+static uint32_t g_resume_frame = 0;
+
+// SD read buffer for the incoming show (Core 1 stack is small)
+static uint8_t g_next_buf[512];
+
+// Next show, prepared during the last frames of the current one
+static struct {
+    bool ready;
+    uint32_t seq;                       // Queue entry it was prepared for
+    uint32_t failed_seq;                // Don't retry an entry that failed to open
+    char filename[32];
+    const seq_cache_entry_t *cached;    // Flash copy, or NULL if on SD
+    FIL *file;                          // SD: open and positioned at channel data
+    uint8_t header_buf[32];
+    fseq_header_t header;
+    fseq_parser_ctx_t *parser;          // SD: own parser once the fade starts
+    bool fading;
+    uint32_t fade_step;                 // Fade frames output so far
+    uint32_t fade_steps;
+} g_next;
+
+// Chase mode: follows an external timecode by seeking or by stretching
+// the interval before the next frame
+static chase_t g_chase;
+static bool g_chasing = false;
+static uint32_t g_frame_interval_us = 33333;
+
+// Measuring the gap between the last frame of one show and the first of the next
+static uint64_t g_last_show_us = 0;
+static bool g_transition_pending = false;
 
 // GPIO base for driver creation
 static uint g_gpio_base = 0;
@@ -28,9 +143,22 @@ static uint g_gpio_base = 0;
 static void pixel_callback(void *user_data, uint8_t string, uint16_t pixel, uint32_t color) {
     fseq_player_t *ctx = (fseq_player_t *)user_data;
     uint16_t string_pixel_count = board_config_get_pixel_count(string);
-    if (ctx && ctx->driver && string < FSEQ_PLAYER_MAX_STRINGS &&
-        string_pixel_count > 0 && pixel < string_pixel_count) {
+    if (!(ctx && ctx->driver && string < FSEQ_PLAYER_MAX_STRINGS &&
+          string_pixel_count > 0 && pixel < string_pixel_count)) {
+        return;
+    }
+
+    if (g_decode_mode == DECODE_TO_DRIVER) {
         pb_set_pixel(ctx->driver, 0, string, pixel, color);
+        return;
+    }
+
+    uint8_t rgb[3] = { (uint8_t)(color >> 16), (uint8_t)(color >> 8), (uint8_t)color };
+    uint8_t *dst = &g_fade_frame[g_string_offsets[string] + (uint32_t)pixel * 3];
+    if (g_decode_mode == DECODE_TO_FRAME) {
+        memcpy(dst, rgb, 3);
+    } else {
+        crossfade_blend(dst, rgb, 3, g_fade_weight);
     }
 }
 
@@ -85,6 +213,10 @@ static bool create_driver(fseq_player_t *ctx) {
         return false;
     }
 
+    pb_power_config_t power;
+    board_config_power(&g_board_config, &power);
+    pb_set_power_config(ctx->driver, &power);
+
     printf("FSEQ: Driver created (%d strings, max %d pixels)\n",
            num_strings, max_pixels);
     return true;
@@ -113,6 +245,45 @@ bool fseq_player_init(fseq_player_t *ctx, uint first_pin) {
     return true;
 }
 
+// Parser for SD playback (flash-cached shows don't need one)
+static bool ensure_parser(fseq_player_t *ctx) {
+    if (g_parser) return true;
+
+    fseq_layout_t layout = {
+        .num_strings = g_num_strings,
+        .string_lengths = g_string_lengths,  // Points to static array - safe!
+    };
+    g_parser = fseq_parser_init(ctx, pixel_callback, layout);
+    return g_parser != NULL;
+}
+
+// Build (or reuse) the frame index for an open SD file
+static void load_index(const uint8_t *header_buf, const char *filename) {
+    if (g_index_valid && strcmp(g_index_name, filename) == 0 &&
+        memcmp(g_index_header, header_buf, sizeof(g_index_header)) == 0) {
+        return;  // Same render of the same file
+    }
+
+    g_index_valid = fseq_index_init(&g_index, header_buf);
+    if (!g_index_valid) {
+        printf("FSEQ: No frame index for %s, seeks are ignored\n", filename);
+        return;
+    }
+
+    memcpy(g_index_header, header_buf, sizeof(g_index_header));
+    strncpy(g_index_name, filename, sizeof(g_index_name) - 1);
+    g_index_name[sizeof(g_index_name) - 1] = '\0';
+}
+
+// Timing of the show now playing (also read by Core 0 for seeks)
+static void set_show_timing(fseq_player_t *ctx, uint32_t frame_count, uint16_t step_time_ms) {
+    ctx->frame_count = frame_count;
+    ctx->step_time_ms = step_time_ms;
+    ctx->target_fps = step_time_ms > 0 ? (1000 / step_time_ms) : 30;
+    ctx->frame = 0;
+    g_frame_interval_us = 1000000u / ctx->target_fps;
+}
+
 bool fseq_player_start(fseq_player_t *ctx, const char *filename) {
     if (!ctx) {
         return false;
@@ -126,13 +297,47 @@ bool fseq_player_start(fseq_player_t *ctx, const char *filename) {
     // Copy filename
     strncpy(ctx->filename, filename, sizeof(ctx->filename) - 1);
     ctx->filename[sizeof(ctx->filename) - 1] = '\0';
+    ctx->seek_request = 0;  // Stale request for the previous show
+    frame_diff_init(&g_diff);
+    ctx->diff = g_diff.stats;
+
+    // Setup layout from board_config - using STATIC array
+    g_num_strings = 0;
+    g_frame_bytes = 0;
+    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
+        g_string_lengths[i] = board_config_get_pixel_count(i);
+        g_string_offsets[i] = g_frame_bytes;
+        g_frame_bytes += (uint32_t)g_string_lengths[i] * 3;
+        if (g_string_lengths[i] > 0) {
+            g_num_strings = i + 1;
+        }
+    }
+    if (g_frame_bytes > sizeof(g_fade_frame)) {
+        printf("FSEQ: Layout is %lu bytes per frame, over %lu - no crossfade, "
+               "interpolation or unchanged-frame skipping\n",
+               (unsigned long)g_frame_bytes, (unsigned long)sizeof(g_fade_frame));
+    }
+    g_resume_frame = 0;
+
+    // Prefer the flash copy when one was installed for this layout
+    g_cached = flash_cache_lookup(ctx->filename);
+    if (g_cached) {
+        printf("FSEQ: %s - %lu frames @ %d fps (flash)\n",
+               ctx->filename,
+               (unsigned long)g_cached->frame_count,
+               g_cached->step_time_ms > 0 ? 1000 / g_cached->step_time_ms : 0);
+        set_show_timing(ctx, g_cached->frame_count, g_cached->step_time_ms);
+        ctx->fps = 0;
+        ctx->running = true;
+        return true;
+    }
 
     // Build full path
     char path[40];
     snprintf(path, sizeof(path), "/%s", ctx->filename);
 
     // Open file
-    FRESULT fr = f_open(&g_fseq_file, path, FA_READ);
+    FRESULT fr = f_open(g_fseq_file, path, FA_READ);
     if (fr != FR_OK) {
         printf("FSEQ: Failed to open %s (err %d)\n", path, fr);
         // Don't destroy driver - keep it for next file attempt
@@ -143,33 +348,18 @@ bool fseq_player_start(fseq_player_t *ctx, const char *filename) {
     // Read and parse header
     uint8_t header_buf[32];
     UINT bytes_read;
-    fr = f_read(&g_fseq_file, header_buf, 32, &bytes_read);
+    fr = f_read(g_fseq_file, header_buf, 32, &bytes_read);
     if (fr != FR_OK || bytes_read != 32) {
         printf("FSEQ: Failed to read header\n");
-        f_close(&g_fseq_file);
+        f_close(g_fseq_file);
         g_file_open = false;
         return false;
     }
 
-    // Setup parser layout from board_config - using STATIC array
-    uint8_t num_strings = 0;
-    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
-        g_string_lengths[i] = board_config_get_pixel_count(i);
-        if (g_string_lengths[i] > 0) {
-            num_strings = i + 1;
-        }
-    }
-
-    fseq_layout_t layout = {
-        .num_strings = num_strings,
-        .string_lengths = g_string_lengths,  // Points to static array - safe!
-    };
-
     // Initialize parser
-    g_parser = fseq_parser_init(ctx, pixel_callback, layout);
-    if (!g_parser) {
+    if (!ensure_parser(ctx)) {
         printf("FSEQ: Failed to init parser\n");
-        f_close(&g_fseq_file);
+        f_close(g_fseq_file);
         g_file_open = false;
         return false;
     }
@@ -179,7 +369,7 @@ bool fseq_player_start(fseq_player_t *ctx, const char *filename) {
         printf("FSEQ: Invalid FSEQ header\n");
         fseq_parser_deinit(g_parser);
         g_parser = NULL;
-        f_close(&g_fseq_file);
+        f_close(g_fseq_file);
         g_file_open = false;
         return false;
     }
@@ -190,15 +380,16 @@ bool fseq_player_start(fseq_player_t *ctx, const char *filename) {
            g_header.step_time_ms > 0 ? 1000 / g_header.step_time_ms : 0);
 
     // Calculate target FPS from step_time_ms
-    ctx->target_fps = g_header.step_time_ms > 0 ? (1000 / g_header.step_time_ms) : 30;
+    set_show_timing(ctx, g_header.frame_count, g_header.step_time_ms);
+    load_index(header_buf, ctx->filename);
 
     // Seek to channel data
-    fr = f_lseek(&g_fseq_file, g_header.channel_data_offset);
+    fr = f_lseek(g_fseq_file, g_header.channel_data_offset);
     if (fr != FR_OK) {
         printf("FSEQ: Failed to seek to data\n");
         fseq_parser_deinit(g_parser);
         g_parser = NULL;
-        f_close(&g_fseq_file);
+        f_close(g_fseq_file);
         g_file_open = false;
         return false;
     }
@@ -210,22 +401,513 @@ bool fseq_player_start(fseq_player_t *ctx, const char *filename) {
     return true;
 }
 
-void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check) {
-    if (!ctx || !ctx->running || !g_parser) {
-        printf("FSEQ: run_loop early exit (ctx=%p, running=%d, parser=%p)\n",
-               ctx, ctx ? ctx->running : 0, g_parser);
+// Chase the external clock: take new samples, then decide the next
+// frame's interval or a seek, once ctx->frame is out
+static void chase_after_frame(fseq_player_t *ctx, uint64_t now) {
+    if (!core1_chase_enabled()) {
+        if (g_chasing) {
+            g_chasing = false;
+            g_frame_interval_us = 1000000u / ctx->target_fps;
+            printf("FSEQ: Chase off\n");
+        }
+        return;
+    }
+    if (!g_chasing) {
+        chase_init(&g_chase);
+        g_chasing = true;
+        printf("FSEQ: Chasing timecode\n");
+    }
+
+    uint32_t master_ms;
+    uint64_t local_us;
+    while (core1_take_chase_sample(&master_ms, &local_us)) {
+        chase_sample(&g_chase, master_ms, local_us);
+    }
+
+    uint32_t step_us = ctx->step_time_ms ? ctx->step_time_ms * 1000u : 1000000u / ctx->target_fps;
+    chase_output_t out;
+    chase_frame(&g_chase, now, ctx->frame, ctx->frame_count, step_us, &out);
+    g_frame_interval_us = out.interval_us;
+    if (out.seek) {
+        fseq_player_request_seek(ctx, out.seek_frame);
+    }
+    ctx->chase = g_chase.stats;
+}
+
+static void perf_lap(uint8_t stage) {
+    perf_ring_lap(&perf_play, stage, perf_cycles());
+}
+
+// Send the encoded frame once the previous DMA is done and its time slot
+// comes, or just wait out the slot for a held frame. Closes the frame's
+// telemetry record (work since the last lap counts as encode).
+static void output_paced(fseq_player_t *ctx, uint32_t interval_us, bool hold) {
+    perf_lap(PERF_PLAY_ENCODE);
+    const uint32_t *cycles = perf_play.current.cycles;
+    uint32_t busy = cycles[PERF_PLAY_READ] + cycles[PERF_PLAY_PARSE] + cycles[PERF_PLAY_ENCODE];
+    if (hold) {
+        pb_hold_with_interval_us(ctx->driver, interval_us);
+    } else {
+        pb_show_wait(ctx->driver);
+        perf_lap(PERF_PLAY_DMA);
+        pb_show_with_interval_us(ctx->driver, interval_us);
+        trace_instant(TRACE_FRAME_SHOW);
+    }
+    uint32_t now = perf_cycles();
+    perf_ring_lap(&perf_play, PERF_PLAY_PACE, now);
+    perf_ring_commit(&perf_play, now);
+
+    play_tracker_frame(&g_play, time_us_64(), interval_us, perf_cycles_to_us(busy));
+    ctx->play = g_play.stats;
+}
+
+// Run a pending Core 0 flash write once the frame just started is out. The
+// write stalls this core, so it must not overlap the frame's DMA.
+static void service_flash(fseq_player_t *ctx) {
+    if (!flash_io_pending()) return;
+    pb_show_wait(ctx->driver);
+    flash_io_service();
+}
+
+// Output the frame in the driver buffer, paced to the show's frame rate
+// (or to the external clock when chasing). A held frame is identical to the
+// one on the LEDs: nothing was encoded and nothing is sent.
+static void show_frame(fseq_player_t *ctx, bool hold) {
+    if (hold) {
+        g_diff.stats.held++;
+    } else if (g_last_show_us != 0 && !g_transition_pending) {
+        uint32_t work_us = (uint32_t)(time_us_64() - g_last_show_us);
+        g_decode_us = g_decode_us ? (g_decode_us * 7 + work_us) / 8 : work_us;
+    }
+    output_paced(ctx, g_frame_interval_us / g_sub_steps, hold);
+    ctx->diff = g_diff.stats;
+    pb_get_power_stats(ctx->driver, &ctx->power);
+    uint64_t now = time_us_64();
+    chase_after_frame(ctx, now);
+
+    if (g_transition_pending) {
+        g_transition_pending = false;
+        uint32_t gap = (uint32_t)(now - g_last_show_us);
+        ctx->transition_us = gap;
+        if (gap > ctx->max_transition_us) ctx->max_transition_us = gap;
+        printf("FSEQ: Transition to %s: %lu us between frames (target %lu us)\n",
+               ctx->filename, (unsigned long)gap,
+               (unsigned long)(ctx->target_fps ? 1000000 / ctx->target_fps : 0));
+    }
+    g_last_show_us = now;
+
+    service_flash(ctx);
+}
+
+// Report the interpolation rate when it changes, with the reason when
+// interpolation is switched on but can't apply
+static uint32_t interp_report(uint32_t steps, const char *why) {
+    if (steps != g_interp_logged) {
+        if (steps > 1) {
+            printf("FSEQ: Interpolating x%lu (decode %lu us/frame)\n",
+                   (unsigned long)steps, (unsigned long)g_decode_us);
+        } else {
+            printf("FSEQ: Not interpolating (%s)\n", why);
+        }
+        g_interp_logged = steps;
+    }
+    return steps;
+}
+
+// Outputs per sequence frame the driver and CPU can sustain, or 1 when
+// interpolation is off or can't apply (fading, chasing, oversized frame)
+static uint32_t interp_steps(const fseq_player_t *ctx) {
+    if (!core1_interpolation_enabled()) {
+        g_interp_logged = 0;
+        return 1;
+    }
+    if (g_chasing) return interp_report(1, "chasing time code");
+    if (g_next.fading) return interp_report(1, "crossfading");
+    if (g_frame_bytes == 0 || g_frame_bytes > sizeof(g_interp_frame)) {
+        return interp_report(1, "frame too large");
+    }
+
+    // Each output needs the wire time of the longest string, and the first
+    // one also fits the next decode - give that some headroom
+    const pb_driver_config_t *config = pb_driver_get_config(ctx->driver);
+    uint32_t wire_us = (uint32_t)((uint64_t)config->max_pixel_length * 24 * 1000000 /
+                                  config->frequency_hz) + config->reset_us;
+    uint32_t work_us = g_decode_us + g_decode_us / 4;
+    uint32_t out_us = wire_us > work_us ? wire_us : work_us;
+
+    uint32_t steps = out_us ? g_frame_interval_us / out_us : 1;
+    if (steps < 1) steps = 1;
+    if (steps > FSEQ_INTERP_MAX_STEPS) steps = FSEQ_INTERP_MAX_STEPS;
+    return interp_report(steps, "no time between frames");
+}
+
+// After frame a is out, fill the rest of its interval with frames blended
+// toward b at an even share of the interval each
+static void show_subframes(fseq_player_t *ctx, const uint8_t *a, const uint8_t *b,
+                           uint32_t steps) {
+    g_sub_steps = steps;
+
+    for (uint32_t k = 1; k < steps; k++) {
+        pb_set_frame_lerp(ctx->driver, 0, a, b, (uint16_t)(k * CROSSFADE_WEIGHT_ONE / steps));
+        output_paced(ctx, g_frame_interval_us / steps, false);
+        g_last_show_us = time_us_64();
+        service_flash(ctx);
+    }
+}
+
+// SD frames decode into the blend frame, which keeps the previous frame's
+// pixels, so chunks unchanged since then can be skipped. Needs reads that
+// end on frame boundaries (whole pixels per frame) and no crossfade.
+// Tracking covers this board's channels only, up to a full board.
+_Static_assert(FSEQ_FRAME_MAX_BYTES <= FRAME_DIFF_MAX_CHUNKS * FSEQ_SD_CHUNK_BYTES,
+               "frame_diff can't track a full board's chunks");
+
+static bool diff_tracking(void) {
+    return !g_next.fading && g_frame_bytes > 0 && g_frame_bytes <= FSEQ_FRAME_MAX_BYTES &&
+           g_header.channel_count % 3 == 0;
+}
+
+static void discard_next(void) {
+    if (g_next.parser) {
+        fseq_parser_deinit(g_next.parser);
+        g_next.parser = NULL;
+    }
+    if (g_next.file) {
+        f_close(g_next.file);
+        g_next.file = NULL;
+    }
+    g_next.ready = false;
+    g_next.fading = false;
+}
+
+// Open and validate the queued next show so the switch costs nothing
+static void prepare_next(fseq_next_file_fn next_file) {
+    if (g_next.ready || !next_file) return;
+
+    char name[sizeof(g_next.filename)];
+    uint32_t seq = next_file(name, sizeof(name));
+    if (seq == 0 || seq == g_next.failed_seq) return;
+
+    g_next.cached = flash_cache_lookup(name);
+    if (!g_next.cached) {
+        FIL *file = (g_fseq_file == &g_files[0]) ? &g_files[1] : &g_files[0];
+        char path[40];
+        snprintf(path, sizeof(path), "/%s", name);
+        if (f_open(file, path, FA_READ) != FR_OK) {
+            printf("FSEQ: Can't pre-open %s\n", name);
+            g_next.failed_seq = seq;
+            return;
+        }
+
+        fseq_header_t header;
+        UINT bytes_read;
+        FRESULT fr = f_read(file, g_next.header_buf, sizeof(g_next.header_buf), &bytes_read);
+        memset(&header, 0, sizeof(header));
+        memcpy(&header, g_next.header_buf, sizeof(g_next.header_buf));
+        g_next.header = header;
+        if (fr != FR_OK || bytes_read != sizeof(g_next.header_buf) ||
+            header.magic != 0x51455350 /* "PSEQ" */ || header.major_version != 2 ||
+            f_lseek(file, header.channel_data_offset) != FR_OK) {
+            printf("FSEQ: Can't pre-parse %s\n", name);
+            f_close(file);
+            g_next.failed_seq = seq;
+            return;
+        }
+        g_next.file = file;
+    }
+
+    strncpy(g_next.filename, name, sizeof(g_next.filename) - 1);
+    g_next.filename[sizeof(g_next.filename) - 1] = '\0';
+    g_next.seq = seq;
+    g_next.ready = true;
+    printf("FSEQ: Next show ready: %s (%s)\n", name, g_next.cached ? "flash" : "SD");
+}
+
+// Make the prepared show current without clearing the LEDs. Returns false
+// (current show untouched) if nothing usable was prepared.
+static bool switch_to_next(fseq_player_t *ctx, fseq_next_file_fn next_file) {
+    if (!g_next.ready) return false;
+
+    // The playlist may have moved on since (e.g. auto-advance turned off)
+    char name[sizeof(g_next.filename)];
+    if (!next_file || next_file(name, sizeof(name)) != g_next.seq ||
+        (!g_next.cached && !g_next.parser && !ensure_parser(ctx))) {
+        discard_next();
+        return false;
+    }
+
+    if (g_file_open) {
+        f_close(g_fseq_file);
+        g_file_open = false;
+    }
+
+    uint8_t step_time_ms;
+    uint32_t frame_count;
+    if (g_next.cached) {
+        g_cached = g_next.cached;
+        step_time_ms = (uint8_t)g_cached->step_time_ms;
+        frame_count = g_cached->frame_count;
+    } else {
+        if (g_next.parser) {
+            // Already streaming from the crossfade - carry on where it is
+            fseq_parser_deinit(g_parser);
+            g_parser = g_next.parser;
+            g_next.parser = NULL;
+            g_header = g_next.header;
+        } else {
+            fseq_parser_read_header(g_parser, g_next.header_buf, &g_header);
+            fseq_parser_reset(g_parser);
+        }
+        g_fseq_file = g_next.file;
+        g_file_open = true;
+        g_cached = NULL;
+        step_time_ms = g_header.step_time_ms;
+        frame_count = g_header.frame_count;
+        load_index(g_next.header_buf, g_next.filename);
+    }
+    g_resume_frame = g_next.fading ? g_next.fade_step : 0;
+    g_interp_primed = false;
+    frame_diff_invalidate(&g_diff);
+
+    strncpy(ctx->filename, g_next.filename, sizeof(ctx->filename) - 1);
+    ctx->filename[sizeof(ctx->filename) - 1] = '\0';
+    set_show_timing(ctx, frame_count, step_time_ms);
+
+    g_next.file = NULL;
+    g_next.ready = false;
+    g_next.fading = false;
+    g_transition_pending = true;
+    core1_notify_fseq_switch(g_next.seq);
+    return true;
+}
+
+// Crossfade length in frames at the current show's rate
+static uint32_t fade_frames(const fseq_player_t *ctx) {
+    return (uint32_t)ctx->target_fps * FSEQ_CROSSFADE_MS / 1000;
+}
+
+// Start mixing the prepared show in over the current show's last frames, if
+// the budget allows; otherwise it is cut to on the frame boundary
+static void start_fade(fseq_player_t *ctx, uint32_t current_channels) {
+    if (!g_next.ready || g_next.fading) return;
+
+    uint32_t steps = fade_frames(ctx);
+    uint32_t next_frames = g_next.cached ? g_next.cached->frame_count : g_next.header.frame_count;
+    uint32_t next_channels = g_next.cached ? g_next.cached->frame_size : g_next.header.channel_count;
+    if (steps == 0 || next_frames <= steps) return;  // Too short to fade into
+
+    crossfade_budget_t budget = {
+        .frame_bytes = g_frame_bytes,
+        .buffer_bytes = sizeof(g_fade_frame),
+        .frame_us = ctx->target_fps ? 1000000u / ctx->target_fps : 33333u,
+        .decode_us = g_decode_us,
+        .current_channels = current_channels,
+        .next_channels = next_channels,
+        .sd_bytes_per_frame = (g_cached ? 0 : current_channels) +
+                              (g_next.cached ? 0 : next_channels),
+        .sd_bytes_per_sec = FSEQ_SD_READ_BYTES_PER_SEC,
+    };
+    crossfade_check_t check = crossfade_check(&budget);
+    if (check != CROSSFADE_OK) {
+        printf("FSEQ: No crossfade to %s (%s), cutting\n",
+               g_next.filename, crossfade_check_name(check));
         return;
     }
 
+    if (!g_next.cached) {
+        fseq_layout_t layout = {
+            .num_strings = g_num_strings,
+            .string_lengths = g_string_lengths,
+        };
+        g_next.parser = fseq_parser_init(ctx, pixel_callback, layout);
+        fseq_header_t header;
+        if (!g_next.parser ||
+            !fseq_parser_read_header(g_next.parser, g_next.header_buf, &header)) {
+            printf("FSEQ: No parser for crossfade, cutting\n");
+            if (g_next.parser) fseq_parser_deinit(g_next.parser);
+            g_next.parser = NULL;
+            return;
+        }
+    }
+
+    frame_diff_invalidate(&g_diff);  // Blend frame is about to be mixed into
+    g_next.fading = true;
+    g_next.fade_step = 0;
+    g_next.fade_steps = steps;
+    printf("FSEQ: Crossfade to %s over %lu frames (decode %lu us/frame)\n",
+           g_next.filename, (unsigned long)steps, (unsigned long)g_decode_us);
+}
+
+// Decode the incoming show's next frame from SD over the blend frame
+static void blend_next_sd_frame(void) {
+    uint32_t chunk = g_next.header.channel_count;
+    if (chunk > sizeof(g_next_buf)) chunk = sizeof(g_next_buf);
+
+    while (true) {
+        UINT bytes_read;
+        FRESULT fr = f_read(g_next.file, g_next_buf, chunk, &bytes_read);
+        if (fr != FR_OK || bytes_read < chunk) {
+            // Shouldn't happen (show is longer than the fade) - hold this frame
+            f_lseek(g_next.file, g_next.header.channel_data_offset);
+            fseq_parser_reset(g_next.parser);
+            return;
+        }
+        play_tracker_read(&g_play, bytes_read);
+        if (fseq_parser_push(g_next.parser, g_next_buf, bytes_read)) return;
+    }
+}
+
+// Mix the incoming show into the blend frame (already holding the current
+// show's frame) and hand the result to the driver
+static void output_fade_frame(fseq_player_t *ctx) {
+    g_next.fade_step++;
+    uint16_t weight = crossfade_weight(g_next.fade_step, g_next.fade_steps);
+
+    if (g_next.cached) {
+        const uint8_t *data = flash_cache_frame(g_next.cached, g_next.fade_step - 1);
+        uint32_t len = g_next.cached->frame_size < g_frame_bytes ? g_next.cached->frame_size : g_frame_bytes;
+        if (data) crossfade_blend(g_fade_frame, data, len, weight);
+    } else {
+        g_fade_weight = weight;
+        g_decode_mode = DECODE_BLEND;
+        blend_next_sd_frame();
+        g_decode_mode = DECODE_TO_DRIVER;
+    }
+
+    const uint8_t *data = g_fade_frame;
+    for (uint8_t s = 0; s < FSEQ_PLAYER_MAX_STRINGS; s++) {
+        if (g_string_lengths[s] > 0) {
+            pb_set_pixels(ctx->driver, 0, s, 0, data, g_string_lengths[s]);
+            data += g_string_lengths[s] * 3;
+        }
+    }
+}
+
+// Take a pending seek (frame, wrapped into the show). A seek abandons any
+// crossfade in progress; the next show is prepared again if still due.
+static bool take_seek(fseq_player_t *ctx, uint32_t *frame) {
+    __dmb();
+    uint32_t request = ctx->seek_request;
+    if (request == 0) return false;
+    ctx->seek_request = 0;
+
+    if (g_next.fading) discard_next();
+    frame_diff_invalidate(&g_diff);
+    *frame = ctx->frame_count ? (request - 1) % ctx->frame_count : 0;
+    return true;
+}
+
+// Playback loop for a flash-cached sequence: frames are already in board
+// channel order, so each string is one contiguous span straight from XIP.
+// Returns true if it moved on to the next show.
+static bool run_cached_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check,
+                            fseq_next_file_fn next_file) {
+    uint32_t frame = g_resume_frame;
+    uint32_t fps_frame_count = 0;
+    uint64_t last_fps_time = time_us_64();
+    const uint8_t *prev = NULL;  // Frame last output as-is
+    g_resume_frame = 0;
+    perf_ring_reset(&perf_play, perf_cycles());
+    play_tracker_reset(&g_play, time_us_64());
+
+    while (!(stop_check && stop_check())) {
+        uint32_t seek;
+        if (take_seek(ctx, &seek)) {
+            frame = seek;
+            prev = NULL;
+        }
+
+        if (frame >= g_cached->frame_count) {
+            bool switched = switch_to_next(ctx, next_file);
+
+            // Notify that we completed a loop (for auto-advance)
+            core1_notify_fseq_loop();
+            if (switched) return true;
+            frame = 0;
+        }
+
+        const uint8_t *data = flash_cache_frame(g_cached, frame);
+        uint32_t len = g_cached->frame_size < g_frame_bytes ? g_cached->frame_size : g_frame_bytes;
+        uint32_t steps = g_cached->frame_size >= g_frame_bytes ? interp_steps(ctx) : 1;
+
+        // A repeat of the frame before is already on the LEDs, unless that
+        // frame's interval was split into blends or the brightness or current
+        // limit moved
+        bool hold = false;
+        if (data && prev && !g_next.fading) {
+            bool unchanged = memcmp(prev, data, len) == 0;
+            g_diff.stats.frames++;
+            if (unchanged) g_diff.stats.unchanged++;
+            hold = unchanged && g_sub_steps == 1 && !pb_hold_stale(ctx->driver);
+        }
+
+        if (g_next.fading) {
+            if (data) memcpy(g_fade_frame, data, len);
+            output_fade_frame(ctx);
+        } else if (!hold) {
+            const uint8_t *span = data;
+            for (uint8_t s = 0; s < FSEQ_PLAYER_MAX_STRINGS && span; s++) {
+                if (g_string_lengths[s] > 0) {
+                    pb_set_pixels(ctx->driver, 0, s, 0, span, g_string_lengths[s]);
+                    span += g_string_lengths[s] * 3;
+                }
+            }
+        }
+
+        ctx->frame = frame;
+        show_frame(ctx, hold);
+
+        // Blend toward the following frame (the last one holds); nothing to
+        // blend if it's the same
+        const uint8_t *next = frame + 1 < g_cached->frame_count ?
+                              flash_cache_frame(g_cached, frame + 1) : data;
+        bool blend = steps > 1 && data && next;
+        if (blend && memcmp(data, next, len) == 0) {
+            blend = false;
+            g_diff.stats.held += steps - 1;
+        }
+        if (blend) {
+            show_subframes(ctx, data, next, steps);
+        } else {
+            g_sub_steps = 1;
+        }
+        prev = g_next.fading ? NULL : data;
+        frame++;
+        fps_frame_count++;
+
+        uint32_t remaining = g_cached->frame_count - frame;
+        if (remaining <= fade_frames(ctx) + FSEQ_PREOPEN_FRAMES) {
+            prepare_next(next_file);
+        }
+        if (remaining == fade_frames(ctx)) {
+            start_fade(ctx, g_cached->frame_size);
+        }
+
+        uint64_t now = time_us_64();
+        if (now - last_fps_time >= 1000000) {
+            ctx->fps = fps_frame_count;
+            fps_frame_count = 0;
+            last_fps_time = now;
+        }
+    }
+    return false;
+}
+
+// Playback loop for a sequence streamed from the SD card.
+// Returns true if it moved on to the next show.
+static bool run_sd_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check,
+                        fseq_next_file_fn next_file) {
     printf("FSEQ: run_loop starting, channel_count=%lu\n", (unsigned long)g_header.channel_count);
 
-    // Playback loop - read in chunks, parser handles frame boundaries
+    // Playback loop - read in chunks that stop at frame boundaries, so each
+    // frame's chunks start at the same offsets as the previous frame's
     uint32_t frame_size = g_header.channel_count;
-    uint8_t buffer[512];
+    uint8_t buffer[FSEQ_SD_CHUNK_BYTES];
     if (frame_size > sizeof(buffer)) frame_size = sizeof(buffer);
 
-    uint32_t frames_played = 0;
+    uint32_t frames_played = g_resume_frame;
     uint32_t fps_frame_count = 0;
+    g_resume_frame = 0;
     uint64_t last_fps_time = time_us_64();
     UINT bytes_read;
     FRESULT fr;
@@ -236,6 +918,15 @@ void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check) {
     uint32_t read_count = 0;
     uint32_t total_bytes_read = 0;
 
+    // Whether frames decode into the blend frame (interpolating, skipping
+    // unchanged chunks) is decided per frame
+    uint32_t steps = interp_steps(ctx);
+    bool track = diff_tracking();
+    g_interp_primed = false;
+    frame_diff_invalidate(&g_diff);
+    perf_ring_reset(&perf_play, perf_cycles());
+    play_tracker_reset(&g_play, time_us_64());
+
     while (true) {
         // Check if we should stop
         if (stop_check && stop_check()) {
@@ -245,33 +936,67 @@ void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check) {
             break;
         }
 
+        // Jump to a requested frame (resume, time code). Without an index
+        // the request is dropped before it disturbs playback.
+        uint32_t seek;
+        fseq_index_pos_t pos;
+        __dmb();
+        uint32_t request = ctx->seek_request;
+        if (request != 0 && !g_index_valid) {
+            ctx->seek_request = 0;
+            printf("FSEQ: Seek to frame %lu ignored (no frame index)\n",
+                   (unsigned long)(request - 1));
+        } else if (take_seek(ctx, &seek) && fseq_index_seek(&g_index, seek, &pos)) {
+            f_lseek(g_fseq_file, pos.offset);
+            fseq_parser_reset(g_parser);
+            frames_played = pos.frame;
+            read_count = 0;
+            total_bytes_read = 0;
+            steps = interp_steps(ctx);
+            track = diff_tracking();
+            g_interp_primed = false;
+        }
+
         // Loop based on header frame count, not EOF
         if (frames_played >= g_header.frame_count) {
+            bool switched = switch_to_next(ctx, next_file);
+
             // Notify that we completed a loop (for auto-advance)
             core1_notify_fseq_loop();
+            if (switched) return true;
 
-            f_lseek(&g_fseq_file, g_header.channel_data_offset);
+            f_lseek(g_fseq_file, g_header.channel_data_offset);
             fseq_parser_reset(g_parser);
             frames_played = 0;
             read_count = 0;
             total_bytes_read = 0;
+            g_interp_primed = false;
             continue;
         }
 
-        fr = f_read(&g_fseq_file, buffer, frame_size, &bytes_read);
-        if (fr != FR_OK || bytes_read < frame_size) {
+        uint32_t chunk_start = total_bytes_read;
+        uint32_t chunk = g_header.channel_count - chunk_start;
+        if (chunk > frame_size) chunk = frame_size;
+        trace_begin(TRACE_SD_READ);
+        fr = f_read(g_fseq_file, buffer, chunk, &bytes_read);
+        trace_end(TRACE_SD_READ);
+        if (fr != FR_OK || bytes_read < chunk) {
             // Unexpected EOF or error - loop back
             printf("FSEQ: Read error or EOF, looping (fr=%d, bytes=%u)\n", fr, bytes_read);
-            f_lseek(&g_fseq_file, g_header.channel_data_offset);
+            f_lseek(g_fseq_file, g_header.channel_data_offset);
             fseq_parser_reset(g_parser);
             frames_played = 0;
             read_count = 0;
             total_bytes_read = 0;
+            g_interp_primed = false;
+            frame_diff_invalidate(&g_diff);
             continue;
         }
 
         read_count++;
         total_bytes_read += bytes_read;
+        play_tracker_read(&g_play, bytes_read);
+        perf_lap(PERF_PLAY_READ);
 
         // Check for stop request after potentially slow SD read
         if (stop_check && stop_check()) {
@@ -280,8 +1005,19 @@ void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check) {
             break;
         }
 
-        // Push data to parser
-        bool frame_complete = fseq_parser_push(g_parser, buffer, bytes_read);
+        // Push data to parser (into the blend frame while crossfading,
+        // interpolating or tracking changes). Chunks the same as last frame's,
+        // or past this board's strings, only move the parser along.
+        bool frame_complete;
+        if (track && (chunk_start >= g_frame_bytes ||
+                      frame_diff_chunk(&g_diff, chunk_start / frame_size, buffer, bytes_read))) {
+            frame_complete = fseq_parser_skip(g_parser, buffer, bytes_read);
+        } else {
+            g_decode_mode = (g_next.fading || track || steps > 1) ? DECODE_TO_FRAME : DECODE_TO_DRIVER;
+            frame_complete = fseq_parser_push(g_parser, buffer, bytes_read);
+            g_decode_mode = DECODE_TO_DRIVER;
+        }
+        perf_lap(PERF_PLAY_PARSE);
 
         if (frame_complete) {
             // Debug: log frame completion with byte counts
@@ -291,11 +1027,54 @@ void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check) {
                        (unsigned long)total_bytes_read);
             }
 
-            // Output the frame with FPS limiting
-            pb_show_with_fps(ctx->driver, ctx->target_fps);
+            // Output the frame with FPS limiting. Interpolation shows the
+            // previous frame, then blends toward the one just decoded. A
+            // repeat of the previous frame is already on the LEDs unless that
+            // frame's interval was split into blends or the brightness or current
+            // limit moved.
+            bool unchanged = track && frame_diff_end_frame(&g_diff);
+            bool hold = !g_next.fading && unchanged && g_sub_steps == 1 &&
+                        !pb_hold_stale(ctx->driver);
+            if (!g_next.fading && steps > 1 && !g_interp_primed) {
+                memcpy(g_interp_frame, g_fade_frame, g_frame_bytes);
+                g_interp_primed = true;
+            }
+
+            if (g_next.fading) {
+                output_fade_frame(ctx);
+            } else if (hold) {
+                // Nothing to encode
+            } else if (steps > 1) {
+                pb_set_frame_lerp(ctx->driver, 0, g_interp_frame, g_interp_frame, 0);
+            } else if (track) {
+                pb_set_frame_lerp(ctx->driver, 0, g_fade_frame, g_fade_frame, 0);
+            }
+            ctx->frame = frames_played;
+            show_frame(ctx, hold);
+
+            if (!g_next.fading && steps > 1 && unchanged) {
+                g_sub_steps = 1;  // Nothing to blend toward
+                g_diff.stats.held += steps - 1;
+            } else if (!g_next.fading && steps > 1) {
+                show_subframes(ctx, g_interp_frame, g_fade_frame, steps);
+                memcpy(g_interp_frame, g_fade_frame, g_frame_bytes);
+            } else {
+                g_sub_steps = 1;
+                g_interp_primed = false;
+            }
             frames_played++;
             fps_frame_count++;
 
+            uint32_t remaining = g_header.frame_count - frames_played;
+            if (remaining <= fade_frames(ctx) + FSEQ_PREOPEN_FRAMES) {
+                prepare_next(next_file);
+            }
+            if (remaining == fade_frames(ctx)) {
+                start_fade(ctx, g_header.channel_count);
+            }
+            steps = interp_steps(ctx);
+            track = diff_tracking();
+
             // Reset per-frame counters
             read_count = 0;
             total_bytes_read = 0;
@@ -309,12 +1088,40 @@ void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check) {
             }
         }
     }
+    return false;
+}
+
+void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check,
+                          fseq_next_file_fn next_file) {
+    if (!ctx || !ctx->running) {
+        printf("FSEQ: run_loop early exit (ctx=%p, running=%d)\n", ctx, ctx ? ctx->running : 0);
+        return;
+    }
+
+    // Each pass plays one show; a gapless switch goes round again
+    while (true) {
+        bool switched;
+        if (g_cached) {
+            switched = run_cached_loop(ctx, stop_check, next_file);
+        } else if (g_parser && g_file_open) {
+            switched = run_sd_loop(ctx, stop_check, next_file);
+        } else {
+            printf("FSEQ: run_loop early exit (parser=%p)\n", g_parser);
+            return;
+        }
+        if (!switched) return;
+    }
 }
 
-void fseq_player_cleanup(fseq_player_t *ctx) {
+void fseq_player_cleanup(fseq_player_t *ctx, bool clear_leds) {
     if (!ctx) return;
 
-    printf("FSEQ: Cleaning up (keeping driver)\n");
+    printf("FSEQ: Cleaning up (keeping driver) - %lu/%lu frames unchanged, %lu outputs held\n",
+           (unsigned long)g_diff.stats.unchanged, (unsigned long)g_diff.stats.frames,
+           (unsigned long)g_diff.stats.held);
+
+    discard_next();
+    g_cached = NULL;
 
     // Clean up parser
     if (g_parser) {
@@ -324,17 +1131,19 @@ void fseq_player_cleanup(fseq_player_t *ctx) {
 
     // Close file
     if (g_file_open) {
-        f_close(&g_fseq_file);
+        f_close(g_fseq_file);
         g_file_open = false;
     }
 
-    // Clear LEDs but keep driver for fast file switching
-    if (ctx->driver) {
+    // Clear LEDs but keep driver for fast file switching. When another show
+    // follows straight away, hold the last frame instead of flashing black.
+    if (ctx->driver && clear_leds) {
         pb_show_wait(ctx->driver);      // Wait for any previous DMA
         pb_clear_all(ctx->driver, 0x000000);
         pb_show(ctx->driver);           // Start DMA to output cleared frame
         pb_show_wait(ctx->driver);      // Wait for DMA to complete
     }
+    g_transition_pending = !clear_leds && g_last_show_us != 0;
 
     ctx->running = false;
 }
@@ -343,7 +1152,7 @@ void fseq_player_shutdown(fseq_player_t *ctx) {
     if (!ctx) return;
 
     // Clean up file/parser first
-    fseq_player_cleanup(ctx);
+    fseq_player_cleanup(ctx, true);
 
     // Now destroy driver
     if (ctx->driver) {
@@ -360,3 +1169,18 @@ bool fseq_player_is_running(const fseq_player_t *ctx) {
 uint16_t fseq_player_get_fps(const fseq_player_t *ctx) {
     return ctx ? ctx->fps : 0;
 }
+
+void fseq_player_request_seek(fseq_player_t *ctx, uint32_t frame) {
+    if (!ctx) return;
+    ctx->seek_request = frame + 1;
+    __dmb();
+}
+
+void fseq_player_request_seek_ms(fseq_player_t *ctx, uint32_t ms) {
+    if (!ctx || ctx->step_time_ms == 0) return;
+    fseq_player_request_seek(ctx, ms / ctx->step_time_ms);
+}
+
+uint32_t fseq_player_get_frame(const fseq_player_t *ctx) {
+    return ctx ? ctx->frame : 0;
+}
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "pico/types.h"
 #include "pb_led_driver.h"
 #include "board_config.h"
+#include "chase.h"
+#include "frame_diff.h"
+#include "play_stats.h"
 
 // Maximum supported layout (from board_config.h)
 #define FSEQ_PLAYER_MAX_STRINGS BOARD_CONFIG_MAX_STRINGS
@@ -12,12 +16,26 @@
 // Stop check callback type - returns true if playback should stop
 typedef bool (*fseq_stop_check_fn)(void);
 
+// Next show callback - copies the filename to play after the current one and
+// returns a sequence number identifying that queue entry (0 = nothing queued)
+typedef uint32_t (*fseq_next_file_fn)(char *filename, size_t len);
+
 typedef struct {
     pb_driver_t *driver;
     volatile bool running;
     char filename[32];  // Support long filenames
     uint16_t target_fps;
     uint16_t fps;
+    uint16_t step_time_ms;       // Frame period of the show playing
+    uint32_t frame_count;
+    volatile uint32_t frame;     // Frame last shown (for resume)
+    volatile uint32_t seek_request;  // Requested frame + 1, 0 = none
+    chase_stats_t chase;         // Timecode chase (copied each frame while chasing)
+    frame_diff_stats_t diff;     // Unchanged frames skipped since start (copied each frame)
+    pb_power_stats_t power;      // LED current estimate (copied each frame)
+    play_stats_t play;           // Late frames, SD rate, load since the show started
+    uint32_t transition_us;      // Last gap between shows (last frame to first frame)
+    uint32_t max_transition_us;
 } fseq_player_t;
 
 // Initialize the player context
@@ -27,13 +45,17 @@ bool fseq_player_init(fseq_player_t *ctx, uint first_pin);
 // Called from Core 1 task manager
 bool fseq_player_start(fseq_player_t *ctx, const char *filename);
 
-// Run the playback loop until stop_check returns true
+// Run the playback loop until stop_check returns true. Near the end of each
+// show the one named by next_file (may be NULL) is opened ahead of time and
+// playback moves onto it on the next frame boundary without clearing.
 // Called from Core 1 task manager
-void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check);
+void fseq_player_run_loop(fseq_player_t *ctx, fseq_stop_check_fn stop_check,
+                          fseq_next_file_fn next_file);
 
-// Clean up after playback (close file, clear LEDs, but keep driver for fast file switching)
+// Clean up after playback (close file, but keep driver for fast file switching).
+// clear_leds blanks the strings; pass false when another show starts right away.
 // Called from Core 1 task manager
-void fseq_player_cleanup(fseq_player_t *ctx);
+void fseq_player_cleanup(fseq_player_t *ctx, bool clear_leds);
 
 // Full shutdown including driver destruction (call when switching to different task type)
 void fseq_player_shutdown(fseq_player_t *ctx);
@@ -43,3 +65,14 @@ bool fseq_player_is_running(const fseq_player_t *ctx);
 
 // Get current FPS
 uint16_t fseq_player_get_fps(const fseq_player_t *ctx);
+
+// Jump to a frame of the current show (wraps). Applied by the playback loop
+// on the next frame boundary; callable from either core. SD files seek via
+// a frame index built from the header (and the block table when compressed).
+void fseq_player_request_seek(fseq_player_t *ctx, uint32_t frame);
+
+// Same, by time into the show
+void fseq_player_request_seek_ms(fseq_player_t *ctx, uint32_t ms);
+
+// Frame last output
+uint32_t fseq_player_get_frame(const fseq_player_t *ctx);
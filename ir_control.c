@@ -1,83 +1,92 @@
 #include "ir_control.h"
-#include <stdio.h>
-#include "pico/platform.h"  // For __not_in_flash_func
 
-// Global variables for IR control
-volatile uint32_t ir_data = 0;
-volatile int bit_index = -1;
-volatile absolute_time_t last_fall_time;
-queue_t ir_queue;
-static uint ir_pin = IR_PIN;
+#ifndef IR_CONTROL_TEST_BUILD
+#include "hardware/pio.h"
+#include "hardware/irq.h"
+#include "ir_nec.pio.h"
+#include "ir_nec_timing.h"
 
-// Track spurious/noise edges for filtering
-static volatile uint32_t ir_noise_edges = 0;
+// ir_nec.pio can't include ir_nec_timing.h; make sure the copies agree
+_Static_assert(ir_nec_LEADER_POLL_CYCLES == IR_NEC_LEADER_POLL_CYCLES &&
+               ir_nec_LEADER_POLLS == IR_NEC_LEADER_POLLS &&
+               ir_nec_SPACE_DELAY == IR_NEC_SPACE_DELAY &&
+               ir_nec_SPACE_POLLS == IR_NEC_SPACE_POLLS &&
+               ir_nec_BIT_SAMPLE == IR_NEC_BIT_SAMPLE,
+               "ir_nec.pio timing differs from ir_nec_timing.h");
+#endif
 
-// Process an IR edge (called from main's combined GPIO ISR)
-// Placed in RAM to avoid flash XIP latency affecting timing-critical code
-void __not_in_flash_func(ir_process_edge)(void)
+ir_nec_result_t ir_nec_decode(uint32_t word, uint8_t *code)
 {
-    absolute_time_t isr_now = get_absolute_time();
-    int64_t dt = absolute_time_diff_us(last_fall_time, isr_now);
+    if (word == 0) {
+        return IR_NEC_REPEAT;
+    }
 
-    // Filter out spurious edges during frame reception:
-    // - Too short (< 900us): noise/bounce - let timing accumulate
-    // - Too long (> 3000us but < 10000us): also spurious - accumulate
-    // Valid NEC bits are 1125us (0) or 2250us (1)
-    if (bit_index >= 0)
-    {
-        if ((dt > 0 && dt < 900) || (dt > 3000 && dt < 10000))
-        {
-            ir_noise_edges++;
-            return;  // Don't update last_fall_time, let timing accumulate
-        }
+    // Format: 0xAABBCCDD where BB=~AA and DD=~CC
+    uint8_t addr = (uint8_t)(word >> 24), addr_inv = (uint8_t)(word >> 16);
+    uint8_t cmd = (uint8_t)(word >> 8), cmd_inv = (uint8_t)word;
+    if ((addr ^ addr_inv) != 0xFF || (cmd ^ cmd_inv) != 0xFF) {
+        return IR_NEC_INVALID;
     }
+    *code = cmd;
+    return IR_NEC_FRAME;
+}
 
-    last_fall_time = isr_now;
+#ifndef IR_CONTROL_TEST_BUILD
 
-    // Check for leader pulse (10-20ms)
-    // The remote sends ~9ms burst + ~4.5ms space = ~13.5ms between falling edges
-    if (dt > 10000 && dt < 20000)
-    {
-        bit_index = 31;
-        ir_data = 0;
-    }
-    else if (bit_index >= 0)
-    {
-        // Each bit: pulse ~562us, then space (~562us for 0, ~1690us for 1)
-        // Total: ~1125us for 0, ~2250us for 1
-        // Threshold at 1500us
-        if (dt > 1500)
-        {
-            ir_data |= (1UL << bit_index);
-        }
-        bit_index--;
+static input_ring_t *ir_ring;
+static PIO ir_pio;
+static uint ir_sm;
+
+// Frames that failed the checksum (noise, or a frame cut short)
+static volatile uint32_t ir_bad_frames = 0;
 
-        if (bit_index == -1)
-        {
-            // Frame complete - verify checksum
-            // Format: 0xAABBCCDD where BB=~AA and DD=~CC
-            uint8_t *data = (uint8_t *)&ir_data;
-            if (data[2] == (uint8_t)~data[3] && data[1] == (uint8_t)~data[0])
-            {
-                uint8_t code = data[1];
-                queue_try_add(&ir_queue, &code);
-            }
+// RX FIFO not empty: one interrupt per frame or repeat, at default priority
+static void ir_rx_handler(void)
+{
+    while (!pio_sm_is_rx_fifo_empty(ir_pio, ir_sm)) {
+        uint32_t now = time_us_32();
+        uint8_t code = 0;
+        switch (ir_nec_decode(pio_sm_get(ir_pio, ir_sm), &code)) {
+            case IR_NEC_FRAME:
+                input_ring_push(ir_ring, now, INPUT_SRC_IR, INPUT_RAW_DOWN, code);
+                break;
+            case IR_NEC_REPEAT:
+                input_ring_push(ir_ring, now, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0);
+                break;
+            case IR_NEC_INVALID:
+                ir_bad_frames++;
+                break;
         }
     }
 }
 
-// Initialize IR control (GPIO interrupt must be enabled separately in main)
-void ir_init(uint gpio_pin)
+bool ir_init(uint gpio_pin, input_ring_t *ring)
 {
-    ir_pin = gpio_pin;
-    gpio_init(ir_pin);
-    gpio_set_dir(ir_pin, GPIO_IN);
-    gpio_pull_up(ir_pin);
-    queue_init(&ir_queue, sizeof(uint8_t), 10);
-}
+    ir_ring = ring;
 
-// Get next command from queue
-bool ir_get_next_command(uint8_t *code)
-{
-    return queue_try_remove(&ir_queue, code);
+    // pio0 / pio1 drive the LED strings and string test from GPIO 0. The
+    // receiver is on GPIO 32+, so it gets pio2 with the GPIO base moved up.
+    ir_pio = pio2;
+    if (gpio_pin >= 32 && pio_set_gpio_base(ir_pio, 16) != PICO_OK) {
+        return false;
+    }
+    int sm = pio_claim_unused_sm(ir_pio, false);
+    if (sm < 0) {
+        return false;
+    }
+    if (!pio_can_add_program(ir_pio, &ir_nec_program)) {
+        pio_sm_unclaim(ir_pio, (uint)sm);
+        return false;
+    }
+    ir_sm = (uint)sm;
+    uint offset = pio_add_program(ir_pio, &ir_nec_program);
+    ir_nec_program_init(ir_pio, ir_sm, offset, gpio_pin);
+
+    uint irq = pio_get_irq_num(ir_pio, 0);
+    pio_set_irqn_source_enabled(ir_pio, 0, pio_get_rx_fifo_not_empty_interrupt_source(ir_sm), true);
+    irq_set_exclusive_handler(irq, ir_rx_handler);
+    irq_set_enabled(irq, true);
+    return true;
 }
+
+#endif // IR_CONTROL_TEST_BUILD
@@ -1,10 +1,12 @@
 #ifndef IR_CONTROL_H
 #define IR_CONTROL_H
 
+#include <stdint.h>
+
+#ifndef IR_CONTROL_TEST_BUILD
 #include "pico/stdlib.h"
-#include "hardware/gpio.h"
-#include "hardware/timer.h"
-#include "pico/util/queue.h"
+#include "input.h"
+#endif
 
 // IR Remote Button Codes (NEC protocol)
 #define IR_PIN 42 // GPIO pin for IR receiver on pixel_blit
@@ -64,9 +66,23 @@
 #define FADE3 0x60
 #define FADE7 0xE0
 
-// Function declarations
-void ir_init(uint gpio_pin);
-void ir_process_edge(void);  // Call from combined GPIO ISR
-bool ir_get_next_command(uint8_t *code);
+typedef enum {
+    IR_NEC_INVALID = 0,
+    IR_NEC_FRAME,
+    IR_NEC_REPEAT,
+} ir_nec_result_t;
+
+// Classify a word from the ir_nec PIO program (first bit received in bit
+// 31, 0 for a repeat). For a frame, code gets the command byte.
+ir_nec_result_t ir_nec_decode(uint32_t word, uint8_t *code);
+
+#ifndef IR_CONTROL_TEST_BUILD
+
+// Start the PIO decoder on gpio_pin. Decoded frames go into ring as
+// INPUT_RAW_DOWN (code = command byte), NEC repeat frames as
+// INPUT_RAW_IR_REPEAT. Returns false if no PIO state machine is free.
+bool ir_init(uint gpio_pin, input_ring_t *ring);
+
+#endif // IR_CONTROL_TEST_BUILD
 
 #endif // IR_CONTROL_H
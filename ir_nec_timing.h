@@ -0,0 +1,18 @@
+#ifndef IR_NEC_TIMING_H
+#define IR_NEC_TIMING_H
+
+// Timing of the ir_nec PIO program, in state machine cycles.
+//
+// pioasm can't include C headers, so ir_nec.pio repeats these as
+// .define PUBLIC values and ir_control.c checks at compile time that the
+// two agree. The host tests run a cycle model of the program on these.
+
+#define IR_NEC_CYCLE_NS      56250  // One cycle: 1/10 of the 562.5 us NEC unit
+
+#define IR_NEC_LEADER_POLL_CYCLES 4   // Leader mark checked every 225 us...
+#define IR_NEC_LEADER_POLLS  32     // ...for 32 x 4 cycles = 7.2 ms
+#define IR_NEC_SPACE_DELAY   30     // Space watched from 1.7 ms after the leader...
+#define IR_NEC_SPACE_POLLS   15     // ...every 2 cycles until 3.4 ms
+#define IR_NEC_BIT_SAMPLE    16     // Bit space sampled 0.9 ms in
+
+#endif // IR_NEC_TIMING_H
@@ -9,6 +9,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/**
+ * @brief Number of parsers that can be open at once (statically allocated).
+ * Two lets one sequence be decoded while another crossfades in.
+ */
+#ifndef FSEQ_PARSER_MAX_INSTANCES
+#define FSEQ_PARSER_MAX_INSTANCES 2
+#endif
+
 /**
  * @brief FSEQ v2 Header Structure (Fixed 32 bytes)
  * This matches the file specification exactly.
@@ -61,12 +69,13 @@ typedef struct {
  * @param user_data Pointer passed to the pixel callback.
  * @param pixel_cb Function to call when a pixel is ready.
  * @param layout Hardware layout configuration for address mapping.
- * @return fseq_parser_ctx_t* Allocated context or NULL on failure.
+ * @return fseq_parser_ctx_t* Context from the static pool, or NULL if all
+ *         FSEQ_PARSER_MAX_INSTANCES are in use.
  */
 fseq_parser_ctx_t* fseq_parser_init(void* user_data, fseq_pixel_cb pixel_cb, fseq_layout_t layout);
 
 /**
- * @brief Free the parser context.
+ * @brief Return the parser context to the pool.
  */
 void fseq_parser_deinit(fseq_parser_ctx_t* ctx);
 
@@ -94,6 +103,17 @@ bool fseq_parser_read_header(fseq_parser_ctx_t* ctx, const uint8_t* buffer, fseq
  */
 bool fseq_parser_push(fseq_parser_ctx_t* ctx, const uint8_t* data, uint32_t len);
 
+/**
+ * @brief Consume a block like fseq_parser_push, without pixel callbacks.
+ *
+ * For chunks the caller knows are unchanged since the previous frame (the
+ * pixels it decoded last time are still valid). Frame position advances
+ * exactly as for fseq_parser_push.
+ *
+ * @return true if one or more frames were completed during this block.
+ */
+bool fseq_parser_skip(fseq_parser_ctx_t* ctx, const uint8_t* data, uint32_t len);
+
 /**
  * @brief Reset the parser state.
  * Call this after seeking the file pointer to the start of channel data
@@ -102,9 +122,9 @@ bool fseq_parser_push(fseq_parser_ctx_t* ctx, const uint8_t* data, uint32_t len)
 void fseq_parser_reset(fseq_parser_ctx_t* ctx);
 
 /**
- * @brief Force cleanup of the parser singleton.
+ * @brief Force cleanup of the parser pool.
  * Call this when Core 1 was forcibly reset and couldn't clean up properly.
- * This clears the singleton flag so a new parser can be initialized.
+ * This releases every instance so new parsers can be initialized.
  */
 void fseq_parser_force_cleanup(void);
 
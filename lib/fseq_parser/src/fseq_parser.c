@@ -18,21 +18,30 @@ struct fseq_parser_ctx {
     uint8_t  temp_pixel[3];         ///< Buffer for assembling split pixels (R, G, B)
     uint8_t  temp_pixel_idx;        ///< Number of bytes currently in temp_pixel (0, 1, 2)
     bool     frame_completed;       ///< Flag to indicate frame end was reached
+    bool     quiet;                 ///< Advance without pixel callbacks (fseq_parser_skip)
 
     // Overflow buffer for bytes that arrive after frame boundary
     uint8_t  overflow_buf[512];     ///< Bytes from next frame (worst case: full read)
     uint16_t overflow_len;          ///< Number of valid bytes in overflow_buf
 };
 
-// Static allocation - single instance (no heap)
-static struct fseq_parser_ctx parser_instance;
-static bool parser_in_use = false;
+// Static allocation - fixed pool (no heap), enough for a crossfade
+static struct fseq_parser_ctx parser_pool[FSEQ_PARSER_MAX_INSTANCES];
+static bool parser_in_use[FSEQ_PARSER_MAX_INSTANCES];
 
 fseq_parser_ctx_t* fseq_parser_init(void* user_data, fseq_pixel_cb pixel_cb, fseq_layout_t layout) {
     if (!pixel_cb) return NULL;
-    if (parser_in_use) return NULL;  // Only one instance allowed
 
-    fseq_parser_ctx_t* ctx = &parser_instance;
+    fseq_parser_ctx_t* ctx = NULL;
+    for (int i = 0; i < FSEQ_PARSER_MAX_INSTANCES; i++) {
+        if (!parser_in_use[i]) {
+            parser_in_use[i] = true;
+            ctx = &parser_pool[i];
+            break;
+        }
+    }
+    if (!ctx) return NULL;  // Pool exhausted
+
     memset(ctx, 0, sizeof(fseq_parser_ctx_t));
     ctx->user_data = user_data;
     ctx->pixel_cb = pixel_cb;
@@ -41,20 +50,21 @@ fseq_parser_ctx_t* fseq_parser_init(void* user_data, fseq_pixel_cb pixel_cb, fse
     // the parser. Consider copying array data into parser struct instead.
     ctx->layout = layout;
 
-    parser_in_use = true;
     return ctx;
 }
 
 void fseq_parser_deinit(fseq_parser_ctx_t* ctx) {
-    if (ctx == &parser_instance) {
-        parser_in_use = false;
+    for (int i = 0; i < FSEQ_PARSER_MAX_INSTANCES; i++) {
+        if (ctx == &parser_pool[i]) {
+            parser_in_use[i] = false;
+        }
     }
 }
 
 void fseq_parser_force_cleanup(void) {
     // Called when Core 1 was forcibly reset and couldn't clean up properly
-    parser_in_use = false;
-    memset(&parser_instance, 0, sizeof(parser_instance));
+    memset(parser_in_use, 0, sizeof(parser_in_use));
+    memset(parser_pool, 0, sizeof(parser_pool));
 }
 
 void fseq_parser_reset(fseq_parser_ctx_t* ctx) {
@@ -98,7 +108,7 @@ static bool process_byte(fseq_parser_ctx_t* ctx, uint8_t byte) {
 
         // 2. Output using current coordinates
         // Only if we are within valid string bounds
-        if (ctx->current_string_idx < ctx->layout.num_strings) {
+        if (ctx->current_string_idx < ctx->layout.num_strings && !ctx->quiet) {
             ctx->pixel_cb(ctx->user_data, ctx->current_string_idx, ctx->current_pixel_idx, color);
         }
 
@@ -163,4 +173,12 @@ bool fseq_parser_push(fseq_parser_ctx_t* ctx, const uint8_t* data, uint32_t len)
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+bool fseq_parser_skip(fseq_parser_ctx_t* ctx, const uint8_t* data, uint32_t len) {
+    if (!ctx) return false;
+    ctx->quiet = true;
+    bool complete = fseq_parser_push(ctx, data, len);
+    ctx->quiet = false;
+    return complete;
+}
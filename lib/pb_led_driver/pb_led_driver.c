@@ -26,6 +26,15 @@ struct pb_driver {
     // Statistics
     uint32_t frame_count;
     uint16_t fps;
+
+    // Power estimate: raw channel sums of the frame being encoded, before
+    // brightness. Latched into power_stats on show.
+    uint32_t channel_sums[PB_MAX_STRINGS];
+    pb_power_config_t power;
+    pb_power_stats_t power_stats;
+    uint16_t power_scale;        // Current limit (256 = none), applied on encode
+    uint16_t shown_scale;        // Limit the frame last shown was encoded at
+    uint8_t shown_brightness;    // Global brightness it was encoded at
 };
 
 // ============================================================================
@@ -55,6 +64,11 @@ static pb_value_bits_t* get_board_buffer(pb_driver_t* driver, uint8_t board, uin
     return &driver->buffers[buffer_offset];
 }
 
+// Brightness the encoders apply: global brightness less any current limit
+static uint32_t encode_brightness(const pb_driver_t* driver) {
+    return ((uint32_t)global_brightness * driver->power_scale) >> 8;
+}
+
 // ============================================================================
 // Driver lifecycle
 // ============================================================================
@@ -86,6 +100,12 @@ pb_driver_t* pb_driver_init(const pb_driver_config_t* config) {
     driver->frame_count = 0;
     driver->fps = 0;
 
+    driver->power.channel_ma = PB_POWER_DEFAULT_CHANNEL_MA;
+    driver->power_scale = PB_POWER_SCALE_NONE;
+    driver->shown_scale = PB_POWER_SCALE_NONE;
+    driver->shown_brightness = global_brightness;
+    driver->power_stats.scale = PB_POWER_SCALE_NONE;
+
 #ifndef PB_LED_DRIVER_TEST_BUILD
     // Reset timing state for FPS tracking (static variables persist across driver cycles)
     extern void pb_reset_timing_state(void);
@@ -132,9 +152,15 @@ void pb_set_pixel(pb_driver_t* driver, uint8_t board, uint8_t string,
     if (string >= driver->config.num_strings) return;
     if (pixel >= driver->config.max_pixel_length) return;
 
+    if (pixel < driver->config.strings[string].length) {
+        driver->channel_sums[string] += ((color >> 16) & 0xFF) + ((color >> 8) & 0xFF) +
+                                        (color & 0xFF);
+    }
+
     // Apply global brightness scaling
-    if (global_brightness < 255) {
-        color = pb_color_scale(color, global_brightness);
+    uint32_t brightness = encode_brightness(driver);
+    if (brightness < 255) {
+        color = pb_color_scale(color, (uint8_t)brightness);
     }
 
     // Get back buffer for this board
@@ -177,6 +203,105 @@ void pb_set_pixel(pb_driver_t* driver, uint8_t board, uint8_t string,
     }
 }
 
+// Source byte (0=R, 1=G, 2=B) for each output channel
+static void resolve_byte_order(pb_color_order_t color_order, uint8_t order[3]) {
+    switch (color_order) {
+        case PB_COLOR_ORDER_RGB: order[0] = 0; order[1] = 1; order[2] = 2; break;
+        case PB_COLOR_ORDER_BGR: order[0] = 2; order[1] = 1; order[2] = 0; break;
+        case PB_COLOR_ORDER_RBG: order[0] = 0; order[1] = 2; order[2] = 1; break;
+        case PB_COLOR_ORDER_GBR: order[0] = 1; order[1] = 2; order[2] = 0; break;
+        case PB_COLOR_ORDER_BRG: order[0] = 2; order[1] = 0; order[2] = 1; break;
+        case PB_COLOR_ORDER_GRB:
+        default:                 order[0] = 1; order[1] = 0; order[2] = 2; break;
+    }
+}
+
+void pb_set_pixels(pb_driver_t* driver, uint8_t board, uint8_t string,
+                   uint16_t first_pixel, const uint8_t* rgb, uint16_t count) {
+    if (driver == NULL || rgb == NULL) return;
+    if (board >= driver->config.num_boards) return;
+    if (string >= driver->config.num_strings) return;
+    if (first_pixel >= driver->config.max_pixel_length) return;
+    if (count > driver->config.max_pixel_length - first_pixel) {
+        count = driver->config.max_pixel_length - first_pixel;
+    }
+
+    uint8_t order[3];
+    resolve_byte_order(driver->config.color_order, order);
+
+    // Only pixels on the string draw current (as in pb_set_pixel)
+    uint16_t length = driver->config.strings[string].length;
+    uint16_t lit = length > first_pixel ? length - first_pixel : 0;
+
+    uint32_t gb = encode_brightness(driver);
+    uint32_t clear = ~(1u << string);
+    uint32_t sum = 0;
+    pb_value_bits_t* dest = &get_board_buffer(driver, board, driver->current_buffer)
+                                [(size_t)first_pixel * 3];
+
+    for (uint16_t i = 0; i < count; i++, rgb += 3) {
+        if (i < lit) sum += rgb[0] + rgb[1] + rgb[2];
+        for (int ch = 0; ch < 3; ch++, dest++) {
+            uint32_t value = rgb[order[ch]];
+            if (gb < 255) value = value * gb / 255;
+
+            // Move each bit straight to the string's position, no branches
+            for (int bit = 0; bit < 8; bit++) {
+                uint32_t color_bit = (value >> (7 - bit)) & 1u;
+                dest->planes[bit] = (dest->planes[bit] & clear) | (color_bit << string);
+            }
+        }
+    }
+    driver->channel_sums[string] += sum;
+}
+
+void pb_set_frame_lerp(pb_driver_t* driver, uint8_t board, const uint8_t* a,
+                       const uint8_t* b, uint16_t weight) {
+    if (driver == NULL || a == NULL || b == NULL) return;
+    if (board >= driver->config.num_boards) return;
+    if (weight > 256) weight = 256;
+
+    const pb_driver_config_t* config = &driver->config;
+    uint8_t order[3];
+    resolve_byte_order(config->color_order, order);
+
+    // Where each string starts in the frames
+    uint32_t offsets[PB_MAX_STRINGS];
+    uint32_t offset = 0;
+    for (uint8_t s = 0; s < config->num_strings; s++) {
+        offsets[s] = offset;
+        offset += (uint32_t)config->strings[s].length * 3;
+    }
+
+    uint32_t gb = encode_brightness(driver);
+    uint32_t weight_a = 256u - weight;
+    pb_value_bits_t* dest = get_board_buffer(driver, board, driver->current_buffer);
+
+    // Pixel-major: gather one pixel from every string, build its plane words
+    // in registers, then store each word once
+    for (uint16_t pixel = 0; pixel < config->max_pixel_length; pixel++, dest += 3) {
+        uint32_t planes[3][PB_VALUE_PLANES] = {{0}};
+        size_t byte = (size_t)pixel * 3;
+
+        for (uint8_t s = 0; s < config->num_strings; s++) {
+            if (pixel >= config->strings[s].length) continue;
+            const uint8_t* pa = a + offsets[s] + byte;
+            const uint8_t* pb = b + offsets[s] + byte;
+
+            for (int ch = 0; ch < 3; ch++) {
+                uint32_t value = (pa[order[ch]] * weight_a + pb[order[ch]] * weight) >> 8;
+                driver->channel_sums[s] += value;
+                if (gb < 255) value = value * gb / 255;
+                for (int bit = 0; bit < 8; bit++) {
+                    planes[ch][bit] |= ((value >> (7 - bit)) & 1u) << s;
+                }
+            }
+        }
+
+        memcpy(dest, planes, sizeof(planes));
+    }
+}
+
 pb_color_t pb_get_pixel(const pb_driver_t* driver, uint8_t board,
                         uint8_t string, uint16_t pixel) {
     if (driver == NULL) return 0;
@@ -259,6 +384,87 @@ void pb_driver_swap_buffers(pb_driver_t* driver) {
     driver->current_buffer ^= 1;
 }
 
+// ============================================================================
+// Global brightness
+// ============================================================================
+
+void pb_set_global_brightness(uint8_t brightness) {
+    global_brightness = brightness;
+}
+
+uint8_t pb_get_global_brightness(void) {
+    return global_brightness;
+}
+
+// ============================================================================
+// Power estimate and current limit
+// ============================================================================
+
+void pb_set_power_config(pb_driver_t* driver, const pb_power_config_t* config) {
+    if (driver == NULL || config == NULL) return;
+    driver->power = *config;
+}
+
+void pb_get_power_stats(const pb_driver_t* driver, pb_power_stats_t* stats) {
+    if (driver == NULL || stats == NULL) return;
+    *stats = driver->power_stats;
+}
+
+// Milliamps drawn by a raw channel sum at the given brightness
+static uint32_t sum_to_ma(uint32_t sum, uint16_t channel_ma, uint32_t brightness) {
+    return (uint32_t)(((uint64_t)sum * channel_ma * brightness) / (255u * 255u));
+}
+
+// Largest scale (of 256) that keeps demand_ma within budget_ma (0 = no budget)
+static uint32_t scale_for_budget(uint32_t demand_ma, uint32_t budget_ma) {
+    if (budget_ma == 0 || demand_ma <= budget_ma) return PB_POWER_SCALE_NONE;
+    return (uint32_t)(((uint64_t)budget_ma * PB_POWER_SCALE_NONE) / demand_ma);
+}
+
+// Turn the sums of the frame just encoded into stats and next frame's
+// limit. The frame goes out with the scale it was encoded at, so a sudden
+// bright frame is over budget for one frame before the limit catches it
+// (pb_hold_stale stops a repeat of it being held). The limit drops straight
+// to what's needed and releases over ~16 frames so brightness doesn't pump
+// as the content changes.
+static void power_frame_done(pb_driver_t* driver) {
+    const pb_power_config_t* power = &driver->power;
+    uint32_t demand = 0;
+    uint32_t target = PB_POWER_SCALE_NONE;
+
+    for (uint8_t s = 0; s < driver->config.num_strings; s++) {
+        uint32_t ma = sum_to_ma(driver->channel_sums[s], power->channel_ma, global_brightness);
+        uint32_t t = scale_for_budget(ma, power->string_budget_ma[s]);
+        if (t < target) target = t;
+        demand += ma;
+        driver->channel_sums[s] = 0;
+    }
+    uint32_t t = scale_for_budget(demand, power->budget_ma);
+    if (t < target) target = t;
+
+    pb_power_stats_t* stats = &driver->power_stats;
+    uint32_t applied = driver->power_scale;
+    driver->shown_scale = (uint16_t)applied;
+    driver->shown_brightness = global_brightness;
+    stats->demand_ma = demand;
+    stats->estimate_ma = (demand * applied) >> 8;
+    if (stats->estimate_ma > stats->peak_ma) stats->peak_ma = stats->estimate_ma;
+    if (applied < PB_POWER_SCALE_NONE) stats->limited_frames++;
+
+    if (target < applied) {
+        driver->power_scale = (uint16_t)target;
+    } else {
+        driver->power_scale = (uint16_t)(applied + (target - applied + 15) / 16);
+    }
+    stats->scale = driver->power_scale;
+}
+
+bool pb_hold_stale(const pb_driver_t* driver) {
+    if (driver == NULL) return false;
+    return driver->power_scale != driver->shown_scale ||
+           global_brightness != driver->shown_brightness;
+}
+
 // ============================================================================
 // Show implementation
 // ============================================================================
@@ -267,7 +473,8 @@ void pb_driver_swap_buffers(pb_driver_t* driver) {
 
 // Test build stubs
 void pb_show(pb_driver_t* driver) {
-    (void)driver;
+    if (driver == NULL) return;
+    power_frame_done(driver);
 }
 
 void pb_show_async(pb_driver_t* driver) {
@@ -287,6 +494,14 @@ void pb_show_with_fps(pb_driver_t* driver, uint16_t target_fps) {
     (void)driver; (void)target_fps;
 }
 
+void pb_show_with_interval_us(pb_driver_t* driver, uint32_t interval_us) {
+    (void)driver; (void)interval_us;
+}
+
+void pb_hold_with_interval_us(pb_driver_t* driver, uint32_t interval_us) {
+    (void)driver; (void)interval_us;
+}
+
 uint16_t pb_get_fps(const pb_driver_t* driver) {
     (void)driver;
     return 0;
@@ -317,12 +532,8 @@ void pb_reset_timing_state(void) {
     fps_frame_count = 0;
 }
 
-void pb_show(pb_driver_t* driver) {
-    if (driver == NULL) return;
-
-    // Trigger DMA (blocking) - swap happens inside after semaphore acquired
-    (void)pb_hw_show(driver, true);
-
+// Count a frame period for the FPS average and pacing
+static void count_frame(pb_driver_t* driver) {
     driver->frame_count++;
 
     // Calculate FPS averaged over 1 second
@@ -340,6 +551,17 @@ void pb_show(pb_driver_t* driver) {
     last_show_time = now;
 }
 
+void pb_show(pb_driver_t* driver) {
+    if (driver == NULL) return;
+
+    power_frame_done(driver);
+
+    // Trigger DMA (blocking) - swap happens inside after semaphore acquired
+    (void)pb_hw_show(driver, true);
+
+    count_frame(driver);
+}
+
 void pb_show_async(pb_driver_t* driver) {
     if (driver == NULL) return;
 
@@ -349,6 +571,7 @@ void pb_show_async(pb_driver_t* driver) {
         return;
     }
 
+    power_frame_done(driver);
     driver->frame_count++;
 }
 
@@ -364,10 +587,12 @@ bool pb_show_busy(const pb_driver_t* driver) {
 
 void pb_show_with_fps(pb_driver_t* driver, uint16_t target_fps) {
     if (driver == NULL || target_fps == 0) return;
+    pb_show_with_interval_us(driver, 1000000 / target_fps);
+}
 
-    uint64_t target_interval_us = 1000000 / target_fps;
-
-    // Wait for target interval: sleep while far away, tight-spin at the end
+// Wait until target_interval_us after the previous frame: sleep while far
+// away, tight-spin at the end
+static void wait_for_interval(uint32_t target_interval_us) {
     if (last_show_time > 0) {
         uint64_t target_time = last_show_time + target_interval_us;
         // Sleep in 100µs chunks until we're within 200µs
@@ -379,10 +604,20 @@ void pb_show_with_fps(pb_driver_t* driver, uint16_t target_fps) {
             tight_loop_contents();
         }
     }
+}
 
+void pb_show_with_interval_us(pb_driver_t* driver, uint32_t target_interval_us) {
+    if (driver == NULL) return;
+    wait_for_interval(target_interval_us);
     pb_show(driver);
 }
 
+void pb_hold_with_interval_us(pb_driver_t* driver, uint32_t target_interval_us) {
+    if (driver == NULL) return;
+    wait_for_interval(target_interval_us);
+    count_frame(driver);
+}
+
 uint16_t pb_get_fps(const pb_driver_t* driver) {
     if (driver == NULL) return 0;
     return driver->fps;
@@ -393,12 +628,4 @@ uint32_t pb_get_frame_count(const pb_driver_t* driver) {
     return driver->frame_count;
 }
 
-void pb_set_global_brightness(uint8_t brightness) {
-    global_brightness = brightness;
-}
-
-uint8_t pb_get_global_brightness(void) {
-    return global_brightness;
-}
-
 #endif // PB_LED_DRIVER_TEST_BUILD
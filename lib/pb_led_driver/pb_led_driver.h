@@ -139,6 +139,25 @@ const pb_driver_config_t* pb_driver_get_config(const pb_driver_t* driver);
 void pb_set_pixel(pb_driver_t* driver, uint8_t board, uint8_t string,
                   uint16_t pixel, pb_color_t color);
 
+/**
+ * Set consecutive pixels on one string from packed RGB bytes (3 per pixel).
+ * Same result as pb_set_pixel per pixel, but resolves the buffer, colour
+ * order and brightness once per call. Pixels past the string end are dropped.
+ */
+void pb_set_pixels(pb_driver_t* driver, uint8_t board, uint8_t string,
+                   uint16_t first_pixel, const uint8_t* rgb, uint16_t count);
+
+/**
+ * Encode a whole board from two frames blended toward b by weight/256.
+ * Frames are in board channel order: each string's RGB bytes back to back,
+ * lengths from the config. Works pixel-major across strings so every plane
+ * word is written once instead of read-modify-written per string, which
+ * makes re-encoding at a multiple of the source frame rate affordable.
+ * Pass a == b (any weight) to encode a single frame.
+ */
+void pb_set_frame_lerp(pb_driver_t* driver, uint8_t board, const uint8_t* a,
+                       const uint8_t* b, uint16_t weight);
+
 /** Get pixel value from buffer */
 pb_color_t pb_get_pixel(const pb_driver_t* driver, uint8_t board,
                         uint8_t string, uint16_t pixel);
@@ -164,6 +183,16 @@ bool pb_show_busy(const pb_driver_t* driver);
 /** Show with frame rate limiting */
 void pb_show_with_fps(pb_driver_t* driver, uint16_t target_fps);
 
+/** Show no sooner than interval_us after the previous show (variable rate) */
+void pb_show_with_interval_us(pb_driver_t* driver, uint32_t interval_us);
+
+/**
+ * Pace like pb_show_with_interval_us but send nothing: the LEDs keep the
+ * frame already out. For a frame identical to the previous one. The back
+ * buffer is left as it was, so the next real show must encode every pixel.
+ */
+void pb_hold_with_interval_us(pb_driver_t* driver, uint32_t interval_us);
+
 // ============================================================================
 // Statistics
 // ============================================================================
@@ -174,6 +203,63 @@ uint16_t pb_get_fps(const pb_driver_t* driver);
 /** Get total frame count since init */
 uint32_t pb_get_frame_count(const pb_driver_t* driver);
 
+// ============================================================================
+// Power estimate and current limit
+// ============================================================================
+
+/** WS2811/WS2812 draw about 20 mA per channel at full value */
+#define PB_POWER_DEFAULT_CHANNEL_MA 20
+
+/** Limit scale meaning "not limiting" */
+#define PB_POWER_SCALE_NONE 256
+
+/** Current budgets (0 = unlimited) */
+typedef struct {
+    uint16_t channel_ma;                           // Draw of one channel at 255
+    uint32_t budget_ma;                            // Whole board
+    uint16_t string_budget_ma[PB_MAX_STRINGS];     // Per string
+} pb_power_config_t;
+
+/** Per-frame current estimate, latched on each show */
+typedef struct {
+    uint32_t demand_ma;         // Last frame at the requested brightness
+    uint32_t estimate_ma;       // Last frame as sent, after limiting
+    uint32_t peak_ma;           // Highest estimate since init
+    uint16_t scale;             // Limit for the next frame (256 = none)
+    uint32_t limited_frames;    // Frames sent with the limit engaged
+} pb_power_stats_t;
+
+/**
+ * Set current budgets. The encoders sum every channel value as they encode,
+ * so the estimate costs an add per pixel rather than a pass over the frame.
+ * When a frame's demand exceeds a budget, later frames are encoded with an
+ * extra brightness scale that holds the draw at the budget. Assumes each
+ * pixel is written once per frame; writing a pixel twice counts it twice.
+ */
+void pb_set_power_config(pb_driver_t* driver, const pb_power_config_t* config);
+
+/** Get the latest current estimate */
+void pb_get_power_stats(const pb_driver_t* driver, pb_power_stats_t* stats);
+
+/**
+ * True when the next encode would use a different limit or global
+ * brightness than the frame on the LEDs. A repeat of that frame must then
+ * be encoded and shown rather than held, or an over-budget frame stays up
+ * (and brightness changes don't show) for as long as it repeats.
+ */
+bool pb_hold_stale(const pb_driver_t* driver);
+
+// ============================================================================
+// Hooks
+// ============================================================================
+
+/**
+ * Called from the DMA completion interrupt on entry (begin = true) and exit.
+ * The library's default does nothing; define it in the application to trace
+ * interrupt timing. Runs in interrupt context.
+ */
+void pb_trace_dma_irq(bool begin);
+
 // ============================================================================
 // Global brightness control
 // ============================================================================
@@ -57,6 +57,12 @@ extern void pb_driver_swap_buffers(pb_driver_t* driver);
 // Interrupt handlers
 // ============================================================================
 
+// Called on entry (true) and exit (false) of the DMA handler. Applications
+// can override this to trace interrupt timing.
+__attribute__((weak)) void pb_trace_dma_irq(bool begin) {
+    (void)begin;
+}
+
 static int64_t reset_delay_complete(alarm_id_t id, void* user_data) {
     (void)id;
     (void)user_data;
@@ -66,6 +72,7 @@ static int64_t reset_delay_complete(alarm_id_t id, void* user_data) {
 }
 
 static void __isr dma_complete_handler(void) {
+    pb_trace_dma_irq(true);
     if (dma_hw->ints0 & (1u << PB_DMA_CHANNEL)) {
         // Clear interrupt
         dma_hw->ints0 = (1u << PB_DMA_CHANNEL);
@@ -77,6 +84,7 @@ static void __isr dma_complete_handler(void) {
         // WS2811/WS2812 reset delay from config (typically 200us)
         hw_state.reset_alarm_id = add_alarm_in_us(hw_state.reset_us, reset_delay_complete, NULL, true);
     }
+    pb_trace_dma_irq(false);
 }
 
 // ============================================================================
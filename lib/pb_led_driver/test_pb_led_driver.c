@@ -7,6 +7,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "pb_led_driver.h"
 
@@ -294,6 +295,101 @@ TEST(set_pixel_different_positions) {
     pb_driver_deinit(driver);
 }
 
+TEST(set_pixels_matches_set_pixel) {
+    pb_driver_config_t config = {
+        .board_id = 0,
+        .num_boards = 1,
+        .num_strings = 4,
+        .max_pixel_length = 10,
+        .color_order = PB_COLOR_ORDER_BRG,
+    };
+    for (int i = 0; i < 4; i++) {
+        config.strings[i].length = 10;
+        config.strings[i].enabled = true;
+    }
+
+    pb_driver_t* driver = pb_driver_init(&config);
+    ASSERT_TRUE(driver != NULL);
+
+    // Neighbouring strings must be left alone
+    pb_set_pixel(driver, 0, 1, 3, 0xFFFFFF);
+    pb_set_pixel(driver, 0, 3, 3, 0xA5A5A5);
+
+    uint8_t rgb[] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0xFF, 0x00, 0x80};
+    pb_set_pixels(driver, 0, 2, 2, rgb, 3);
+
+    ASSERT_EQ(0x112233, pb_get_pixel(driver, 0, 2, 2));
+    ASSERT_EQ(0x445566, pb_get_pixel(driver, 0, 2, 3));
+    ASSERT_EQ(0xFF0080, pb_get_pixel(driver, 0, 2, 4));
+    ASSERT_EQ(0xFFFFFF, pb_get_pixel(driver, 0, 1, 3));
+    ASSERT_EQ(0xA5A5A5, pb_get_pixel(driver, 0, 3, 3));
+
+    // Runs past the end are clipped
+    pb_set_pixels(driver, 0, 2, 9, rgb, 3);
+    ASSERT_EQ(0x112233, pb_get_pixel(driver, 0, 2, 9));
+
+    // Brightness matches pb_set_pixel
+    pb_set_global_brightness(100);
+    pb_set_pixels(driver, 0, 0, 0, rgb, 1);
+    pb_set_pixel(driver, 0, 0, 1, 0x112233);
+    pb_set_global_brightness(255);
+    ASSERT_EQ(pb_get_pixel(driver, 0, 0, 1), pb_get_pixel(driver, 0, 0, 0));
+
+    pb_driver_deinit(driver);
+}
+
+TEST(set_frame_lerp_blends_every_string) {
+    pb_driver_config_t config = {
+        .board_id = 0,
+        .num_boards = 1,
+        .num_strings = 3,
+        .max_pixel_length = 4,
+        .color_order = PB_COLOR_ORDER_GRB,
+    };
+    config.strings[0].length = 2;
+    config.strings[0].enabled = true;
+    config.strings[1].length = 0;
+    config.strings[1].enabled = false;
+    config.strings[2].length = 4;
+    config.strings[2].enabled = true;
+
+    pb_driver_t* driver = pb_driver_init(&config);
+    ASSERT_TRUE(driver != NULL);
+
+    // Strings back to back: string 0 (2 px), string 2 (4 px)
+    uint8_t a[18];
+    uint8_t b[18];
+    for (int i = 0; i < 18; i++) {
+        a[i] = (uint8_t)(i * 10);
+        b[i] = (uint8_t)(255 - i * 10);
+    }
+
+    // Weight 0 encodes a exactly, like pb_set_pixels
+    pb_set_frame_lerp(driver, 0, a, b, 0);
+    ASSERT_EQ(0x000A14, pb_get_pixel(driver, 0, 0, 0));
+    ASSERT_EQ(0x1E2832, pb_get_pixel(driver, 0, 0, 1));
+    ASSERT_EQ(0x3C4650, pb_get_pixel(driver, 0, 2, 0));
+    ASSERT_EQ(0x96A0AA, pb_get_pixel(driver, 0, 2, 3));
+    ASSERT_EQ(0x000000, pb_get_pixel(driver, 0, 0, 2));  // Past the string end
+
+    // Full weight is b, halfway is the midpoint (rounded down)
+    pb_set_frame_lerp(driver, 0, a, b, 256);
+    ASSERT_EQ(0xFFF5EB, pb_get_pixel(driver, 0, 0, 0));
+    pb_set_frame_lerp(driver, 0, a, b, 128);
+    ASSERT_EQ(0x7F7F7F, pb_get_pixel(driver, 0, 0, 0));
+    ASSERT_EQ(0x7F7F7F, pb_get_pixel(driver, 0, 2, 3));
+
+    // Brightness matches pb_set_pixels
+    pb_set_global_brightness(100);
+    pb_set_frame_lerp(driver, 0, a, a, 0);
+    pb_color_t lerped = pb_get_pixel(driver, 0, 2, 1);
+    pb_set_pixels(driver, 0, 2, 1, &a[9], 1);
+    pb_set_global_brightness(255);
+    ASSERT_EQ(pb_get_pixel(driver, 0, 2, 1), lerped);
+
+    pb_driver_deinit(driver);
+}
+
 TEST(clear_board_sets_all_pixels) {
     pb_driver_config_t config = {
         .board_id = 0,
@@ -326,6 +422,191 @@ TEST(clear_board_sets_all_pixels) {
     pb_driver_deinit(driver);
 }
 
+// ============================================================================
+// Power estimate tests
+// ============================================================================
+
+static pb_driver_t* init_power_driver(void) {
+    pb_driver_config_t config = {
+        .board_id = 0,
+        .num_boards = 1,
+        .num_strings = 2,
+        .max_pixel_length = 4,
+        .color_order = PB_COLOR_ORDER_GRB,
+    };
+    for (int s = 0; s < 2; s++) {
+        config.strings[s].length = 4;
+        config.strings[s].enabled = true;
+    }
+    return pb_driver_init(&config);
+}
+
+static const uint8_t white4[12] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+static const uint8_t black4[12] = {0};
+
+TEST(power_estimate_tracks_encoded_frame) {
+    pb_driver_t* driver = init_power_driver();
+    ASSERT_TRUE(driver != NULL);
+
+    // Four white pixels at the default 20 mA per channel
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    pb_set_pixels(driver, 0, 1, 0, black4, 4);
+    pb_show(driver);
+
+    pb_power_stats_t stats;
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(240, stats.demand_ma);
+    ASSERT_EQ(240, stats.estimate_ma);
+    ASSERT_EQ(PB_POWER_SCALE_NONE, stats.scale);
+
+    // Brightness counts; the peak stays. Frame is string 0 then string 1.
+    uint8_t frame[24];
+    memcpy(frame, black4, sizeof(black4));
+    memcpy(&frame[12], white4, sizeof(white4));
+    pb_set_global_brightness(102);
+    pb_set_frame_lerp(driver, 0, frame, frame, 0);
+    pb_show(driver);
+    pb_set_global_brightness(255);
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(96, stats.demand_ma);
+    ASSERT_EQ(240, stats.peak_ma);
+    ASSERT_EQ(0, stats.limited_frames);
+
+    pb_driver_deinit(driver);
+}
+
+TEST(power_limit_holds_board_budget) {
+    pb_driver_t* driver = init_power_driver();
+    ASSERT_TRUE(driver != NULL);
+
+    pb_power_config_t power = {.channel_ma = 20, .budget_ma = 120};
+    pb_set_power_config(driver, &power);
+
+    // First bright frame goes out as is, then the limit halves it
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    pb_show(driver);
+    pb_power_stats_t stats;
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(240, stats.estimate_ma);
+    ASSERT_EQ(128, stats.scale);
+
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    ASSERT_EQ(0x7F7F7F, pb_get_pixel(driver, 0, 0, 0));
+    pb_show(driver);
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(240, stats.demand_ma);
+    ASSERT_EQ(120, stats.estimate_ma);
+    ASSERT_EQ(1, stats.limited_frames);
+
+    // Releases gradually once the content gets darker
+    pb_set_pixels(driver, 0, 0, 0, black4, 4);
+    pb_show(driver);
+    pb_get_power_stats(driver, &stats);
+    ASSERT_TRUE(stats.scale > 128 && stats.scale < PB_POWER_SCALE_NONE);
+    for (int i = 0; i < 64; i++) pb_show(driver);
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(PB_POWER_SCALE_NONE, stats.scale);
+
+    pb_driver_deinit(driver);
+}
+
+TEST(power_limit_holds_string_budget) {
+    pb_driver_t* driver = init_power_driver();
+    ASSERT_TRUE(driver != NULL);
+
+    pb_power_config_t power = {.channel_ma = 20};
+    power.string_budget_ma[1] = 60;
+    pb_set_power_config(driver, &power);
+
+    // String 0 has no budget of its own
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    pb_show(driver);
+    pb_power_stats_t stats;
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(PB_POWER_SCALE_NONE, stats.scale);
+
+    // 240 mA on string 1 against 60 mA
+    pb_set_pixels(driver, 0, 1, 0, white4, 4);
+    pb_show(driver);
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(64, stats.scale);
+
+    pb_driver_deinit(driver);
+}
+
+TEST(power_limit_reaches_repeated_frame) {
+    pb_driver_t* driver = init_power_driver();
+    ASSERT_TRUE(driver != NULL);
+
+    pb_power_config_t power = {.channel_ma = 20, .budget_ma = 120};
+    pb_set_power_config(driver, &power);
+
+    // A bright frame goes out unlimited; its repeat can't be held
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    ASSERT_TRUE(!pb_hold_stale(driver));
+    pb_show(driver);
+    ASSERT_TRUE(pb_hold_stale(driver));
+
+    // Encoded again, the repeat comes out scaled and can be held after that
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    ASSERT_EQ(0x7F7F7F, pb_get_pixel(driver, 0, 0, 0));
+    pb_show(driver);
+    pb_power_stats_t stats;
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(120, stats.estimate_ma);
+    ASSERT_TRUE(!pb_hold_stale(driver));
+
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    pb_show(driver);
+    ASSERT_TRUE(!pb_hold_stale(driver));
+
+    pb_driver_deinit(driver);
+}
+
+TEST(power_estimate_ignores_pixels_past_string) {
+    pb_driver_config_t config = {
+        .board_id = 0,
+        .num_boards = 1,
+        .num_strings = 1,
+        .max_pixel_length = 4,
+        .color_order = PB_COLOR_ORDER_GRB,
+    };
+    config.strings[0].length = 2;
+    config.strings[0].enabled = true;
+    pb_driver_t* driver = pb_driver_init(&config);
+    ASSERT_TRUE(driver != NULL);
+
+    // A span running past the string's 2 pixels counts only those 2
+    pb_set_pixels(driver, 0, 0, 1, white4, 3);
+    pb_show(driver);
+    pb_power_stats_t stats;
+    pb_get_power_stats(driver, &stats);
+    ASSERT_EQ(60, stats.demand_ma);
+
+    pb_driver_deinit(driver);
+}
+
+TEST(brightness_change_ends_hold) {
+    pb_driver_t* driver = init_power_driver();
+    ASSERT_TRUE(driver != NULL);
+
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    pb_show(driver);
+    ASSERT_TRUE(!pb_hold_stale(driver));
+
+    // The frame on the LEDs is at the old brightness until encoded again
+    pb_set_global_brightness(128);
+    ASSERT_TRUE(pb_hold_stale(driver));
+    pb_set_pixels(driver, 0, 0, 0, white4, 4);
+    pb_show(driver);
+    ASSERT_TRUE(!pb_hold_stale(driver));
+    pb_set_global_brightness(255);
+
+    pb_driver_deinit(driver);
+}
+
 // ============================================================================
 // Raster creation tests
 // ============================================================================
@@ -917,8 +1198,18 @@ int main(void) {
     RUN_TEST(set_pixel_basic);
     RUN_TEST(set_pixel_different_strings);
     RUN_TEST(set_pixel_different_positions);
+    RUN_TEST(set_pixels_matches_set_pixel);
+    RUN_TEST(set_frame_lerp_blends_every_string);
     RUN_TEST(clear_board_sets_all_pixels);
 
+    printf("\nPower estimate tests:\n");
+    RUN_TEST(power_estimate_tracks_encoded_frame);
+    RUN_TEST(power_limit_holds_board_budget);
+    RUN_TEST(power_limit_holds_string_budget);
+    RUN_TEST(power_limit_reaches_repeated_frame);
+    RUN_TEST(power_estimate_ignores_pixels_past_string);
+    RUN_TEST(brightness_change_ends_hold);
+
     printf("\nRaster creation tests:\n");
     RUN_TEST(raster_create_returns_valid_id);
     RUN_TEST(raster_get_dimensions);
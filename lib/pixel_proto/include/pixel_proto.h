@@ -0,0 +1,213 @@
+/**
+ * @file pixel_proto.h
+ * @brief Network pixel protocol decoder: DDP, E1.31 (sACN) and Art-Net.
+ *
+ * Parses single packets, maps universe/offset to (board, string, pixel) and
+ * assembles complete frames. Decoded data is emitted as contiguous per-string
+ * RGB spans so it can go straight to the encoder without per-pixel callbacks.
+ */
+
+#ifndef PIXEL_PROTO_H
+#define PIXEL_PROTO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Well-known UDP ports
+#define PP_DDP_PORT     4048
+#define PP_E131_PORT    5568
+#define PP_ARTNET_PORT  6454
+
+#define PP_DDP_HEADER_LEN       10
+#define PP_DDP_HEADER_LEN_TIME  14      // Header with 4-byte timecode
+#define PP_DDP_MAX_DATA         1440    // Max DDP payload (fits one Ethernet frame)
+
+// DDP header flag bits (byte 0)
+#define PP_DDP_FLAG_VER_MASK    0xC0
+#define PP_DDP_FLAG_VER1        0x40
+#define PP_DDP_FLAG_TIME        0x10
+#define PP_DDP_FLAG_STORAGE     0x08
+#define PP_DDP_FLAG_REPLY       0x04
+#define PP_DDP_FLAG_QUERY       0x02
+#define PP_DDP_FLAG_PUSH        0x01
+
+// DDP destination IDs accepted (1 = default output device, 255 = all)
+#define PP_DDP_ID_DISPLAY       1
+#define PP_DDP_ID_ALL           255
+#define PP_DMX_SLOTS            512
+
+#define PP_MAX_STRINGS          32
+#define PP_MAX_UNIVERSES        128     // Per board: 32 x 512 px = 97 universes at 510 ch
+#define PP_SYNC_TIMEOUT_MS      4000    // Fall back to free-run after this long without sync
+
+// ============================================================================
+// Packet parsing
+// ============================================================================
+
+typedef enum {
+    PP_PROTO_UNKNOWN = 0,
+    PP_PROTO_DDP,
+    PP_PROTO_E131,
+    PP_PROTO_ARTNET,
+} pp_proto_t;
+
+typedef enum {
+    PP_PACKET_INVALID = 0,   // Not a recognised packet
+    PP_PACKET_DATA,          // Pixel data
+    PP_PACKET_SYNC,          // E1.31 sync or ArtSync
+    PP_PACKET_IGNORED,       // Valid but not for us (poll, query, preview, ...)
+} pp_packet_kind_t;
+
+/**
+ * @brief A parsed packet. data points into the caller's buffer.
+ */
+typedef struct {
+    pp_proto_t proto;
+    pp_packet_kind_t kind;
+    uint8_t sequence;
+    bool sequenced;             // False if sender doesn't use sequence numbers
+    uint16_t universe;          // DMX universe (E1.31/Art-Net), sync address for E1.31 sync
+    uint16_t sync_address;      // E1.31 data: universe the sender syncs on (0 = none)
+    uint32_t channel_offset;    // DDP: absolute channel offset. DMX: 0
+    const uint8_t* data;
+    uint16_t length;
+    bool push;                  // DDP PUSH flag (end of frame)
+} pp_packet_t;
+
+/**
+ * @brief Identify and parse one UDP payload (or one framed DDP packet).
+ * @return Packet kind; out is filled for DATA and SYNC.
+ */
+pp_packet_kind_t pp_parse_packet(const uint8_t* buf, uint16_t len, pp_packet_t* out);
+
+// ============================================================================
+// Channel mapping
+// ============================================================================
+
+/**
+ * @brief Board layout in the sender's channel space.
+ *
+ * Channels map linearly like FSEQ: string 0 first, then string 1, etc.,
+ * 3 channels per pixel. DMX universes are laid end to end starting at
+ * start_universe, each carrying channels_per_universe channels.
+ */
+typedef struct {
+    uint8_t board_id;
+    uint8_t num_strings;
+    const uint16_t* string_lengths;  // Must outlive the assembler
+    uint32_t start_channel;          // Absolute channel of string 0 pixel 0
+    uint16_t start_universe;         // Universe carrying absolute channel 0
+    uint16_t channels_per_universe;  // 510 = 170 RGB pixels (xLights default)
+} pp_layout_t;
+
+typedef struct {
+    uint8_t board;
+    uint8_t string;
+    uint16_t pixel;
+    uint8_t component;               // 0=R, 1=G, 2=B (stream order)
+} pp_location_t;
+
+/**
+ * @brief Map an absolute channel to a location on this board.
+ * @return false if the channel belongs to another board or is past the layout.
+ */
+bool pp_map_channel(const pp_layout_t* layout, uint32_t channel, pp_location_t* out);
+
+/**
+ * @brief Absolute channel of the first slot in a universe.
+ * @return UINT32_MAX if the universe is below start_universe.
+ */
+uint32_t pp_universe_to_channel(const pp_layout_t* layout, uint16_t universe);
+
+// ============================================================================
+// Frame assembly
+// ============================================================================
+
+/**
+ * @brief Span output: count RGB pixels (3 bytes each, stream order) for
+ * consecutive pixels of one string, starting at first_pixel.
+ */
+typedef void (*pp_span_cb)(void* user_data, uint8_t string, uint16_t first_pixel,
+                           const uint8_t* rgb, uint16_t count);
+
+typedef struct {
+    uint32_t packets;        // Data packets accepted
+    uint32_t frames;         // Frames completed
+    uint32_t sync_frames;    // Frames completed by a sync packet or DDP PUSH
+    uint32_t partial_frames; // Frames completed with universes missing
+    uint32_t out_of_order;   // Packets discarded as late or duplicate
+    uint32_t lost;           // Sequence gaps (packets never received)
+    uint32_t ignored;        // Valid packets not for this board
+} pp_stats_t;
+
+typedef struct {
+    pp_layout_t layout;
+    pp_span_cb span_cb;
+    void* user_data;
+
+    // Derived layout
+    uint32_t num_channels;                    // Channels on this board
+    uint32_t string_start[PP_MAX_STRINGS + 1];// First pixel index of each string
+    uint16_t first_universe;                  // First universe touching this board
+    uint16_t universe_count;                  // Universes touching this board
+
+    // Frame tracking
+    uint32_t received[PP_MAX_UNIVERSES / 32]; // Universes received this frame
+    uint16_t received_count;
+    uint8_t last_seq[PP_MAX_UNIVERSES];       // Last DMX sequence per universe
+    uint32_t seq_valid[PP_MAX_UNIVERSES / 32];
+    uint8_t ddp_last_seq;
+    bool frame_dirty;                         // Data written since last frame
+
+    // Sync state
+    bool sync_mode;                           // Sender uses sync packets
+    uint16_t sync_address;                    // E1.31 sync universe in use
+    uint32_t last_sync_ms;
+
+    // Pixel straddling two packets
+    uint32_t carry_pixel;
+    uint8_t carry[3];
+    uint8_t carry_have;                       // Bit mask of components present
+
+    pp_stats_t stats;
+} pp_assembler_t;
+
+/**
+ * @brief Result of feeding a packet to the assembler.
+ */
+typedef enum {
+    PP_PUSH_OK = 0,          // Consumed, frame still in progress
+    PP_PUSH_FRAME,           // Consumed and the frame is complete - show it
+    PP_PUSH_FRAME_REPLAY,    // Packet starts the next frame and was NOT consumed:
+                             // show the completed frame, then push it again
+} pp_push_result_t;
+
+/**
+ * @brief Initialize assembler for a layout.
+ */
+void pp_assembler_init(pp_assembler_t* a, const pp_layout_t* layout,
+                       pp_span_cb span_cb, void* user_data);
+
+/**
+ * @brief Forget partial frame and sequence history (e.g. on source change).
+ */
+void pp_assembler_reset(pp_assembler_t* a);
+
+/**
+ * @brief Feed one parsed packet.
+ *
+ * Frames complete on DDP PUSH, on E1.31 sync / ArtSync once the sender uses
+ * them, or otherwise when every universe covering this board has arrived.
+ * A universe arriving twice before that ends the frame early (partial).
+ *
+ * @param now_ms Monotonic milliseconds (for sync timeout).
+ */
+pp_push_result_t pp_assembler_push(pp_assembler_t* a, const pp_packet_t* pkt, uint32_t now_ms);
+
+/**
+ * @brief Parse and feed one raw packet.
+ */
+pp_push_result_t pp_assembler_push_raw(pp_assembler_t* a, const uint8_t* buf, uint16_t len,
+                                       uint32_t now_ms);
+
+#endif // PIXEL_PROTO_H
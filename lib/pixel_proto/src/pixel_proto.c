@@ -0,0 +1,490 @@
+/**
+ * @file pixel_proto.c
+ * @brief DDP / E1.31 / Art-Net packet parsing and frame assembly.
+ */
+
+#include "pixel_proto.h"
+#include <string.h>
+
+// ============================================================================
+// Byte helpers
+// ============================================================================
+
+static inline uint16_t be16(const uint8_t* p) {
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+static inline uint32_t be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline uint16_t le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+// ============================================================================
+// DDP
+// ============================================================================
+
+static pp_packet_kind_t parse_ddp(const uint8_t* buf, uint16_t len, pp_packet_t* out) {
+    if (len < PP_DDP_HEADER_LEN) return PP_PACKET_INVALID;
+
+    uint8_t flags = buf[0];
+    if ((flags & PP_DDP_FLAG_VER_MASK) != PP_DDP_FLAG_VER1) return PP_PACKET_INVALID;
+
+    uint16_t header_len = (flags & PP_DDP_FLAG_TIME) ? PP_DDP_HEADER_LEN_TIME : PP_DDP_HEADER_LEN;
+    uint16_t data_len = be16(&buf[8]);
+    if (len < header_len || data_len > PP_DDP_MAX_DATA || header_len + data_len > len) {
+        return PP_PACKET_INVALID;
+    }
+
+    out->proto = PP_PROTO_DDP;
+    if ((flags & (PP_DDP_FLAG_QUERY | PP_DDP_FLAG_REPLY | PP_DDP_FLAG_STORAGE)) ||
+        (buf[3] != PP_DDP_ID_DISPLAY && buf[3] != PP_DDP_ID_ALL)) {
+        return PP_PACKET_IGNORED;
+    }
+
+    // Byte 2 (data type) is not checked: senders disagree on it and we
+    // only support 8-bit RGB anyway
+    out->sequence = buf[1] & 0x0F;
+    out->sequenced = out->sequence != 0;
+    out->universe = 0;
+    out->sync_address = 0;
+    out->channel_offset = be32(&buf[4]);
+    out->data = &buf[header_len];
+    out->length = data_len;
+    out->push = (flags & PP_DDP_FLAG_PUSH) != 0;
+    return PP_PACKET_DATA;
+}
+
+// ============================================================================
+// E1.31 (ANSI E1.31-2018)
+// ============================================================================
+
+#define E131_ROOT_VECTOR_DATA      0x00000004
+#define E131_ROOT_VECTOR_EXTENDED  0x00000008
+#define E131_FRAME_VECTOR_DATA     0x00000002
+#define E131_EXT_VECTOR_SYNC       0x00000001
+#define E131_DMP_VECTOR            0x02
+#define E131_DMP_ADDR_TYPE         0xA1
+#define E131_OPT_PREVIEW           0x80
+#define E131_OPT_TERMINATED        0x40
+
+#define E131_DATA_HEADER_LEN       126   // Up to and including the start code
+#define E131_SYNC_LEN              49
+
+static const uint8_t e131_acn_id[12] = {
+    'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00
+};
+
+static bool is_e131(const uint8_t* buf, uint16_t len) {
+    return len >= 22 &&
+           be16(&buf[0]) == 0x0010 &&      // Preamble size
+           be16(&buf[2]) == 0x0000 &&      // Postamble size
+           memcmp(&buf[4], e131_acn_id, sizeof(e131_acn_id)) == 0;
+}
+
+static pp_packet_kind_t parse_e131(const uint8_t* buf, uint16_t len, pp_packet_t* out) {
+    out->proto = PP_PROTO_E131;
+    uint32_t root_vector = be32(&buf[18]);
+
+    if (root_vector == E131_ROOT_VECTOR_EXTENDED) {
+        if (len < E131_SYNC_LEN) return PP_PACKET_INVALID;
+        if (be32(&buf[40]) != E131_EXT_VECTOR_SYNC) {
+            return PP_PACKET_IGNORED;  // Universe discovery
+        }
+        out->sequence = buf[44];
+        out->sequenced = true;
+        out->universe = be16(&buf[45]);
+        out->sync_address = out->universe;
+        out->channel_offset = 0;
+        out->data = NULL;
+        out->length = 0;
+        out->push = false;
+        return PP_PACKET_SYNC;
+    }
+
+    if (root_vector != E131_ROOT_VECTOR_DATA) return PP_PACKET_INVALID;
+    if (len < E131_DATA_HEADER_LEN) return PP_PACKET_INVALID;
+    if (be32(&buf[40]) != E131_FRAME_VECTOR_DATA) return PP_PACKET_INVALID;
+    if (buf[117] != E131_DMP_VECTOR || buf[118] != E131_DMP_ADDR_TYPE) return PP_PACKET_INVALID;
+
+    uint16_t value_count = be16(&buf[123]);  // Start code + slots
+    if (value_count < 1 || value_count > PP_DMX_SLOTS + 1 ||
+        E131_DATA_HEADER_LEN - 1 + value_count > len) {
+        return PP_PACKET_INVALID;
+    }
+
+    uint8_t options = buf[112];
+    if ((options & (E131_OPT_PREVIEW | E131_OPT_TERMINATED)) || buf[125] != 0x00) {
+        return PP_PACKET_IGNORED;  // Preview data, stream end, or non-dimmer start code
+    }
+
+    out->sequence = buf[111];
+    out->sequenced = true;
+    out->sync_address = be16(&buf[109]);
+    out->universe = be16(&buf[113]);
+    out->channel_offset = 0;
+    out->data = &buf[E131_DATA_HEADER_LEN];
+    out->length = value_count - 1;
+    out->push = false;
+    return PP_PACKET_DATA;
+}
+
+// ============================================================================
+// Art-Net 4
+// ============================================================================
+
+#define ARTNET_OP_DMX   0x5000
+#define ARTNET_OP_SYNC  0x5200
+#define ARTNET_DMX_HEADER_LEN 18
+
+static const uint8_t artnet_id[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00};
+
+static pp_packet_kind_t parse_artnet(const uint8_t* buf, uint16_t len, pp_packet_t* out) {
+    out->proto = PP_PROTO_ARTNET;
+    uint16_t opcode = le16(&buf[8]);
+
+    if (opcode == ARTNET_OP_SYNC) {
+        out->sequence = 0;
+        out->sequenced = false;
+        out->universe = 0;
+        out->sync_address = 0;
+        out->channel_offset = 0;
+        out->data = NULL;
+        out->length = 0;
+        out->push = false;
+        return PP_PACKET_SYNC;
+    }
+
+    if (opcode != ARTNET_OP_DMX) return PP_PACKET_IGNORED;  // Poll, etc.
+    if (len < ARTNET_DMX_HEADER_LEN) return PP_PACKET_INVALID;
+
+    uint16_t data_len = be16(&buf[16]);
+    if (data_len > PP_DMX_SLOTS || ARTNET_DMX_HEADER_LEN + data_len > len) {
+        return PP_PACKET_INVALID;
+    }
+
+    out->sequence = buf[12];
+    out->sequenced = buf[12] != 0;  // 0 = sequencing disabled
+    out->universe = (uint16_t)(buf[14] | ((buf[15] & 0x7F) << 8));  // 15-bit port address
+    out->sync_address = 0;
+    out->channel_offset = 0;
+    out->data = &buf[ARTNET_DMX_HEADER_LEN];
+    out->length = data_len;
+    out->push = false;
+    return PP_PACKET_DATA;
+}
+
+pp_packet_kind_t pp_parse_packet(const uint8_t* buf, uint16_t len, pp_packet_t* out) {
+    if (!buf || !out) return PP_PACKET_INVALID;
+    memset(out, 0, sizeof(*out));
+
+    if (len >= 12 && memcmp(buf, artnet_id, sizeof(artnet_id)) == 0) {
+        out->kind = parse_artnet(buf, len, out);
+    } else if (is_e131(buf, len)) {
+        out->kind = parse_e131(buf, len, out);
+    } else {
+        out->kind = parse_ddp(buf, len, out);
+    }
+    return out->kind;
+}
+
+// ============================================================================
+// Channel mapping
+// ============================================================================
+
+bool pp_map_channel(const pp_layout_t* layout, uint32_t channel, pp_location_t* out) {
+    if (!layout || !out || channel < layout->start_channel) return false;
+
+    uint32_t pixel = (channel - layout->start_channel) / 3;
+    uint8_t component = (uint8_t)((channel - layout->start_channel) % 3);
+
+    for (uint8_t s = 0; s < layout->num_strings; s++) {
+        if (pixel < layout->string_lengths[s]) {
+            out->board = layout->board_id;
+            out->string = s;
+            out->pixel = (uint16_t)pixel;
+            out->component = component;
+            return true;
+        }
+        pixel -= layout->string_lengths[s];
+    }
+    return false;
+}
+
+uint32_t pp_universe_to_channel(const pp_layout_t* layout, uint16_t universe) {
+    if (!layout || universe < layout->start_universe) return UINT32_MAX;
+    return (uint32_t)(universe - layout->start_universe) * layout->channels_per_universe;
+}
+
+// ============================================================================
+// Frame assembly
+// ============================================================================
+
+static inline bool bit_get(const uint32_t* bits, uint16_t i) {
+    return (bits[i >> 5] >> (i & 31)) & 1u;
+}
+
+static inline void bit_set(uint32_t* bits, uint16_t i) {
+    bits[i >> 5] |= 1u << (i & 31);
+}
+
+void pp_assembler_init(pp_assembler_t* a, const pp_layout_t* layout,
+                       pp_span_cb span_cb, void* user_data) {
+    if (!a || !layout) return;
+    memset(a, 0, sizeof(*a));
+    a->layout = *layout;
+    a->span_cb = span_cb;
+    a->user_data = user_data;
+
+    if (a->layout.num_strings > PP_MAX_STRINGS) a->layout.num_strings = PP_MAX_STRINGS;
+    if (a->layout.channels_per_universe == 0 || a->layout.channels_per_universe > PP_DMX_SLOTS) {
+        a->layout.channels_per_universe = 510;
+    }
+
+    // Prefix sums so a pixel index maps to a string without walking lengths
+    uint32_t pixels = 0;
+    for (uint8_t s = 0; s < a->layout.num_strings; s++) {
+        a->string_start[s] = pixels;
+        pixels += a->layout.string_lengths[s];
+    }
+    for (uint8_t s = a->layout.num_strings; s <= PP_MAX_STRINGS; s++) {
+        a->string_start[s] = pixels;
+    }
+    a->num_channels = pixels * 3;
+
+    // Universes that carry any of this board's channels
+    if (a->num_channels > 0) {
+        uint16_t cpu = a->layout.channels_per_universe;
+        uint32_t first = a->layout.start_channel / cpu;
+        uint32_t last = (a->layout.start_channel + a->num_channels - 1) / cpu;
+        a->first_universe = (uint16_t)(a->layout.start_universe + first);
+        uint32_t count = last - first + 1;
+        a->universe_count = (uint16_t)(count > PP_MAX_UNIVERSES ? PP_MAX_UNIVERSES : count);
+    }
+}
+
+void pp_assembler_reset(pp_assembler_t* a) {
+    if (!a) return;
+    memset(a->received, 0, sizeof(a->received));
+    memset(a->seq_valid, 0, sizeof(a->seq_valid));
+    a->received_count = 0;
+    a->ddp_last_seq = 0;
+    a->frame_dirty = false;
+    a->sync_mode = false;
+    a->sync_address = 0;
+    a->carry_have = 0;
+}
+
+// Emit whole pixels starting at a board pixel index, split at string boundaries
+static void emit_pixels(pp_assembler_t* a, uint32_t pixel, const uint8_t* rgb, uint32_t count) {
+    uint8_t s = 0;
+    while (s < a->layout.num_strings && pixel >= a->string_start[s + 1]) s++;
+
+    while (count > 0 && s < a->layout.num_strings) {
+        uint32_t room = a->string_start[s + 1] - pixel;
+        uint32_t n = count < room ? count : room;
+        if (n > 0) {
+            a->span_cb(a->user_data, s, (uint16_t)(pixel - a->string_start[s]), rgb, (uint16_t)n);
+            rgb += n * 3;
+            pixel += n;
+            count -= n;
+        }
+        s++;
+    }
+}
+
+// Write channel data at an absolute channel; returns false if none of it is ours
+static bool write_channels(pp_assembler_t* a, uint32_t channel, const uint8_t* data, uint32_t len) {
+    uint32_t start = a->layout.start_channel;
+    uint32_t end = start + a->num_channels;
+    if (len == 0 || channel >= end || channel + len <= start) return false;
+
+    if (channel < start) {
+        data += start - channel;
+        len -= start - channel;
+        channel = start;
+    }
+    if (channel + len > end) len = end - channel;
+
+    uint32_t rel = channel - start;
+    uint32_t pixel = rel / 3;
+    uint8_t comp = (uint8_t)(rel % 3);
+
+    // Finish a pixel started by the previous packet
+    if (comp != 0) {
+        if (a->carry_pixel != pixel) a->carry_have = 0;
+        a->carry_pixel = pixel;
+        while (comp < 3 && len > 0) {
+            a->carry[comp] = *data++;
+            a->carry_have |= (uint8_t)(1u << comp);
+            comp++;
+            len--;
+        }
+        if (comp < 3) return true;  // Packet ended inside the pixel
+        if (a->carry_have == 0x07) emit_pixels(a, pixel, a->carry, 1);
+        a->carry_have = 0;
+        pixel++;
+    }
+
+    uint32_t whole = len / 3;
+    if (whole > 0) {
+        emit_pixels(a, pixel, data, whole);
+        data += whole * 3;
+        len -= whole * 3;
+        pixel += whole;
+    }
+
+    // Keep the start of a pixel that continues in the next packet
+    if (len > 0) {
+        a->carry_pixel = pixel;
+        a->carry_have = 0;
+        for (uint32_t i = 0; i < len; i++) {
+            a->carry[i] = data[i];
+            a->carry_have |= (uint8_t)(1u << i);
+        }
+    }
+    return true;
+}
+
+static pp_push_result_t complete_frame(pp_assembler_t* a, bool synced, bool dmx) {
+    a->stats.frames++;
+    if (synced) a->stats.sync_frames++;
+    if (dmx && a->received_count < a->universe_count) a->stats.partial_frames++;
+    memset(a->received, 0, sizeof(a->received));
+    a->received_count = 0;
+    a->frame_dirty = false;
+    return PP_PUSH_FRAME;
+}
+
+// E1.31 section 6.7.2: discard if within 20 behind the last accepted sequence
+static bool dmx_sequence_ok(pp_assembler_t* a, uint16_t idx, const pp_packet_t* pkt) {
+    if (!pkt->sequenced || !bit_get(a->seq_valid, idx)) return true;
+
+    int8_t diff = (int8_t)(pkt->sequence - a->last_seq[idx]);
+    if (diff <= 0 && diff > -20) {
+        a->stats.out_of_order++;
+        return false;
+    }
+    return true;
+}
+
+// Record an accepted sequence number and count the gap before it
+static void dmx_sequence_accept(pp_assembler_t* a, uint16_t idx, const pp_packet_t* pkt) {
+    if (!pkt->sequenced) return;
+
+    if (bit_get(a->seq_valid, idx)) {
+        uint8_t last = a->last_seq[idx];
+        int8_t diff = (int8_t)(pkt->sequence - last);
+        // Art-Net skips 0 when wrapping
+        if (diff > 1 && pkt->proto == PP_PROTO_ARTNET && pkt->sequence < last) diff--;
+        if (diff > 1) a->stats.lost += (uint32_t)(diff - 1);
+    }
+    a->last_seq[idx] = pkt->sequence;
+    bit_set(a->seq_valid, idx);
+}
+
+static pp_push_result_t push_dmx(pp_assembler_t* a, const pp_packet_t* pkt) {
+    if (pkt->universe < a->first_universe ||
+        pkt->universe >= a->first_universe + a->universe_count) {
+        a->stats.ignored++;
+        return PP_PUSH_OK;
+    }
+    uint16_t idx = (uint16_t)(pkt->universe - a->first_universe);
+
+    if (!dmx_sequence_ok(a, idx, pkt)) return PP_PUSH_OK;
+
+    // A universe we already have means the sender moved on to the next frame
+    if (!a->sync_mode && bit_get(a->received, idx)) {
+        complete_frame(a, false, true);
+        return PP_PUSH_FRAME_REPLAY;
+    }
+
+    dmx_sequence_accept(a, idx, pkt);
+
+    if (pkt->proto == PP_PROTO_E131 && pkt->sync_address != 0) {
+        a->sync_address = pkt->sync_address;
+    }
+
+    uint32_t len = pkt->length;
+    if (len > a->layout.channels_per_universe) len = a->layout.channels_per_universe;
+    write_channels(a, pp_universe_to_channel(&a->layout, pkt->universe), pkt->data, len);
+
+    a->stats.packets++;
+    a->frame_dirty = true;
+    bit_set(a->received, idx);
+    a->received_count++;
+
+    if (!a->sync_mode && a->received_count >= a->universe_count) {
+        return complete_frame(a, false, true);
+    }
+    return PP_PUSH_OK;
+}
+
+static pp_push_result_t push_ddp(pp_assembler_t* a, const pp_packet_t* pkt) {
+    // DDP sequence numbers are 1-15 and may be per packet or per frame, so
+    // they are only used to count gaps, never to drop data
+    if (pkt->sequenced) {
+        if (a->ddp_last_seq != 0 && pkt->sequence != a->ddp_last_seq) {
+            uint8_t step = (uint8_t)((pkt->sequence + 15 - a->ddp_last_seq) % 15);
+            if (step > 1 && step < 8) a->stats.lost += step - 1u;
+        }
+        a->ddp_last_seq = pkt->sequence;
+    }
+
+    if (write_channels(a, pkt->channel_offset, pkt->data, pkt->length)) {
+        a->stats.packets++;
+        a->frame_dirty = true;
+    } else if (pkt->length > 0) {
+        a->stats.ignored++;
+    }
+
+    if (pkt->push) {
+        return complete_frame(a, true, false);
+    }
+    return PP_PUSH_OK;
+}
+
+static pp_push_result_t push_sync(pp_assembler_t* a, const pp_packet_t* pkt, uint32_t now_ms) {
+    if (pkt->proto == PP_PROTO_E131 && a->sync_address != 0 && pkt->universe != a->sync_address) {
+        a->stats.ignored++;
+        return PP_PUSH_OK;
+    }
+
+    a->sync_mode = true;
+    a->last_sync_ms = now_ms;
+
+    if (a->frame_dirty) {
+        return complete_frame(a, true, true);
+    }
+    return PP_PUSH_OK;
+}
+
+pp_push_result_t pp_assembler_push(pp_assembler_t* a, const pp_packet_t* pkt, uint32_t now_ms) {
+    if (!a || !pkt || !a->span_cb) return PP_PUSH_OK;
+
+    // Sender stopped syncing - go back to completing on all universes
+    if (a->sync_mode && (uint32_t)(now_ms - a->last_sync_ms) > PP_SYNC_TIMEOUT_MS) {
+        a->sync_mode = false;
+    }
+
+    switch (pkt->kind) {
+        case PP_PACKET_DATA:
+            return pkt->proto == PP_PROTO_DDP ? push_ddp(a, pkt) : push_dmx(a, pkt);
+        case PP_PACKET_SYNC:
+            return push_sync(a, pkt, now_ms);
+        case PP_PACKET_IGNORED:
+            a->stats.ignored++;
+            return PP_PUSH_OK;
+        default:
+            return PP_PUSH_OK;
+    }
+}
+
+pp_push_result_t pp_assembler_push_raw(pp_assembler_t* a, const uint8_t* buf, uint16_t len,
+                                       uint32_t now_ms) {
+    pp_packet_t pkt;
+    pp_parse_packet(buf, len, &pkt);
+    return pp_assembler_push(a, &pkt, now_ms);
+}
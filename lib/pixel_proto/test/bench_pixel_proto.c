@@ -0,0 +1,145 @@
+/**
+ * bench_pixel_proto.c - Host throughput benchmark for pixel_proto
+ *
+ * Decodes a fully populated board (32 strings x 512 pixels) as E1.31, Art-Net
+ * and DDP and reports time per packet and decoded MB/s. The span callback
+ * copies into a frame buffer so the cost of the output path is included.
+ *
+ * Build: mkdir build && cd build && cmake -DPIXEL_PROTO_TEST=ON .. && make
+ * Run: ./pixel_proto_bench [frames]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pixel_proto.h"
+#include "reference_packets.h"
+
+#define B_STRINGS 32
+#define B_PIXELS 512
+#define B_CHANNELS (B_STRINGS * B_PIXELS * 3)
+
+static uint16_t lengths[B_STRINGS];
+static uint8_t frame_buf[B_STRINGS][B_PIXELS * 3];
+static uint8_t channels[B_CHANNELS];
+
+// Pre-built packets for one frame
+#define MAX_PACKETS 128
+static uint8_t packets[MAX_PACKETS][1500];
+static uint16_t packet_len[MAX_PACKETS];
+static int packet_count;
+static int seq_offset;      // Sequence byte to bump each frame (-1 = none)
+
+static void span_cb(void* user_data, uint8_t string, uint16_t first_pixel,
+                    const uint8_t* rgb, uint16_t count) {
+    (void)user_data;
+    memcpy(&frame_buf[string][first_pixel * 3], rgb, (size_t)count * 3);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void build_e131(void) {
+    packet_count = 0;
+    seq_offset = REF_E131_SEQ_OFFSET;
+    for (uint32_t ch = 0; ch < B_CHANNELS; ch += 510) {
+        uint16_t len = (uint16_t)((B_CHANNELS - ch) < 510 ? (B_CHANNELS - ch) : 510);
+        packet_len[packet_count] = ref_build_e131(packets[packet_count], (uint16_t)(1 + ch / 510),
+                                                  0, &channels[ch], len);
+        packet_count++;
+    }
+}
+
+static void build_artnet(void) {
+    packet_count = 0;
+    seq_offset = REF_ARTDMX_SEQ_OFFSET;
+    for (uint32_t ch = 0; ch < B_CHANNELS; ch += 510) {
+        uint16_t len = (uint16_t)((B_CHANNELS - ch) < 510 ? (B_CHANNELS - ch) : 510);
+        packet_len[packet_count] = ref_build_artdmx(packets[packet_count], (uint16_t)(ch / 510),
+                                                    0, &channels[ch], len);
+        packet_count++;
+    }
+}
+
+static void build_ddp(void) {
+    packet_count = 0;
+    seq_offset = -1;
+    for (uint32_t ch = 0; ch < B_CHANNELS; ch += PP_DDP_MAX_DATA) {
+        uint16_t len = (uint16_t)((B_CHANNELS - ch) < PP_DDP_MAX_DATA ? (B_CHANNELS - ch)
+                                                                      : PP_DDP_MAX_DATA);
+        packet_len[packet_count] = ref_build_ddp(packets[packet_count], 0, ch, &channels[ch], len,
+                                                 ch + len >= B_CHANNELS);
+        packet_count++;
+    }
+}
+
+static void run(const char* name, pp_layout_t* layout, int frames) {
+    static pp_assembler_t as;
+    pp_assembler_init(&as, layout, span_cb, NULL);
+
+    uint32_t frames_done = 0;
+    double start = now_sec();
+    for (int f = 0; f < frames; f++) {
+        if (seq_offset >= 0) {
+            uint8_t seq = (uint8_t)(f % 255 + 1);
+            for (int i = 0; i < packet_count; i++) packets[i][seq_offset] = seq;
+        }
+        for (int i = 0; i < packet_count; i++) {
+            pp_push_result_t r = pp_assembler_push_raw(&as, packets[i], packet_len[i], 0);
+            if (r == PP_PUSH_FRAME_REPLAY) {
+                r = pp_assembler_push_raw(&as, packets[i], packet_len[i], 0);
+            }
+            if (r != PP_PUSH_OK) frames_done++;
+        }
+    }
+    double elapsed = now_sec() - start;
+
+    if (memcmp(frame_buf, channels, sizeof(channels)) != 0 || frames_done != (uint32_t)frames) {
+        printf("  %-8s FAILED (frames %u/%d)\n", name, frames_done, frames);
+        exit(1);
+    }
+
+    double packets_total = (double)packet_count * frames;
+    printf("  %-8s %3d pkt/frame  %7.1f ns/pkt  %7.1f us/frame  %8.1f MB/s\n",
+           name, packet_count,
+           elapsed * 1e9 / packets_total,
+           elapsed * 1e6 / frames,
+           (double)B_CHANNELS * frames / elapsed / 1e6);
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    if (frames <= 0) frames = 2000;
+
+    for (int s = 0; s < B_STRINGS; s++) lengths[s] = B_PIXELS;
+    for (uint32_t i = 0; i < B_CHANNELS; i++) channels[i] = (uint8_t)(i * 31u + (i >> 8));
+
+    pp_layout_t layout = {
+        .board_id = 0,
+        .num_strings = B_STRINGS,
+        .string_lengths = lengths,
+        .start_channel = 0,
+        .start_universe = 1,
+        .channels_per_universe = 510,
+    };
+
+    printf("\n=== pixel_proto benchmark: %d x %d pixels, %d frames ===\n\n",
+           B_STRINGS, B_PIXELS, frames);
+
+    build_e131();
+    run("E1.31", &layout, frames);
+
+    layout.start_universe = 0;
+    build_artnet();
+    run("Art-Net", &layout, frames);
+
+    build_ddp();
+    run("DDP", &layout, frames);
+
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * reference_packets.h - Reference packet headers for pixel_proto tests
+ *
+ * Byte-for-byte headers as sent by xLights / common controllers. Tests copy a
+ * header, patch universe / sequence / length, and append channel data.
+ */
+
+#ifndef REFERENCE_PACKETS_H
+#define REFERENCE_PACKETS_H
+
+#include <stdint.h>
+#include <string.h>
+
+// E1.31 data packet header (126 bytes incl. start code).
+// Universe 1, priority 100, sequence 0x10, 510 slots (full length 636).
+static const uint8_t ref_e131_data_header[126] = {
+    // Root layer
+    0x00, 0x10, 0x00, 0x00,                                     // Preamble, postamble
+    0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00,  // "ASC-E1.17"
+    0x72, 0x6c,                                                 // Flags & length (620)
+    0x00, 0x00, 0x00, 0x04,                                     // VECTOR_ROOT_E131_DATA
+    0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x00,             // CID
+    0x8a, 0x1c, 0x3e, 0x52, 0x9f, 0x07, 0x44, 0xd1,
+    // Framing layer
+    0x72, 0x56,                                                 // Flags & length (598)
+    0x00, 0x00, 0x00, 0x02,                                     // VECTOR_E131_DATA_PACKET
+    'x', 'L', 'i', 'g', 'h', 't', 's', 0, 0, 0, 0, 0, 0, 0, 0, 0,  // Source name (64)
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0x64,                                                       // Priority 100
+    0x00, 0x00,                                                 // Sync address
+    0x10,                                                       // Sequence
+    0x00,                                                       // Options
+    0x00, 0x01,                                                 // Universe 1
+    // DMP layer
+    0x72, 0x09,                                                 // Flags & length (521)
+    0x02,                                                       // VECTOR_DMP_SET_PROPERTY
+    0xa1,                                                       // Address & data type
+    0x00, 0x00,                                                 // First property address
+    0x00, 0x01,                                                 // Address increment
+    0x01, 0xff,                                                 // Property value count (511)
+    0x00,                                                       // DMX start code
+};
+
+#define REF_E131_SYNC_ADDR_OFFSET   109
+#define REF_E131_SEQ_OFFSET         111
+#define REF_E131_OPTIONS_OFFSET     112
+#define REF_E131_UNIVERSE_OFFSET    113
+#define REF_E131_COUNT_OFFSET       123
+
+// E1.31 synchronization packet (49 bytes), sync address 7000, sequence 0x21
+static const uint8_t ref_e131_sync[49] = {
+    0x00, 0x10, 0x00, 0x00,
+    0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00,
+    0x70, 0x21,                                                 // Flags & length (33)
+    0x00, 0x00, 0x00, 0x08,                                     // VECTOR_ROOT_E131_EXTENDED
+    0x78, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x73, 0x00,
+    0x8a, 0x1c, 0x3e, 0x52, 0x9f, 0x07, 0x44, 0xd1,
+    0x70, 0x0b,                                                 // Flags & length (11)
+    0x00, 0x00, 0x00, 0x01,                                     // VECTOR_E131_EXTENDED_SYNCHRONIZATION
+    0x21,                                                       // Sequence
+    0x1b, 0x58,                                                 // Sync address 7000
+    0x00, 0x00,                                                 // Reserved
+};
+
+// Art-Net ArtDmx header (18 bytes), universe 0, sequence 1, 510 channels
+static const uint8_t ref_artdmx_header[18] = {
+    'A', 'r', 't', '-', 'N', 'e', 't', 0x00,
+    0x00, 0x50,                                                 // OpDmx (little endian)
+    0x00, 0x0e,                                                 // Protocol version 14
+    0x01,                                                       // Sequence
+    0x00,                                                       // Physical
+    0x00, 0x00,                                                 // SubUni, Net
+    0x01, 0xfe,                                                 // Length 510 (big endian)
+};
+
+#define REF_ARTDMX_SEQ_OFFSET       12
+#define REF_ARTDMX_SUBUNI_OFFSET    14
+#define REF_ARTDMX_NET_OFFSET       15
+#define REF_ARTDMX_LENGTH_OFFSET    16
+
+// Art-Net ArtSync (14 bytes)
+static const uint8_t ref_artsync[14] = {
+    'A', 'r', 't', '-', 'N', 'e', 't', 0x00,
+    0x00, 0x52,                                                 // OpSync
+    0x00, 0x0e,
+    0x00, 0x00,                                                 // Aux
+};
+
+// Art-Net ArtPoll (14 bytes)
+static const uint8_t ref_artpoll[14] = {
+    'A', 'r', 't', '-', 'N', 'e', 't', 0x00,
+    0x00, 0x20,                                                 // OpPoll
+    0x00, 0x0e,
+    0x06, 0x00,                                                 // Flags, priority
+};
+
+// DDP header (10 bytes) as sent by xLights: PUSH, seq 1, offset 0, 1440 bytes
+static const uint8_t ref_ddp_header[10] = {
+    0x41,                                                       // Version 1, PUSH
+    0x01,                                                       // Sequence
+    0x01,                                                       // Data type
+    0x01,                                                       // Destination ID (display)
+    0x00, 0x00, 0x00, 0x00,                                     // Offset
+    0x05, 0xa0,                                                 // Length 1440
+};
+
+// ============================================================================
+// Builders - copy a reference header and patch it
+// ============================================================================
+
+static inline uint16_t ref_build_e131(uint8_t* out, uint16_t universe, uint8_t seq,
+                                      const uint8_t* data, uint16_t slots) {
+    memcpy(out, ref_e131_data_header, sizeof(ref_e131_data_header));
+    uint16_t total = (uint16_t)(sizeof(ref_e131_data_header) + slots);
+    uint16_t root = (uint16_t)(0x7000 | (total - 16));
+    uint16_t framing = (uint16_t)(0x7000 | (total - 38));
+    uint16_t dmp = (uint16_t)(0x7000 | (total - 115));
+    out[16] = (uint8_t)(root >> 8);    out[17] = (uint8_t)root;
+    out[38] = (uint8_t)(framing >> 8); out[39] = (uint8_t)framing;
+    out[115] = (uint8_t)(dmp >> 8);    out[116] = (uint8_t)dmp;
+    out[REF_E131_SEQ_OFFSET] = seq;
+    out[REF_E131_UNIVERSE_OFFSET] = (uint8_t)(universe >> 8);
+    out[REF_E131_UNIVERSE_OFFSET + 1] = (uint8_t)universe;
+    out[REF_E131_COUNT_OFFSET] = (uint8_t)((slots + 1) >> 8);
+    out[REF_E131_COUNT_OFFSET + 1] = (uint8_t)(slots + 1);
+    memcpy(&out[sizeof(ref_e131_data_header)], data, slots);
+    return total;
+}
+
+static inline uint16_t ref_build_artdmx(uint8_t* out, uint16_t universe, uint8_t seq,
+                                        const uint8_t* data, uint16_t len) {
+    memcpy(out, ref_artdmx_header, sizeof(ref_artdmx_header));
+    out[REF_ARTDMX_SEQ_OFFSET] = seq;
+    out[REF_ARTDMX_SUBUNI_OFFSET] = (uint8_t)universe;
+    out[REF_ARTDMX_NET_OFFSET] = (uint8_t)((universe >> 8) & 0x7F);
+    out[REF_ARTDMX_LENGTH_OFFSET] = (uint8_t)(len >> 8);
+    out[REF_ARTDMX_LENGTH_OFFSET + 1] = (uint8_t)len;
+    memcpy(&out[sizeof(ref_artdmx_header)], data, len);
+    return (uint16_t)(sizeof(ref_artdmx_header) + len);
+}
+
+static inline uint16_t ref_build_ddp(uint8_t* out, uint8_t seq, uint32_t offset,
+                                     const uint8_t* data, uint16_t len, int push) {
+    memcpy(out, ref_ddp_header, sizeof(ref_ddp_header));
+    out[0] = (uint8_t)(push ? 0x41 : 0x40);
+    out[1] = seq & 0x0F;
+    out[4] = (uint8_t)(offset >> 24);
+    out[5] = (uint8_t)(offset >> 16);
+    out[6] = (uint8_t)(offset >> 8);
+    out[7] = (uint8_t)offset;
+    out[8] = (uint8_t)(len >> 8);
+    out[9] = (uint8_t)len;
+    memcpy(&out[sizeof(ref_ddp_header)], data, len);
+    return (uint16_t)(sizeof(ref_ddp_header) + len);
+}
+
+#endif // REFERENCE_PACKETS_H
@@ -0,0 +1,566 @@
+/**
+ * test_pixel_proto.c - Host tests for the network pixel protocol library
+ *
+ * Build: mkdir build && cd build && cmake -DPIXEL_PROTO_TEST=ON .. && make
+ * Run: ./pixel_proto_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pixel_proto.h"
+#include "reference_packets.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond) ASSERT_TRUE(!(cond))
+
+// ============================================================================
+// Simulated LED buffer (span callback target)
+// ============================================================================
+
+#define T_STRINGS 4
+#define T_MAX_PIXELS 512
+
+static uint32_t leds[T_STRINGS][T_MAX_PIXELS];
+static uint32_t span_calls;
+static uint32_t span_pixels;
+
+static void span_cb(void* user_data, uint8_t string, uint16_t first_pixel,
+                    const uint8_t* rgb, uint16_t count) {
+    (void)user_data;
+    span_calls++;
+    span_pixels += count;
+    for (uint16_t i = 0; i < count; i++) {
+        if (string < T_STRINGS && first_pixel + i < T_MAX_PIXELS) {
+            leds[string][first_pixel + i] = ((uint32_t)rgb[i * 3] << 16) |
+                                            ((uint32_t)rgb[i * 3 + 1] << 8) |
+                                            rgb[i * 3 + 2];
+        }
+    }
+}
+
+static void reset_leds(void) {
+    memset(leds, 0, sizeof(leds));
+    span_calls = 0;
+    span_pixels = 0;
+}
+
+// 200 + 100 + 7 + 300 pixels = 1821 channels -> 4 universes at 510
+static uint16_t lengths[T_STRINGS] = {200, 100, 7, 300};
+
+static pp_layout_t make_layout(uint32_t start_channel, uint16_t start_universe, uint16_t cpu) {
+    pp_layout_t layout = {
+        .board_id = 0,
+        .num_strings = T_STRINGS,
+        .string_lengths = lengths,
+        .start_channel = start_channel,
+        .start_universe = start_universe,
+        .channels_per_universe = cpu,
+    };
+    return layout;
+}
+
+static uint32_t board_channels(void) {
+    uint32_t n = 0;
+    for (int i = 0; i < T_STRINGS; i++) n += lengths[i] * 3u;
+    return n;
+}
+
+// Absolute channel data for the whole show
+static uint8_t channel_value(uint32_t frame, uint32_t channel) {
+    return (uint8_t)(channel * 13u + frame * 7u + (channel >> 9));
+}
+
+static void verify_board(uint32_t frame, uint32_t start_channel) {
+    uint32_t ch = start_channel;
+    for (int s = 0; s < T_STRINGS; s++) {
+        for (uint16_t p = 0; p < lengths[s]; p++) {
+            uint32_t expected = ((uint32_t)channel_value(frame, ch) << 16) |
+                                ((uint32_t)channel_value(frame, ch + 1) << 8) |
+                                channel_value(frame, ch + 2);
+            ASSERT_EQ(expected, leds[s][p]);
+            ch += 3;
+        }
+    }
+}
+
+static uint8_t pkt[2048];
+static uint8_t data[PP_DDP_MAX_DATA];
+
+static void fill_data(uint32_t frame, uint32_t channel, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) data[i] = channel_value(frame, channel + i);
+}
+
+// Send one frame as E1.31 universes; returns result of the last push.
+// Sequence numbers are per universe, so every universe gets *seq.
+static pp_push_result_t send_e131_frame(pp_assembler_t* a, uint32_t frame, uint16_t universes,
+                                        uint16_t start_universe, uint16_t cpu, uint8_t* seq) {
+    pp_push_result_t r = PP_PUSH_OK;
+    for (uint16_t u = 0; u < universes; u++) {
+        fill_data(frame, (uint32_t)u * cpu, cpu);
+        uint16_t n = ref_build_e131(pkt, start_universe + u, *seq, data, cpu);
+        r = pp_assembler_push_raw(a, pkt, n, 0);
+    }
+    (*seq)++;
+    return r;
+}
+
+// ============================================================================
+// Packet parsing
+// ============================================================================
+
+TEST(parse_e131_reference_header) {
+    fill_data(0, 0, 510);
+    uint16_t n = ref_build_e131(pkt, 1, 0x10, data, 510);
+    ASSERT_EQ(636, n);
+    // Builder must reproduce the captured lengths exactly
+    ASSERT_EQ(0, memcmp(pkt, ref_e131_data_header, sizeof(ref_e131_data_header)));
+
+    pp_packet_t p;
+    ASSERT_EQ(PP_PACKET_DATA, pp_parse_packet(pkt, n, &p));
+    ASSERT_EQ(PP_PROTO_E131, p.proto);
+    ASSERT_EQ(1, p.universe);
+    ASSERT_EQ(0x10, p.sequence);
+    ASSERT_TRUE(p.sequenced);
+    ASSERT_EQ(510, p.length);
+    ASSERT_EQ(0, p.sync_address);
+    ASSERT_TRUE(p.data == &pkt[126]);
+}
+
+TEST(parse_e131_sync) {
+    pp_packet_t p;
+    ASSERT_EQ(PP_PACKET_SYNC, pp_parse_packet(ref_e131_sync, sizeof(ref_e131_sync), &p));
+    ASSERT_EQ(PP_PROTO_E131, p.proto);
+    ASSERT_EQ(7000, p.universe);
+    ASSERT_EQ(0x21, p.sequence);
+}
+
+TEST(parse_e131_preview_and_start_code_ignored) {
+    pp_packet_t p;
+    fill_data(0, 0, 30);
+    uint16_t n = ref_build_e131(pkt, 1, 1, data, 30);
+    pkt[REF_E131_OPTIONS_OFFSET] = 0x80;
+    ASSERT_EQ(PP_PACKET_IGNORED, pp_parse_packet(pkt, n, &p));
+
+    n = ref_build_e131(pkt, 1, 1, data, 30);
+    pkt[125] = 0xDD;  // Per-address priority start code
+    ASSERT_EQ(PP_PACKET_IGNORED, pp_parse_packet(pkt, n, &p));
+}
+
+TEST(parse_e131_truncated_is_invalid) {
+    pp_packet_t p;
+    fill_data(0, 0, 510);
+    uint16_t n = ref_build_e131(pkt, 1, 1, data, 510);
+    ASSERT_EQ(PP_PACKET_INVALID, pp_parse_packet(pkt, n - 1, &p));
+    ASSERT_EQ(PP_PACKET_INVALID, pp_parse_packet(pkt, 100, &p));
+}
+
+TEST(parse_artnet_dmx_sync_poll) {
+    pp_packet_t p;
+    fill_data(0, 0, 510);
+    uint16_t n = ref_build_artdmx(pkt, 0x0123, 9, data, 510);
+    ASSERT_EQ(PP_PACKET_DATA, pp_parse_packet(pkt, n, &p));
+    ASSERT_EQ(PP_PROTO_ARTNET, p.proto);
+    ASSERT_EQ(0x0123, p.universe);
+    ASSERT_EQ(9, p.sequence);
+    ASSERT_EQ(510, p.length);
+
+    n = ref_build_artdmx(pkt, 0, 0, data, 510);
+    ASSERT_EQ(PP_PACKET_DATA, pp_parse_packet(pkt, n, &p));
+    ASSERT_FALSE(p.sequenced);
+
+    ASSERT_EQ(PP_PACKET_SYNC, pp_parse_packet(ref_artsync, sizeof(ref_artsync), &p));
+    ASSERT_EQ(PP_PACKET_IGNORED, pp_parse_packet(ref_artpoll, sizeof(ref_artpoll), &p));
+}
+
+TEST(parse_ddp) {
+    pp_packet_t p;
+    fill_data(0, 0, 300);
+    uint16_t n = ref_build_ddp(pkt, 3, 1440, data, 300, 1);
+    ASSERT_EQ(PP_PACKET_DATA, pp_parse_packet(pkt, n, &p));
+    ASSERT_EQ(PP_PROTO_DDP, p.proto);
+    ASSERT_EQ(1440, p.channel_offset);
+    ASSERT_EQ(300, p.length);
+    ASSERT_TRUE(p.push);
+
+    pkt[0] |= 0x02;  // Query
+    ASSERT_EQ(PP_PACKET_IGNORED, pp_parse_packet(pkt, n, &p));
+}
+
+TEST(parse_garbage_is_invalid) {
+    pp_packet_t p;
+    const uint8_t junk[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A};
+    ASSERT_EQ(PP_PACKET_INVALID, pp_parse_packet(junk, sizeof(junk), &p));
+    ASSERT_EQ(PP_PACKET_INVALID, pp_parse_packet(ref_ddp_header, sizeof(ref_ddp_header), &p));
+}
+
+// ============================================================================
+// Channel mapping
+// ============================================================================
+
+TEST(map_channel_across_strings) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_location_t loc;
+
+    ASSERT_TRUE(pp_map_channel(&layout, 0, &loc));
+    ASSERT_EQ(0, loc.string);
+    ASSERT_EQ(0, loc.pixel);
+
+    ASSERT_TRUE(pp_map_channel(&layout, 200 * 3 + 5, &loc));
+    ASSERT_EQ(1, loc.string);
+    ASSERT_EQ(1, loc.pixel);
+    ASSERT_EQ(2, loc.component);
+
+    ASSERT_TRUE(pp_map_channel(&layout, board_channels() - 1, &loc));
+    ASSERT_EQ(3, loc.string);
+    ASSERT_EQ(299, loc.pixel);
+    ASSERT_FALSE(pp_map_channel(&layout, board_channels(), &loc));
+}
+
+TEST(map_channel_board_offset) {
+    pp_layout_t layout = make_layout(6000, 1, 510);
+    layout.board_id = 2;
+    pp_location_t loc;
+
+    ASSERT_FALSE(pp_map_channel(&layout, 5999, &loc));
+    ASSERT_TRUE(pp_map_channel(&layout, 6003, &loc));
+    ASSERT_EQ(2, loc.board);
+    ASSERT_EQ(0, loc.string);
+    ASSERT_EQ(1, loc.pixel);
+}
+
+TEST(universe_to_channel) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    ASSERT_EQ(0, pp_universe_to_channel(&layout, 1));
+    ASSERT_EQ(1020, pp_universe_to_channel(&layout, 3));
+    ASSERT_EQ(UINT32_MAX, pp_universe_to_channel(&layout, 0));
+}
+
+// ============================================================================
+// Frame assembly
+// ============================================================================
+
+static pp_assembler_t as;
+
+TEST(e131_frame_completes_on_last_universe) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+    ASSERT_EQ(4, as.universe_count);
+
+    uint8_t seq = 0;
+    ASSERT_EQ(PP_PUSH_FRAME, send_e131_frame(&as, 0, 4, 1, 510, &seq));
+    verify_board(0, 0);
+    ASSERT_EQ(1, as.stats.frames);
+    ASSERT_EQ(0, as.stats.partial_frames);
+    ASSERT_EQ(1821 / 3, span_pixels);
+
+    ASSERT_EQ(PP_PUSH_FRAME, send_e131_frame(&as, 1, 4, 1, 510, &seq));
+    verify_board(1, 0);
+    ASSERT_EQ(0, as.stats.lost);
+}
+
+TEST(spans_split_at_string_boundaries) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    // Universe 2 covers pixels 170..339: end of string 0, all of strings 1 and 2,
+    // start of string 3
+    fill_data(0, 510, 510);
+    uint16_t n = ref_build_e131(pkt, 2, 0, data, 510);
+    pp_assembler_push_raw(&as, pkt, n, 0);
+    ASSERT_EQ(4, span_calls);
+    ASSERT_EQ(170, span_pixels);
+}
+
+TEST(pixel_straddling_universes) {
+    // 512 channels per universe: pixel 170 straddles universes 1 and 2
+    pp_layout_t layout = make_layout(0, 1, 512);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    uint8_t seq = 0;
+    ASSERT_EQ(PP_PUSH_FRAME, send_e131_frame(&as, 4, 4, 1, 512, &seq));
+    verify_board(4, 0);
+}
+
+TEST(e131_out_of_order_discarded) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    fill_data(0, 0, 510);
+    uint16_t n = ref_build_e131(pkt, 1, 50, data, 510);
+    pp_assembler_push_raw(&as, pkt, n, 0);
+
+    // Late packet is dropped without ending the frame
+    n = ref_build_e131(pkt, 1, 45, data, 510);
+    ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, pkt, n, 0));
+    ASSERT_EQ(1, as.stats.out_of_order);
+    ASSERT_EQ(0, as.stats.frames);
+
+    // Duplicate is dropped too
+    n = ref_build_e131(pkt, 1, 50, data, 510);
+    ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, pkt, n, 0));
+    ASSERT_EQ(2, as.stats.out_of_order);
+
+    // Far behind (more than 20) is a restarted sender and is accepted
+    n = ref_build_e131(pkt, 1, 10, data, 510);
+    ASSERT_EQ(PP_PUSH_FRAME_REPLAY, pp_assembler_push_raw(&as, pkt, n, 0));
+    ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, pkt, n, 0));
+    ASSERT_EQ(2, as.stats.out_of_order);
+}
+
+TEST(e131_lost_packets_counted) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    uint8_t seq = 254;
+    send_e131_frame(&as, 0, 4, 1, 510, &seq);
+    seq += 3;  // Three packets never arrive on each universe
+    send_e131_frame(&as, 1, 4, 1, 510, &seq);
+    ASSERT_EQ(0, as.stats.out_of_order);
+    ASSERT_EQ(12, as.stats.lost);
+}
+
+TEST(repeated_universe_ends_partial_frame) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    // Frame 0 loses universe 4
+    uint8_t seq = 0;
+    send_e131_frame(&as, 0, 3, 1, 510, &seq);
+    ASSERT_EQ(0, as.stats.frames);
+
+    // Universe 1 of frame 1 ends frame 0 and must be replayed
+    fill_data(1, 0, 510);
+    uint16_t n = ref_build_e131(pkt, 1, seq, data, 510);
+    ASSERT_EQ(PP_PUSH_FRAME_REPLAY, pp_assembler_push_raw(&as, pkt, n, 0));
+    ASSERT_EQ(1, as.stats.frames);
+    ASSERT_EQ(1, as.stats.partial_frames);
+    uint32_t frame0 = ((uint32_t)channel_value(0, 0) << 16) |
+                      ((uint32_t)channel_value(0, 1) << 8) | channel_value(0, 2);
+    ASSERT_EQ(frame0, leds[0][0]);  // Frame 1 data not written yet
+    ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, pkt, n, 0));
+    ASSERT_EQ(((uint32_t)channel_value(1, 0) << 16) | ((uint32_t)channel_value(1, 1) << 8) |
+              channel_value(1, 2), leds[0][0]);
+}
+
+TEST(e131_sync_packet_completes_frame) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    // Sender announces sync address 7000
+    uint8_t seq = 0;
+    for (uint16_t u = 0; u < 4; u++) {
+        fill_data(0, (uint32_t)u * 510, 510);
+        uint16_t n = ref_build_e131(pkt, 1 + u, seq, data, 510);
+        pkt[REF_E131_SYNC_ADDR_OFFSET] = 0x1b;
+        pkt[REF_E131_SYNC_ADDR_OFFSET + 1] = 0x58;
+        pp_assembler_push_raw(&as, pkt, n, 100);
+    }
+    seq++;
+    ASSERT_EQ(1, as.stats.frames);  // Free-run until the first sync arrives
+
+    ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, ref_e131_sync, sizeof(ref_e131_sync), 110));
+    ASSERT_TRUE(as.sync_mode);
+
+    // In sync mode, all universes arriving is not enough
+    for (uint16_t u = 0; u < 4; u++) {
+        fill_data(1, (uint32_t)u * 510, 510);
+        uint16_t n = ref_build_e131(pkt, 1 + u, seq, data, 510);
+        ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, pkt, n, 120));
+    }
+    seq++;
+    ASSERT_EQ(PP_PUSH_FRAME, pp_assembler_push_raw(&as, ref_e131_sync, sizeof(ref_e131_sync), 130));
+    verify_board(1, 0);
+    ASSERT_EQ(1, as.stats.sync_frames);
+
+    // Sync on a different address is ignored
+    uint8_t other[sizeof(ref_e131_sync)];
+    memcpy(other, ref_e131_sync, sizeof(other));
+    other[46] = 0x59;
+    fill_data(2, 0, 510);
+    uint16_t n = ref_build_e131(pkt, 1, seq, data, 510);
+    pp_assembler_push_raw(&as, pkt, n, 140);
+    ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, other, sizeof(other), 150));
+}
+
+TEST(sync_timeout_falls_back_to_free_run) {
+    pp_layout_t layout = make_layout(0, 0, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    pp_assembler_push_raw(&as, ref_artsync, sizeof(ref_artsync), 0);
+    ASSERT_TRUE(as.sync_mode);
+
+    uint8_t seq = 1;
+    pp_push_result_t r = PP_PUSH_OK;
+    for (uint16_t u = 0; u < 4; u++) {
+        fill_data(0, (uint32_t)u * 510, 510);
+        uint16_t n = ref_build_artdmx(pkt, u, seq, data, 510);
+        r = pp_assembler_push_raw(&as, pkt, n, PP_SYNC_TIMEOUT_MS + 1);
+    }
+    ASSERT_FALSE(as.sync_mode);
+    ASSERT_EQ(PP_PUSH_FRAME, r);
+}
+
+TEST(artnet_frame_with_artsync) {
+    pp_layout_t layout = make_layout(0, 0, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    pp_assembler_push_raw(&as, ref_artsync, sizeof(ref_artsync), 0);
+    uint8_t seq = 255;
+    for (uint16_t u = 0; u < 4; u++) {
+        fill_data(3, (uint32_t)u * 510, 510);
+        uint16_t n = ref_build_artdmx(pkt, u, seq, data, 510);
+        ASSERT_EQ(PP_PUSH_OK, pp_assembler_push_raw(&as, pkt, n, 10));
+    }
+    ASSERT_EQ(PP_PUSH_FRAME, pp_assembler_push_raw(&as, ref_artsync, sizeof(ref_artsync), 20));
+    verify_board(3, 0);
+
+    // 255 -> 1 is consecutive for Art-Net (0 is skipped)
+    for (uint16_t u = 0; u < 4; u++) {
+        fill_data(4, (uint32_t)u * 510, 510);
+        uint16_t n = ref_build_artdmx(pkt, u, 1, data, 510);
+        pp_assembler_push_raw(&as, pkt, n, 30);
+    }
+    ASSERT_EQ(0, as.stats.lost);
+    ASSERT_EQ(0, as.stats.out_of_order);
+}
+
+TEST(other_boards_universes_ignored) {
+    // This board starts at channel 3000 -> universes 6 (510*5=2550) .. 10
+    pp_layout_t layout = make_layout(3000, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+    ASSERT_EQ(6, as.first_universe);
+    ASSERT_EQ(5, as.universe_count);
+
+    uint8_t seq = 0;
+    pp_push_result_t r = PP_PUSH_OK;
+    for (uint16_t u = 0; u < 12; u++) {
+        fill_data(5, (uint32_t)u * 510, 510);
+        uint16_t n = ref_build_e131(pkt, 1 + u, seq, data, 510);
+        pp_push_result_t pr = pp_assembler_push_raw(&as, pkt, n, 0);
+        if (pr != PP_PUSH_OK) r = pr;
+    }
+    ASSERT_EQ(PP_PUSH_FRAME, r);
+    ASSERT_EQ(7, as.stats.ignored);
+    verify_board(5, 3000);
+}
+
+TEST(ddp_push_and_offsets) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    uint32_t total = board_channels();
+    uint8_t seq = 1;
+    pp_push_result_t r = PP_PUSH_OK;
+    // 1000-byte payloads split pixels across packets
+    for (uint32_t off = 0; off < total; off += 1000) {
+        uint16_t len = (uint16_t)((total - off) < 1000 ? (total - off) : 1000);
+        fill_data(6, off, len);
+        uint16_t n = ref_build_ddp(pkt, seq, off, data, len, off + len >= total);
+        seq = (uint8_t)(seq % 15 + 1);
+        r = pp_assembler_push_raw(&as, pkt, n, 0);
+        if (off + len < total) ASSERT_EQ(PP_PUSH_OK, r);
+    }
+    ASSERT_EQ(PP_PUSH_FRAME, r);
+    ASSERT_EQ(1, as.stats.sync_frames);
+    verify_board(6, 0);
+    ASSERT_EQ(0, as.stats.lost);
+}
+
+TEST(ddp_data_past_layout_ignored) {
+    pp_layout_t layout = make_layout(0, 1, 510);
+    pp_assembler_init(&as, &layout, span_cb, NULL);
+    reset_leds();
+
+    fill_data(0, 0, 30);
+    uint16_t n = ref_build_ddp(pkt, 1, board_channels(), data, 30, 1);
+    ASSERT_EQ(PP_PUSH_FRAME, pp_assembler_push_raw(&as, pkt, n, 0));
+    ASSERT_EQ(0, span_calls);
+    ASSERT_EQ(1, as.stats.ignored);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== pixel_proto tests ===\n\n");
+
+    printf("Packet parsing:\n");
+    RUN_TEST(parse_e131_reference_header);
+    RUN_TEST(parse_e131_sync);
+    RUN_TEST(parse_e131_preview_and_start_code_ignored);
+    RUN_TEST(parse_e131_truncated_is_invalid);
+    RUN_TEST(parse_artnet_dmx_sync_poll);
+    RUN_TEST(parse_ddp);
+    RUN_TEST(parse_garbage_is_invalid);
+
+    printf("\nChannel mapping:\n");
+    RUN_TEST(map_channel_across_strings);
+    RUN_TEST(map_channel_board_offset);
+    RUN_TEST(universe_to_channel);
+
+    printf("\nFrame assembly:\n");
+    RUN_TEST(e131_frame_completes_on_last_universe);
+    RUN_TEST(spans_split_at_string_boundaries);
+    RUN_TEST(pixel_straddling_universes);
+    RUN_TEST(e131_out_of_order_discarded);
+    RUN_TEST(e131_lost_packets_counted);
+    RUN_TEST(repeated_universe_ends_partial_frame);
+    RUN_TEST(e131_sync_packet_completes_frame);
+    RUN_TEST(sync_timeout_falls_back_to_free_run);
+    RUN_TEST(artnet_frame_with_artsync);
+    RUN_TEST(other_boards_universes_ignored);
+    RUN_TEST(ddp_push_and_offsets);
+    RUN_TEST(ddp_data_past_layout_ignored);
+
+    printf("\n=== Results: %d/%d tests passed ===\n\n", tests_passed, tests_run);
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -42,6 +42,10 @@ static bool create_driver(rainbow_test_t *ctx)
         return false;
     }
 
+    pb_power_config_t power;
+    board_config_power(&g_board_config, &power);
+    pb_set_power_config(ctx->driver, &power);
+
     pb_raster_config_t raster_cfg = {
         .width = RAINBOW_TEST_PIXELS_PER_STRING,
         .height = RAINBOW_TEST_NUM_STRINGS,
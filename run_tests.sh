@@ -40,6 +40,297 @@ fi
 make -j > /dev/null
 ./test_board_config || FAILED=1
 
+# --- ddp_stream tests ---
+echo ""
+echo "--- ddp_stream tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_ddp_stream"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/ddp_stream"
+fi
+
+make -j > /dev/null
+./test_ddp_stream || FAILED=1
+
+# --- pixel_proto tests ---
+echo ""
+echo "--- pixel_proto tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_pixel_proto"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake -DPIXEL_PROTO_TEST=ON "$SCRIPT_DIR/lib/pixel_proto"
+fi
+
+make -j > /dev/null
+./pixel_proto_test || FAILED=1
+
+# --- seq_cache tests ---
+echo ""
+echo "--- seq_cache tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_seq_cache"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/seq_cache"
+fi
+
+make -j > /dev/null
+./test_seq_cache || FAILED=1
+
+# --- settings_log tests ---
+echo ""
+echo "--- settings_log tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_settings_log"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/settings_log"
+fi
+
+make -j > /dev/null
+./test_settings_log || FAILED=1
+
+# --- show_index tests ---
+echo ""
+echo "--- show_index tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_show_index"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/show_index"
+fi
+
+make -j > /dev/null
+./test_show_index || FAILED=1
+
+# --- Crossfade tests ---
+echo ""
+echo "--- Crossfade tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_crossfade"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/crossfade"
+fi
+
+make -j > /dev/null
+./test_crossfade || FAILED=1
+
+# --- FSEQ index tests ---
+echo ""
+echo "--- FSEQ index tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_fseq_index"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/fseq_index"
+fi
+
+make -j > /dev/null
+./test_fseq_index || FAILED=1
+
+# --- Chase tests ---
+echo ""
+echo "--- Chase tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_chase"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/chase"
+fi
+
+make -j > /dev/null
+./test_chase || FAILED=1
+
+# --- USB command tests ---
+echo ""
+echo "--- USB command tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_usb_cmd"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/usb_cmd"
+fi
+
+make -j > /dev/null
+./test_usb_cmd || FAILED=1
+
+# --- Frame diff tests ---
+echo ""
+echo "--- Frame diff tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_frame_diff"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/frame_diff"
+fi
+
+make -j > /dev/null
+./test_frame_diff || FAILED=1
+
+# --- Perf telemetry tests ---
+echo ""
+echo "--- Perf telemetry tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_perf"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/perf"
+fi
+
+make -j > /dev/null
+./test_perf || FAILED=1
+
+# --- Trace buffer tests ---
+echo ""
+echo "--- Trace buffer tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_trace"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/trace"
+fi
+
+make -j > /dev/null
+./test_trace || FAILED=1
+
+# --- Play stats tests ---
+echo ""
+echo "--- Play stats tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_play_stats"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/play_stats"
+fi
+
+make -j > /dev/null
+./test_play_stats || FAILED=1
+
+# --- Display tests ---
+echo ""
+echo "--- Display tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_sh1106"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/sh1106"
+fi
+
+make -j > /dev/null
+./test_sh1106 || FAILED=1
+
+# --- Action queue tests ---
+echo ""
+echo "--- Action queue tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_action_queue"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/action_queue"
+fi
+
+make -j > /dev/null
+./test_action_queue || FAILED=1
+
+# --- Input tests ---
+echo ""
+echo "--- Input tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_input"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/input"
+fi
+
+make -j > /dev/null
+./test_input || FAILED=1
+
+# --- IR control tests ---
+echo ""
+echo "--- IR control tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_ir_control"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/ir_control"
+fi
+
+make -j > /dev/null
+./test_ir_control || FAILED=1
+
+# --- String discovery tests ---
+echo ""
+echo "--- String discovery tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_string_discovery"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/string_discovery"
+fi
+
+make -j > /dev/null
+./test_string_discovery || FAILED=1
+
+# --- Effects tests ---
+echo ""
+echo "--- Effects tests ---"
+BUILD_DIR="$SCRIPT_DIR/build_test_effects"
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
+
+if [ ! -f "Makefile" ]; then
+    echo "Configuring..."
+    cmake "$SCRIPT_DIR/test/effects"
+fi
+
+make -j > /dev/null
+./test_effects || FAILED=1
+
+# --- Host tool tests ---
+echo ""
+echo "--- Host tool tests ---"
+cd "$SCRIPT_DIR/tools"
+python3 -m unittest -q test_trace_to_chrome || FAILED=1
+
 # --- Summary ---
 echo ""
 echo "========================================"
@@ -1,6 +1,11 @@
 #include "sh1106.h"
 #include <string.h>
+
+#ifndef SH1106_TEST_BUILD
 #include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "trace.h"
+#endif
 
 #define SH1106_I2C_CMD 0x00
 #define SH1106_I2C_DATA 0x40
@@ -104,6 +109,74 @@ static const uint8_t font5x7[] = {
     0x08, 0x04, 0x08, 0x10, 0x08,
 };
 
+void sh1106_clear(sh1106_t *dev)
+{
+    memset(dev->buffer, 0, sizeof dev->buffer);
+}
+
+static void draw_char(sh1106_t *dev, int x, int page, char c, bool invert)
+{
+    if (c < 32 || c > 126 || page < 0 || page >= (SH1106_HEIGHT / 8))
+        return;
+    int idx = (c - 32) * 5;
+    int base = page * SH1106_WIDTH + x;
+    if (base < 0 || base + 5 >= (int)sizeof(dev->buffer))
+        return;
+    for (int i = 0; i < 5; i++)
+    {
+        uint8_t col = font5x7[idx + i];
+        dev->buffer[base + i] = invert ? ~col : col;
+    }
+    dev->buffer[base + 5] = invert ? 0xFF : 0x00;
+}
+
+void sh1106_draw_string(sh1106_t *dev, int x, int y, const char *text, bool invert)
+{
+    int page = y / 8;
+    int cursor = x;
+    while (*text)
+    {
+        if (cursor + 6 >= SH1106_WIDTH)
+            break;
+        draw_char(dev, cursor, page, *text++, invert);
+        cursor += 6;
+    }
+}
+
+uint8_t sh1106_dirty_pages(const uint8_t *frame, const uint8_t *sent)
+{
+    uint8_t mask = 0;
+    for (int page = 0; page < SH1106_PAGES; page++)
+    {
+        if (memcmp(&frame[page * SH1106_WIDTH], &sent[page * SH1106_WIDTH], SH1106_WIDTH) != 0)
+            mask |= (uint8_t)(1u << page);
+    }
+    return mask;
+}
+
+size_t sh1106_build_transfer(const uint8_t *frame, uint8_t mask, uint32_t *words)
+{
+    size_t n = 0;
+    for (int page = 0; page < SH1106_PAGES; page++)
+    {
+        if (!(mask & (1u << page)))
+            continue;
+        words[n++] = SH1106_I2C_CMD;
+        words[n++] = 0xB0 | page;
+        words[n++] = SH1106_COLUMN_OFFSET;
+        words[n++] = 0x10 | SH1106_WORD_STOP;
+        words[n++] = SH1106_I2C_DATA;
+        for (int col = 0; col < SH1106_WIDTH; col++)
+            words[n++] = frame[page * SH1106_WIDTH + col];
+        words[n - 1] |= SH1106_WORD_STOP;
+    }
+    return n;
+}
+
+#ifndef SH1106_TEST_BUILD
+
+_Static_assert(SH1106_WORD_STOP == I2C_IC_DATA_CMD_STOP_BITS, "I2C STOP bit");
+
 static bool send_cmd(sh1106_t *dev, uint8_t cmd)
 {
     uint8_t buf[2] = {SH1106_I2C_CMD, cmd};
@@ -115,6 +188,11 @@ bool sh1106_init(sh1106_t *dev, i2c_inst_t *i2c, uint8_t addr)
     dev->i2c = i2c;
     dev->addr = addr;
     memset(dev->buffer, 0, sizeof dev->buffer);
+    dev->sent_valid = false;
+    dev->pending = false;
+    dev->busy = false;
+    dev->last_start_us = 0;
+    dev->dma_chan = -1;
 
     const uint8_t init_seq[] = {
         0xAE,       // display off
@@ -140,56 +218,84 @@ bool sh1106_init(sh1106_t *dev, i2c_inst_t *i2c, uint8_t addr)
             return false;
         }
     }
-    return true;
-}
 
-void sh1106_clear(sh1106_t *dev)
-{
-    memset(dev->buffer, 0, sizeof dev->buffer);
+    // Blocking writes above left the target address set; from here on the
+    // bus belongs to the background transfers
+    dev->dma_chan = dma_claim_unused_channel(false);
+    if (dev->dma_chan >= 0)
+    {
+        dma_channel_config c = dma_channel_get_default_config(dev->dma_chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+        dma_channel_configure(dev->dma_chan, &c, &i2c_get_hw(i2c)->data_cmd, dev->words, 0, false);
+    }
+    return true;
 }
 
-static void draw_char(sh1106_t *dev, int x, int page, char c, bool invert)
+static void start_transfer(sh1106_t *dev)
 {
-    if (c < 32 || c > 126 || page < 0 || page >= (SH1106_HEIGHT / 8))
-        return;
-    int idx = (c - 32) * 5;
-    int base = page * SH1106_WIDTH + x;
-    if (base < 0 || base + 5 >= (int)sizeof(dev->buffer))
+    uint8_t mask = dev->sent_valid ? sh1106_dirty_pages(dev->buffer, dev->sent) : 0xFF;
+    dev->pending = false;
+    if (mask == 0)
         return;
-    for (int i = 0; i < 5; i++)
+
+    size_t n = sh1106_build_transfer(dev->buffer, mask, dev->words);
+    memcpy(dev->sent, dev->buffer, sizeof dev->sent);
+    dev->sent_valid = true;
+    dev->last_start_us = time_us_64();
+    trace_begin(TRACE_DISPLAY_RENDER);
+
+    if (dev->dma_chan < 0)
     {
-        uint8_t col = font5x7[idx + i];
-        dev->buffer[base + i] = invert ? ~col : col;
+        // No channel to spare: same words, pushed as the FIFO drains
+        i2c_hw_t *hw = i2c_get_hw(dev->i2c);
+        for (size_t i = 0; i < n; i++)
+        {
+            while (i2c_get_write_available(dev->i2c) == 0)
+                tight_loop_contents();
+            hw->data_cmd = dev->words[i];
+        }
+        trace_end(TRACE_DISPLAY_RENDER);
+        return;
     }
-    dev->buffer[base + 5] = invert ? 0xFF : 0x00;
+
+    dev->busy = true;
+    dma_channel_set_read_addr(dev->dma_chan, dev->words, false);
+    dma_channel_set_trans_count(dev->dma_chan, n, true);
 }
 
-void sh1106_draw_string(sh1106_t *dev, int x, int y, const char *text, bool invert)
+void sh1106_poll(sh1106_t *dev)
 {
-    int page = y / 8;
-    int cursor = x;
-    while (*text)
+    if (dev->busy)
     {
-        if (cursor + 6 >= SH1106_WIDTH)
-            break;
-        draw_char(dev, cursor, page, *text++, invert);
-        cursor += 6;
+        i2c_hw_t *hw = i2c_get_hw(dev->i2c);
+        if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+        {
+            // NAK or lost arbitration: the controller flushed its FIFO and
+            // stalls until cleared. Resend everything next time.
+            dma_channel_abort(dev->dma_chan);
+            (void)hw->clr_tx_abrt;
+            dev->sent_valid = false;
+            dev->pending = true;
+        }
+        else if (dma_channel_is_busy(dev->dma_chan))
+        {
+            return;
+        }
+        dev->busy = false;
+        trace_end(TRACE_DISPLAY_RENDER);
     }
+
+    if (dev->pending && time_us_64() - dev->last_start_us >= SH1106_MIN_REFRESH_US)
+        start_transfer(dev);
 }
 
 void sh1106_render(sh1106_t *dev)
 {
-    for (int page = 0; page < (SH1106_HEIGHT / 8); page++)
-    {
-        send_cmd(dev, 0xB0 | page);
-        send_cmd(dev, 0x02);
-        send_cmd(dev, 0x10);
-        for (int col = 0; col < SH1106_WIDTH; col += 16)
-        {
-            uint8_t buf[17];
-            buf[0] = SH1106_I2C_DATA;
-            memcpy(&buf[1], &dev->buffer[page * SH1106_WIDTH + col], 16);
-            i2c_write_blocking(dev->i2c, dev->addr, buf, 17, false);
-        }
-    }
+    dev->pending = true;
+    sh1106_poll(dev);
 }
+
+#endif // SH1106_TEST_BUILD
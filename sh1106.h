@@ -1,23 +1,68 @@
 #ifndef SH1106_H
 #define SH1106_H
 
-#include "hardware/i2c.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#ifndef SH1106_TEST_BUILD
+#include "hardware/i2c.h"
+#else
+typedef struct i2c_inst i2c_inst_t;
+#endif
+
 #define SH1106_WIDTH 128
 #define SH1106_HEIGHT 64
+#define SH1106_PAGES (SH1106_HEIGHT / 8)
+
+// I2C words per page: command transaction (control, page, column low/high)
+// then data transaction (control, one byte per column)
+#define SH1106_PAGE_WORDS (4 + 1 + SH1106_WIDTH)
 
+// Renders requested faster than this are coalesced into one transfer
+#define SH1106_MIN_REFRESH_US 33000
+
+// I2C_IC_DATA_CMD STOP bit: ends the transaction after this byte
+#define SH1106_WORD_STOP (1u << 9)
+
+// Drawing goes into buffer. sh1106_render() only requests a refresh: pages
+// that differ from what the panel last received are queued as I2C data
+// command words and fed to the controller by DMA in the background, so
+// rendering never blocks on the bus (a full refresh is ~25 ms at 400 kHz).
 typedef struct
 {
     i2c_inst_t *i2c;
     uint8_t addr;
     uint8_t buffer[SH1106_WIDTH * SH1106_HEIGHT / 8];
+
+    uint8_t sent[SH1106_WIDTH * SH1106_HEIGHT / 8]; // Panel contents as last transmitted
+    bool sent_valid;                                // false: panel contents unknown
+    bool pending;                                   // Render requested, not started
+    bool busy;                                      // Transfer in progress
+    int dma_chan;                                   // -1: write words from the CPU
+    uint64_t last_start_us;
+    uint32_t words[SH1106_PAGES * SH1106_PAGE_WORDS];
 } sh1106_t;
 
-bool sh1106_init(sh1106_t *dev, i2c_inst_t *i2c, uint8_t addr);
 void sh1106_clear(sh1106_t *dev);
 void sh1106_draw_string(sh1106_t *dev, int x, int y, const char *text, bool invert);
+
+// Bit per page (bit 0 = page 0) where frame differs from sent
+uint8_t sh1106_dirty_pages(const uint8_t *frame, const uint8_t *sent);
+
+// Fill words with the transfer for the pages in mask. Returns the word count.
+size_t sh1106_build_transfer(const uint8_t *frame, uint8_t mask, uint32_t *words);
+
+#ifndef SH1106_TEST_BUILD
+
+bool sh1106_init(sh1106_t *dev, i2c_inst_t *i2c, uint8_t addr);
+
+// Request a refresh (returns immediately)
 void sh1106_render(sh1106_t *dev);
 
+// Finish / start background transfers. Call from the main loop.
+void sh1106_poll(sh1106_t *dev);
+
+#endif // SH1106_TEST_BUILD
+
 #endif // SH1106_H
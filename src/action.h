@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // Action types - represent "what happened"
 typedef enum {
@@ -28,11 +29,29 @@ typedef enum {
     // Playback events
     ACTION_FSEQ_NEXT,           // Skip to next file during playback
     ACTION_AUTO_TOGGLE,         // Toggle auto-loop mode
+    ACTION_INTERP_TOGGLE,       // Toggle frame interpolation
     ACTION_FSEQ_LOOP_COMPLETE,  // Current file finished one loop (for auto-advance)
 
     // Brightness events
     ACTION_BRIGHTNESS_UP,
     ACTION_BRIGHTNESS_DOWN,
+
+    // USB stream events
+    ACTION_USB_STREAM_STATS,    // Periodic FPS/frame count from Core 1
+
+    // Flash cache events
+    ACTION_FLASH_CACHE_STATUS,  // Periodic install progress / cache usage
+
+    // Perf view events
+    ACTION_PERF_STATS,          // Periodic playback health from Core 1
+
+    // String discovery events
+    ACTION_STRING_DISCOVERY_SAVED,  // Results file written (or not) to SD
+    ACTION_STRING_DISCOVERY_ANSWER_ROUND,  // Same answer for the rest of the round
+
+    // Effects events
+    ACTION_EFFECTS_START,       // Start an effect (IR), or the cycling show
+    ACTION_EFFECTS_STATS,       // Periodic FPS/frame budget from Core 1
 } ActionType;
 
 // Action payload union
@@ -59,6 +78,58 @@ typedef union {
     struct {
         uint16_t fps;
     } rainbow;
+
+    // For ACTION_USB_STREAM_STATS
+    struct {
+        uint16_t fps;
+        uint32_t frames;
+    } usb_stream;
+
+    // For ACTION_FLASH_CACHE_STATUS
+    struct {
+        bool installing;
+        uint8_t progress;
+        uint8_t cached_count;
+        uint32_t free_kb;
+        char message[24];
+    } flash_cache;
+
+    // For ACTION_PERF_STATS
+    struct {
+        uint16_t fps;
+        uint16_t target_fps;
+        uint32_t late;
+        uint32_t dropped;
+        uint32_t sd_kbps;
+        uint16_t read_us;
+        uint16_t decode_us;
+        uint16_t encode_us;
+        uint8_t core1_pct;
+    } perf;
+
+    // For ACTION_STRING_DISCOVERY_SAVED
+    struct {
+        char message[24];
+    } string_discovery;
+
+    // For ACTION_STRING_DISCOVERY_ANSWER_ROUND
+    struct {
+        bool lit;
+    } discovery_round;
+
+    // For ACTION_EFFECTS_START
+    struct {
+        uint8_t effect;
+        bool cycle;                // Show: move on to the next effect periodically
+    } effects_start;
+
+    // For ACTION_EFFECTS_STATS
+    struct {
+        uint16_t fps;
+        uint16_t render_us;
+        uint16_t encode_us;
+        uint8_t load_pct;
+    } effects;
 } ActionPayload;
 
 // Action struct
@@ -169,6 +240,13 @@ static inline Action action_auto_toggle(uint32_t timestamp) {
     };
 }
 
+static inline Action action_interp_toggle(uint32_t timestamp) {
+    return (Action){
+        .type = ACTION_INTERP_TOGGLE,
+        .timestamp = timestamp,
+    };
+}
+
 static inline Action action_fseq_loop_complete(uint32_t timestamp) {
     return (Action){
         .type = ACTION_FSEQ_LOOP_COMPLETE,
@@ -189,3 +267,102 @@ static inline Action action_brightness_down(uint32_t timestamp) {
         .timestamp = timestamp,
     };
 }
+
+static inline Action action_usb_stream_stats(uint32_t timestamp, uint16_t fps, uint32_t frames) {
+    return (Action){
+        .type = ACTION_USB_STREAM_STATS,
+        .timestamp = timestamp,
+        .payload.usb_stream = {
+            .fps = fps,
+            .frames = frames,
+        },
+    };
+}
+
+static inline Action action_flash_cache_status(uint32_t timestamp, bool installing,
+                                               uint8_t progress, uint8_t cached_count,
+                                               uint32_t free_kb, const char* msg) {
+    Action a = {
+        .type = ACTION_FLASH_CACHE_STATUS,
+        .timestamp = timestamp,
+        .payload.flash_cache = {
+            .installing = installing,
+            .progress = progress,
+            .cached_count = cached_count,
+            .free_kb = free_kb,
+        },
+    };
+    for(int i=0; i<23 && msg[i]; i++) {
+        a.payload.flash_cache.message[i] = msg[i];
+    }
+    a.payload.flash_cache.message[23] = 0;
+    return a;
+}
+
+static inline Action action_perf_stats(uint32_t timestamp, uint16_t fps, uint16_t target_fps,
+                                       uint32_t late, uint32_t dropped, uint32_t sd_kbps,
+                                       uint16_t read_us, uint16_t decode_us, uint16_t encode_us,
+                                       uint8_t core1_pct) {
+    return (Action){
+        .type = ACTION_PERF_STATS,
+        .timestamp = timestamp,
+        .payload.perf = {
+            .fps = fps,
+            .target_fps = target_fps,
+            .late = late,
+            .dropped = dropped,
+            .sd_kbps = sd_kbps,
+            .read_us = read_us,
+            .decode_us = decode_us,
+            .encode_us = encode_us,
+            .core1_pct = core1_pct,
+        },
+    };
+}
+
+static inline Action action_string_discovery_saved(uint32_t timestamp, const char* msg) {
+    Action a = {
+        .type = ACTION_STRING_DISCOVERY_SAVED,
+        .timestamp = timestamp,
+    };
+    for(int i=0; i<23 && msg[i]; i++) {
+        a.payload.string_discovery.message[i] = msg[i];
+    }
+    a.payload.string_discovery.message[23] = 0;
+    return a;
+}
+
+static inline Action action_string_discovery_answer_round(uint32_t timestamp, bool lit) {
+    return (Action){
+        .type = ACTION_STRING_DISCOVERY_ANSWER_ROUND,
+        .timestamp = timestamp,
+        .payload.discovery_round = {
+            .lit = lit,
+        },
+    };
+}
+
+static inline Action action_effects_start(uint32_t timestamp, uint8_t effect, bool cycle) {
+    return (Action){
+        .type = ACTION_EFFECTS_START,
+        .timestamp = timestamp,
+        .payload.effects_start = {
+            .effect = effect,
+            .cycle = cycle,
+        },
+    };
+}
+
+static inline Action action_effects_stats(uint32_t timestamp, uint16_t fps, uint16_t render_us,
+                                          uint16_t encode_us, uint8_t load_pct) {
+    return (Action){
+        .type = ACTION_EFFECTS_STATS,
+        .timestamp = timestamp,
+        .payload.effects = {
+            .fps = fps,
+            .render_us = render_us,
+            .encode_us = encode_us,
+            .load_pct = load_pct,
+        },
+    };
+}
@@ -0,0 +1,32 @@
+#include "action_queue.h"
+#include "reducer.h"
+#include <string.h>
+
+void action_queue_init(action_queue_t* q) {
+    memset(q, 0, sizeof(*q));
+}
+
+bool action_queue_push(action_queue_t* q, const Action* action) {
+    if (q->count >= ACTION_QUEUE_SIZE) return false;
+    q->actions[(q->head + q->count) % ACTION_QUEUE_SIZE] = *action;
+    q->count++;
+    return true;
+}
+
+bool action_queue_pop(action_queue_t* q, Action* out) {
+    if (q->count == 0) return false;
+    *out = q->actions[q->head];
+    q->head = (q->head + 1) % ACTION_QUEUE_SIZE;
+    q->count--;
+    return true;
+}
+
+uint8_t action_queue_reduce(action_queue_t* q, AppState* state) {
+    uint8_t n = 0;
+    Action action;
+    while (action_queue_pop(q, &action)) {
+        *state = reduce(state, &action);
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_state.h"
+#include "action.h"
+
+// Actions waiting for the next reduce pass.
+//
+// The main loop queues actions as events arrive and drains the queue once
+// per iteration: the reducer folds the whole batch, then side effects and
+// the view render run once against the batch's first and last states. A
+// burst (IR repeat, tick and board address sample in the same iteration)
+// costs one render instead of one per action.
+//
+// Folding is the same as reducing one action at a time, so the final state
+// doesn't depend on how actions were batched. Side effects see only the net
+// change: a test started and stopped within one batch never starts.
+
+#define ACTION_QUEUE_SIZE 16
+
+typedef struct {
+    Action actions[ACTION_QUEUE_SIZE];
+    uint8_t head;              // Oldest action
+    uint8_t count;
+} action_queue_t;
+
+void action_queue_init(action_queue_t* q);
+
+// Append an action. Returns false (action not queued) when full.
+bool action_queue_push(action_queue_t* q, const Action* action);
+
+// Remove the oldest action. Returns false when empty.
+bool action_queue_pop(action_queue_t* q, Action* out);
+
+// Reduce every queued action into *state, oldest first, emptying the queue.
+// Returns the number of actions reduced.
+uint8_t action_queue_reduce(action_queue_t* q, AppState* state);
@@ -2,16 +2,23 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "string_discovery.h"
+#include "effects.h"
 
 // Menu entries
 typedef enum {
     MENU_INFO = 0,
     MENU_BOARD_ADDRESS,
     MENU_SD_CARD,
+    MENU_FLASH_CACHE,
+    MENU_USB_STREAM,
+    MENU_EFFECTS,
+    MENU_PERF,
     MENU_STRING_TEST,
     MENU_TOGGLE_TEST,
     MENU_RAINBOW_TEST,
     MENU_STRING_LENGTH,
+    MENU_STRING_DISCOVERY,
     MENU_BRIGHTNESS,
     MENU_SHUTDOWN,
     MENU_COUNT
@@ -24,7 +31,7 @@ typedef enum {
 } TestRunState;
 
 // SD Card State
-#define SD_MAX_FILES 16
+#define SD_MAX_FILES 250  // Menu adds up to 2 items; counts stay in uint8_t
 #define SD_FILENAME_LEN 32  // Support long filenames
 
 typedef struct {
@@ -40,11 +47,25 @@ typedef struct {
     uint8_t playing_index;         // Index into sd_file_list (reducer stays pure)
     bool auto_play_pending;        // Start playback after SD scan completes
     bool auto_loop;                // When true, auto-advance to next file on completion
+    bool interpolate;              // Blend extra frames between sequence frames
 } SdCardState;
 
 // External static file list (defined in main.c)
 extern char sd_file_list[SD_MAX_FILES][SD_FILENAME_LEN];
 
+// Flash sequence cache state
+// Detail view lists sd_file_list, then [Clear Cache] and [Main Menu]
+typedef struct {
+    TestRunState run_state;        // RUNNING while an install is in progress
+    uint8_t scroll_index;          // Current scroll position
+    uint8_t install_index;         // Index into sd_file_list being installed
+    uint8_t progress;              // Install progress 0-100
+    uint8_t cached_count;          // Sequences in flash
+    uint32_t free_kb;              // Largest free block
+    uint8_t clear_requests;        // Incremented to request an erase (side effect)
+    char status_msg[24];           // Result of the last install / clear
+} FlashCacheState;
+
 // Board address decode result
 typedef struct {
     uint16_t adc_value;
@@ -75,6 +96,37 @@ typedef struct {
     uint16_t fps;
 } RainbowTestState;
 
+// USB live stream state
+typedef struct {
+    TestRunState run_state;
+    uint16_t fps;
+    uint32_t frames;               // Frames received since stream start
+} UsbStreamState;
+
+// Procedural effects state (see effects.h)
+typedef struct {
+    TestRunState run_state;
+    uint8_t effect;                // effect_id_t
+    bool cycle;                    // Show: next effect every EFFECTS_SHOW_SECONDS
+    uint16_t fps;
+    uint16_t render_us;            // Average per frame: render
+    uint16_t encode_us;            //   bit-plane encode
+    uint8_t load_pct;              // Render + encode share of the 60 fps budget
+} EffectsState;
+
+// Playback health view state (refreshed from Core 1's counters while shown)
+typedef struct {
+    uint16_t fps;
+    uint16_t target_fps;
+    uint32_t late;                 // Frames out late since the show started
+    uint32_t dropped;              // Frame slots lost
+    uint32_t sd_kbps;              // SD read rate, KB/s
+    uint16_t read_us;              // Average per frame: SD read
+    uint16_t decode_us;            //   decompress / decode
+    uint16_t encode_us;            //   bit-plane encode
+    uint8_t core1_pct;             // Core 1 busy
+} PerfViewState;
+
 // String length tool state
 #define STRING_LENGTH_MAX_PIXELS 512  // Must match PB_MAX_PIXELS
 #define STRING_LENGTH_NUM_STRINGS 32
@@ -86,6 +138,15 @@ typedef struct {
     uint16_t lengths[STRING_LENGTH_NUM_STRINGS];  // Recorded lengths
 } StringLengthState;
 
+// String length discovery state (all strings at once, see string_discovery.h)
+typedef struct {
+    TestRunState run_state;
+    bool save_pending;             // Results waiting to be written to SD (main loop)
+    char status_msg[24];           // Result of the last save
+    uint8_t answer_round;          // Round of the last single answer (a hold finishes it)
+    string_discovery_t search;
+} StringDiscoveryState;
+
 // Brightness levels (1-10 map to hardware values)
 #define BRIGHTNESS_MIN 1
 #define BRIGHTNESS_MAX 10
@@ -114,11 +175,24 @@ typedef struct {
     // SD Card
     SdCardState sd_card;
 
+    // Flash sequence cache
+    FlashCacheState flash_cache;
+
+    // USB live stream
+    UsbStreamState usb_stream;
+
+    // Procedural effects
+    EffectsState effects;
+
+    // Playback health
+    PerfViewState perf;
+
     // Test states
     StringTestState string_test;
     ToggleTestState toggle_test;
     RainbowTestState rainbow_test;
     StringLengthState string_length;
+    StringDiscoveryState string_discovery;
 
     // System
     uint32_t uptime_seconds;
@@ -143,7 +217,24 @@ static inline AppState app_state_init(void) {
             .is_playing = false,
             .playing_index = 0,
             .auto_loop = false,
+            .interpolate = false,
+        },
+        .flash_cache = {
+            .run_state = TEST_STOPPED,
+            .scroll_index = 0,
+            .status_msg = "",
         },
+        .usb_stream = {
+            .run_state = TEST_STOPPED,
+            .fps = 0,
+            .frames = 0,
+        },
+        .effects = {
+            .run_state = TEST_STOPPED,
+            .effect = EFFECT_COLOR_WIPE,
+            .cycle = false,
+        },
+        .perf = {0},
         .string_test = {.run_state = TEST_STOPPED},
         .toggle_test = {.run_state = TEST_STOPPED},
         .rainbow_test = {
@@ -157,6 +248,11 @@ static inline AppState app_state_init(void) {
             .current_pixel = 0,
             .lengths = {0},
         },
+        .string_discovery = {
+            .run_state = TEST_STOPPED,
+            .save_pending = false,
+            .status_msg = "",
+        },
         .uptime_seconds = 0,
     };
     return state;
@@ -60,6 +60,18 @@ pb_color_order_t board_config_parse_color_order(const char* str) {
     return PB_COLOR_ORDER_GRB;
 }
 
+const char* board_config_color_order_name(pb_color_order_t order) {
+    switch (order) {
+        case PB_COLOR_ORDER_RGB: return "RGB";
+        case PB_COLOR_ORDER_GRB: return "GRB";
+        case PB_COLOR_ORDER_BGR: return "BGR";
+        case PB_COLOR_ORDER_RBG: return "RBG";
+        case PB_COLOR_ORDER_GBR: return "GBR";
+        case PB_COLOR_ORDER_BRG: return "BRG";
+        default: return "???";
+    }
+}
+
 bool board_config_parse_line(const char* line, uint16_t* pixel_count, pb_color_order_t* color_order) {
     if (!line || !pixel_count || !color_order) return false;
 
@@ -100,6 +112,79 @@ bool board_config_parse_line(const char* line, uint16_t* pixel_count, pb_color_o
     return true;
 }
 
+// Optional third column of a string row: current budget in mA (0 if absent)
+static uint16_t parse_max_ma(const char* line) {
+    const char* comma = strchr(line, ',');
+    if (comma) comma = strchr(comma + 1, ',');
+    if (!comma) return 0;
+    long ma = strtol(comma + 1, NULL, 10);
+    if (ma < 0) return 0;
+    return ma > UINT16_MAX ? UINT16_MAX : (uint16_t)ma;
+}
+
+// Match "keyword," at the start of a line; returns the text after the comma
+static const char* match_keyword(const char* line, const char* keyword) {
+    size_t len = strlen(keyword);
+    if (strncmp(line, keyword, len) != 0 || line[len] != ',') return NULL;
+    return line + len + 1;
+}
+
+// Apply a power keyword line. Returns false if the line isn't one.
+static bool parse_power_line(const char* line, uint8_t board_id, board_config_t* config) {
+    const char* args = match_keyword(line, "power");
+    if (args) {
+        char* end;
+        long board = strtol(args, &end, 10);
+        if (*end == ',' && board == board_id) {
+            long ma = strtol(end + 1, NULL, 10);
+            config->power_budget_ma = ma > 0 ? (uint32_t)ma : 0;
+        }
+        return true;
+    }
+
+    args = match_keyword(line, "channel_ma");
+    if (args) {
+        long ma = strtol(args, NULL, 10);
+        if (ma > 0 && ma <= UINT16_MAX) config->channel_ma = (uint16_t)ma;
+        return true;
+    }
+    return false;
+}
+
+bool board_config_parse_board_id(const char* buffer, size_t buffer_len, uint8_t* board_id) {
+    const char* line = buffer;
+    const char* buffer_end = buffer + buffer_len;
+
+    while (line < buffer_end) {
+        while (line < buffer_end && (*line == ' ' || *line == '\t')) line++;
+
+        // Long enough for "board_id,<id>"; longer lines aren't the keyword
+        char line_buf[24];
+        size_t len = 0;
+        while (line + len < buffer_end && len < sizeof(line_buf) - 1 &&
+               line[len] != '\n' && line[len] != '\r') {
+            line_buf[len] = line[len];
+            len++;
+        }
+        line_buf[len] = '\0';
+
+        const char* args = match_keyword(line_buf, "board_id");
+        if (args) {
+            char* end;
+            long id = strtol(args, &end, 10);
+            if (end != args && id >= 0 && id <= UINT8_MAX) {
+                *board_id = (uint8_t)id;
+                return true;
+            }
+            return false;
+        }
+
+        while (line < buffer_end && *line != '\n' && *line != '\r') line++;
+        while (line < buffer_end && (*line == '\n' || *line == '\r')) line++;
+    }
+    return false;
+}
+
 board_config_parse_result_t board_config_parse_buffer(
     const char* buffer,
     size_t buffer_len,
@@ -117,14 +202,21 @@ board_config_parse_result_t board_config_parse_buffer(
         return result;
     }
 
+    // A board_id line in the file wins over the caller's (ladder) ID
+    config->board_id_from_config = board_config_parse_board_id(buffer, buffer_len, &board_id);
+
     // Initialize config
     config->loaded = false;
     config->board_id = board_id;
     config->string_count = 0;
     config->max_pixel_count = 0;
+    config->start_channel = 0;
+    config->power_budget_ma = 0;
+    config->channel_ma = PB_POWER_DEFAULT_CHANNEL_MA;
     for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
         config->strings[i].pixel_count = 0;
         config->strings[i].color_order = PB_COLOR_ORDER_GRB;
+        config->strings[i].max_ma = 0;
     }
 
     // Calculate which rows we need
@@ -165,6 +257,24 @@ board_config_parse_result_t board_config_parse_buffer(
             continue;
         }
 
+        // Keyword lines may appear anywhere, including after our section
+        if (parse_power_line(p, board_id, config) || match_keyword(p, "board_id")) {
+            continue;
+        }
+        if (current_row > end_row) {
+            continue;
+        }
+
+        // Earlier boards' strings come first in a shared channel space.
+        // Their format errors are reported when that board parses.
+        if (current_row < start_row) {
+            uint16_t pixel_count;
+            pb_color_order_t color_order;
+            if (board_config_parse_line(line_buf, &pixel_count, &color_order)) {
+                config->start_channel += (uint32_t)pixel_count * 3;
+            }
+        }
+
         // Process this line if it's in our board's range
         if (current_row >= start_row && current_row <= end_row) {
             uint8_t string_index = current_row - start_row;
@@ -179,6 +289,7 @@ board_config_parse_result_t board_config_parse_buffer(
 
             config->strings[string_index].pixel_count = pixel_count;
             config->strings[string_index].color_order = color_order;
+            config->strings[string_index].max_ma = parse_max_ma(line_buf);
 
             if (pixel_count > config->max_pixel_count) {
                 config->max_pixel_count = pixel_count;
@@ -189,9 +300,6 @@ board_config_parse_result_t board_config_parse_buffer(
         }
 
         current_row++;
-
-        // Stop if we've passed our board's section
-        if (current_row > end_row) break;
     }
 
     // Check if we found any data for this board
@@ -205,15 +313,61 @@ board_config_parse_result_t board_config_parse_buffer(
     return result;
 }
 
+uint32_t board_config_hash(const char* buffer, size_t buffer_len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < buffer_len; i++) {
+        hash ^= (uint8_t)buffer[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+size_t board_config_format_csv(const board_config_t* config, const uint16_t* lengths,
+                               char* out, size_t out_size) {
+    int n = snprintf(out, out_size,
+                     "# Board %u string lengths, from Find Lengths\n"
+                     "# Rows for this board's section of config.csv\n",
+                     config->board_id);
+    if (n < 0 || (size_t)n >= out_size) return 0;
+    size_t pos = (size_t)n;
+
+    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
+        const string_config_t* s = &config->strings[i];
+        const char* order = board_config_color_order_name(s->color_order);
+        if (s->max_ma > 0) {
+            n = snprintf(out + pos, out_size - pos, "%u,%s,%u\n", lengths[i], order, s->max_ma);
+        } else {
+            n = snprintf(out + pos, out_size - pos, "%u,%s\n", lengths[i], order);
+        }
+        if (n < 0 || (size_t)n >= out_size - pos) return 0;
+        pos += (size_t)n;
+    }
+    return pos;
+}
+
 void board_config_set_defaults(uint8_t board_id) {
     g_board_config.loaded = false;
     g_board_config.board_id = board_id;
+    g_board_config.board_id_from_config = false;
     g_board_config.string_count = BOARD_CONFIG_MAX_STRINGS;
     g_board_config.max_pixel_count = 50;
+    g_board_config.start_channel = (uint32_t)board_id * BOARD_CONFIG_MAX_STRINGS * 50 * 3;
+    g_board_config.power_budget_ma = 0;
+    g_board_config.channel_ma = PB_POWER_DEFAULT_CHANNEL_MA;
 
     for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
         g_board_config.strings[i].pixel_count = 50;
         g_board_config.strings[i].color_order = PB_COLOR_ORDER_GRB;
+        g_board_config.strings[i].max_ma = 0;
+    }
+}
+
+void board_config_power(const board_config_t* config, pb_power_config_t* power) {
+    memset(power, 0, sizeof(*power));
+    power->channel_ma = config->channel_ma;
+    power->budget_ma = config->power_budget_ma;
+    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS && i < PB_MAX_STRINGS; i++) {
+        power->string_budget_ma[i] = config->strings[i].max_ma;
     }
 }
 
@@ -237,25 +391,18 @@ uint16_t board_config_get_pixel_count(uint8_t string) {
 
 #ifndef BOARD_CONFIG_TEST_BUILD
 
-board_config_load_result_t board_config_load_from_sd(uint8_t board_id) {
+// Read and parse config.csv from the mounted card. Skips the parse when the
+// file hash matches known_hash (0 = always parse).
+static board_config_load_result_t load_config_file(uint8_t board_id, uint32_t known_hash) {
     board_config_load_result_t result = {
         .success = false,
+        .changed = false,
+        .config_hash = 0,
         .error_msg = "Unknown error"
     };
 
-    // Set defaults first (fallback if load fails)
-    board_config_set_defaults(board_id);
-
-    sd_card_t *sd = sd_get_by_num(0);
-    FRESULT fr = f_mount(&sd->fatfs, sd->pcName, 1);
-
-    if (fr != FR_OK) {
-        result.error_msg = "SD mount failed";
-        return result;
-    }
-
     FIL file;
-    fr = f_open(&file, "/config.csv", FA_READ);
+    FRESULT fr = f_open(&file, "/config.csv", FA_READ);
     if (fr != FR_OK) {
         result.error_msg = "config.csv not found";
         return result;
@@ -273,9 +420,17 @@ board_config_load_result_t board_config_load_from_sd(uint8_t board_id) {
     }
     file_buffer[bytes_read] = '\0';
 
-    // Parse the buffer
+    result.config_hash = board_config_hash(file_buffer, bytes_read);
+    if (known_hash != 0 && result.config_hash == known_hash) {
+        result.success = true;
+        result.error_msg = NULL;
+        return result;
+    }
+
+    // Parse into a scratch copy so a bad file leaves the current config alone
+    static board_config_t parsed;
     board_config_parse_result_t parse_result = board_config_parse_buffer(
-        file_buffer, bytes_read, board_id, &g_board_config
+        file_buffer, bytes_read, board_id, &parsed
     );
 
     if (!parse_result.success) {
@@ -291,9 +446,59 @@ board_config_load_result_t board_config_load_from_sd(uint8_t board_id) {
         return result;
     }
 
+    memcpy(&g_board_config, &parsed, sizeof(board_config_t));
     result.success = true;
+    result.changed = true;
     result.error_msg = NULL;
     return result;
 }
 
+board_config_load_result_t board_config_load_from_sd(uint8_t board_id) {
+    // Set defaults first (fallback if load fails)
+    board_config_set_defaults(board_id);
+
+    sd_card_t *sd = sd_get_by_num(0);
+    FRESULT fr = f_mount(&sd->fatfs, sd->pcName, 1);
+
+    if (fr != FR_OK) {
+        board_config_load_result_t result = {
+            .success = false,
+            .changed = false,
+            .config_hash = 0,
+            .error_msg = "SD mount failed"
+        };
+        return result;
+    }
+
+    return load_config_file(board_id, 0);
+}
+
+board_config_load_result_t board_config_reload_if_changed(uint8_t board_id,
+                                                          uint32_t known_hash) {
+    return load_config_file(board_id, known_hash);
+}
+
+const char* board_config_save_lengths(const uint16_t* lengths) {
+    static char csv[1024];
+    size_t len = board_config_format_csv(&g_board_config, lengths, csv, sizeof(csv));
+    if (len == 0) return "Format error";
+
+    // The card may not be mounted yet when the config came from flash
+    sd_card_t *sd = sd_get_by_num(0);
+    if (f_mount(&sd->fatfs, sd->pcName, 1) != FR_OK) return "SD mount failed";
+
+    char path[32];
+    snprintf(path, sizeof(path), BOARD_CONFIG_LENGTHS_PATH, g_board_config.board_id);
+
+    FIL file;
+    if (f_open(&file, path, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return "Can't create file";
+    UINT written;
+    FRESULT fr = f_write(&file, csv, len, &written);
+    f_close(&file);
+    if (fr != FR_OK || written != len) return "Write error";
+
+    printf("Config: String lengths written to %s\n", path);
+    return NULL;
+}
+
 #endif // BOARD_CONFIG_TEST_BUILD
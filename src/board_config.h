@@ -12,14 +12,23 @@
 typedef struct {
     uint16_t pixel_count;         // Number of pixels (0 = disabled)
     pb_color_order_t color_order; // RGB, GRB, etc.
+    uint16_t max_ma;              // Current budget (0 = unlimited)
 } string_config_t;
 
+// Where string length discovery writes its results, by board ID
+#define BOARD_CONFIG_LENGTHS_PATH "/config_board%u.csv"
+
 // Board configuration loaded from SD card
 typedef struct {
     bool loaded;                  // True if config was successfully loaded
-    uint8_t board_id;             // This board's ID (from ADC)
+    uint8_t board_id;             // This board's ID
+    bool board_id_from_config;    // Set by a board_id line (else the address ladder)
     uint8_t string_count;         // Highest configured string index + 1
     uint16_t max_pixel_count;     // Maximum pixels across all strings
+    uint32_t start_channel;       // First channel of this board when all boards share one
+                                  // channel space (sum of earlier boards' pixels x 3)
+    uint32_t power_budget_ma;     // Whole-board current budget (0 = unlimited)
+    uint16_t channel_ma;          // Draw of one LED channel at full value
     string_config_t strings[BOARD_CONFIG_MAX_STRINGS];
 } board_config_t;
 
@@ -33,6 +42,8 @@ typedef struct {
 // Result of loading from SD
 typedef struct {
     bool success;
+    bool changed;                 // g_board_config was replaced
+    uint32_t config_hash;         // Hash of config.csv (0 if it couldn't be read)
     const char* error_msg;        // Error description (NULL if success)
 } board_config_load_result_t;
 
@@ -46,12 +57,21 @@ extern board_config_t g_board_config;
 // Parse color order string (e.g., "GRB", "RGB") to enum
 pb_color_order_t board_config_parse_color_order(const char* str);
 
+// Name of a color order as written in config.csv ("GRB" etc.)
+const char* board_config_color_order_name(pb_color_order_t order);
+
 // Parse a single CSV line: "pixel_count,color_order"
 // Returns true if valid, false if empty/comment/invalid
 bool board_config_parse_line(const char* line, uint16_t* pixel_count, pb_color_order_t* color_order);
 
 // Parse entire config buffer for a specific board
 // board_id determines which 32-row section to read (0=rows 0-31, 1=rows 32-63, etc.)
+// String rows take an optional third column, a current budget in mA:
+// "pixel_count,color_order,max_ma". Keyword lines don't count as rows:
+//   power,<board_id>,<max_ma>   Current budget for the whole board
+//   channel_ma,<ma>             Draw of one channel at full value (default 20)
+//   board_id,<id>               This board's ID, in place of the board_id passed
+//                               in (the address ladder reading)
 board_config_parse_result_t board_config_parse_buffer(
     const char* buffer,
     size_t buffer_len,
@@ -59,9 +79,26 @@ board_config_parse_result_t board_config_parse_buffer(
     board_config_t* config
 );
 
+// Find a board_id keyword line. Returns false if there is none (or it's
+// out of range).
+bool board_config_parse_board_id(const char* buffer, size_t buffer_len, uint8_t* board_id);
+
+// Hash of a config.csv buffer (FNV-1a), used to key the cached snapshot
+uint32_t board_config_hash(const char* buffer, size_t buffer_len);
+
+// Format one board's section of config.csv: a comment header, then one
+// "pixel_count,color_order[,max_ma]" row per string. Pixel counts come from
+// lengths (BOARD_CONFIG_MAX_STRINGS entries), color orders and budgets from
+// config. Returns the length written, 0 if out_size is too small.
+size_t board_config_format_csv(const board_config_t* config, const uint16_t* lengths,
+                               char* out, size_t out_size);
+
 // Set default configuration (all 32 strings, 50 pixels, GRB)
 void board_config_set_defaults(uint8_t board_id);
 
+// Fill LED driver current budgets from a parsed config
+void board_config_power(const board_config_t* config, pb_power_config_t* power);
+
 // Get color order for a specific string
 // Returns GRB if string not configured
 pb_color_order_t board_config_get_color_order(uint8_t string);
@@ -80,4 +117,13 @@ uint16_t board_config_get_pixel_count(uint8_t string);
 // Returns result with error message if failed
 board_config_load_result_t board_config_load_from_sd(uint8_t board_id);
 
+// Re-read config.csv from an already-mounted card. g_board_config is only
+// replaced if the file's hash differs from known_hash and it parses cleanly.
+board_config_load_result_t board_config_reload_if_changed(uint8_t board_id,
+                                                          uint32_t known_hash);
+
+// Write discovered string lengths for this board to BOARD_CONFIG_LENGTHS_PATH
+// (see board_config_format_csv). Returns an error message, NULL on success.
+const char* board_config_save_lengths(const uint16_t* lengths);
+
 #endif
@@ -0,0 +1,29 @@
+#include "boot_timing.h"
+#include "pico/time.h"
+#include <stdio.h>
+
+typedef struct {
+    const char* phase;
+    uint32_t time_us;         // Since power-on
+} boot_timing_mark_t;
+
+static boot_timing_mark_t g_marks[BOOT_TIMING_MAX_PHASES];
+static uint8_t g_mark_count = 0;
+
+void boot_timing_mark(const char* phase) {
+    if (g_mark_count >= BOOT_TIMING_MAX_PHASES) return;
+    g_marks[g_mark_count].phase = phase;
+    g_marks[g_mark_count].time_us = time_us_32();
+    g_mark_count++;
+}
+
+void boot_timing_print(void) {
+    printf("Boot timing:\n");
+    uint32_t prev = 0;
+    for (uint8_t i = 0; i < g_mark_count; i++) {
+        printf("  %-12s %6lu us (+%lu)\n", g_marks[i].phase,
+               (unsigned long)g_marks[i].time_us,
+               (unsigned long)(g_marks[i].time_us - prev));
+        prev = g_marks[i].time_us;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+// Boot phase timestamps.
+//
+// main() marks each phase as it completes. USB stdio usually isn't
+// connected yet during boot, so the marks are kept and printed later.
+
+#define BOOT_TIMING_MAX_PHASES 16
+
+// Record that a phase finished now (phase must be a string literal)
+void boot_timing_mark(const char* phase);
+
+// Print all recorded phases with absolute and delta times
+void boot_timing_print(void);
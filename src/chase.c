@@ -0,0 +1,93 @@
+#include "chase.h"
+#include <string.h>
+
+void chase_init(chase_t* c) {
+    memset(c, 0, sizeof(*c));
+}
+
+static int64_t abs64(int64_t v) {
+    return v < 0 ? -v : v;
+}
+
+void chase_sample(chase_t* c, uint32_t master_ms, uint64_t local_us) {
+    int64_t offset = (int64_t)master_ms * 1000 - (int64_t)local_us;
+
+    if (!c->locked) {
+        c->locked = true;
+        c->offset_us = offset;
+        c->suspect_count = 0;
+        c->last_sample_us = local_us;
+        c->stats.samples++;
+        return;
+    }
+
+    if (abs64(offset - c->offset_us) > CHASE_OUTLIER_US) {
+        // Either jitter or the master jumped; a jump repeats, jitter doesn't
+        if (c->suspect_count > 0 && abs64(offset - c->suspect_us) <= CHASE_OUTLIER_US) {
+            c->suspect_count++;
+        } else {
+            c->suspect_count = 1;
+        }
+        c->suspect_us = offset;
+
+        if (c->suspect_count >= CHASE_RELOCK_SAMPLES) {
+            c->offset_us = offset;
+            c->suspect_count = 0;
+            c->last_sample_us = local_us;
+            c->stats.relocks++;
+            c->stats.samples++;
+        } else {
+            c->stats.outliers++;
+        }
+        return;
+    }
+
+    c->suspect_count = 0;
+    c->offset_us += (offset - c->offset_us) / (1 << CHASE_FILTER_SHIFT);
+    c->last_sample_us = local_us;
+    c->stats.samples++;
+}
+
+bool chase_active(const chase_t* c, uint64_t now_us) {
+    return c->locked && now_us - c->last_sample_us < CHASE_TIMEOUT_US;
+}
+
+void chase_frame(chase_t* c, uint64_t now_us, uint32_t frame, uint32_t frame_count,
+                 uint32_t step_us, chase_output_t* out) {
+    out->seek = false;
+    out->seek_frame = 0;
+    out->interval_us = step_us;
+    if (!chase_active(c, now_us) || frame_count == 0 || step_us == 0) return;
+
+    // Where the master is now, wrapped into the show
+    int64_t length_us = (int64_t)frame_count * step_us;
+    int64_t master_us = ((int64_t)now_us + c->offset_us) % length_us;
+    if (master_us < 0) master_us += length_us;
+
+    // Shortest signed distance around the loop
+    int64_t error = master_us - (int64_t)frame * step_us;
+    if (error > length_us / 2) error -= length_us;
+    if (error < -length_us / 2) error += length_us;
+
+    c->stats.offset_us = (int32_t)error;
+    uint32_t abs_error = (uint32_t)abs64(error);
+    if (abs_error > c->stats.max_abs_offset_us) c->stats.max_abs_offset_us = abs_error;
+
+    if (abs_error >= (uint32_t)CHASE_SEEK_FRAMES * step_us) {
+        // Next frame goes out one step from now - show where the master will be
+        out->seek = true;
+        out->seek_frame = (uint32_t)(((master_us + step_us) / step_us) % frame_count);
+        c->stats.seeks++;
+        c->stats.max_abs_offset_us = 0;
+        return;
+    }
+
+    int64_t adjust = error / CHASE_SLEW_DIVISOR;
+    int64_t limit = (int64_t)step_us * CHASE_MAX_SLEW_PCT / 100;
+    if (adjust > limit) adjust = limit;
+    if (adjust < -limit) adjust = -limit;
+    if (adjust != 0) {
+        out->interval_us = (uint32_t)((int64_t)step_us - adjust);
+        c->stats.slews++;
+    }
+}
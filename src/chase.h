@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Timecode chase: slave FSEQ playback to an external clock.
+//
+// The master sends its position (ms into the show) now and then; each
+// sample is stamped with local arrival time. The controller tracks the
+// offset between the master clock and the local microsecond clock, and on
+// every frame compares where the master is now with the frame being shown:
+//
+//   |error| >= CHASE_SEEK_FRAMES frames   jump straight to the master frame
+//   otherwise                             slew: shorten/lengthen the next
+//                                         frame interval (bounded) to close
+//                                         the gap over a few frames
+//
+// Transport jitter is filtered by smoothing the offset; a sample far off the
+// filtered value is treated as an outlier unless several in a row agree
+// (the master really jumped), in which case the filter relocks.
+// Without samples for CHASE_TIMEOUT_US playback free-runs at the show rate.
+//
+// Times are passed in, so the loop runs on the host against a simulated
+// clock.
+
+#define CHASE_SEEK_FRAMES       2        // Error that triggers a seek instead of a slew
+#define CHASE_SLEW_DIVISOR      4        // Correct 1/4 of the error per frame...
+#define CHASE_MAX_SLEW_PCT      10       // ...changing a frame interval by at most 10%
+#define CHASE_FILTER_SHIFT      3        // Offset smoothing: 1/8 of each new sample
+#define CHASE_OUTLIER_US        20000    // Sample this far off the filter is suspect
+#define CHASE_RELOCK_SAMPLES    3        // Consecutive outliers that mean a real jump
+#define CHASE_TIMEOUT_US        2000000  // Free-run after this long without samples
+
+typedef struct {
+    uint32_t samples;         // Timecode samples accepted
+    uint32_t outliers;        // Samples rejected by the jitter filter
+    uint32_t relocks;         // Filter reset to a jumped master
+    uint32_t seeks;           // Corrections by seeking
+    uint32_t slews;           // Frames shown at an adjusted interval
+    int32_t offset_us;        // Last error (master - playback), + = playback behind
+    uint32_t max_abs_offset_us;  // Largest error since the last seek
+} chase_stats_t;
+
+typedef struct {
+    bool locked;              // Have a filtered offset
+    int64_t offset_us;        // Filtered master time - local time
+    int64_t suspect_us;       // Offset of the outlier run being considered
+    uint8_t suspect_count;
+    uint64_t last_sample_us;  // Local time of the last accepted sample
+    chase_stats_t stats;
+} chase_t;
+
+typedef struct {
+    bool seek;                // Jump to seek_frame before the next frame
+    uint32_t seek_frame;
+    uint32_t interval_us;     // Interval before showing the next frame
+} chase_output_t;
+
+void chase_init(chase_t* c);
+
+// Feed a master timestamp (ms into the show) received at local_us.
+void chase_sample(chase_t* c, uint32_t master_ms, uint64_t local_us);
+
+// True while samples are arriving
+bool chase_active(const chase_t* c, uint64_t now_us);
+
+// Call just after frame (of frame_count, step_us apart) went out at now_us.
+// Fills in what to do before the next frame.
+void chase_frame(chase_t* c, uint64_t now_us, uint32_t frame, uint32_t frame_count,
+                 uint32_t step_us, chase_output_t* out);
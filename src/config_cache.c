@@ -0,0 +1,91 @@
+#include "config_cache.h"
+#include "board_config.h"
+#include "flash_io.h"
+#include "flash_layout.h"
+#include "hardware/flash.h"
+#include <stddef.h>
+#include <string.h>
+
+#define CONFIG_CACHE_ADDR    (XIP_BASE + FLASH_LAYOUT_CONFIG_CACHE_OFFSET)
+#define CONFIG_CACHE_MAGIC   0x43434250  // "PBCC"
+#define CONFIG_CACHE_VERSION 3
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t config_size;     // sizeof(board_config_t) when written
+    uint32_t config_hash;     // Hash of the config.csv this was parsed from
+    board_config_t config;
+    uint32_t crc;             // CRC32 of fields above
+} config_cache_record_t;
+
+// Whole pages, padded with 0xFF
+#define CONFIG_CACHE_PROGRAM_SIZE \
+    (((sizeof(config_cache_record_t) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE) * FLASH_PAGE_SIZE)
+
+_Static_assert(CONFIG_CACHE_PROGRAM_SIZE <= FLASH_SECTOR_SIZE,
+               "Config snapshot must fit in one sector");
+
+// Program buffer - static to keep it off the stack
+static uint8_t g_program_buf[CONFIG_CACHE_PROGRAM_SIZE];
+
+// Simple CRC32 (polynomial 0xEDB88320)
+static uint32_t crc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t record_crc(const config_cache_record_t* record) {
+    return crc32((const uint8_t*)record, offsetof(config_cache_record_t, crc));
+}
+
+static bool record_valid(const config_cache_record_t* record) {
+    return record->magic == CONFIG_CACHE_MAGIC &&
+           record->version == CONFIG_CACHE_VERSION &&
+           record->config_size == sizeof(board_config_t) &&
+           record->crc == record_crc(record);
+}
+
+bool config_cache_load(uint8_t board_id, uint32_t* config_hash) {
+    const config_cache_record_t* record = (const config_cache_record_t*)CONFIG_CACHE_ADDR;
+
+    if (!record_valid(record)) return false;
+    if (!record->config.loaded) return false;
+    // An ID set in config.csv holds whatever the address ladder reads
+    if (!record->config.board_id_from_config && record->config.board_id != board_id) return false;
+
+    memcpy(&g_board_config, &record->config, sizeof(board_config_t));
+    if (config_hash) *config_hash = record->config_hash;
+    return true;
+}
+
+bool config_cache_save(uint32_t config_hash) {
+    config_cache_record_t* record = (config_cache_record_t*)g_program_buf;
+
+    memset(g_program_buf, 0xFF, sizeof(g_program_buf));
+    memset(record, 0, sizeof(*record));
+    record->magic = CONFIG_CACHE_MAGIC;
+    record->version = CONFIG_CACHE_VERSION;
+    record->config_size = sizeof(board_config_t);
+    record->config_hash = config_hash;
+    memcpy(&record->config, &g_board_config, sizeof(board_config_t));
+    record->crc = record_crc(record);
+
+    // Nothing to do if flash already holds this snapshot
+    if (memcmp((const void*)CONFIG_CACHE_ADDR, record, sizeof(*record)) == 0) {
+        return true;
+    }
+
+    if (!flash_io_erase(FLASH_LAYOUT_CONFIG_CACHE_OFFSET, FLASH_SECTOR_SIZE)) return false;
+    if (!flash_io_program(FLASH_LAYOUT_CONFIG_CACHE_OFFSET, g_program_buf,
+                          sizeof(g_program_buf))) {
+        return false;
+    }
+    return memcmp((const void*)CONFIG_CACHE_ADDR, record, sizeof(*record)) == 0;
+}
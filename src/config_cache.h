@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Compiled board config snapshot in flash.
+//
+// Parsing config.csv means mounting the SD card at boot. Instead the parsed
+// board_config_t is kept in one flash sector together with the hash of the
+// config.csv it came from, so boot can start from the snapshot and check the
+// card later (board_config_reload_if_changed) once it is mounted anyway.
+
+// Copy a valid snapshot for board_id (the address ladder reading) into
+// g_board_config. A snapshot whose ID came from config.csv matches any
+// board_id. Returns false (g_board_config untouched) if there is none.
+bool config_cache_load(uint8_t board_id, uint32_t* config_hash);
+
+// Store g_board_config, keyed by the hash of its config.csv. Skips the
+// write if the stored snapshot is already identical.
+bool config_cache_save(uint32_t config_hash);
@@ -5,6 +5,12 @@
 #include "hardware/sync.h"
 #include "fseq_player.h"
 #include "rainbow_test.h"
+#include "usb_stream.h"
+#include "effects_player.h"
+#include "flash_cache.h"
+#include "flash_io.h"
+#include "perf.h"
+#include "trace.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -21,9 +27,40 @@ static volatile bool cmd_pending = false;
 // Context pointers (set during init)
 static fseq_player_t* g_fseq_ctx = NULL;
 static rainbow_test_t* g_rainbow_ctx = NULL;
+static usb_stream_t* g_stream_ctx = NULL;
+static flash_cache_t* g_flash_cache_ctx = NULL;
+static effects_player_t* g_effects_ctx = NULL;
 
-// Filename buffer for FSEQ playback (written by Core 0 before sending command)
+// Filename buffer for FSEQ playback / flash install (written by Core 0 before sending command)
 static char g_filename[32];
+static uint32_t g_start_frame = 0;
+
+// Effect to start with (written by Core 0 before sending command)
+static uint8_t g_start_effect = 0;
+
+// Show to play after the current one (written by Core 0 at any time).
+// g_next_seq is odd while Core 0 is writing; 0 means nothing queued yet.
+static char g_next_filename[32];
+static volatile uint32_t g_next_seq = 0;
+
+// Queue entry Core 1 switched to on its own (0 = playing g_filename)
+static volatile uint32_t g_playing_seq = 0;
+
+// Set while Core 0 swaps one show for another, so the LEDs aren't blanked
+static volatile bool fseq_switching = false;
+
+// Timecode samples for chase mode (single producer Core 0, consumer Core 1)
+#define CHASE_RING_SIZE 8
+static struct {
+    uint32_t master_ms;
+    uint64_t local_us;
+} g_chase_ring[CHASE_RING_SIZE];
+static volatile uint32_t g_chase_head = 0;  // Written by Core 0
+static volatile uint32_t g_chase_tail = 0;  // Written by Core 1
+static volatile bool g_chase_enabled = false;
+
+// Blend extra frames between sequence frames (set by Core 0)
+static volatile bool g_interp_enabled = false;
 
 // --- Internal: Check if stop requested (non-blocking) ---
 static bool check_stop_requested(void) {
@@ -41,11 +78,28 @@ static bool check_stop_requested(void) {
     return false;
 }
 
+// --- Internal: Next show for gapless playback (seqlock read) ---
+static uint32_t next_fseq_file(char* filename, size_t len) {
+    uint32_t seq;
+    do {
+        seq = g_next_seq;
+        __dmb();
+        strncpy(filename, g_next_filename, len - 1);
+        filename[len - 1] = '\0';
+        __dmb();
+    } while ((seq & 1) || seq != g_next_seq);
+
+    if (seq == 0 || filename[0] == '\0') return 0;
+    return seq;
+}
+
 // --- Internal: FSEQ playback task ---
 static bool run_fseq_task(void) {
     fseq_player_t* ctx = g_fseq_ctx;
     if (!ctx) return false;
 
+    g_playing_seq = 0;
+
     // Start playback (opens file, creates driver, parses header)
     if (!fseq_player_start(ctx, g_filename)) {
         printf("Core1: Failed to start FSEQ\n");
@@ -53,12 +107,18 @@ static bool run_fseq_task(void) {
     }
 
     printf("Core1: FSEQ task starting: %s\n", g_filename);
+    if (g_start_frame > 0) {
+        printf("Core1: Resuming at frame %lu\n", (unsigned long)g_start_frame);
+        fseq_player_request_seek(ctx, g_start_frame);
+    }
 
     // Run the playback loop until stop is requested
-    fseq_player_run_loop(ctx, check_stop_requested);
+    fseq_player_run_loop(ctx, check_stop_requested, next_fseq_file);
 
-    // Clean up (close file, destroy driver)
-    fseq_player_cleanup(ctx);
+    // Clean up (close file, keep driver); hold the last frame if another show follows
+    __dmb();
+    fseq_player_cleanup(ctx, !fseq_switching);
+    g_playing_seq = 0;
 
     printf("Core1: FSEQ task ended\n");
     return true;
@@ -77,6 +137,10 @@ static bool run_rainbow_task(void) {
     // Run frames until stopped
     while (!check_stop_requested()) {
         rainbow_test_task(ctx);
+        if (flash_io_pending()) {
+            pb_show_wait(ctx->driver);  // Flash writes go after the frame is out
+            flash_io_service();
+        }
     }
 
     // Clean up
@@ -86,11 +150,73 @@ static bool run_rainbow_task(void) {
     return true;
 }
 
+// --- Internal: USB streaming loop (runs until stop) ---
+static bool run_stream_task(void) {
+    usb_stream_t* ctx = g_stream_ctx;
+    if (!ctx) return false;
+
+    if (!usb_stream_start(ctx)) {
+        printf("Core1: Failed to start USB stream\n");
+        return false;
+    }
+
+    printf("Core1: USB stream task starting\n");
+
+    usb_stream_run_loop(ctx, check_stop_requested);
+
+    // Clean up (clears LEDs, destroys driver)
+    usb_stream_stop(ctx);
+
+    printf("Core1: USB stream task ended\n");
+    return true;
+}
+
+// --- Internal: Procedural effects loop (runs until stop) ---
+static bool run_effects_task(void) {
+    effects_player_t* ctx = g_effects_ctx;
+    if (!ctx) return false;
+
+    if (!effects_player_start(ctx, g_start_effect)) {
+        printf("Core1: Failed to start effects\n");
+        return false;
+    }
+
+    printf("Core1: Effects task starting\n");
+
+    effects_player_run_loop(ctx, check_stop_requested);
+
+    // Clean up (clears LEDs, destroys driver)
+    effects_player_stop(ctx);
+
+    printf("Core1: Effects task ended\n");
+    return true;
+}
+
+// --- Internal: Flash cache install (runs until done or stopped) ---
+static bool run_flash_install_task(void) {
+    flash_cache_t* ctx = g_flash_cache_ctx;
+    if (!ctx) return false;
+
+    printf("Core1: Flash install starting: %s\n", g_filename);
+
+    // Blocks until the file is copied, fails, or stop is requested
+    bool ok = flash_cache_install(ctx, g_filename, check_stop_requested);
+
+    printf("Core1: Flash install ended\n");
+    return ok;
+}
+
 // --- Core 1 main loop ---
 void core1_main(void) {
     // Allow Core 0 to pause us for flash operations
     flash_safe_execute_core_init();
 
+    // Core 0 flash writes are now carried out here, between frames
+    flash_io_enable_service();
+
+    // Playback telemetry uses this core's own cycle counter
+    perf_counter_init();
+
     // Ensure clean state before processing commands
     // (static initializers may not be visible to Core 1 immediately)
     pending_cmd = CORE1_CMD_IDLE;
@@ -103,10 +229,13 @@ void core1_main(void) {
     printf("Core1: Started, waiting for commands\n");
 
     while (true) {
-        // Poll for command from Core 0 via shared memory
+        // Wait for a command from Core 0 via shared memory. Core 0 sends an
+        // event (SEV) with every command and flash request, so sleep until one.
         __dmb();
         if (!cmd_pending) {
-            tight_loop_contents();
+            if (!flash_io_service()) {
+                __wfe();
+            }
             continue;
         }
 
@@ -137,7 +266,6 @@ void core1_main(void) {
 
             case CORE1_CMD_PLAY_FSEQ:
                 current_task = CORE1_TASK_FSEQ;
-                fseq_loop_count = 0;
                 run_fseq_task();
                 previous_task = CORE1_TASK_FSEQ;  // Remember we were playing FSEQ
                 current_task = CORE1_TASK_IDLE;
@@ -150,6 +278,27 @@ void core1_main(void) {
                 current_task = CORE1_TASK_IDLE;
                 break;
 
+            case CORE1_CMD_PLAY_STREAM:
+                current_task = CORE1_TASK_STREAM;
+                run_stream_task();
+                previous_task = CORE1_TASK_STREAM;
+                current_task = CORE1_TASK_IDLE;
+                break;
+
+            case CORE1_CMD_INSTALL_FLASH:
+                current_task = CORE1_TASK_FLASH_INSTALL;
+                run_flash_install_task();
+                previous_task = CORE1_TASK_FLASH_INSTALL;
+                current_task = CORE1_TASK_IDLE;
+                break;
+
+            case CORE1_CMD_PLAY_EFFECTS:
+                current_task = CORE1_TASK_EFFECTS;
+                run_effects_task();
+                previous_task = CORE1_TASK_EFFECTS;
+                current_task = CORE1_TASK_IDLE;
+                break;
+
             default:
                 printf("Core1: Unknown command %u\n", cmd);
                 break;
@@ -157,14 +306,20 @@ void core1_main(void) {
 
         // Signal that we're now idle (Core 0 might be waiting)
         __dmb();
+        __sev();
     }
 }
 
 // --- API for Core 0 ---
 
-void core1_task_init(fseq_player_t* fseq_ctx, rainbow_test_t* rainbow_ctx) {
+void core1_task_init(fseq_player_t* fseq_ctx, rainbow_test_t* rainbow_ctx,
+                     usb_stream_t* stream_ctx, flash_cache_t* flash_cache_ctx,
+                     effects_player_t* effects_ctx) {
     g_fseq_ctx = fseq_ctx;
     g_rainbow_ctx = rainbow_ctx;
+    g_stream_ctx = stream_ctx;
+    g_flash_cache_ctx = flash_cache_ctx;
+    g_effects_ctx = effects_ctx;
     current_task = CORE1_TASK_IDLE;
     previous_task = CORE1_TASK_IDLE;
     stop_requested = false;
@@ -172,30 +327,43 @@ void core1_task_init(fseq_player_t* fseq_ctx, rainbow_test_t* rainbow_ctx) {
 }
 
 void core1_stop_and_wait(void) {
+    trace_begin(TRACE_CORE1_STOP);
+
     // Signal stop via shared variable
     stop_requested = true;
     __dmb();
 
-    // Wait for Core 1 to become idle
+    // Wait for Core 1 to become idle (it sends an event when it does)
     while (current_task != CORE1_TASK_IDLE) {
-        tight_loop_contents();
+        __wfe();
         __dmb();
     }
+
+    trace_end(TRACE_CORE1_STOP);
 }
 
 void core1_start_fseq(const char* filename) {
-    // Stop any current task first
+    core1_start_fseq_at(filename, 0);
+}
+
+void core1_start_fseq_at(const char* filename, uint32_t frame) {
+    // Stop any current task first (an FSEQ task keeps its last frame up)
+    fseq_switching = true;
+    __dmb();
     core1_stop_and_wait();
+    fseq_switching = false;
 
     // Copy filename to shared buffer
     strncpy(g_filename, filename, sizeof(g_filename) - 1);
     g_filename[sizeof(g_filename) - 1] = '\0';
+    g_start_frame = frame;
 
     // Send command via shared memory
     pending_cmd = CORE1_CMD_PLAY_FSEQ;
     __dmb();
     cmd_pending = true;
     __dmb();
+    __sev();  // Wake Core 1 if idle
 }
 
 void core1_start_rainbow(void) {
@@ -207,6 +375,59 @@ void core1_start_rainbow(void) {
     __dmb();
     cmd_pending = true;
     __dmb();
+    __sev();  // Wake Core 1 if idle
+}
+
+void core1_start_stream(void) {
+    // Stop any current task first
+    core1_stop_and_wait();
+
+    // Send command via shared memory
+    pending_cmd = CORE1_CMD_PLAY_STREAM;
+    __dmb();
+    cmd_pending = true;
+    __dmb();
+    __sev();  // Wake Core 1 if idle
+}
+
+void core1_start_effects(uint8_t effect) {
+    // Stop any current task first
+    core1_stop_and_wait();
+
+    g_start_effect = effect;
+
+    // Send command via shared memory
+    pending_cmd = CORE1_CMD_PLAY_EFFECTS;
+    __dmb();
+    cmd_pending = true;
+    __dmb();
+    __sev();  // Wake Core 1 if idle
+}
+
+void core1_set_effect(uint8_t effect) {
+    if (g_effects_ctx) effects_player_set_effect(g_effects_ctx, effect);
+    __dmb();
+}
+
+void core1_start_flash_install(const char* filename) {
+    // Stop any current task first
+    core1_stop_and_wait();
+
+    // Copy filename to shared buffer
+    strncpy(g_filename, filename, sizeof(g_filename) - 1);
+    g_filename[sizeof(g_filename) - 1] = '\0';
+
+    if (g_flash_cache_ctx) {
+        g_flash_cache_ctx->progress = 0;
+        g_flash_cache_ctx->status = FLASH_CACHE_INSTALLING;
+    }
+
+    // Send command via shared memory
+    pending_cmd = CORE1_CMD_INSTALL_FLASH;
+    __dmb();
+    cmd_pending = true;
+    __dmb();
+    __sev();  // Wake Core 1 if idle
 }
 
 core1_task_t core1_get_current_task(void) {
@@ -224,8 +445,98 @@ uint32_t core1_get_fseq_loop_count(void) {
     return fseq_loop_count;
 }
 
+// Called by fseq_player when it moves on to a queued show (before the loop notify)
+void core1_notify_fseq_switch(uint32_t seq) {
+    g_playing_seq = seq;
+    __dmb();
+}
+
 // Called by fseq_player when a loop completes
 void core1_notify_fseq_loop(void) {
     fseq_loop_count++;
     __dmb();
+    __sev();  // Wake Core 0 to auto-advance
+}
+
+void core1_set_next_fseq(const char* filename) {
+    uint32_t seq = g_next_seq;
+    g_next_seq = seq + 1;  // Odd: write in progress
+    __dmb();
+    if (filename) {
+        strncpy(g_next_filename, filename, sizeof(g_next_filename) - 1);
+        g_next_filename[sizeof(g_next_filename) - 1] = '\0';
+    } else {
+        g_next_filename[0] = '\0';
+    }
+    __dmb();
+    g_next_seq = seq + 2;
+    __dmb();
+}
+
+bool core1_fseq_is_playing(const char* filename) {
+    __dmb();
+    uint32_t playing = g_playing_seq;
+    return filename && current_task == CORE1_TASK_FSEQ &&
+           playing != 0 && playing == g_next_seq &&
+           strcmp(g_next_filename, filename) == 0;
+}
+
+void core1_seek_fseq(uint32_t frame) {
+    if (g_fseq_ctx) fseq_player_request_seek(g_fseq_ctx, frame);
+}
+
+void core1_seek_fseq_ms(uint32_t ms) {
+    if (g_fseq_ctx) fseq_player_request_seek_ms(g_fseq_ctx, ms);
+}
+
+uint32_t core1_get_fseq_frame(void) {
+    __dmb();
+    return fseq_player_get_frame(g_fseq_ctx);
+}
+
+void core1_chase_sample(uint32_t master_ms, uint64_t local_us) {
+    uint32_t head = g_chase_head;
+    if (head - g_chase_tail >= CHASE_RING_SIZE) return;  // Full - drop the sample
+
+    g_chase_ring[head % CHASE_RING_SIZE].master_ms = master_ms;
+    g_chase_ring[head % CHASE_RING_SIZE].local_us = local_us;
+    __dmb();
+    g_chase_head = head + 1;
+    g_chase_enabled = true;
+    __dmb();
+}
+
+void core1_chase_off(void) {
+    g_chase_enabled = false;
+    __dmb();
+}
+
+// Called by fseq_player once per frame
+bool core1_chase_enabled(void) {
+    __dmb();
+    return g_chase_enabled;
+}
+
+void core1_set_interpolation(bool enabled) {
+    g_interp_enabled = enabled;
+    __dmb();
+}
+
+// Called by fseq_player once per frame
+bool core1_interpolation_enabled(void) {
+    __dmb();
+    return g_interp_enabled;
+}
+
+// Called by fseq_player to drain samples
+bool core1_take_chase_sample(uint32_t* master_ms, uint64_t* local_us) {
+    uint32_t tail = g_chase_tail;
+    __dmb();
+    if (tail == g_chase_head) return false;
+
+    *master_ms = g_chase_ring[tail % CHASE_RING_SIZE].master_ms;
+    *local_us = g_chase_ring[tail % CHASE_RING_SIZE].local_us;
+    __dmb();
+    g_chase_tail = tail + 1;
+    return true;
 }
@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include "fseq_player.h"
 #include "rainbow_test.h"
+#include "usb_stream.h"
+#include "effects_player.h"
+#include "flash_cache.h"
 
 // Command types sent from Core 0 to Core 1
 typedef enum {
@@ -11,6 +14,9 @@ typedef enum {
     CORE1_CMD_STOP,           // Stop current task, return to idle
     CORE1_CMD_PLAY_FSEQ,      // Start FSEQ playback
     CORE1_CMD_PLAY_RAINBOW,   // Start rainbow test
+    CORE1_CMD_PLAY_STREAM,    // Start USB live streaming
+    CORE1_CMD_INSTALL_FLASH,  // Copy an FSEQ file into the flash cache
+    CORE1_CMD_PLAY_EFFECTS,   // Start procedural effects
 } core1_cmd_type_t;
 
 // Current task running on Core 1 (readable from Core 0)
@@ -18,10 +24,15 @@ typedef enum {
     CORE1_TASK_IDLE = 0,
     CORE1_TASK_FSEQ,
     CORE1_TASK_RAINBOW,
+    CORE1_TASK_STREAM,
+    CORE1_TASK_FLASH_INSTALL,
+    CORE1_TASK_EFFECTS,
 } core1_task_t;
 
 // Initialize Core 1 task system (call once from main, before launching Core 1)
-void core1_task_init(fseq_player_t* fseq_ctx, rainbow_test_t* rainbow_ctx);
+void core1_task_init(fseq_player_t* fseq_ctx, rainbow_test_t* rainbow_ctx,
+                     usb_stream_t* stream_ctx, flash_cache_t* flash_cache_ctx,
+                     effects_player_t* effects_ctx);
 
 // Core 1 entry point - runs forever processing commands
 void core1_main(void);
@@ -36,9 +47,48 @@ void core1_stop_and_wait(void);
 // filename is copied internally - caller's string doesn't need to persist
 void core1_start_fseq(const char* filename);
 
+// Start FSEQ playback at a frame (resume after power loss)
+void core1_start_fseq_at(const char* filename, uint32_t frame);
+
+// Jump the playing show to a frame / time (console GF / GT). A chase in
+// progress pulls it back to the master.
+// Takes effect on the next frame boundary.
+void core1_seek_fseq(uint32_t frame);
+void core1_seek_fseq_ms(uint32_t ms);
+
+// Chase mode: feed an external timecode sample (ms into the show, stamped
+// with local receive time). The first sample turns chasing on.
+void core1_chase_sample(uint32_t master_ms, uint64_t local_us);
+
+// Stop chasing and free-run at the show's rate
+void core1_chase_off(void);
+
+// Output blended frames between sequence frames, up to the driver's rate.
+// Takes effect on the next frame.
+void core1_set_interpolation(bool enabled);
+
+// Queue the show to play after the current one (NULL = none). The player
+// opens it near the end of the current show and switches without a gap.
+// filename is copied internally.
+void core1_set_next_fseq(const char* filename);
+
 // Start rainbow test (stops any current task first)
 void core1_start_rainbow(void);
 
+// Start USB live streaming (stops any current task first)
+void core1_start_stream(void);
+
+// Start procedural effects (stops any current task first)
+void core1_start_effects(uint8_t effect);
+
+// Switch the running effect (takes effect on the next frame)
+void core1_set_effect(uint8_t effect);
+
+// Install a file into the flash cache (stops any current task first)
+// Marks the install as in progress before returning, so status polls never
+// see a stale result. filename is copied internally.
+void core1_start_flash_install(const char* filename);
+
 // --- Status (called from Core 0) ---
 
 // Get current task type
@@ -49,3 +99,9 @@ bool core1_is_idle(void);
 
 // Get FSEQ loop count (for auto-advance detection)
 uint32_t core1_get_fseq_loop_count(void);
+
+// True if Core 1 has already moved on to filename from the next-show queue
+bool core1_fseq_is_playing(const char* filename);
+
+// Frame the FSEQ player last output (saved for resume)
+uint32_t core1_get_fseq_frame(void);
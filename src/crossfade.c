@@ -0,0 +1,48 @@
+#include "crossfade.h"
+
+uint16_t crossfade_weight(uint32_t step, uint32_t steps) {
+    if (steps == 0) return CROSSFADE_WEIGHT_ONE;
+    if (step > steps) step = steps;
+    // steps + 1 intervals: the last one is the cut to the incoming show
+    return (uint16_t)((step * CROSSFADE_WEIGHT_ONE) / (steps + 1));
+}
+
+void crossfade_blend(uint8_t* dst, const uint8_t* src, uint32_t len, uint16_t weight) {
+    if (weight == 0) return;
+    uint32_t inv = CROSSFADE_WEIGHT_ONE - weight;
+    for (uint32_t i = 0; i < len; i++) {
+        dst[i] = (uint8_t)((dst[i] * inv + src[i] * weight + 128) >> 8);
+    }
+}
+
+crossfade_check_t crossfade_check(const crossfade_budget_t* b) {
+    if (b->frame_bytes == 0 || b->frame_bytes > b->buffer_bytes) {
+        return CROSSFADE_NO_BUFFER;
+    }
+
+    if (b->frame_us > 0 && b->sd_bytes_per_frame > 0) {
+        uint64_t needed = (uint64_t)b->sd_bytes_per_frame * 1000000u / b->frame_us;
+        if (needed > b->sd_bytes_per_sec) return CROSSFADE_SD_BANDWIDTH;
+    }
+
+    // Incoming show costs about the same per channel as the current one;
+    // the copy and blend passes cost about one more decode of the frame
+    uint64_t next_us = b->current_channels
+        ? (uint64_t)b->decode_us * b->next_channels / b->current_channels
+        : b->decode_us;
+    uint64_t total_us = b->decode_us + next_us + b->decode_us / 2;
+    if (total_us * 100 > (uint64_t)b->frame_us * CROSSFADE_CPU_BUDGET_PCT) {
+        return CROSSFADE_CPU;
+    }
+    return CROSSFADE_OK;
+}
+
+const char* crossfade_check_name(crossfade_check_t result) {
+    switch (result) {
+        case CROSSFADE_OK:           return "ok";
+        case CROSSFADE_NO_BUFFER:    return "frame too large";
+        case CROSSFADE_SD_BANDWIDTH: return "SD bandwidth";
+        case CROSSFADE_CPU:          return "CPU budget";
+    }
+    return "?";
+}
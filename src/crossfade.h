@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Show-to-show crossfade.
+//
+// Both sequences are decoded into one RGB frame in board channel order: the
+// outgoing show is copied in, then the incoming show is mixed over it with a
+// Q8 weight (0 = all outgoing, 256 = all incoming). The weight ramps over
+// the fade so the incoming show owns the strings by the time the outgoing
+// one runs out.
+//
+// Decoding two shows per frame doubles the work, so the fade is planned up
+// front from the current show's measured frame cost, the SD read budget and
+// the size of the blend buffer; if any of them doesn't fit, playback falls
+// back to a hard cut on the frame boundary.
+
+#define CROSSFADE_WEIGHT_ONE     256
+#define CROSSFADE_CPU_BUDGET_PCT 80   // Share of the frame period decoding may use
+
+// Weight for fade step (1..steps): ramps from near 0 to near 256, never
+// reaching either end (the cut to the incoming show is the final step).
+uint16_t crossfade_weight(uint32_t step, uint32_t steps);
+
+// dst = dst + (src - dst) * weight / 256 for len bytes, rounded.
+void crossfade_blend(uint8_t* dst, const uint8_t* src, uint32_t len, uint16_t weight);
+
+typedef struct {
+    uint32_t frame_bytes;          // Blend frame size (board channels)
+    uint32_t buffer_bytes;         // Blend buffer capacity
+    uint32_t frame_us;             // Frame period during the fade
+    uint32_t decode_us;            // Measured per-frame cost of the current show
+    uint32_t current_channels;     // Channels per frame of the current show
+    uint32_t next_channels;        // ...and of the incoming one
+    uint32_t sd_bytes_per_frame;   // Bytes read from SD per frame, both shows
+    uint32_t sd_bytes_per_sec;     // Sustained SD read budget
+} crossfade_budget_t;
+
+typedef enum {
+    CROSSFADE_OK = 0,
+    CROSSFADE_NO_BUFFER,      // Frame doesn't fit the blend buffer
+    CROSSFADE_SD_BANDWIDTH,   // Both streams together read too fast
+    CROSSFADE_CPU,            // Two decodes + blend won't fit in a frame
+} crossfade_check_t;
+
+// Decide whether a fade with these numbers can hold the frame rate.
+// Incoming cost is estimated from decode_us scaled by channel count.
+crossfade_check_t crossfade_check(const crossfade_budget_t* budget);
+
+const char* crossfade_check_name(crossfade_check_t result);
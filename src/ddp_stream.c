@@ -0,0 +1,91 @@
+#include "ddp_stream.h"
+#include <string.h>
+
+// Read big-endian fields from the header
+static uint16_t be16(const uint8_t* p) {
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+// Check the header prefix collected so far.
+// Returns false if the bytes cannot be the start of a DDP header.
+static bool header_prefix_valid(const uint8_t* h, uint16_t len) {
+    if (len >= 1 && (h[0] & PP_DDP_FLAG_VER_MASK) != PP_DDP_FLAG_VER1) return false;
+    if (len >= 2 && (h[1] & 0xF0) != 0) return false;  // Sequence is 4 bits
+    if (len >= PP_DDP_HEADER_LEN && be16(&h[8]) > DDP_STREAM_MAX_DATA) return false;
+    return true;
+}
+
+void ddp_stream_init(ddp_stream_t* s) {
+    if (!s) return;
+    memset(s, 0, sizeof(*s));
+    s->header_need = PP_DDP_HEADER_LEN;
+}
+
+void ddp_stream_reset(ddp_stream_t* s) {
+    if (!s) return;
+    s->packet_len = 0;
+    s->packet_need = 0;
+    s->header_need = PP_DDP_HEADER_LEN;
+}
+
+uint32_t ddp_stream_push(ddp_stream_t* s, const uint8_t* data, uint32_t len,
+                         bool* packet_ready) {
+    if (packet_ready) *packet_ready = false;
+    if (!s || !data) return len;
+
+    // Previous packet was handed out - start collecting the next one
+    if (s->packet_need != 0 && s->packet_len == s->packet_need) {
+        ddp_stream_reset(s);
+    }
+
+    uint32_t i = 0;
+    while (i < len) {
+        // Payload bytes - copy as much as is available
+        if (s->packet_need != 0) {
+            uint32_t n = len - i;
+            if (n > (uint32_t)(s->packet_need - s->packet_len)) n = s->packet_need - s->packet_len;
+            memcpy(&s->packet[s->packet_len], &data[i], n);
+            s->packet_len += (uint16_t)n;
+            i += n;
+        } else {
+            // Header bytes
+            s->packet[s->packet_len++] = data[i++];
+
+            // Drop leading bytes until the collected prefix looks like a header
+            while (s->packet_len > 0 && !header_prefix_valid(s->packet, s->packet_len)) {
+                memmove(s->packet, s->packet + 1, s->packet_len - 1);
+                s->packet_len--;
+                s->stats.resyncs++;
+            }
+            if (s->packet_len >= 1) {
+                s->header_need = (s->packet[0] & PP_DDP_FLAG_TIME) ? PP_DDP_HEADER_LEN_TIME
+                                                                    : PP_DDP_HEADER_LEN;
+            }
+            if (s->packet_len == s->header_need) {
+                s->packet_need = (uint16_t)(s->header_need + be16(&s->packet[8]));
+            }
+        }
+
+        if (s->packet_need != 0 && s->packet_len == s->packet_need) {
+            s->stats.packets++;
+            if (packet_ready) *packet_ready = true;
+            break;
+        }
+    }
+    return i;
+}
+
+uint8_t ddp_stream_write_header(uint8_t* out, uint8_t seq, uint32_t offset,
+                                uint16_t len, bool push) {
+    out[0] = PP_DDP_FLAG_VER1 | (push ? PP_DDP_FLAG_PUSH : 0);
+    out[1] = seq & 0x0F;
+    out[2] = 0x01;             // Data type: RGB, 8 bits per channel
+    out[3] = PP_DDP_ID_DISPLAY;
+    out[4] = (uint8_t)(offset >> 24);
+    out[5] = (uint8_t)(offset >> 16);
+    out[6] = (uint8_t)(offset >> 8);
+    out[7] = (uint8_t)offset;
+    out[8] = (uint8_t)(len >> 8);
+    out[9] = (uint8_t)len;
+    return PP_DDP_HEADER_LEN;
+}
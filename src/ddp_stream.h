@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pixel_proto.h"
+
+// DDP (Distributed Display Protocol) framer for a byte stream.
+//
+// UDP delivers one DDP packet per datagram, but over USB CDC the packets
+// arrive as an unframed byte stream. This framer recovers whole packets using
+// the DDP header (length field) and resynchronises on garbage. Complete
+// packets are handed to pixel_proto for decoding and frame assembly, the same
+// path a network transport would use.
+
+// Header layout and flags are pixel_proto's (PP_DDP_*)
+#define DDP_STREAM_MAX_DATA PP_DDP_MAX_DATA  // Max payload per packet (matches UDP DDP)
+
+typedef struct {
+    uint32_t packets;        // Complete packets framed
+    uint32_t resyncs;        // Bytes discarded while hunting for a header
+} ddp_stream_stats_t;
+
+typedef struct {
+    // Packet being collected: header, optional timecode, payload
+    uint8_t packet[PP_DDP_HEADER_LEN_TIME + DDP_STREAM_MAX_DATA];
+    uint16_t packet_len;     // Bytes collected in packet[]
+    uint16_t packet_need;    // Total length once the header is known (0 = unknown)
+    uint8_t header_need;     // 10 or 14 once flags byte is known
+
+    ddp_stream_stats_t stats;
+} ddp_stream_t;
+
+// Initialize framer
+void ddp_stream_init(ddp_stream_t* s);
+
+// Drop any partial packet and wait for the next header
+void ddp_stream_reset(ddp_stream_t* s);
+
+// Push raw bytes from the transport.
+// Consumes bytes up to the end of the next complete packet, then stops and
+// sets *packet_ready; s->packet / s->packet_len hold the packet until the
+// next call. Returns the number of bytes consumed; call again with the rest.
+uint32_t ddp_stream_push(ddp_stream_t* s, const uint8_t* data, uint32_t len,
+                         bool* packet_ready);
+
+// Build a DDP header for a packet (used by tests and host tools).
+// Returns header length written (always PP_DDP_HEADER_LEN).
+uint8_t ddp_stream_write_header(uint8_t* out, uint8_t seq, uint32_t offset,
+                                uint16_t len, bool push);
@@ -0,0 +1,303 @@
+#include "effects.h"
+#include <math.h>
+#include <string.h>
+
+#define WIPE_MS          2000    // One wipe down every string
+#define WIPE_HUE_STEP    48      // Hue change between wipes
+#define CHASE_STEP_MS    50      // Chase moves one pixel
+#define CHASE_SPACING    4       // Every 4th pixel lit (power of two)
+#define TWINKLE_MAX_DT   100     // Longer gaps count as this (ms)
+#define FIRE_ZOOM        40      // Noise cells per pixel, 8.8 (a cell is ~6 pixels)
+#define NOISE_ZOOM       24
+
+static uint8_t g_sin8[256];
+static uint32_t g_hue[256];
+static uint32_t g_heat[256];
+static uint8_t g_ease[256];        // Smoothstep, for noise interpolation
+
+static const char* const names[EFFECT_COUNT] = {
+    "Color Wipe",
+    "Chase",
+    "Twinkle",
+    "Fire",
+    "Plasma",
+    "Noise",
+};
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+void effects_init_tables(void) {
+    for (int i = 0; i < 256; i++) {
+        g_sin8[i] = (uint8_t)lrintf(127.5f + 127.5f * sinf((float)i * 6.2831853f / 256.0f));
+
+        // Hue wheel in 6 segments of 43 steps
+        uint8_t seg = (uint8_t)(i / 43);
+        uint8_t f = (uint8_t)((i - seg * 43) * 6);
+        uint8_t r, g, b;
+        switch (seg) {
+            case 0:  r = 255;     g = f;       b = 0;       break;
+            case 1:  r = 255 - f; g = 255;     b = 0;       break;
+            case 2:  r = 0;       g = 255;     b = f;       break;
+            case 3:  r = 0;       g = 255 - f; b = 255;     break;
+            case 4:  r = f;       g = 0;       b = 255;     break;
+            default: r = 255;     g = 0;       b = 255 - f; break;
+        }
+        g_hue[i] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+
+        // Heat: red rises first, then green, then blue
+        uint32_t h = (uint32_t)i * 3;
+        if (i < 85) {
+            g_heat[i] = h << 16;
+        } else if (i < 170) {
+            g_heat[i] = 0xFF0000 | ((h - 255) << 8);
+        } else {
+            g_heat[i] = 0xFFFF00 | (h - 510);
+        }
+
+        // f * f * (3 - 2f), f in 0..1 as 0..255
+        g_ease[i] = (uint8_t)(((uint32_t)i * i * (768 - 2 * i)) >> 16);
+    }
+}
+
+uint8_t effects_sin8(uint8_t angle) {
+    return g_sin8[angle];
+}
+
+uint32_t effects_hue(uint8_t hue) {
+    return g_hue[hue];
+}
+
+uint32_t effects_heat(uint8_t heat) {
+    return g_heat[heat];
+}
+
+const char* effects_name(uint8_t effect) {
+    return effect < EFFECT_COUNT ? names[effect] : "?";
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline void put(uint8_t* p, uint32_t c) {
+    p[0] = (uint8_t)(c >> 16);
+    p[1] = (uint8_t)(c >> 8);
+    p[2] = (uint8_t)c;
+}
+
+static inline void put_scaled(uint8_t* p, uint32_t c, uint32_t scale) {
+    p[0] = (uint8_t)((((c >> 16) & 0xFF) * scale) >> 8);
+    p[1] = (uint8_t)((((c >> 8) & 0xFF) * scale) >> 8);
+    p[2] = (uint8_t)(((c & 0xFF) * scale) >> 8);
+}
+
+static inline uint32_t xorshift32(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static inline uint8_t hash8(uint32_t x, uint32_t seed) {
+    x = (x ^ seed) * 0x9E3779B1u;
+    x ^= x >> 15;
+    x *= 0x85EBCA77u;
+    return (uint8_t)(x >> 24);
+}
+
+// 1D value noise at x (8.8 fixed point): random values at whole cells,
+// eased in between
+static inline uint8_t noise8(uint32_t x, uint32_t seed) {
+    uint32_t cell = x >> 8;
+    int32_t a = hash8(cell, seed);
+    int32_t b = hash8(cell + 1, seed);
+    return (uint8_t)(a + (((b - a) * g_ease[x & 0xFF]) >> 8));
+}
+
+// noise8 sampled along a string. The two cell hashes are kept until x moves
+// into another cell, so a run of samples costs one hash per cell crossed
+// instead of two per sample.
+typedef struct {
+    uint32_t seed;
+    uint32_t cell;
+    int32_t a;                     // hash8(cell)
+    int32_t b;                     // hash8(cell + 1)
+} noise_walk_t;
+
+static inline void noise_walk_start(noise_walk_t* w, uint32_t x, uint32_t seed) {
+    w->seed = seed;
+    w->cell = x >> 8;
+    w->a = hash8(w->cell, seed);
+    w->b = hash8(w->cell + 1, seed);
+}
+
+// Same value as noise8(x, seed); cheapest when x only creeps forward
+static inline uint8_t noise_walk(noise_walk_t* w, uint32_t x) {
+    uint32_t cell = x >> 8;
+    if (cell != w->cell) {
+        w->a = cell == w->cell + 1 ? w->b : hash8(cell, w->seed);
+        w->b = hash8(cell + 1, w->seed);
+        w->cell = cell;
+    }
+    return (uint8_t)(w->a + (((w->b - w->a) * g_ease[x & 0xFF]) >> 8));
+}
+
+// ============================================================================
+// Effects
+// ============================================================================
+
+// Each wipe paints a new hue over the last one, start to end of every string
+static void render_color_wipe(const effects_t* fx, uint32_t t, uint8_t* frame) {
+    uint32_t cycle = t / WIPE_MS;
+    uint32_t front = ((t % WIPE_MS) << 8) / WIPE_MS;      // 0..255 along the string
+    uint32_t now = g_hue[(uint8_t)(cycle * WIPE_HUE_STEP)];
+    uint32_t before = g_hue[(uint8_t)((cycle - 1) * WIPE_HUE_STEP)];
+
+    for (uint8_t s = 0; s < fx->num_strings; s++) {
+        uint8_t* p = frame + fx->offsets[s];
+        uint16_t len = fx->lengths[s];
+        uint32_t edge = (len * front) >> 8;
+        for (uint32_t i = 0; i < len; i++, p += 3) {
+            put(p, i < edge ? now : before);
+        }
+    }
+}
+
+// Theater chase with the rainbow spread along the string
+static void render_chase(const effects_t* fx, uint32_t t, uint8_t* frame) {
+    uint32_t step = t / CHASE_STEP_MS;
+    uint8_t hue0 = (uint8_t)(t >> 4);
+
+    for (uint8_t s = 0; s < fx->num_strings; s++) {
+        uint8_t* p = frame + fx->offsets[s];
+        uint16_t len = fx->lengths[s];
+        for (uint32_t i = 0; i < len; i++, p += 3) {
+            if (((i - step) & (CHASE_SPACING - 1)) == 0) {
+                put(p, g_hue[(uint8_t)(hue0 + i * 2)]);
+            } else {
+                put(p, 0);
+            }
+        }
+    }
+}
+
+// Fade what's there, then light random pixels in random hues
+static void render_twinkle(effects_t* fx, uint32_t t, uint8_t* frame) {
+    uint32_t dt = t - fx->last_ms;
+    if (dt > TWINKLE_MAX_DT) dt = TWINKLE_MAX_DT;
+    fx->last_ms = t;
+
+    uint32_t scale = 256 - dt * 2;                 // ~12% per 60 fps frame
+    for (uint32_t i = 0; i < fx->frame_bytes; i++) {
+        frame[i] = (uint8_t)((frame[i] * scale) >> 8);
+    }
+
+    // About one pixel in 256 per 16 ms
+    uint32_t sparks = (fx->total_pixels * dt) >> 12;
+    for (uint32_t k = 0; k < sparks; k++) {
+        uint32_t r = xorshift32(&fx->rng);
+        uint8_t s = (uint8_t)(((r & 0xFFFF) * fx->num_strings) >> 16);
+        uint32_t i = ((r >> 16) * fx->lengths[s]) >> 16;
+        if (i < fx->lengths[s]) {
+            put(frame + fx->offsets[s] + i * 3, g_hue[(uint8_t)(xorshift32(&fx->rng) >> 24)]);
+        }
+    }
+}
+
+// Noise rising along each string, cooling toward the end
+static void render_fire(const effects_t* fx, uint32_t t, uint8_t* frame) {
+    uint32_t rise = t * 2;
+
+    for (uint8_t s = 0; s < fx->num_strings; s++) {
+        uint8_t* p = frame + fx->offsets[s];
+        uint16_t len = fx->lengths[s];
+        if (len == 0) continue;
+
+        uint32_t seed = (s + 1) * 0x51ED27u;
+        uint32_t flicker = 192 + (noise8(t / 4, seed ^ 0xF1A3u) >> 2);
+        uint32_t cool_step = (255u << 16) / len;   // 16.16 cooling per pixel
+        uint32_t cool = 0;
+        noise_walk_t heat_noise;
+        noise_walk_start(&heat_noise, -rise, seed);
+
+        for (uint32_t i = 0; i < len; i++, p += 3, cool += cool_step) {
+            uint32_t n = noise_walk(&heat_noise, i * FIRE_ZOOM - rise);
+            uint32_t heat = (n * (255 - (cool >> 16)) >> 8) * flicker >> 8;
+            put(p, g_heat[heat]);
+        }
+    }
+}
+
+// Three sine waves (along the string, across strings, diagonal) picking a hue
+static void render_plasma(const effects_t* fx, uint32_t t, uint8_t* frame) {
+    uint8_t t1 = (uint8_t)(t >> 3);
+    uint8_t t2 = (uint8_t)(t >> 4);
+    uint8_t t3 = (uint8_t)(t >> 5);
+    uint8_t shift = (uint8_t)(t >> 6);
+
+    for (uint8_t s = 0; s < fx->num_strings; s++) {
+        uint8_t* p = frame + fx->offsets[s];
+        uint16_t len = fx->lengths[s];
+        uint32_t across = g_sin8[(uint8_t)(s * 16 + t2)];
+        for (uint32_t i = 0; i < len; i++, p += 3) {
+            uint32_t v = g_sin8[(uint8_t)(i * 3 + t1)] + across +
+                         g_sin8[(uint8_t)((i + s * 8) * 2 - t3)];
+            put(p, g_hue[(uint8_t)(((v * 85) >> 8) + shift)]);  // v / 3
+        }
+    }
+}
+
+// Drifting value noise for hue and brightness
+static void render_noise(const effects_t* fx, uint32_t t, uint8_t* frame) {
+    uint8_t shift = (uint8_t)(t >> 6);
+
+    for (uint8_t s = 0; s < fx->num_strings; s++) {
+        uint8_t* p = frame + fx->offsets[s];
+        uint16_t len = fx->lengths[s];
+        uint32_t seed = (s + 1) * 0x2545F491u;
+        noise_walk_t hue_noise, level_noise;
+        noise_walk_start(&hue_noise, t, seed);
+        noise_walk_start(&level_noise, -(t / 2), seed ^ 0xB5297A4Du);
+        for (uint32_t i = 0; i < len; i++, p += 3) {
+            uint32_t x = i * NOISE_ZOOM;
+            uint8_t hue = (uint8_t)(noise_walk(&hue_noise, x + t) + shift);
+            uint32_t level = 64 + (noise_walk(&level_noise, x * 2 - t / 2) * 3 >> 2);
+            put_scaled(p, g_hue[hue], level);
+        }
+    }
+}
+
+// ============================================================================
+// Engine
+// ============================================================================
+
+void effects_init(effects_t* fx, const uint16_t* lengths, uint8_t num_strings, uint32_t seed) {
+    memset(fx, 0, sizeof(*fx));
+    if (num_strings > EFFECTS_MAX_STRINGS) num_strings = EFFECTS_MAX_STRINGS;
+    fx->num_strings = num_strings;
+
+    uint32_t offset = 0;
+    for (uint8_t s = 0; s < num_strings; s++) {
+        fx->lengths[s] = lengths[s];
+        fx->offsets[s] = offset;
+        offset += (uint32_t)lengths[s] * 3;
+        fx->total_pixels += lengths[s];
+    }
+    fx->frame_bytes = offset;
+    fx->rng = seed ? seed : 0x6D2B79F5u;
+}
+
+void effects_render(effects_t* fx, effect_id_t effect, uint32_t time_ms, uint8_t* frame) {
+    switch (effect) {
+        case EFFECT_COLOR_WIPE: render_color_wipe(fx, time_ms, frame); break;
+        case EFFECT_CHASE:      render_chase(fx, time_ms, frame);      break;
+        case EFFECT_TWINKLE:    render_twinkle(fx, time_ms, frame);    break;
+        case EFFECT_FIRE:       render_fire(fx, time_ms, frame);       break;
+        case EFFECT_PLASMA:     render_plasma(fx, time_ms, frame);     break;
+        case EFFECT_NOISE:      render_noise(fx, time_ms, frame);      break;
+        default:                memset(frame, 0, fx->frame_bytes);     break;
+    }
+}
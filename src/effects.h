@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Procedural effects.
+//
+// Effects render into a frame in board channel order (each string's RGB
+// bytes back to back, lengths from the layout), the form pb_set_frame_lerp
+// encodes pixel-major in one pass. Pixel loops are integer only:
+//
+//   - sine, hue, fire colors and the noise ease curve come from 256-entry
+//     tables built once by effects_init_tables()
+//   - positions and noise coordinates are 8.8 fixed point
+//   - divisions happen once per frame or per string, never per pixel
+//   - noise hashes each cell once as a string walks through it
+//
+// Time is passed in (ms), so speed doesn't depend on the frame rate and
+// the effects run on the host. Twinkle fades the previous frame, so the
+// caller keeps the frame between calls; every other effect writes each
+// pixel.
+
+#define EFFECTS_MAX_STRINGS   32
+#define EFFECTS_SHOW_SECONDS  30     // Fallback show: time on each effect
+
+typedef enum {
+    EFFECT_COLOR_WIPE = 0,
+    EFFECT_CHASE,
+    EFFECT_TWINKLE,
+    EFFECT_FIRE,
+    EFFECT_PLASMA,
+    EFFECT_NOISE,
+    EFFECT_COUNT
+} effect_id_t;
+
+typedef struct {
+    uint8_t num_strings;
+    uint16_t lengths[EFFECTS_MAX_STRINGS];
+    uint32_t offsets[EFFECTS_MAX_STRINGS];  // Byte offset of each string in the frame
+    uint32_t frame_bytes;
+    uint32_t total_pixels;
+    uint32_t rng;                  // Twinkle sparkles (xorshift32)
+    uint32_t last_ms;              // Twinkle: time of the previous frame
+} effects_t;
+
+// Build the lookup tables (once, before the first render)
+void effects_init_tables(void);
+
+// Layout: num_strings strings of lengths[i] pixels. seed starts the
+// sparkle generator (0 is replaced).
+void effects_init(effects_t* fx, const uint16_t* lengths, uint8_t num_strings, uint32_t seed);
+
+// Render one frame of effect at time_ms into frame (fx->frame_bytes long)
+void effects_render(effects_t* fx, effect_id_t effect, uint32_t time_ms, uint8_t* frame);
+
+// Display name ("Plasma" etc.), "?" if out of range
+const char* effects_name(uint8_t effect);
+
+// Table lookups
+uint8_t effects_sin8(uint8_t angle);       // 0..255 around 128, angle 256 = full turn
+uint32_t effects_hue(uint8_t hue);         // Fully saturated 0xRRGGBB
+uint32_t effects_heat(uint8_t heat);       // Black - red - yellow - white
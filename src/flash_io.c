@@ -0,0 +1,169 @@
+#include "flash_io.h"
+#include "trace.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/flash.h"
+#include "pico/time.h"
+#include <string.h>
+
+// Operation passed through flash_safe_execute
+typedef struct {
+    bool erase;
+    uint32_t offset;
+    const uint8_t* data;
+    uint32_t len;
+} flash_io_op_t;
+
+// Request mailbox states (Core 0 -> Core 1)
+typedef enum {
+    REQUEST_NONE = 0,
+    REQUEST_PENDING,          // Posted by Core 0, waiting for a frame gap
+    REQUEST_CLAIMED,          // Core 1 is running it
+    REQUEST_DONE,             // Result is valid
+} flash_io_request_state_t;
+
+static spin_lock_t* g_lock = NULL;
+static volatile bool g_service_enabled = false;
+
+static flash_io_op_t g_request;
+static volatile flash_io_request_state_t g_request_state = REQUEST_NONE;
+static volatile bool g_request_ok = false;
+
+// Written by whichever core ran the operation, under g_lock
+static flash_io_stats_t g_stats;
+
+// Callback - runs with the other core paused
+static void do_op_callback(void* param) {
+    const flash_io_op_t* op = (const flash_io_op_t*)param;
+    if (op->erase) {
+        flash_range_erase(op->offset, op->len);
+    } else {
+        flash_range_program(op->offset, op->data, op->len);
+    }
+}
+
+// Run one operation now, timing how long the other core was held off
+static bool execute(flash_io_op_t* op, uint32_t* counter) {
+    uint64_t start = time_us_64();
+    trace_begin(TRACE_FLASH_OP);
+    bool ok = flash_safe_execute(do_op_callback, op, UINT32_MAX) == PICO_OK;
+    trace_end(TRACE_FLASH_OP);
+    uint32_t stall = (uint32_t)(time_us_64() - start);
+
+    uint32_t save = spin_lock_blocking(g_lock);
+    (*counter)++;
+    g_stats.last_stall_us = stall;
+    if (stall > g_stats.max_stall_us) g_stats.max_stall_us = stall;
+    g_stats.total_stall_us += stall;
+    spin_unlock(g_lock, save);
+    return ok;
+}
+
+// Core 0: post the operation and wait for Core 1 to run it between frames
+static bool request(flash_io_op_t* op) {
+    g_request = *op;
+    g_request_ok = false;
+    __dmb();
+    g_request_state = REQUEST_PENDING;
+    __dmb();
+    __sev();  // Wake Core 1 if idle
+
+    uint64_t deadline = time_us_64() + FLASH_IO_SERVICE_TIMEOUT_US;
+    while (true) {
+        __dmb();
+        if (g_request_state == REQUEST_DONE) break;
+
+        if (time_us_64() >= deadline) {
+            // Take the request back unless Core 1 has already started it
+            uint32_t save = spin_lock_blocking(g_lock);
+            bool reclaimed = g_request_state == REQUEST_PENDING;
+            if (reclaimed) g_request_state = REQUEST_NONE;
+            spin_unlock(g_lock, save);
+
+            if (reclaimed) return execute(op, &g_stats.fallbacks);
+            deadline = UINT64_MAX;  // Claimed - it will finish shortly
+        }
+        tight_loop_contents();
+    }
+
+    bool ok = g_request_ok;
+    g_request_state = REQUEST_NONE;
+    __dmb();
+    return ok;
+}
+
+static bool run(flash_io_op_t* op) {
+    if (get_core_num() == 1) {
+        return execute(op, &g_stats.direct);
+    }
+    __dmb();
+    if (!g_service_enabled) {
+        return execute(op, &g_stats.direct);
+    }
+    return request(op);
+}
+
+// Split a range into sector-sized operations so each fits its own frame gap
+static bool run_split(bool erase, uint32_t offset, const uint8_t* data, uint32_t len) {
+    while (len > 0) {
+        uint32_t n = len < FLASH_SECTOR_SIZE ? len : FLASH_SECTOR_SIZE;
+        flash_io_op_t op = {.erase = erase, .offset = offset, .data = data, .len = n};
+        if (!run(&op)) return false;
+        offset += n;
+        if (data) data += n;
+        len -= n;
+    }
+    return true;
+}
+
+void flash_io_init(void) {
+    if (!g_lock) {
+        g_lock = spin_lock_init(spin_lock_claim_unused(true));
+    }
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_request_state = REQUEST_NONE;
+    g_service_enabled = false;
+    __dmb();
+}
+
+void flash_io_enable_service(void) {
+    g_service_enabled = true;
+    __dmb();
+}
+
+bool flash_io_pending(void) {
+    __dmb();
+    return g_request_state == REQUEST_PENDING;
+}
+
+bool flash_io_service(void) {
+    __dmb();
+    if (g_request_state != REQUEST_PENDING) return false;
+
+    uint32_t save = spin_lock_blocking(g_lock);
+    bool claimed = g_request_state == REQUEST_PENDING;
+    if (claimed) g_request_state = REQUEST_CLAIMED;
+    spin_unlock(g_lock, save);
+    if (!claimed) return false;
+
+    flash_io_op_t op = g_request;
+    g_request_ok = execute(&op, &g_stats.serviced);
+    __dmb();
+    g_request_state = REQUEST_DONE;
+    __dmb();
+    return true;
+}
+
+bool flash_io_erase(uint32_t offset, uint32_t len) {
+    return run_split(true, offset, NULL, len);
+}
+
+bool flash_io_program(uint32_t offset, const uint8_t* data, uint32_t len) {
+    return run_split(false, offset, data, len);
+}
+
+void flash_io_get_stats(flash_io_stats_t* stats) {
+    uint32_t save = spin_lock_blocking(g_lock);
+    *stats = g_stats;
+    spin_unlock(g_lock, save);
+}
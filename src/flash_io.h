@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Flash erase/program callable from either core.
+//
+// Each operation runs through flash_safe_execute, so the other core is parked
+// in RAM while XIP is unavailable. Both cores must have called
+// flash_safe_execute_core_init() (main does this for Core 0, core1_main for
+// Core 1). Offsets are from the start of flash; erase ranges must be sector
+// aligned, program ranges page aligned, and program data must be in RAM.
+//
+// Scheduling: Core 1 owns the LED output, so a write requested from Core 0
+// is handed to Core 1 and carried out in the gap after a frame's DMA has
+// finished: the players check flash_io_pending after starting a frame, wait
+// for its DMA, then call flash_io_service. Large ranges are split into one
+// sector per request, so an erase and the following program land in separate
+// gaps rather than freezing a single frame. A gap is only a start point: Core 1
+// stays stalled for the whole operation, tens of milliseconds for a sector
+// erase, so the next frame is late by that much. Core 0 blocks until its
+// request is done; if Core 1 doesn't pick it up in time (e.g. busy with a
+// long SD operation) Core 0 performs it itself, pausing Core 1 the old way.
+
+// Time Core 0 waits for Core 1 to service a request before doing it itself
+#define FLASH_IO_SERVICE_TIMEOUT_US 250000
+
+typedef struct {
+    uint32_t serviced;        // Core 0 requests done by Core 1 between frames
+    uint32_t fallbacks;       // Core 0 requests that timed out and ran directly
+    uint32_t direct;          // Run immediately (Core 1 callers, or before Core 1 starts)
+    uint32_t last_stall_us;   // Duration of the most recent operation
+    uint32_t max_stall_us;    // Longest single operation
+    uint64_t total_stall_us;  // Sum of all operation durations
+} flash_io_stats_t;
+
+// Claim the request lock. Call on Core 0 before launching Core 1.
+void flash_io_init(void);
+
+// Called by Core 1 once it's ready to service requests. Until then Core 0
+// performs its own operations directly.
+void flash_io_enable_service(void);
+
+// Core 1: whether a Core 0 request is waiting for a frame gap
+bool flash_io_pending(void);
+
+// Core 1: perform one pending Core 0 request, if any. Call once the frame's
+// DMA has finished (pb_show_wait) and from the idle loop. Returns true if a
+// request was serviced.
+bool flash_io_service(void);
+
+// Erase len bytes at offset. Returns false if the other core couldn't be
+// locked out.
+bool flash_io_erase(uint32_t offset, uint32_t len);
+
+// Program len bytes at offset.
+bool flash_io_program(uint32_t offset, const uint8_t* data, uint32_t len);
+
+// Snapshot of the stall metrics
+void flash_io_get_stats(flash_io_stats_t* stats);
@@ -0,0 +1,51 @@
+#pragma once
+
+// Flash partition map (offsets from the start of flash, not XIP addresses).
+//
+//   0x000000  Firmware image (XIP)            FLASH_LAYOUT_FIRMWARE_SIZE
+//   ........  Sequence cache (seq_cache.h)    up to the settings region
+//   end-64K   Settings region                 FLASH_LAYOUT_SETTINGS_SIZE
+//     end-24K   Board config snapshot           1 sector (config_cache.h)
+//     end-20K   Settings log (settings_log.h)   4 sectors
+//     end-4K    Legacy single-record settings   read once for migration
+//
+// Everything is sector aligned. The firmware region leaves plenty of headroom
+// over the current image; flash_layout_firmware_fits() checks that at boot so
+// a build that outgrows it never mounts (or erases) the sequence cache.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/flash.h"
+#include "hardware/regs/addressmap.h"
+
+#define FLASH_LAYOUT_FIRMWARE_SIZE   (2u * 1024u * 1024u)
+#define FLASH_LAYOUT_SETTINGS_SIZE   (64u * 1024u)
+
+#define FLASH_LAYOUT_SETTINGS_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_LAYOUT_SETTINGS_SIZE)
+
+// Settings log sits just below the legacy v1/v2 settings sector
+#define FLASH_LAYOUT_SETTINGS_LEGACY_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define FLASH_LAYOUT_SETTINGS_LOG_SIZE      (4u * FLASH_SECTOR_SIZE)
+#define FLASH_LAYOUT_SETTINGS_LOG_OFFSET    (FLASH_LAYOUT_SETTINGS_LEGACY_OFFSET - FLASH_LAYOUT_SETTINGS_LOG_SIZE)
+
+// Compiled board config snapshot for fast boot
+#define FLASH_LAYOUT_CONFIG_CACHE_OFFSET    (FLASH_LAYOUT_SETTINGS_LOG_OFFSET - FLASH_SECTOR_SIZE)
+
+#define FLASH_LAYOUT_SEQ_CACHE_OFFSET FLASH_LAYOUT_FIRMWARE_SIZE
+#define FLASH_LAYOUT_SEQ_CACHE_SIZE   (FLASH_LAYOUT_SETTINGS_OFFSET - FLASH_LAYOUT_SEQ_CACHE_OFFSET)
+
+_Static_assert(FLASH_LAYOUT_SETTINGS_OFFSET > FLASH_LAYOUT_SEQ_CACHE_OFFSET,
+               "Flash too small for sequence cache partition");
+_Static_assert((FLASH_LAYOUT_SEQ_CACHE_OFFSET % FLASH_SECTOR_SIZE) == 0,
+               "Sequence cache must be sector aligned");
+
+// End of the firmware image, from the linker script (an XIP address)
+extern char __flash_binary_end;
+
+static inline uint32_t flash_layout_firmware_bytes(void) {
+    return (uint32_t)((uintptr_t)&__flash_binary_end - XIP_BASE);
+}
+
+static inline bool flash_layout_firmware_fits(void) {
+    return flash_layout_firmware_bytes() <= FLASH_LAYOUT_FIRMWARE_SIZE;
+}
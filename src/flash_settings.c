@@ -1,31 +1,53 @@
 #include "flash_settings.h"
-#include "core1_task.h"
+#include "app_state.h"  // For SD_MAX_FILES
+#include "flash_io.h"
+#include "flash_layout.h"
+#include "settings_log.h"
 #include "hardware/flash.h"
-#include "hardware/sync.h"
 #include "pico/stdlib.h"
-#include "pico/flash.h"  // For flash_safe_execute
+#include <stdio.h>
 #include <string.h>
 
-// Flash location: last 4KB sector
-// PICO_FLASH_SIZE_BYTES is defined by the board config
-#define FLASH_SETTINGS_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
-#define FLASH_SETTINGS_ADDR   (XIP_BASE + FLASH_SETTINGS_OFFSET)
+// Settings live in an append-only log (settings_log.h). The single-record
+// sector written by older firmware is read once for migration and erased
+// after the first log write.
+#define FLASH_SETTINGS_LOG_ADDR    (XIP_BASE + FLASH_LAYOUT_SETTINGS_LOG_OFFSET)
+#define FLASH_SETTINGS_LEGACY_ADDR (XIP_BASE + FLASH_LAYOUT_SETTINGS_LEGACY_OFFSET)
 
 // Debounce settings saves (2 seconds - balance between flash wear and responsiveness)
 #define SAVE_DEBOUNCE_US 2000000
 
+// Playback position checkpoints (one log record each, an erase every 64)
+#define FLASH_SETTINGS_POSITION_INTERVAL_US 30000000
+
+// v2 record: same as v3 without resume_frame
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t brightness;
+    uint8_t was_playing;
+    uint8_t playing_index;
+    uint8_t auto_loop;
+    uint8_t reserved[3];
+    uint32_t crc;
+} flash_settings_v2_t;
+
+_Static_assert(sizeof(flash_settings_t) <= SETTINGS_LOG_MAX_PAYLOAD,
+               "Settings don't fit in a log record");
+
 // State for debounced saving
 static flash_settings_t last_saved = {0};
 static flash_settings_t pending_save = {0};
 static bool save_pending = false;
 static uint64_t save_pending_time = 0;
 static bool initialized = false;
+static uint64_t position_due_time = 0;
+static uint32_t loaded_resume_frame = 0;
 
-// Data passed to flash_safe_execute callback
-typedef struct {
-    const flash_settings_t* settings;
-    uint8_t page_buffer[FLASH_PAGE_SIZE];
-} flash_write_params_t;
+// Settings log (mounted on first use)
+static settings_log_t settings_log;
+static bool log_mounted = false;
+static bool legacy_present = false;
 
 // Simple CRC32 (polynomial 0xEDB88320)
 static uint32_t crc32(const uint8_t* data, size_t len) {
@@ -44,76 +66,121 @@ static uint32_t calc_settings_crc(const flash_settings_t* settings) {
     return crc32((const uint8_t*)settings, offsetof(flash_settings_t, crc));
 }
 
-bool flash_settings_load(flash_settings_t* settings) {
-    if (!settings) return false;
+// Log-relative flash backend (flash_io pauses the other core)
+static bool log_erase(void* user, uint32_t offset, uint32_t len) {
+    (void)user;
+    return flash_io_erase(FLASH_LAYOUT_SETTINGS_LOG_OFFSET + offset, len);
+}
 
-    // Read directly from flash (memory-mapped via XIP)
-    const flash_settings_t* flash_data = (const flash_settings_t*)FLASH_SETTINGS_ADDR;
+static bool log_program(void* user, uint32_t offset, const uint8_t* data, uint32_t len) {
+    (void)user;
+    return flash_io_program(FLASH_LAYOUT_SETTINGS_LOG_OFFSET + offset, data, len);
+}
+
+static void mount_log(void) {
+    if (log_mounted) return;
+
+    settings_log_flash_t flash = {
+        .base = (const uint8_t*)FLASH_SETTINGS_LOG_ADDR,
+        .size = FLASH_LAYOUT_SETTINGS_LOG_SIZE,
+        .erase = log_erase,
+        .program = log_program,
+        .user = NULL,
+    };
+    settings_log_mount(&settings_log, &flash);
+
+    legacy_present = *(const uint32_t*)FLASH_SETTINGS_LEGACY_ADDR != 0xFFFFFFFF;
+    log_mounted = true;
+}
+
+static bool fields_in_range(uint8_t brightness, uint8_t playing_index) {
+    return brightness >= 1 && brightness <= 10 && playing_index < SD_MAX_FILES;
+}
+
+static bool settings_in_range(const flash_settings_t* settings) {
+    return fields_in_range(settings->brightness, settings->playing_index);
+}
+
+// Build current-version settings from an older record's fields
+static void migrate(flash_settings_t* settings, const flash_settings_v2_t* old, uint8_t auto_loop) {
+    memset(settings, 0, sizeof(*settings));
+    settings->magic = FLASH_SETTINGS_MAGIC;
+    settings->version = FLASH_SETTINGS_VERSION;
+    settings->brightness = old->brightness;
+    settings->was_playing = old->was_playing;
+    settings->playing_index = old->playing_index;
+    settings->auto_loop = auto_loop;
+    settings->resume_frame = 0;  // Older firmware didn't track position
+    settings->crc = calc_settings_crc(settings);
+}
+
+// Accept a v2 record (log written by earlier log firmware, or legacy sector)
+static bool load_v2(flash_settings_t* settings, const flash_settings_v2_t* old) {
+    if (old->magic != FLASH_SETTINGS_MAGIC || old->version != 2) return false;
+    if (old->crc != crc32((const uint8_t*)old, offsetof(flash_settings_v2_t, crc))) return false;
+    if (!fields_in_range(old->brightness, old->playing_index)) return false;
+    migrate(settings, old, old->auto_loop);
+    return true;
+}
+
+// Read the single-record sector written by v1/v2 firmware
+static bool load_legacy(flash_settings_t* settings) {
+    const flash_settings_v2_t* flash_data = (const flash_settings_v2_t*)FLASH_SETTINGS_LEGACY_ADDR;
 
     // Check magic number
     if (flash_data->magic != FLASH_SETTINGS_MAGIC) return false;
 
-    // Check version - support migration from v1
-    if (flash_data->version != FLASH_SETTINGS_VERSION) {
-        if (flash_data->version == 1) {
-            // Migrate from v1: auto_loop defaults to false
-            // CRC check uses v1 layout, so skip CRC for migration
-            if (flash_data->brightness < 1 || flash_data->brightness > 10) return false;
-            if (flash_data->playing_index > 15) return false;
-            settings->magic = FLASH_SETTINGS_MAGIC;
-            settings->version = FLASH_SETTINGS_VERSION;
-            settings->brightness = flash_data->brightness;
-            settings->was_playing = flash_data->was_playing;
-            settings->playing_index = flash_data->playing_index;
-            settings->auto_loop = 0;  // Default for migrated settings
-            memset(settings->reserved, 0, sizeof(settings->reserved));
-            settings->crc = calc_settings_crc(settings);
-            return true;
-        }
-        return false;  // Unknown version
+    // Migrate from v1: auto_loop defaults to false
+    // CRC check uses v1 layout, so skip CRC for migration
+    if (flash_data->version == 1) {
+        if (!fields_in_range(flash_data->brightness, flash_data->playing_index)) return false;
+        migrate(settings, flash_data, 0);
+        return true;
     }
 
-    // Verify CRC
-    uint32_t expected_crc = calc_settings_crc(flash_data);
-    if (flash_data->crc != expected_crc) return false;
+    return load_v2(settings, flash_data);
+}
 
-    // Validate ranges
-    if (flash_data->brightness < 1 || flash_data->brightness > 10) return false;
-    if (flash_data->playing_index > 15) return false;
+bool flash_settings_load(flash_settings_t* settings) {
+    if (!settings) return false;
 
-    // Copy to output
-    memcpy(settings, flash_data, sizeof(flash_settings_t));
+    mount_log();
 
     // DON'T set last_saved or initialized here!
     // Let check_save() initialize last_saved from the actual current state on first call.
     // This prevents false "change" detection when is_playing starts as false
     // but we loaded was_playing=true (auto-play hasn't triggered yet).
 
-    return true;
-}
-
-// Direct flash write - only safe when core1 is not running
-static void do_flash_write_direct(const uint8_t* page_buffer) {
-    uint32_t ints = save_and_disable_interrupts();
-    flash_range_erase(FLASH_SETTINGS_OFFSET, FLASH_SECTOR_SIZE);
-    flash_range_program(FLASH_SETTINGS_OFFSET, page_buffer, FLASH_PAGE_SIZE);
-    restore_interrupts(ints);
-}
-
-// Callback for flash_safe_execute - runs with other core paused
-static void do_flash_write_callback(void* param) {
-    flash_write_params_t* p = (flash_write_params_t*)param;
+    flash_settings_t record;
+    uint16_t length = 0;
+    if (settings_log_read(&settings_log, &record, sizeof(record), &length)) {
+        if (length == sizeof(record) &&
+            record.magic == FLASH_SETTINGS_MAGIC &&
+            record.version == FLASH_SETTINGS_VERSION &&
+            record.crc == calc_settings_crc(&record) &&
+            settings_in_range(&record)) {
+            memcpy(settings, &record, sizeof(flash_settings_t));
+            loaded_resume_frame = settings->resume_frame;
+            return true;
+        }
 
-    // Erase the sector (required before writing)
-    flash_range_erase(FLASH_SETTINGS_OFFSET, FLASH_SECTOR_SIZE);
+        // v2 records from before the position was stored
+        flash_settings_v2_t old;
+        if (length == sizeof(old)) {
+            memcpy(&old, &record, sizeof(old));
+            if (load_v2(settings, &old)) return true;
+        }
+    }
 
-    // Write the settings
-    flash_range_program(FLASH_SETTINGS_OFFSET, p->page_buffer, FLASH_PAGE_SIZE);
+    // Nothing in the log yet - fall back to settings from older firmware
+    return load_legacy(settings);
 }
 
 void flash_settings_save(const flash_settings_t* settings) {
     if (!settings) return;
 
+    mount_log();
+
     // Prepare data with CRC
     flash_settings_t to_write;
     memcpy(&to_write, settings, sizeof(flash_settings_t));
@@ -121,25 +188,18 @@ void flash_settings_save(const flash_settings_t* settings) {
     to_write.version = FLASH_SETTINGS_VERSION;
     to_write.crc = calc_settings_crc(&to_write);
 
-    // Prepare page buffer
-    uint8_t page_buffer[FLASH_PAGE_SIZE];
-    memset(page_buffer, 0xFF, FLASH_PAGE_SIZE);
-    memcpy(page_buffer, &to_write, sizeof(flash_settings_t));
-
-    // Check if core1 is running a task
-    bool core1_active = !core1_is_idle();
-
-    if (core1_active) {
-        // Core1 is running - need to use flash_safe_execute to pause it
-        flash_write_params_t params;
-        params.settings = &to_write;
-        memcpy(params.page_buffer, page_buffer, FLASH_PAGE_SIZE);
-
-        int rc = flash_safe_execute(do_flash_write_callback, &params, UINT32_MAX);
-        if (rc != PICO_OK) return;
-    } else {
-        // Core1 not running - safe to write directly
-        do_flash_write_direct(page_buffer);
+    if (!settings_log_append(&settings_log, &to_write, sizeof(to_write))) return;
+
+    flash_io_stats_t stats;
+    flash_io_get_stats(&stats);
+    printf("Settings: Saved (flash stall %lu us, max %lu us, %lu fallbacks)\n",
+           (unsigned long)stats.last_stall_us, (unsigned long)stats.max_stall_us,
+           (unsigned long)stats.fallbacks);
+
+    // The log now holds the current settings - retire the legacy sector
+    if (legacy_present &&
+        flash_io_erase(FLASH_LAYOUT_SETTINGS_LEGACY_OFFSET, FLASH_SECTOR_SIZE)) {
+        legacy_present = false;
     }
 
     // Update last saved state
@@ -148,27 +208,13 @@ void flash_settings_save(const flash_settings_t* settings) {
     initialized = true;
 }
 
-// Callback for flash erase
-static void do_flash_erase_callback(void* param) {
-    (void)param;
-    flash_range_erase(FLASH_SETTINGS_OFFSET, FLASH_SECTOR_SIZE);
-}
-
-// Direct flash erase - only safe when core1 is not running
-static void do_flash_erase_direct(void) {
-    uint32_t ints = save_and_disable_interrupts();
-    flash_range_erase(FLASH_SETTINGS_OFFSET, FLASH_SECTOR_SIZE);
-    restore_interrupts(ints);
-}
-
 void flash_settings_clear(void) {
-    bool core1_active = !core1_is_idle();
+    mount_log();
 
-    if (core1_active) {
-        int rc = flash_safe_execute(do_flash_erase_callback, NULL, UINT32_MAX);
-        if (rc != PICO_OK) return;
-    } else {
-        do_flash_erase_direct();
+    if (!settings_log_erase_all(&settings_log)) return;
+    if (legacy_present) {
+        if (!flash_io_erase(FLASH_LAYOUT_SETTINGS_LEGACY_OFFSET, FLASH_SECTOR_SIZE)) return;
+        legacy_present = false;
     }
     memset(&last_saved, 0, sizeof(flash_settings_t));
     save_pending = false;
@@ -181,6 +227,7 @@ void flash_settings_check_save(uint8_t brightness, bool is_playing, uint8_t play
         last_saved.was_playing = is_playing ? 1 : 0;
         last_saved.playing_index = playing_index;
         last_saved.auto_loop = auto_loop ? 1 : 0;
+        last_saved.resume_frame = loaded_resume_frame;  // Kept until playback moves on
         initialized = true;
         return;
     }
@@ -192,11 +239,11 @@ void flash_settings_check_save(uint8_t brightness, bool is_playing, uint8_t play
                    ((auto_loop ? 1 : 0) != last_saved.auto_loop);
 
     if (changed) {
-        // Update pending save data
-        pending_save.brightness = brightness;
-        pending_save.was_playing = is_playing ? 1 : 0;
-        pending_save.playing_index = playing_index;
-        pending_save.auto_loop = auto_loop ? 1 : 0;
+        // A different file, or stopping, starts from the top next time
+        if ((last_saved.was_playing && !is_playing) ||
+            playing_index != last_saved.playing_index) {
+            last_saved.resume_frame = 0;
+        }
 
         // Update last_saved so we don't detect the same change next frame
         last_saved.brightness = brightness;
@@ -204,6 +251,9 @@ void flash_settings_check_save(uint8_t brightness, bool is_playing, uint8_t play
         last_saved.playing_index = playing_index;
         last_saved.auto_loop = auto_loop ? 1 : 0;
 
+        // Update pending save data
+        memcpy(&pending_save, &last_saved, sizeof(flash_settings_t));
+
         // Reset debounce timer
         save_pending = true;
         save_pending_time = time_us_64() + SAVE_DEBOUNCE_US;
@@ -214,3 +264,21 @@ void flash_settings_check_save(uint8_t brightness, bool is_playing, uint8_t play
         flash_settings_save(&pending_save);
     }
 }
+
+void flash_settings_check_position(uint32_t frame) {
+    if (!initialized || !last_saved.was_playing) return;
+
+    uint64_t now = time_us_64();
+    if (position_due_time == 0) {
+        position_due_time = now + FLASH_SETTINGS_POSITION_INTERVAL_US;
+        return;
+    }
+    if (now < position_due_time) return;
+    position_due_time = now + FLASH_SETTINGS_POSITION_INTERVAL_US;
+
+    if (frame == last_saved.resume_frame) return;
+
+    // Saves everything current, including any change still being debounced
+    last_saved.resume_frame = frame;
+    flash_settings_save(&last_saved);
+}
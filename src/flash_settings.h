@@ -9,21 +9,23 @@ typedef struct {
     uint8_t version;          // Schema version (for future migration)
     uint8_t brightness;       // 1-10
     uint8_t was_playing;      // bool: was FSEQ playback active?
-    uint8_t playing_index;    // 0-15: which file was playing
+    uint8_t playing_index;    // Which file was playing (< SD_MAX_FILES)
     uint8_t auto_loop;        // bool: auto-advance through all files
     uint8_t reserved[3];      // Padding for future use
+    uint32_t resume_frame;    // Frame of the playing file at the last checkpoint
     uint32_t crc;             // CRC32 of fields above
 } flash_settings_t;
 
 #define FLASH_SETTINGS_MAGIC 0x50425345  // "PBSE"
-#define FLASH_SETTINGS_VERSION 2
+#define FLASH_SETTINGS_VERSION 3
 
 // Load settings from flash
 // Returns true if valid settings were loaded, false if defaults should be used
 bool flash_settings_load(flash_settings_t* settings);
 
 // Save settings to flash (handles XIP safety internally)
-// Note: This erases a 4KB sector and writes - use sparingly
+// Appends one record to the settings log; a sector erase happens only once
+// every 64 saves
 void flash_settings_save(const flash_settings_t* settings);
 
 // Clear saved settings (revert to defaults on next boot)
@@ -32,3 +34,7 @@ void flash_settings_clear(void);
 // Check if settings need saving (call periodically from main loop)
 // Implements debouncing to avoid excessive flash writes
 void flash_settings_check_save(uint8_t brightness, bool is_playing, uint8_t playing_index, bool auto_loop);
+
+// Checkpoint the playback position (call periodically while playing).
+// Writes at most once per FLASH_SETTINGS_POSITION_INTERVAL_US.
+void flash_settings_check_position(uint32_t frame);
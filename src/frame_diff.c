@@ -0,0 +1,59 @@
+#include "frame_diff.h"
+#include <string.h>
+
+void frame_diff_init(frame_diff_t* diff) {
+    memset(diff, 0, sizeof(*diff));
+}
+
+void frame_diff_invalidate(frame_diff_t* diff) {
+    memset(diff->known, 0, sizeof(diff->known));
+    memset(diff->seen, 0, sizeof(diff->seen));
+    diff->changed = true;
+}
+
+uint32_t frame_diff_hash(const uint8_t* data, uint32_t len) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool frame_diff_chunk(frame_diff_t* diff, uint32_t index, const uint8_t* data, uint32_t len) {
+    if (index >= FRAME_DIFF_MAX_CHUNKS) {
+        diff->changed = true;  // Not tracked - always decoded
+        return false;
+    }
+
+    // Length goes in too, so a short chunk never matches a longer one
+    uint32_t word = index / 32;
+    uint32_t bit = 1u << (index % 32);
+    uint32_t hash = frame_diff_hash(data, len) ^ len;
+    bool same = (diff->known[word] & bit) && diff->hashes[index] == hash;
+    diff->hashes[index] = hash;
+    diff->seen[word] |= bit;
+
+    if (same) {
+        diff->stats.chunks_skipped++;
+    } else {
+        diff->changed = true;
+    }
+    return same;
+}
+
+bool frame_diff_end_frame(frame_diff_t* diff) {
+    bool any_seen = false;
+    for (int i = 0; i < FRAME_DIFF_MASK_WORDS; i++) {
+        if (diff->seen[i]) any_seen = true;
+    }
+    bool unchanged = !diff->changed && any_seen &&
+                     memcmp(diff->seen, diff->known, sizeof(diff->seen)) == 0;
+
+    memcpy(diff->known, diff->seen, sizeof(diff->known));
+    memset(diff->seen, 0, sizeof(diff->seen));
+    diff->changed = false;
+
+    diff->stats.frames++;
+    if (unchanged) diff->stats.unchanged++;
+    return unchanged;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Identical-frame detection for SD playback.
+//
+// Sequences often hold a look (or blackout) for many frames. Each frame is
+// read in chunks that start at the same offsets every frame; a chunk whose
+// hash matches the same chunk of the previous frame doesn't need decoding,
+// since the decoded frame from last time still holds its pixels. A frame
+// with no changed chunk needs no encode or DMA either - the LEDs already
+// show it.
+//
+// Hashes are 32-bit FNV-1a, so a change is missed with odds of about one in
+// four billion per chunk; a missed change lasts until that chunk changes
+// again.
+
+#define FRAME_DIFF_MAX_CHUNKS 96   // Chunks tracked per frame (48 KB at 512 bytes,
+                                   // a full 32 x 512 board)
+#define FRAME_DIFF_MASK_WORDS ((FRAME_DIFF_MAX_CHUNKS + 31) / 32)
+
+typedef struct {
+    uint32_t frames;               // Frames checked
+    uint32_t unchanged;            // Identical to the previous frame, not decoded
+    uint32_t chunks_skipped;       // Chunks not decoded (in any frame)
+    uint32_t held;                 // Outputs skipped entirely: no encode, no DMA
+} frame_diff_stats_t;
+
+typedef struct {
+    uint32_t hashes[FRAME_DIFF_MAX_CHUNKS];
+    uint32_t known[FRAME_DIFF_MASK_WORDS];  // Chunks hashed in the previous frame
+    uint32_t seen[FRAME_DIFF_MASK_WORDS];   // Chunks hashed in the frame in progress
+    bool changed;                  // Frame in progress differs somewhere
+    frame_diff_stats_t stats;
+} frame_diff_t;
+
+// Clear hashes and stats.
+void frame_diff_init(frame_diff_t* diff);
+
+// Forget the previous frame (seek, new show, decoded frame overwritten).
+// The next frame counts as changed throughout.
+void frame_diff_invalidate(frame_diff_t* diff);
+
+uint32_t frame_diff_hash(const uint8_t* data, uint32_t len);
+
+// Record chunk index of the frame in progress. Returns true if it matches the
+// same chunk of the previous frame, i.e. decoding it can be skipped.
+bool frame_diff_chunk(frame_diff_t* diff, uint32_t index, const uint8_t* data, uint32_t len);
+
+// Close the frame. Returns true if every chunk matched the previous frame.
+bool frame_diff_end_frame(frame_diff_t* diff);
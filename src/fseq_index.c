@@ -0,0 +1,31 @@
+#include "fseq_index.h"
+#include <string.h>
+
+static uint32_t read_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool fseq_index_init(fseq_index_t* idx, const uint8_t* h) {
+    if (!idx || !h) return false;
+    memset(idx, 0, sizeof(*idx));
+
+    if (read_u32(h) != 0x51455350 || h[7] != 2) return false;  // "PSEQ" v2
+    if ((h[20] & 0x0F) != 0) return false;                      // Compressed
+
+    idx->data_offset = (uint32_t)h[4] | ((uint32_t)h[5] << 8);
+    idx->channel_count = read_u32(h + 10);
+    idx->frame_count = read_u32(h + 14);
+    idx->step_time_ms = h[18];
+    for (int i = 7; i >= 0; i--) {
+        idx->unique_id = (idx->unique_id << 8) | h[24 + i];
+    }
+    return true;
+}
+
+bool fseq_index_seek(const fseq_index_t* idx, uint32_t frame, fseq_index_pos_t* pos) {
+    if (!idx || !pos || idx->frame_count == 0) return false;
+    frame %= idx->frame_count;
+    pos->offset = idx->data_offset + frame * idx->channel_count;
+    pos->frame = frame;
+    return true;
+}
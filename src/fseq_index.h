@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Frame index for random access into an FSEQ v2 file.
+//
+// Uncompressed files need no table: frame N starts at
+// channel_data_offset + N * channel_count. Compressed files aren't indexed:
+// the parser can't decompress them, so there is nothing to seek within.
+
+#define FSEQ_INDEX_HEADER_SIZE  32
+
+typedef struct {
+    uint32_t data_offset;     // channel_data_offset
+    uint32_t channel_count;
+    uint32_t frame_count;
+    uint8_t step_time_ms;
+    uint64_t unique_id;
+} fseq_index_t;
+
+// Where a frame starts
+typedef struct {
+    uint32_t offset;          // File offset to seek to
+    uint32_t frame;           // Frame there (requested, wrapped)
+} fseq_index_pos_t;
+
+// Set up from the 32-byte fixed header. Returns false if it isn't an
+// uncompressed FSEQ v2 file.
+bool fseq_index_init(fseq_index_t* idx, const uint8_t* header);
+
+// Find where frame (wrapped into the sequence) starts.
+// Returns false if the file has no frames.
+bool fseq_index_seek(const fseq_index_t* idx, uint32_t frame, fseq_index_pos_t* pos);
@@ -0,0 +1,172 @@
+#include "input.h"
+#include <string.h>
+
+// Orders the event copy against head / tail on both sides (a DMB on the M33)
+#define INPUT_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+// ============================================================================
+// Ring
+// ============================================================================
+
+void input_ring_init(input_ring_t* ring) {
+    memset(ring, 0, sizeof(*ring));
+}
+
+bool input_ring_push(input_ring_t* ring, uint32_t time_us, input_source_t source,
+                     input_raw_kind_t kind, uint8_t code) {
+    uint32_t head = ring->head;
+    if (head - ring->tail >= INPUT_RING_SIZE) {
+        ring->dropped++;
+        return false;
+    }
+    input_event_t* ev = &ring->events[head & (INPUT_RING_SIZE - 1)];
+    ev->time_us = time_us;
+    ev->source = (uint8_t)source;
+    ev->kind = (uint8_t)kind;
+    ev->code = code;
+    INPUT_BARRIER();
+    ring->head = head + 1;
+    return true;
+}
+
+bool input_ring_pop(input_ring_t* ring, input_event_t* out) {
+    uint32_t tail = ring->tail;
+    if (tail == ring->head) return false;
+    INPUT_BARRIER();
+    *out = ring->events[tail & (INPUT_RING_SIZE - 1)];
+    INPUT_BARRIER();
+    ring->tail = tail + 1;
+    return true;
+}
+
+// ============================================================================
+// Tracker
+// ============================================================================
+
+void input_tracker_init(input_tracker_t* t) {
+    memset(t, 0, sizeof(*t));
+}
+
+static input_key_t* find_key(input_tracker_t* t, uint8_t source, uint8_t code) {
+    for (int i = 0; i < INPUT_MAX_HELD; i++) {
+        input_key_t* k = &t->keys[i];
+        if (k->held && k->source == source && k->code == code) return k;
+    }
+    return NULL;
+}
+
+// The IR key being held, if any (one at a time: a new frame replaces it)
+static input_key_t* held_ir(input_tracker_t* t) {
+    for (int i = 0; i < INPUT_MAX_HELD; i++) {
+        if (t->keys[i].held && t->keys[i].source == INPUT_SRC_IR) return &t->keys[i];
+    }
+    return NULL;
+}
+
+static void key_event(input_event_t* out, const input_key_t* k, input_key_kind_t kind,
+                      uint32_t time_us) {
+    out->time_us = time_us;
+    out->source = k->source;
+    out->kind = (uint8_t)kind;
+    out->code = k->code;
+}
+
+static void press(input_tracker_t* t, const input_event_t* raw) {
+    input_key_t* k = find_key(t, raw->source, raw->code);
+    for (int i = 0; !k && i < INPUT_MAX_HELD; i++) {
+        if (!t->keys[i].held) k = &t->keys[i];
+    }
+    if (!k) k = &t->keys[0];  // More keys than slots: forget the first
+
+    k->held = true;
+    k->source = raw->source;
+    k->code = raw->code;
+    k->long_sent = false;
+    k->press_us = raw->time_us;
+    k->last_us = raw->time_us;
+    k->repeat_us = raw->time_us;
+}
+
+int input_tracker_feed(input_tracker_t* t, const input_event_t* raw, input_event_t* out) {
+    switch (raw->kind) {
+        case INPUT_RAW_DOWN: {
+            if (raw->source == INPUT_SRC_IR) {
+                input_key_t* prev = held_ir(t);
+                if (prev) prev->held = false;
+            }
+            press(t, raw);
+            key_event(out, find_key(t, raw->source, raw->code), INPUT_KEY_PRESS, raw->time_us);
+            return 1;
+        }
+
+        case INPUT_RAW_UP: {
+            input_key_t* k = find_key(t, raw->source, raw->code);
+            if (k) k->held = false;
+            return 0;
+        }
+
+        case INPUT_RAW_IR_REPEAT: {
+            // A repeat only continues a key still alive (first one missed or
+            // the key timed out: nothing to repeat)
+            input_key_t* k = held_ir(t);
+            if (!k || raw->time_us - k->last_us > INPUT_IR_RELEASE_US) {
+                if (k) k->held = false;
+                return 0;
+            }
+            k->last_us = raw->time_us;
+
+            int n = 0;
+            uint32_t held_us = raw->time_us - k->press_us;
+            if (held_us >= INPUT_REPEAT_DELAY_US) {
+                k->repeat_us = raw->time_us;
+                key_event(&out[n++], k, INPUT_KEY_REPEAT, raw->time_us);
+            }
+            if (held_us >= INPUT_LONG_PRESS_US && !k->long_sent) {
+                k->long_sent = true;
+                key_event(&out[n++], k, INPUT_KEY_LONG, raw->time_us);
+            }
+            return n;
+        }
+    }
+    return 0;
+}
+
+int input_tracker_poll(input_tracker_t* t, uint32_t now_us, input_event_t* out, int max) {
+    int n = 0;
+    for (int i = 0; i < INPUT_MAX_HELD; i++) {
+        input_key_t* k = &t->keys[i];
+        if (!k->held) continue;
+
+        if (k->source == INPUT_SRC_IR) {
+            if (now_us - k->last_us > INPUT_IR_RELEASE_US) k->held = false;
+            continue;  // Repeat and long press come with repeat frames
+        }
+
+        uint32_t held_us = now_us - k->press_us;
+        if (n < max && held_us >= INPUT_REPEAT_DELAY_US &&
+            now_us - k->repeat_us >= INPUT_REPEAT_INTERVAL_US) {
+            k->repeat_us = now_us;
+            key_event(&out[n++], k, INPUT_KEY_REPEAT, now_us);
+        }
+        if (n < max && held_us >= INPUT_LONG_PRESS_US && !k->long_sent) {
+            k->long_sent = true;
+            key_event(&out[n++], k, INPUT_KEY_LONG, now_us);
+        }
+    }
+    return n;
+}
+
+bool input_tracker_held(const input_tracker_t* t, input_source_t source, uint8_t code) {
+    for (int i = 0; i < INPUT_MAX_HELD; i++) {
+        const input_key_t* k = &t->keys[i];
+        if (k->held && k->source == source && k->code == code) return true;
+    }
+    return false;
+}
+
+bool input_tracker_busy(const input_tracker_t* t) {
+    for (int i = 0; i < INPUT_MAX_HELD; i++) {
+        if (t->keys[i].held) return true;
+    }
+    return false;
+}
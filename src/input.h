@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Button and IR input events.
+//
+// The button and IR interrupts push raw events - button down/up, decoded
+// IR frames and NEC repeat frames - into a ring with their timestamps. The
+// ring takes one producer at a time: both interrupts run at the same
+// priority, so neither preempts the other. The main loop pops them in
+// order and runs them through a tracker that turns them into key events:
+//
+//   PRESS   on button down or a new IR frame
+//   REPEAT  while held: every NEC repeat frame (~108 ms) for IR keys, or
+//           every INPUT_REPEAT_INTERVAL_US for buttons, after
+//           INPUT_REPEAT_DELAY_US
+//   LONG    once, when held for INPUT_LONG_PRESS_US
+//
+// IR keys have no release: a key counts as released once repeat frames
+// stop for INPUT_IR_RELEASE_US. Buttons need input_tracker_poll() to
+// repeat and long-press while held, since nothing arrives meanwhile.
+
+#define INPUT_RING_SIZE          32        // Raw events buffered (power of two)
+#define INPUT_MAX_HELD           4         // Keys tracked at once
+#define INPUT_REPEAT_DELAY_US    400000
+#define INPUT_REPEAT_INTERVAL_US 100000
+#define INPUT_LONG_PRESS_US      1000000
+#define INPUT_IR_RELEASE_US      150000
+
+_Static_assert((INPUT_RING_SIZE & (INPUT_RING_SIZE - 1)) == 0,
+               "INPUT_RING_SIZE must be a power of two");
+
+typedef enum {
+    INPUT_SRC_BUTTON = 0,          // code = GPIO pin
+    INPUT_SRC_IR,                  // code = NEC command byte
+} input_source_t;
+
+typedef enum {
+    INPUT_RAW_DOWN = 0,            // Button pressed / IR frame decoded
+    INPUT_RAW_UP,                  // Button released
+    INPUT_RAW_IR_REPEAT,           // NEC repeat frame (code unused)
+} input_raw_kind_t;
+
+typedef enum {
+    INPUT_KEY_PRESS = 0,
+    INPUT_KEY_REPEAT,
+    INPUT_KEY_LONG,
+} input_key_kind_t;
+
+typedef struct {
+    uint32_t time_us;
+    uint8_t source;
+    uint8_t kind;
+    uint8_t code;
+} input_event_t;
+
+typedef struct {
+    input_event_t events[INPUT_RING_SIZE];
+    volatile uint32_t head;        // Written by the producer (interrupt)
+    volatile uint32_t tail;        // Written by the consumer (main loop)
+    volatile uint32_t dropped;     // Events lost to a full ring
+} input_ring_t;
+
+typedef struct {
+    bool held;
+    uint8_t source;
+    uint8_t code;
+    bool long_sent;
+    uint32_t press_us;
+    uint32_t last_us;              // Last sign of life (repeat frame / poll)
+    uint32_t repeat_us;            // Last repeat emitted
+} input_key_t;
+
+typedef struct {
+    input_key_t keys[INPUT_MAX_HELD];
+} input_tracker_t;
+
+void input_ring_init(input_ring_t* ring);
+
+// Producer side (one interrupt). Returns false and counts a drop when full.
+bool input_ring_push(input_ring_t* ring, uint32_t time_us, input_source_t source,
+                     input_raw_kind_t kind, uint8_t code);
+
+// Consumer side. Returns false when empty.
+bool input_ring_pop(input_ring_t* ring, input_event_t* out);
+
+void input_tracker_init(input_tracker_t* t);
+
+// Key events for one raw event; out needs room for 2 (REPEAT and LONG can
+// come from the same repeat frame). Returns the number written.
+int input_tracker_feed(input_tracker_t* t, const input_event_t* raw, input_event_t* out);
+
+// Time-based events for held keys at now_us: button repeat and long press,
+// IR release. out needs room for max. Returns the number written.
+int input_tracker_poll(input_tracker_t* t, uint32_t now_us, input_event_t* out, int max);
+
+// True while the tracker considers the key down
+bool input_tracker_held(const input_tracker_t* t, input_source_t source, uint8_t code);
+
+// True while any key is down: input_tracker_poll() has work to do
+bool input_tracker_busy(const input_tracker_t* t);
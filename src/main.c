@@ -6,6 +6,7 @@
 #include "pico/stdlib.h"
 #include "pico/time.h"
 #include "pico/multicore.h"
+#include "pico/stdio_usb.h"  // For stdio_usb_connected
 #include "pico/flash.h"  // For flash_safe_execute_core_init
 #include "hardware/i2c.h"
 #include "hardware/adc.h"
@@ -20,6 +21,16 @@
 // FSEQ Player
 #include "fseq_player.h"
 
+// USB live stream
+#include "usb_stream.h"
+
+// Procedural effects
+#include "effects_player.h"
+
+// Flash sequence cache
+#include "flash_cache.h"
+#include "flash_io.h"
+
 // String Length Test
 #include "string_length_test.h"
 
@@ -31,15 +42,26 @@
 
 // Board configuration
 #include "board_config.h"
+#include "config_cache.h"
+
+// Boot phase timestamps
+#include "boot_timing.h"
+
+// Per-frame timing telemetry and event trace
+#include "perf.h"
+#include "trace.h"
 
 #include "app_state.h"
 #include "action.h"
 #include "reducer.h"
+#include "action_queue.h"
+#include "input.h"
 #include "side_effects.h"
 #include "views.h"
 #include "flash_settings.h"
 #include "pb_led_driver.h"
 #include "core1_task.h"
+#include "usb_cmd.h"
 
 // Pin definitions
 #define DISP_SDA_PIN 46
@@ -57,12 +79,13 @@
 #define STRING_OUT_BASE_PIN 0
 
 // Timing
-#define BTN_DEBOUNCE_US 200000  // 200ms debounce
+#define BTN_DEBOUNCE_US 30000   // 30ms: edges closer than this are bounce
 #define TICK_1S_US 1000000      // 1 second
 #define DISPLAY_REFRESH_US 500000  // 500ms display refresh for FPS
 
 // Global state
 static AppState current_state;
+static action_queue_t action_queue;
 static HardwareContext hw_context;
 static sh1106_t display;
 static string_test_t string_test_ctx;
@@ -70,15 +93,43 @@ static toggle_test_t toggle_test_ctx;
 static rainbow_test_t rainbow_test_ctx;
 static string_length_test_t string_length_test_ctx;
 static fseq_player_t fseq_player_ctx;
+static usb_stream_t usb_stream_ctx;
+static effects_player_t effects_player_ctx;
+static flash_cache_t flash_cache_ctx;
+
+// Boot used the flash config snapshot; config.csv is checked on the first SD scan
+static bool config_revalidate_pending = false;
+static uint32_t config_hash = 0;
+
+// Board address ladder, read once at boot. A board_id line in config.csv
+// overrides it.
+static uint8_t ladder_board_id = 0;
 
 // Static file list buffer (declared extern in app_state.h)
 char sd_file_list[SD_MAX_FILES][SD_FILENAME_LEN];
 
-// Button state
-static volatile uint64_t select_last_press_us = 0;
-static volatile uint64_t next_last_press_us = 0;
-static volatile bool select_pressed = false;
-static volatile bool next_pressed = false;
+// Input: gpio_isr fills the ring, the main loop drains it into the tracker
+static input_ring_t input_ring;
+static input_tracker_t input_tracker;
+
+// Main loop wake-ups, set from timer and stdio callbacks
+static volatile bool tick_1s_due = false;
+static volatile bool display_refresh_due = false;
+static volatile bool usb_rx_pending = true;  // Drain anything received before the callback
+static repeating_timer_t tick_1s_timer;
+static repeating_timer_t display_refresh_timer;
+
+// Debounced button level, as last recorded in input_ring
+typedef struct {
+    uint pin;
+    bool down;
+    uint32_t edge_us;
+} button_t;
+
+static button_t buttons[2] = {
+    { .pin = BTN_SELECT_PIN },
+    { .pin = BTN_NEXT_PIN },
+};
 
 // Board address decoding
 // Theoretical ADC values for each code (sorted high→low by voltage)
@@ -132,42 +183,307 @@ static uint16_t sample_board_address_adc(void) {
     return (uint16_t)(acc / BOARD_ADDR_SAMPLES);
 }
 
-// Combined GPIO ISR for buttons and IR
+// Compare config.csv with the snapshot we booted from (card already mounted)
+static void revalidate_board_config(void) {
+    board_config_load_result_t result =
+        board_config_reload_if_changed(ladder_board_id, config_hash);
+    if (result.config_hash == 0) return;  // Not readable yet - retry on next scan
+
+    config_revalidate_pending = false;
+    if (!result.success) {
+        printf("Config: %s - keeping cached config\n", result.error_msg);
+        return;
+    }
+    if (result.changed) {
+        printf("Config: config.csv changed - %u strings, max %u pixels\n",
+               g_board_config.string_count, g_board_config.max_pixel_count);
+        config_hash = result.config_hash;
+        config_cache_save(config_hash);
+    }
+}
+
+// Console commands over USB CDC (timecode chase). Core 1 owns stdin while
+// live streaming, so this only runs otherwise.
+static void poll_usb_commands(void) {
+    static usb_cmd_reader_t reader;
+    static bool reader_ready = false;
+    if (!reader_ready) {
+        usb_cmd_reader_init(&reader);
+        reader_ready = true;
+    }
+
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        // Stamp on arrival, before any parsing delay
+        uint64_t received_us = time_us_64();
+        usb_cmd_t cmd;
+        if (!usb_cmd_feed(&reader, (char)c, &cmd)) continue;
+
+        switch (cmd.type) {
+            case USB_CMD_TIMECODE_MS:
+                core1_chase_sample(cmd.value, received_us);
+                break;
+            case USB_CMD_TIMECODE_FRAME: {
+                uint32_t step_ms = fseq_player_ctx.step_time_ms;
+                if (step_ms == 0) break;
+                // A frame past UINT32_MAX ms would wrap to an early time
+                if (cmd.value > UINT32_MAX / step_ms) {
+                    printf("Chase: frame %lu out of range\n", (unsigned long)cmd.value);
+                    break;
+                }
+                core1_chase_sample(cmd.value * step_ms, received_us);
+                break;
+            }
+            case USB_CMD_CHASE_OFF:
+                core1_chase_off();
+                printf("Chase: off\n");
+                break;
+            case USB_CMD_SEEK_MS:
+                core1_seek_fseq_ms(cmd.value);
+                break;
+            case USB_CMD_SEEK_FRAME:
+                core1_seek_fseq(cmd.value);
+                break;
+            case USB_CMD_CHASE_STATUS: {
+                chase_stats_t st = fseq_player_ctx.chase;
+                printf("Chase: offset %ld us (max %lu), %lu samples, %lu outliers, "
+                       "%lu relocks, %lu seeks, %lu slewed frames\n",
+                       (long)st.offset_us, (unsigned long)st.max_abs_offset_us,
+                       (unsigned long)st.samples, (unsigned long)st.outliers,
+                       (unsigned long)st.relocks, (unsigned long)st.seeks,
+                       (unsigned long)st.slews);
+                break;
+            }
+            case USB_CMD_PERF_DUMP:
+                perf_dump();
+                break;
+            case USB_CMD_TRACE_DUMP:
+                trace_dump();
+                break;
+            case USB_CMD_POWER_STATUS: {
+                pb_power_stats_t st = fseq_player_ctx.power;
+                printf("Power: %lu mA (wanted %lu, peak %lu), limit %u/256, "
+                       "%lu limited frames\n",
+                       (unsigned long)st.estimate_ma, (unsigned long)st.demand_ma,
+                       (unsigned long)st.peak_ma, (unsigned)st.scale,
+                       (unsigned long)st.limited_frames);
+                break;
+            }
+            case USB_CMD_INVALID:
+                printf("?\n");
+                break;
+            case USB_CMD_NONE:
+                break;
+        }
+    }
+}
+
+// Record a button level change (buttons pull low when pressed). Runs in
+// gpio_isr, or in the main loop with interrupts off. The other producer,
+// the IR receive interrupt, shares gpio_isr's priority, so pushes to
+// input_ring never interleave.
+static void __not_in_flash_func(button_update)(button_t *b, uint32_t now) {
+    bool down = !gpio_get(b->pin);
+    if (down == b->down || now - b->edge_us < BTN_DEBOUNCE_US) return;
+    b->down = down;
+    b->edge_us = now;
+    input_ring_push(&input_ring, now, INPUT_SRC_BUTTON,
+                    down ? INPUT_RAW_DOWN : INPUT_RAW_UP, (uint8_t)b->pin);
+}
+
+// GPIO ISR for the buttons (IR is decoded by PIO)
 // Placed in RAM to avoid flash XIP latency
 static void __not_in_flash_func(gpio_isr)(uint gpio, uint32_t events) {
-    uint64_t now = time_us_64();
+    if (gpio == BTN_SELECT_PIN) {
+        button_update(&buttons[0], time_us_32());
+    } else if (gpio == BTN_NEXT_PIN) {
+        button_update(&buttons[1], time_us_32());
+    }
+}
 
-    if (gpio == BTN_SELECT_PIN && (events & GPIO_IRQ_EDGE_FALL)) {
-        if (now - select_last_press_us >= BTN_DEBOUNCE_US) {
-            select_pressed = true;
-            select_last_press_us = now;
-        }
-    } else if (gpio == BTN_NEXT_PIN && (events & GPIO_IRQ_EDGE_FALL)) {
-        if (now - next_last_press_us >= BTN_DEBOUNCE_US) {
-            next_pressed = true;
-            next_last_press_us = now;
-        }
-    } else if (gpio == IR_PIN && (events & GPIO_IRQ_EDGE_FALL)) {
-        ir_process_edge();
+// Repeating timer callback: raise the flag passed as user data
+static bool set_due_flag(repeating_timer_t *rt) {
+    *(volatile bool *)rt->user_data = true;
+    return true;
+}
+
+static void usb_rx_available(void *param) {
+    usb_rx_pending = true;
+}
+
+// Consume a flag set from interrupt context
+static bool take_flag(volatile bool *flag) {
+    if (!*flag) return false;
+    *flag = false;
+    return true;
+}
+
+// Catch a level change whose edge fell inside the debounce window (the
+// last bounce of a release, say) and left the button looking held
+static void buttons_resync(uint32_t now) {
+    uint32_t irq = save_and_disable_interrupts();
+    for (int i = 0; i < 2; i++) {
+        button_update(&buttons[i], now);
     }
+    restore_interrupts(irq);
 }
 
-// Dispatch an action through the reducer
-static void dispatch(Action action) {
+// Reduce all queued actions, then apply side effects (and render) once
+static void dispatch_flush(void) {
+    if (action_queue.count == 0) return;
+
     AppState old_state = current_state;
+    trace_begin(TRACE_DISPATCH);
+    perf_ring_reset(&perf_ui, perf_cycles());
 
     // Run through pure reducer
-    current_state = reduce(&current_state, &action);
+    action_queue_reduce(&action_queue, &current_state);
+    perf_ring_lap(&perf_ui, PERF_UI_REDUCE, perf_cycles());
 
     // Apply side effects only if state changed
     if (app_state_dirty(&old_state, &current_state)) {
         side_effects_apply(&hw_context, &old_state, &current_state);
     }
+    uint32_t now = perf_cycles();
+    perf_ring_lap(&perf_ui, PERF_UI_EFFECTS, now);
+    perf_ring_commit(&perf_ui, now);
+    trace_end(TRACE_DISPATCH);
+}
+
+// Queue an action for this main-loop iteration's reduce pass
+static void dispatch(Action action) {
+    if (!action_queue_push(&action_queue, &action)) {
+        // Burst bigger than the queue: reduce what's there, then queue
+        dispatch_flush();
+        action_queue_push(&action_queue, &action);
+    }
+}
+
+// Playback health for the perf view: Core 1's counters plus per-stage
+// averages from its telemetry ring
+static void dispatch_perf_stats(uint32_t now_us) {
+    __dmb();
+    play_stats_t play = fseq_player_ctx.play;
+    uint32_t avg_us[PERF_PLAY_STAGES] = {0};
+    perf_averages_us(&perf_play, avg_us);
+    dispatch(action_perf_stats(now_us, fseq_player_ctx.fps, fseq_player_ctx.target_fps,
+                               play.late, play.dropped, play.sd_kbps,
+                               (uint16_t)avg_us[PERF_PLAY_READ],
+                               (uint16_t)avg_us[PERF_PLAY_PARSE],
+                               (uint16_t)avg_us[PERF_PLAY_ENCODE],
+                               play.core1_pct));
+}
+
+// Effects frame budget: render + encode averages from Core 1's telemetry
+// ring, as a share of the 60 fps frame time
+static void dispatch_effects_stats(uint32_t now_us) {
+    uint32_t avg_us[PERF_PLAY_STAGES] = {0};
+    perf_averages_us(&perf_play, avg_us);
+    uint32_t busy_us = avg_us[PERF_PLAY_PARSE] + avg_us[PERF_PLAY_ENCODE];
+    uint32_t load_pct = busy_us * 100 / (1000000 / EFFECTS_TARGET_FPS);
+    dispatch(action_effects_stats(now_us, effects_player_get_fps(&effects_player_ctx),
+                                  (uint16_t)avg_us[PERF_PLAY_PARSE],
+                                  (uint16_t)avg_us[PERF_PLAY_ENCODE],
+                                  (uint8_t)(load_pct > 255 ? 255 : load_pct)));
+}
+
+// String discovery answers once per press; a long press answers the rest
+// of the round instead of repeating
+static bool string_discovery_running(void) {
+    return current_state.in_detail_view &&
+           current_state.menu_selection == MENU_STRING_DISCOVERY &&
+           current_state.string_discovery.run_state == TEST_RUNNING;
+}
+
+// Map a key event to actions. Held NEXT steps through the menu and held
+// brightness keys ramp; everything else acts once per press. Holding SELECT
+// or NEXT during string discovery answers lit or dark for the whole round.
+static void handle_key(const input_event_t *ev) {
+    uint32_t ts = ev->time_us;
+
+    if (ev->source == INPUT_SRC_BUTTON) {
+        bool lit = ev->code == BTN_SELECT_PIN;
+        if (ev->code != BTN_SELECT_PIN && ev->code != BTN_NEXT_PIN) return;
+
+        if (ev->kind == INPUT_KEY_LONG) {
+            dispatch(action_string_discovery_answer_round(ts, lit));
+        } else if (ev->kind == INPUT_KEY_PRESS) {
+            dispatch(lit ? action_button_select(ts) : action_button_next(ts));
+        } else if (!lit && !string_discovery_running()) {
+            dispatch(action_button_next(ts));
+        }
+        return;
+    }
+
+    switch (ev->code) {
+        case BRIGHTNESS_UP:
+            if (ev->kind != INPUT_KEY_LONG) dispatch(action_brightness_up(ts));
+            return;
+        case BRIGHTNESS_DN:
+            if (ev->kind != INPUT_KEY_LONG) dispatch(action_brightness_down(ts));
+            return;
+    }
+
+    if (ev->kind != INPUT_KEY_PRESS) return;
+    switch (ev->code) {
+        case POWER:
+            dispatch(action_power_toggle(ts));
+            break;
+        case PLAY:
+            dispatch(action_fseq_next(ts));
+            break;
+        case AUTO:
+            dispatch(action_auto_toggle(ts));
+            break;
+        case FADE3:
+            dispatch(action_interp_toggle(ts));
+            break;
+        case DIY1:
+            dispatch(action_effects_start(ts, EFFECT_COLOR_WIPE, false));
+            break;
+        case DIY2:
+            dispatch(action_effects_start(ts, EFFECT_CHASE, false));
+            break;
+        case DIY3:
+            dispatch(action_effects_start(ts, EFFECT_TWINKLE, false));
+            break;
+        case DIY4:
+            dispatch(action_effects_start(ts, EFFECT_FIRE, false));
+            break;
+        case DIY5:
+            dispatch(action_effects_start(ts, EFFECT_PLASMA, false));
+            break;
+        case DIY6:
+            dispatch(action_effects_start(ts, EFFECT_NOISE, false));
+            break;
+        case FLASH:
+            // Cycling show, as run when there's no SD card
+            dispatch(action_effects_start(ts, EFFECT_COLOR_WIPE, true));
+            break;
+    }
+}
+
+// Drain raw input in order, then the tracker's time-based events
+static void process_input(uint32_t now) {
+    input_event_t raw;
+    input_event_t keys[INPUT_MAX_HELD * 2];
+    int n;
+
+    buttons_resync(now);
+    while (input_ring_pop(&input_ring, &raw)) {
+        n = input_tracker_feed(&input_tracker, &raw, keys);
+        for (int i = 0; i < n; i++) handle_key(&keys[i]);
+    }
+    n = input_tracker_poll(&input_tracker, now, keys, INPUT_MAX_HELD * 2);
+    for (int i = 0; i < n; i++) handle_key(&keys[i]);
 }
 
 int main() {
     stdio_init_all();
-    sleep_ms(2000);
+    trace_init();
+    flash_io_init();
+    perf_counter_init();
+    boot_timing_mark("stdio");
     printf("Pixel_Blit starting (reactive architecture)...\n");
 
     // Initialize I2C for display
@@ -184,6 +500,7 @@ int main() {
     } else {
         printf("Failed to init OLED at 0x%02X\n", OLED_ADDR);
     }
+    boot_timing_mark("display");
 
     // Initialize buttons
     gpio_init(BTN_SELECT_PIN);
@@ -200,47 +517,65 @@ int main() {
     adc_init();
     adc_gpio_init(BOARD_ADDR_ADC_GPIO);
 
-    // Read board ID and load configuration from SD card
+    // Read board ID and load configuration from SD card. The ladder is
+    // only read here; config.csv can override it.
     // Delay for ADC settling after init
     sleep_ms(100);
     uint16_t adc_sample = sample_board_address_adc();
     uint8_t board_id;
     uint16_t adc_error, adc_margin;
     decode_board_address(adc_sample, &board_id, &adc_error, &adc_margin);
-    printf("Board ID: %u (ADC: %u, err: %u, margin: %u)\n",
+    ladder_board_id = board_id;
+    printf("Board ladder ID: %u (ADC: %u, err: %u, margin: %u)\n",
            board_id, adc_sample, adc_error, adc_margin);
+    boot_timing_mark("board_id");
 
     // Configure SD card library to use DMA_IRQ_1 BEFORE first SD access
     // (IRQ_0 is used by pb_led_driver)
     set_spi_dma_irq_channel(true, true);  // useChannel1=true, shared=true
+    trace_install_sd_irq_hooks();
 
-    board_config_load_result_t config_result = board_config_load_from_sd(board_id);
-    if (!config_result.success) {
-        printf("Config: %s - using defaults\n", config_result.error_msg);
-
-        // Show error on display and wait for button
-        if (display_ready) {
-            char line[24];
-            sh1106_clear(&display);
-            sh1106_draw_string(&display, 0, 0, "Config Error", false);
-            sh1106_draw_string(&display, 0, 16, config_result.error_msg, false);
-            snprintf(line, sizeof(line), "Board ID: %u", board_id);
-            sh1106_draw_string(&display, 0, 32, line, false);
-            sh1106_draw_string(&display, 0, 48, "Using defaults", false);
-            sh1106_draw_string(&display, 0, 56, "Press button...", false);
-            sh1106_render(&display);
-
-            // Wait for button press
-            while (gpio_get(BTN_SELECT_PIN) && gpio_get(BTN_NEXT_PIN)) {
-                tight_loop_contents();
+    // Fast path: compiled config snapshot from flash, checked against the
+    // card later. Otherwise parse config.csv now and snapshot it.
+    if (config_cache_load(board_id, &config_hash)) {
+        config_revalidate_pending = true;
+        printf("Config: Cached snapshot - %u strings, max %u pixels\n",
+               g_board_config.string_count, g_board_config.max_pixel_count);
+    } else {
+        board_config_load_result_t config_result = board_config_load_from_sd(board_id);
+        if (!config_result.success) {
+            printf("Config: %s - using defaults\n", config_result.error_msg);
+
+            // Show error on display and wait for button
+            if (display_ready) {
+                char line[24];
+                sh1106_clear(&display);
+                sh1106_draw_string(&display, 0, 0, "Config Error", false);
+                sh1106_draw_string(&display, 0, 16, config_result.error_msg, false);
+                snprintf(line, sizeof(line), "Board ID: %u", board_id);
+                sh1106_draw_string(&display, 0, 32, line, false);
+                sh1106_draw_string(&display, 0, 48, "Using defaults", false);
+                sh1106_draw_string(&display, 0, 56, "Press button...", false);
+                sh1106_render(&display);
+
+                // Wait for button press
+                while (gpio_get(BTN_SELECT_PIN) && gpio_get(BTN_NEXT_PIN)) {
+                    tight_loop_contents();
+                }
+                // Debounce
+                sleep_ms(200);
             }
-            // Debounce
-            sleep_ms(200);
+        } else {
+            printf("Config: Loaded %u strings, max %u pixels\n",
+                   g_board_config.string_count, g_board_config.max_pixel_count);
+            config_hash = config_result.config_hash;
+            config_cache_save(config_hash);
         }
-    } else {
-        printf("Config: Loaded %u strings, max %u pixels\n",
-               g_board_config.string_count, g_board_config.max_pixel_count);
     }
+    if (g_board_config.board_id_from_config) {
+        printf("Board ID: %u (config.csv)\n", g_board_config.board_id);
+    }
+    boot_timing_mark("config");
 
     // Initialize test modules
     if (!string_test_init(&string_test_ctx, STRING_OUT_BASE_PIN)) {
@@ -258,6 +593,14 @@ int main() {
     if (!fseq_player_init(&fseq_player_ctx, STRING_OUT_BASE_PIN)) {
         printf("FSEQ player init failed\n");
     }
+    if (!usb_stream_init(&usb_stream_ctx, STRING_OUT_BASE_PIN)) {
+        printf("USB stream init failed\n");
+    }
+    if (!effects_player_init(&effects_player_ctx, STRING_OUT_BASE_PIN)) {
+        printf("Effects player init failed\n");
+    }
+    flash_cache_init(&flash_cache_ctx);
+    boot_timing_mark("modules");
 
     // Setup hardware context
     hw_context.display = &display;
@@ -266,11 +609,18 @@ int main() {
     hw_context.rainbow_test = &rainbow_test_ctx;
     hw_context.string_length_test = &string_length_test_ctx;
     hw_context.fseq_player = &fseq_player_ctx;
+    hw_context.usb_stream = &usb_stream_ctx;
+    hw_context.flash_cache = &flash_cache_ctx;
 
     // Initialize and launch Core 1 task system
-    core1_task_init(&fseq_player_ctx, &rainbow_test_ctx);
+    core1_task_init(&fseq_player_ctx, &rainbow_test_ctx, &usb_stream_ctx, &flash_cache_ctx,
+                    &effects_player_ctx);
     multicore_launch_core1(core1_main);
+
+    // Allow Core 1 to pause us for flash operations (cache installs, serviced writes)
+    flash_safe_execute_core_init();
     printf("Core 1 launched\n");
+    boot_timing_mark("core1");
 
     // Load saved settings and initialize application state
     flash_settings_t saved_settings;
@@ -280,21 +630,25 @@ int main() {
             saved_settings.was_playing,
             saved_settings.playing_index,
             saved_settings.auto_loop);
+        side_effects_set_resume(saved_settings.playing_index, saved_settings.resume_frame);
     } else {
         current_state = app_state_init();
     }
+    boot_timing_mark("settings");
 
     // Initialize IR receiver
-    ir_init(IR_PIN);
-    printf("IR receiver initialized on GPIO %d\n", IR_PIN);
-
-    // Setup GPIO interrupts (combined callback for buttons and IR)
-    gpio_set_irq_enabled_with_callback(BTN_SELECT_PIN, GPIO_IRQ_EDGE_FALL, true, gpio_isr);
-    gpio_set_irq_enabled(BTN_NEXT_PIN, GPIO_IRQ_EDGE_FALL, true);
-    gpio_set_irq_enabled(IR_PIN, GPIO_IRQ_EDGE_FALL, true);
+    input_ring_init(&input_ring);
+    input_tracker_init(&input_tracker);
+    if (ir_init(IR_PIN, &input_ring)) {
+        printf("IR receiver initialized on GPIO %d\n", IR_PIN);
+    } else {
+        printf("IR receiver: no PIO state machine free\n");
+    }
 
-    // Give GPIO interrupts highest priority for reliable IR reception
-    irq_set_priority(IO_IRQ_BANK0, 0x00);
+    // Button interrupts on both edges: release ends repeat / long press
+    gpio_set_irq_enabled_with_callback(BTN_SELECT_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE,
+                                       true, gpio_isr);
+    gpio_set_irq_enabled(BTN_NEXT_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
 
     // Set initial brightness from loaded state
     uint8_t init_brightness = current_state.brightness_level;
@@ -305,52 +659,39 @@ int main() {
     // Render initial view
     views_render(&display, &current_state);
 
-    // Timing
-    absolute_time_t last_tick_1s = get_absolute_time();
-    absolute_time_t last_display_refresh = get_absolute_time();
-    absolute_time_t last_board_addr_sample = get_absolute_time();
+    // The boot reading is the only one (shown on the Board Address view)
+    dispatch(action_board_address_updated(time_us_32(), adc_sample, board_id,
+                                          adc_error, adc_margin));
+
+    // Periodic work, all on the default alarm pool (shared with the LED
+    // driver's reset alarm). Callbacks only raise flags; the interrupt
+    // wakes the loop.
+    add_repeating_timer_us(TICK_1S_US, set_due_flag, (void *)&tick_1s_due, &tick_1s_timer);
+    add_repeating_timer_us(DISPLAY_REFRESH_US, set_due_flag, (void *)&display_refresh_due,
+                           &display_refresh_timer);
+    stdio_set_chars_available_callback(usb_rx_available, NULL);
 
     printf("Entering main loop\n");
+    boot_timing_mark("main_loop");
+    bool boot_show_marked = false;
+    bool boot_timing_printed = false;
 
     while (true) {
         uint32_t now_us = time_us_32();
-        absolute_time_t now = get_absolute_time();
+        uint32_t version_at_start = current_state.version;
 
-        // Handle button presses
-        if (select_pressed) {
-            select_pressed = false;
-            dispatch(action_button_select(now_us));
-        }
-        if (next_pressed) {
-            next_pressed = false;
-            dispatch(action_button_next(now_us));
-        }
+        // Buttons and IR remote, in the order they happened
+        process_input(now_us);
 
-        // Handle IR remote commands
-        uint8_t ir_code;
-        if (ir_get_next_command(&ir_code)) {
-            switch (ir_code) {
-                case POWER:
-                    dispatch(action_power_toggle(now_us));
-                    break;
-                case PLAY:
-                    dispatch(action_fseq_next(now_us));
-                    break;
-                case AUTO:
-                    dispatch(action_auto_toggle(now_us));
-                    break;
-                case BRIGHTNESS_UP:
-                    dispatch(action_brightness_up(now_us));
-                    break;
-                case BRIGHTNESS_DN:
-                    dispatch(action_brightness_down(now_us));
-                    break;
-            }
+        // USB console commands (stdin belongs to the live stream while it runs)
+        if (current_state.usb_stream.run_state != TEST_RUNNING && take_flag(&usb_rx_pending)) {
+            poll_usb_commands();
         }
 
-        // SD Card Scan - when entering SD view OR auto-play pending on boot
+        // SD Card Scan - when entering SD / flash cache view OR auto-play pending on boot
         bool need_scan_for_view = current_state.in_detail_view &&
-                                  current_state.menu_selection == MENU_SD_CARD &&
+                                  (current_state.menu_selection == MENU_SD_CARD ||
+                                   current_state.menu_selection == MENU_FLASH_CACHE) &&
                                   current_state.sd_card.needs_scan;
         bool need_scan_for_autoplay = current_state.sd_card.auto_play_pending &&
                                       !current_state.sd_card.mounted;
@@ -360,6 +701,10 @@ int main() {
 
             switch (scan.result) {
                 case SD_OPS_OK:
+                    // Config must be settled before auto-play starts the show
+                    if (config_revalidate_pending && core1_is_idle()) {
+                        revalidate_board_config();
+                    }
                     dispatch(action_sd_card_mounted(now_us));
                     dispatch(action_sd_files_loaded(now_us, scan.file_count));
                     break;
@@ -372,58 +717,112 @@ int main() {
             }
         }
 
-        // 1 second tick
-        if (absolute_time_diff_us(last_tick_1s, now) >= TICK_1S_US) {
-            last_tick_1s = now;
-            dispatch(action_tick_1s(now_us));
+        // Write the string discovery results once every length is known
+        if (current_state.string_discovery.save_pending) {
+            const char* error = board_config_save_lengths(current_state.string_length.lengths);
+            dispatch(action_string_discovery_saved(now_us, error ? error : "Saved"));
         }
 
-        // Sample board address periodically (every 100ms)
-        if (absolute_time_diff_us(last_board_addr_sample, now) >= 100000) {
-            last_board_addr_sample = now;
+        if (!boot_show_marked && current_state.sd_card.is_playing) {
+            boot_show_marked = true;
+            boot_timing_mark("show");
+        }
 
-            uint16_t adc_value = sample_board_address_adc();
-            uint8_t code;
-            uint16_t error, margin;
-            decode_board_address(adc_value, &code, &error, &margin);
+        // 1 second tick
+        if (take_flag(&tick_1s_due)) {
+            dispatch(action_tick_1s(now_us));
 
-            dispatch(action_board_address_updated(now_us, adc_value, code, error, margin));
+            // Boot log is buffered until a host is listening
+            if (!boot_timing_printed && stdio_usb_connected()) {
+                boot_timing_printed = true;
+                boot_timing_print();
+            }
         }
 
         // Periodic FPS update for rainbow test display
-        if (current_state.in_detail_view &&
-            current_state.menu_selection == MENU_RAINBOW_TEST &&
-            absolute_time_diff_us(last_display_refresh, now) >= DISPLAY_REFRESH_US) {
-            last_display_refresh = now;
+        bool refresh_due = take_flag(&display_refresh_due);
+        if (refresh_due && current_state.in_detail_view &&
+            current_state.menu_selection == MENU_RAINBOW_TEST) {
             uint16_t fps = rainbow_test_get_fps(hw_context.rainbow_test);
             if (fps != current_state.rainbow_test.fps) {
                 dispatch(action_rainbow_frame_complete(now_us, fps));
             }
         }
 
+        // Periodic stats update for USB stream display
+        if (refresh_due && current_state.in_detail_view &&
+            current_state.menu_selection == MENU_USB_STREAM) {
+            dispatch(action_usb_stream_stats(now_us,
+                                             usb_stream_get_fps(hw_context.usb_stream),
+                                             usb_stream_ctx.frames));
+        }
+
+        // Periodic frame budget update for effects display
+        if (refresh_due && current_state.in_detail_view &&
+            current_state.menu_selection == MENU_EFFECTS) {
+            dispatch_effects_stats(now_us);
+        }
+
+        // Periodic playback health update for perf display
+        if (refresh_due && current_state.in_detail_view &&
+            current_state.menu_selection == MENU_PERF) {
+            dispatch_perf_stats(now_us);
+        }
+
+        // Periodic install progress / usage update for flash cache display
+        if (refresh_due && current_state.in_detail_view &&
+            current_state.menu_selection == MENU_FLASH_CACHE) {
+            __dmb();
+            bool installing = flash_cache_ctx.status == FLASH_CACHE_INSTALLING;
+            dispatch(action_flash_cache_status(now_us, installing,
+                                               flash_cache_ctx.progress,
+                                               flash_cache_count(),
+                                               flash_cache_free_kb(),
+                                               flash_cache_ctx.message));
+        }
+
         // Check for FSEQ loop completion (for auto-advance mode)
         {
             static uint32_t last_observed_loop_count = 0;
             static uint8_t last_playing_index = 255;
 
-            // Reset loop counter when file changes (manual skip or auto-advance)
+            // The count never resets (a gapless switch doesn't restart the
+            // task), so loops are counted from when the file changed
+            uint32_t loop_count = core1_get_fseq_loop_count();
             if (current_state.sd_card.playing_index != last_playing_index) {
-                last_observed_loop_count = 0;
+                last_observed_loop_count = loop_count;
                 last_playing_index = current_state.sd_card.playing_index;
             }
 
             if (current_state.sd_card.is_playing && current_state.sd_card.auto_loop) {
-                uint32_t loop_count = core1_get_fseq_loop_count();
-                if (loop_count > last_observed_loop_count) {
+                if (loop_count != last_observed_loop_count) {
                     last_observed_loop_count = loop_count;
                     dispatch(action_fseq_loop_complete(now_us));
                 }
+            } else {
+                last_observed_loop_count = loop_count;
             }
         }
 
+        // One reduce / side effects / render pass for everything queued above
+        dispatch_flush();
+
+        // Send display updates in the background (coalesced)
+        sh1106_poll(&display);
+
         // Run test module tasks (for string_test and toggle_test timing)
         side_effects_tick(&hw_context, &current_state);
 
-        tight_loop_contents();
+        // Sleep until an interrupt (timers, buttons, IR, USB) or an event
+        // from Core 1, unless something here still has to be polled. The
+        // event register latches anything that arrives before the WFE.
+        bool state_changed = current_state.version != version_at_start;
+        bool polling = display.busy || display.pending ||
+                       input_tracker_busy(&input_tracker) ||
+                       current_state.string_test.run_state == TEST_RUNNING ||
+                       current_state.toggle_test.run_state == TEST_RUNNING;
+        if (!state_changed && !polling) {
+            __wfe();
+        }
     }
 }
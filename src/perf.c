@@ -0,0 +1,177 @@
+#include "perf.h"
+#include <string.h>
+
+#ifndef PERF_TEST_BUILD
+#include "hardware/clocks.h"
+#include "hardware/structs/m33.h"
+#include <stdio.h>
+#endif
+
+// Orders the record copy against head on both sides (a DMB on the M33)
+#define PERF_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+// ============================================================================
+// Pure functions (no I/O, testable on host)
+// ============================================================================
+
+void perf_ring_init(perf_ring_t* ring, const char* name,
+                    const char* const* stage_names, uint8_t stage_count) {
+    memset(ring, 0, sizeof(*ring));
+    ring->name = name;
+    ring->stage_names = stage_names;
+    ring->stage_count = stage_count > PERF_MAX_STAGES ? PERF_MAX_STAGES : stage_count;
+}
+
+void perf_ring_lap(perf_ring_t* ring, uint8_t stage, uint32_t now) {
+    if (stage < PERF_MAX_STAGES) ring->current.cycles[stage] += now - ring->mark;
+    ring->mark = now;
+}
+
+void perf_ring_commit(perf_ring_t* ring, uint32_t now) {
+    uint32_t head = ring->head;
+    ring->records[head & (PERF_RING_SIZE - 1)] = ring->current;
+    PERF_BARRIER();
+    ring->head = head + 1;
+
+    memset(&ring->current, 0, sizeof(ring->current));
+    ring->mark = now;
+}
+
+void perf_ring_reset(perf_ring_t* ring, uint32_t now) {
+    memset(&ring->current, 0, sizeof(ring->current));
+    ring->mark = now;
+}
+
+uint32_t perf_ring_snapshot(const perf_ring_t* ring, perf_record_t* out, uint32_t max) {
+    uint32_t head = ring->head;
+    PERF_BARRIER();
+
+    uint32_t n = head < PERF_RING_SIZE ? head : PERF_RING_SIZE;
+    if (n > max) n = max;
+    uint32_t first = head - n;
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = ring->records[(first + i) & (PERF_RING_SIZE - 1)];
+    }
+
+    // Record h lives in the slot of record h - SIZE, so anything at or
+    // before (new head - SIZE) may have been overwritten mid-copy
+    PERF_BARRIER();
+    uint32_t now_head = ring->head;
+    uint32_t skip = 0;
+    if (now_head - first >= PERF_RING_SIZE) {
+        skip = now_head - first - PERF_RING_SIZE + 1;
+        if (skip > n) skip = n;
+        memmove(out, out + skip, (n - skip) * sizeof(*out));
+    }
+    return n - skip;
+}
+
+static uint32_t stage_cycles(const perf_record_t* r, uint8_t stage) {
+    if (stage != PERF_TOTAL) return stage < PERF_MAX_STAGES ? r->cycles[stage] : 0;
+    uint32_t total = 0;
+    for (int s = 0; s < PERF_MAX_STAGES; s++) total += r->cycles[s];
+    return total;
+}
+
+void perf_summarize(const perf_record_t* records, uint32_t count, uint8_t stage,
+                    perf_summary_t* out) {
+    memset(out, 0, sizeof(*out));
+    if (count == 0) return;
+    if (count > PERF_RING_SIZE) count = PERF_RING_SIZE;
+
+    // Sorted copy for the percentile (insertion sort, at most a ring's worth)
+    uint32_t sorted[PERF_RING_SIZE];
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t v = stage_cycles(&records[i], stage);
+        sum += v;
+        uint32_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    // Nearest rank: the smallest value at or above 99% of the records
+    uint32_t rank = (count * 99 + 99) / 100;
+    out->count = count;
+    out->min = sorted[0];
+    out->avg = (uint32_t)(sum / count);
+    out->p99 = sorted[rank - 1];
+    out->max = sorted[count - 1];
+}
+
+// ============================================================================
+// Hardware-dependent functions (only compiled for target)
+// ============================================================================
+
+#ifndef PERF_TEST_BUILD
+
+static const char* const play_stage_names[PERF_PLAY_STAGES] = {
+    "read", "parse", "encode", "dma", "pace",
+};
+
+static const char* const ui_stage_names[PERF_UI_STAGES] = {
+    "reduce", "effects",
+};
+
+perf_ring_t perf_play;
+perf_ring_t perf_ui;
+
+void perf_counter_init(void) {
+    // Core 0 sets up both rings before launching core 1
+    if (perf_play.stage_names == NULL) {
+        perf_ring_init(&perf_play, "play", play_stage_names, PERF_PLAY_STAGES);
+        perf_ring_init(&perf_ui, "ui", ui_stage_names, PERF_UI_STAGES);
+    }
+
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_cyccnt = 0;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+}
+
+uint32_t perf_cycles(void) {
+    return m33_hw->dwt_cyccnt;
+}
+
+uint32_t perf_cycles_to_us(uint32_t cycles) {
+    uint32_t per_us = clock_get_hz(clk_sys) / 1000000;
+    return per_us ? cycles / per_us : 0;
+}
+
+// Shared by the dump and the averages (both run on core 0)
+static perf_record_t records[PERF_RING_SIZE];
+
+uint32_t perf_averages_us(const perf_ring_t* ring, uint32_t* avg_us) {
+    uint32_t n = perf_ring_snapshot(ring, records, PERF_RING_SIZE);
+    for (uint8_t s = 0; s < ring->stage_count; s++) {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < n; i++) sum += records[i].cycles[s];
+        avg_us[s] = n ? perf_cycles_to_us((uint32_t)(sum / n)) : 0;
+    }
+    return n;
+}
+
+static void dump_ring(const perf_ring_t* ring) {
+    uint32_t n = perf_ring_snapshot(ring, records, PERF_RING_SIZE);
+    printf("Perf %s: last %lu records (us: min/avg/p99/max)\n", ring->name, (unsigned long)n);
+    if (n == 0) return;
+
+    for (uint8_t s = 0; s <= ring->stage_count; s++) {
+        uint8_t stage = s < ring->stage_count ? s : PERF_TOTAL;
+        perf_summary_t sum;
+        perf_summarize(records, n, stage, &sum);
+        printf("  %-8s %6lu %6lu %6lu %6lu\n",
+               stage == PERF_TOTAL ? "total" : ring->stage_names[s],
+               (unsigned long)perf_cycles_to_us(sum.min), (unsigned long)perf_cycles_to_us(sum.avg),
+               (unsigned long)perf_cycles_to_us(sum.p99), (unsigned long)perf_cycles_to_us(sum.max));
+    }
+}
+
+void perf_dump(void) {
+    dump_ring(&perf_play);
+    dump_ring(&perf_ui);
+}
+
+#endif // PERF_TEST_BUILD
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Per-frame performance telemetry.
+//
+// The loop being measured calls perf_ring_lap() at the end of each stage
+// with the current cycle count; the cycles since the previous lap go to that
+// stage. perf_ring_commit() closes the record and starts the next one. Laps
+// are contiguous, so a record's stages add up to the whole period between
+// commits (PERF_TOTAL in summaries).
+//
+// Each core owns one ring and is its only writer. Readers on either core take
+// a snapshot without locking: the writer publishes a record by bumping head
+// after filling it, and the reader drops any record the writer may have
+// lapped while it was copying.
+
+#define PERF_RING_SIZE   128     // Records kept per ring (power of two)
+#define PERF_MAX_STAGES  6
+#define PERF_TOTAL       0xFF    // Stage index for the sum of all stages
+
+_Static_assert((PERF_RING_SIZE & (PERF_RING_SIZE - 1)) == 0,
+               "PERF_RING_SIZE must be a power of two");
+
+typedef struct {
+    uint32_t cycles[PERF_MAX_STAGES];
+} perf_record_t;
+
+typedef struct {
+    const char* name;
+    const char* const* stage_names;
+    uint8_t stage_count;
+    perf_record_t records[PERF_RING_SIZE];
+    volatile uint32_t head;       // Records published (writer only)
+    perf_record_t current;        // Being filled by the writer
+    uint32_t mark;                // Cycle count at the last lap or commit
+} perf_ring_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t p99;
+    uint32_t max;
+} perf_summary_t;
+
+void perf_ring_init(perf_ring_t* ring, const char* name,
+                    const char* const* stage_names, uint8_t stage_count);
+
+// Charge the cycles since the last lap to stage
+void perf_ring_lap(perf_ring_t* ring, uint8_t stage, uint32_t now);
+
+// Publish the current record and start the next one at now
+void perf_ring_commit(perf_ring_t* ring, uint32_t now);
+
+// Forget recorded history (next record starts at now)
+void perf_ring_reset(perf_ring_t* ring, uint32_t now);
+
+// Copy up to max of the newest records, oldest first. Safe against a writer
+// on the other core. Returns the number copied.
+uint32_t perf_ring_snapshot(const perf_ring_t* ring, perf_record_t* out, uint32_t max);
+
+// min/avg/p99/max of one stage (or PERF_TOTAL) over records
+void perf_summarize(const perf_record_t* records, uint32_t count, uint8_t stage,
+                    perf_summary_t* out);
+
+// ============================================================================
+// Hardware-dependent functions (target only)
+// ============================================================================
+
+#ifndef PERF_TEST_BUILD
+
+// Core 1 playback stages
+enum {
+    PERF_PLAY_READ = 0,     // SD read
+    PERF_PLAY_PARSE,        // Decompress and decode (and encode, when decoding
+                            // straight to the driver)
+    PERF_PLAY_ENCODE,       // Bit-plane encode, blends
+    PERF_PLAY_DMA,          // Waiting for the previous frame's DMA
+    PERF_PLAY_PACE,         // Waiting for the frame's time slot
+    PERF_PLAY_STAGES
+};
+
+// Core 0 dispatch stages
+enum {
+    PERF_UI_REDUCE = 0,     // Reducer
+    PERF_UI_EFFECTS,        // Side effects (display, SD, task control)
+    PERF_UI_STAGES
+};
+
+extern perf_ring_t perf_play;     // Written by core 1, one record per output frame
+extern perf_ring_t perf_ui;       // Written by core 0, one record per dispatch
+
+// Start the DWT cycle counter on the calling core. Each core has its own;
+// call once from each.
+void perf_counter_init(void);
+
+// Cycle count of the calling core (wraps every ~28 s at 150 MHz)
+uint32_t perf_cycles(void);
+
+uint32_t perf_cycles_to_us(uint32_t cycles);
+
+// Average microseconds per stage over the ring's records (avg_us gets
+// ring->stage_count entries). Returns the number of records.
+uint32_t perf_averages_us(const perf_ring_t* ring, uint32_t* avg_us);
+
+// Print min/avg/p99/max per stage of both rings
+void perf_dump(void);
+
+#endif // PERF_TEST_BUILD
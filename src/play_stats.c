@@ -0,0 +1,39 @@
+#include "play_stats.h"
+#include <string.h>
+
+void play_tracker_reset(play_tracker_t* t, uint64_t now_us) {
+    memset(t, 0, sizeof(*t));
+    t->window_start_us = now_us;
+}
+
+void play_tracker_read(play_tracker_t* t, uint32_t bytes) {
+    t->window_bytes += bytes;
+}
+
+void play_tracker_frame(play_tracker_t* t, uint64_t now_us, uint32_t interval_us,
+                        uint32_t busy_us) {
+    t->stats.frames++;
+
+    if (t->last_output_us != 0 && interval_us > 0) {
+        uint64_t gap = now_us - t->last_output_us;
+        if (gap > interval_us + interval_us / 8) {
+            t->stats.late++;
+            // Slots the frame took, rounded, less its own
+            uint64_t slots = (gap + interval_us / 2) / interval_us;
+            if (slots > 1) t->stats.dropped += (uint32_t)(slots - 1);
+        }
+    }
+    t->last_output_us = now_us;
+
+    t->window_busy_us += busy_us;
+    uint64_t elapsed = now_us - t->window_start_us;
+    if (elapsed >= PLAY_STATS_WINDOW_US) {
+        // Bytes per ms = KB/s (1 KB = 1000 bytes)
+        t->stats.sd_kbps = (uint32_t)((uint64_t)t->window_bytes * 1000 / elapsed);
+        uint64_t pct = (uint64_t)t->window_busy_us * 100 / elapsed;
+        t->stats.core1_pct = (uint8_t)(pct > 100 ? 100 : pct);
+        t->window_start_us = now_us;
+        t->window_bytes = 0;
+        t->window_busy_us = 0;
+    }
+}
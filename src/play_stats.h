@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Playback health counters for the Perf view.
+//
+// The player reports each output frame (shown or held) with its time slot
+// and the Core 1 time spent producing it, and each SD read with its size.
+// A frame that goes out noticeably later than its slot is late; every whole
+// slot it overran is a dropped frame (the player never skips frames, so
+// the show falls behind by that much). Rates are taken over one-second
+// windows.
+
+#define PLAY_STATS_WINDOW_US 1000000
+
+typedef struct {
+    uint32_t frames;           // Frames output since the show started
+    uint32_t late;             // Frames out more than 1/8 slot late
+    uint32_t dropped;          // Whole frame slots lost to late frames
+    uint32_t sd_kbps;          // SD read rate over the last window, KB/s
+    uint8_t core1_pct;         // Core 1 busy (not waiting on DMA or pacing)
+} play_stats_t;
+
+typedef struct {
+    play_stats_t stats;        // Published (copied to the player context)
+    uint64_t last_output_us;   // 0 = no frame yet
+    uint64_t window_start_us;
+    uint32_t window_bytes;
+    uint32_t window_busy_us;
+} play_tracker_t;
+
+// Clear counters and start a window at now_us (show start)
+void play_tracker_reset(play_tracker_t* t, uint64_t now_us);
+
+// Count bytes read from the SD card
+void play_tracker_read(play_tracker_t* t, uint32_t bytes);
+
+// A frame went out at now_us. interval_us is the slot it was paced to,
+// busy_us the Core 1 work that went into it.
+void play_tracker_frame(play_tracker_t* t, uint64_t now_us, uint32_t interval_us,
+                        uint32_t busy_us);
@@ -8,6 +8,10 @@ static AppState stop_all_output(AppState state) {
     state.toggle_test.run_state = TEST_STOPPED;
     state.rainbow_test.run_state = TEST_STOPPED;
     state.string_length.run_state = TEST_STOPPED;
+    state.string_discovery.run_state = TEST_STOPPED;
+    state.usb_stream.run_state = TEST_STOPPED;
+    state.effects.run_state = TEST_STOPPED;
+    state.flash_cache.run_state = TEST_STOPPED;
     state.sd_card.is_playing = false;
     return state;
 }
@@ -26,6 +30,18 @@ static AppState stop_other_tests(AppState state, MenuEntry keep_running) {
     if (keep_running != MENU_STRING_LENGTH) {
         state.string_length.run_state = TEST_STOPPED;
     }
+    if (keep_running != MENU_STRING_DISCOVERY) {
+        state.string_discovery.run_state = TEST_STOPPED;
+    }
+    if (keep_running != MENU_USB_STREAM) {
+        state.usb_stream.run_state = TEST_STOPPED;
+    }
+    if (keep_running != MENU_EFFECTS) {
+        state.effects.run_state = TEST_STOPPED;
+    }
+    if (keep_running != MENU_FLASH_CACHE) {
+        state.flash_cache.run_state = TEST_STOPPED;
+    }
     return state;
 }
 
@@ -43,6 +59,26 @@ static AppState handle_select_menu(const AppState* state) {
             new_state.sd_card.needs_scan = true;
             new_state.sd_card.scroll_index = 0;
             break;
+        case MENU_FLASH_CACHE:
+            // Installs pick from the SD file list - rescan it
+            new_state.sd_card.needs_scan = true;
+            new_state.flash_cache.scroll_index = 0;
+            for(int i=0; i<24; i++) new_state.flash_cache.status_msg[i] = 0;
+            break;
+        case MENU_USB_STREAM:
+            // Stream and FSEQ playback both drive the LEDs from Core 1
+            new_state.sd_card.is_playing = false;
+            new_state.usb_stream.run_state = TEST_RUNNING;
+            new_state.usb_stream.fps = 0;
+            new_state.usb_stream.frames = 0;
+            break;
+        case MENU_EFFECTS:
+            // Effects also drive the LEDs from Core 1
+            new_state.sd_card.is_playing = false;
+            new_state.effects.run_state = TEST_RUNNING;
+            new_state.effects.cycle = false;
+            new_state.effects.fps = 0;
+            break;
         case MENU_STRING_TEST:
             new_state.string_test.run_state = TEST_RUNNING;
             break;
@@ -59,6 +95,14 @@ static AppState handle_select_menu(const AppState* state) {
             new_state.string_length.current_pixel = 0;
             // Don't reset lengths array - keep previous measurements
             break;
+        case MENU_STRING_DISCOVERY:
+            // Markers go out through the LED driver, like FSEQ playback
+            new_state.sd_card.is_playing = false;
+            new_state.string_discovery.run_state = TEST_RUNNING;
+            new_state.string_discovery.save_pending = false;
+            for(int i=0; i<24; i++) new_state.string_discovery.status_msg[i] = 0;
+            string_discovery_init(&new_state.string_discovery.search, STRING_DISCOVERY_MAX_PIXELS);
+            break;
         case MENU_SHUTDOWN:
             // Shutdown: power off immediately (don't enter detail view)
             new_state.in_detail_view = false;
@@ -66,13 +110,52 @@ static AppState handle_select_menu(const AppState* state) {
             new_state = stop_all_output(new_state);
             break;
         default:
-            // INFO and BOARD_ADDRESS just show detail view
+            // INFO, BOARD_ADDRESS and PERF just show detail view
             break;
     }
 
     return new_state;
 }
 
+// Once every length is known the search stops and the main loop writes the
+// results file
+static void finish_string_discovery(AppState* state) {
+    const string_discovery_t* search = &state->string_discovery.search;
+    if (!string_discovery_done(search)) return;
+
+    state->string_discovery.run_state = TEST_STOPPED;
+    state->string_discovery.save_pending = true;
+    // The String Length view shows them as recorded lengths
+    for (int i = 0; i < STRING_LENGTH_NUM_STRINGS; i++) {
+        state->string_length.lengths[i] = string_discovery_length(search, i);
+    }
+}
+
+// Answer for the string under the discovery cursor
+static AppState answer_string_discovery(const AppState* state, bool lit) {
+    AppState new_state = app_state_new_version(state);
+    string_discovery_t* search = &new_state.string_discovery.search;
+    new_state.string_discovery.answer_round = search->round;
+    string_discovery_answer(search, lit);
+    finish_string_discovery(&new_state);
+    return new_state;
+}
+
+// Long press: the rest of the round the press answered in gets the same
+// answer, so a uniformly wired board takes one hold per round
+static AppState handle_string_discovery_answer_round(const AppState* state, const Action* action) {
+    if (state->menu_selection != MENU_STRING_DISCOVERY || !state->in_detail_view ||
+        state->string_discovery.run_state != TEST_RUNNING) {
+        return *state;
+    }
+    AppState new_state = app_state_new_version(state);
+    string_discovery_answer_round(&new_state.string_discovery.search,
+                                  state->string_discovery.answer_round,
+                                  action->payload.discovery_round.lit);
+    finish_string_discovery(&new_state);
+    return new_state;
+}
+
 // Handle SELECT button in detail view
 static AppState handle_select_detail(const AppState* state) {
     switch (state->menu_selection) {
@@ -86,6 +169,22 @@ static AppState handle_select_detail(const AppState* state) {
             return new_state;
         }
 
+        case MENU_USB_STREAM: {
+            // Select stops streaming and exits
+            AppState new_state = app_state_new_version(state);
+            new_state.in_detail_view = false;
+            new_state.usb_stream.run_state = TEST_STOPPED;
+            return new_state;
+        }
+
+        case MENU_EFFECTS: {
+            // Select picks the next effect (doesn't exit), and ends the show
+            AppState new_state = app_state_new_version(state);
+            new_state.effects.effect = (state->effects.effect + 1) % EFFECT_COUNT;
+            new_state.effects.cycle = false;
+            return new_state;
+        }
+
         case MENU_RAINBOW_TEST: {
             // Select advances to next string (doesn't exit)
             AppState new_state = app_state_new_version(state);
@@ -117,6 +216,41 @@ static AppState handle_select_detail(const AppState* state) {
             return new_state;
         }
 
+        case MENU_FLASH_CACHE: {
+            // If installing, SELECT cancels
+            if (state->flash_cache.run_state == TEST_RUNNING) {
+                AppState new_state = app_state_new_version(state);
+                new_state.flash_cache.run_state = TEST_STOPPED;
+                return new_state;
+            }
+
+            uint8_t file_count = state->sd_card.file_count;
+
+            // SELECT on a file - install it (side effects look up the filename)
+            // Core 1 does the copy, so playback has to stop
+            if (state->flash_cache.scroll_index < file_count) {
+                AppState new_state = app_state_new_version(state);
+                new_state.sd_card.is_playing = false;
+                new_state.flash_cache.run_state = TEST_RUNNING;
+                new_state.flash_cache.install_index = state->flash_cache.scroll_index;
+                new_state.flash_cache.progress = 0;
+                return new_state;
+            }
+
+            // SELECT on [Clear Cache] - playback may be reading from flash
+            if (state->flash_cache.scroll_index == file_count) {
+                AppState new_state = app_state_new_version(state);
+                new_state.sd_card.is_playing = false;
+                new_state.flash_cache.clear_requests = state->flash_cache.clear_requests + 1;
+                return new_state;
+            }
+
+            // SELECT on [Main Menu] - exit
+            AppState new_state = app_state_new_version(state);
+            new_state.in_detail_view = false;
+            return new_state;
+        }
+
         case MENU_BRIGHTNESS: {
             // Cycle brightness 1->2->...->10->1
             AppState new_state = app_state_new_version(state);
@@ -155,6 +289,17 @@ static AppState handle_select_detail(const AppState* state) {
             return new_state;
         }
 
+        case MENU_STRING_DISCOVERY: {
+            // SELECT: the cursor string's marker is lit
+            if (state->string_discovery.run_state == TEST_RUNNING) {
+                return answer_string_discovery(state, true);
+            }
+            // Finished - exit
+            AppState new_state = app_state_new_version(state);
+            new_state.in_detail_view = false;
+            return new_state;
+        }
+
         case MENU_BOARD_ADDRESS:
         default: {
             // Exit detail view
@@ -201,6 +346,21 @@ static AppState handle_button_next(const AppState* state) {
             return new_state;
         }
 
+        // Special handling for Flash Cache
+        if (state->menu_selection == MENU_FLASH_CACHE) {
+            // If installing, NEXT cancels
+            if (state->flash_cache.run_state == TEST_RUNNING) {
+                AppState new_state = app_state_new_version(state);
+                new_state.flash_cache.run_state = TEST_STOPPED;
+                return new_state;
+            }
+            // Scroll through files, +2 for [Clear Cache] and [Main Menu]
+            AppState new_state = app_state_new_version(state);
+            uint8_t total_items = state->sd_card.file_count + 2;
+            new_state.flash_cache.scroll_index = (state->flash_cache.scroll_index + 1) % total_items;
+            return new_state;
+        }
+
         // Special handling for String Length tool
         if (state->menu_selection == MENU_STRING_LENGTH) {
             AppState new_state = app_state_new_version(state);
@@ -210,6 +370,12 @@ static AppState handle_button_next(const AppState* state) {
             return new_state;
         }
 
+        // String discovery: NEXT means the cursor string's marker is dark
+        if (state->menu_selection == MENU_STRING_DISCOVERY &&
+            state->string_discovery.run_state == TEST_RUNNING) {
+            return answer_string_discovery(state, false);
+        }
+
         // Default: Exit detail view and stop any running tests
         AppState new_state = app_state_new_version(state);
         new_state.in_detail_view = false;
@@ -217,6 +383,13 @@ static AppState handle_button_next(const AppState* state) {
         new_state.toggle_test.run_state = TEST_STOPPED;
         new_state.rainbow_test.run_state = TEST_STOPPED;
         new_state.string_length.run_state = TEST_STOPPED;
+        new_state.string_discovery.run_state = TEST_STOPPED;
+        new_state.usb_stream.run_state = TEST_STOPPED;
+        new_state.effects.run_state = TEST_STOPPED;
+        if (state->menu_selection == MENU_EFFECTS) {
+            // Leaving the fallback show gives up waiting for the SD card
+            new_state.sd_card.auto_play_pending = false;
+        }
         return new_state;
     } else {
         // Navigate to next menu item
@@ -230,6 +403,12 @@ static AppState handle_button_next(const AppState* state) {
 static AppState handle_tick_1s(const AppState* state) {
     AppState new_state = app_state_new_version(state);
     new_state.uptime_seconds = state->uptime_seconds + 1;
+
+    // Effects show moves on to the next effect
+    if (state->effects.run_state == TEST_RUNNING && state->effects.cycle &&
+        new_state.uptime_seconds % EFFECTS_SHOW_SECONDS == 0) {
+        new_state.effects.effect = (state->effects.effect + 1) % EFFECT_COUNT;
+    }
     return new_state;
 }
 
@@ -257,6 +436,19 @@ static AppState handle_sd_mounted(const AppState* state) {
     return new_state;
 }
 
+// Start the effects show in its view - the fallback when auto-play finds
+// nothing to play. Doesn't touch auto_play_pending.
+static AppState start_effects_show(AppState state) {
+    state = stop_all_output(state);
+    state.effects.run_state = TEST_RUNNING;
+    state.effects.effect = EFFECT_COLOR_WIPE;
+    state.effects.cycle = true;
+    state.effects.fps = 0;
+    state.menu_selection = MENU_EFFECTS;
+    state.in_detail_view = true;
+    return state;
+}
+
 // Handle SD Card Error
 static AppState handle_sd_error(const AppState* state, const Action* action) {
     AppState new_state = app_state_new_version(state);
@@ -266,6 +458,11 @@ static AppState handle_sd_error(const AppState* state, const Action* action) {
     for(int i=0; i<24; i++) {
         new_state.sd_card.status_msg[i] = action->payload.sd_error.message[i];
     }
+    // A show was wanted: run effects until the card comes back (auto-play
+    // stays pending, so the scan keeps retrying)
+    if (state->sd_card.auto_play_pending && state->effects.run_state != TEST_RUNNING) {
+        new_state = start_effects_show(new_state);
+    }
     return new_state;
 }
 
@@ -280,9 +477,13 @@ static AppState handle_sd_files(const AppState* state, const Action* action) {
     if(new_state.sd_card.file_count == 0) {
         const char* msg = "No .fseq files";
         for(int i=0; msg[i] && i<23; i++) new_state.sd_card.status_msg[i] = msg[i];
+        if (state->sd_card.auto_play_pending && state->effects.run_state != TEST_RUNNING) {
+            new_state = start_effects_show(new_state);
+        }
         new_state.sd_card.auto_play_pending = false;  // Can't auto-play with no files
     } else if (state->sd_card.auto_play_pending) {
         // Auto-play was requested (IR remote or saved settings restore)
+        new_state.effects.run_state = TEST_STOPPED;  // Fallback show, if running
         new_state.sd_card.is_playing = true;
         // Use saved playing_index, but bounds-check against current file count
         uint8_t saved_index = state->sd_card.playing_index;
@@ -310,6 +511,131 @@ static AppState handle_rainbow_frame_complete(const AppState* state, const Actio
     return new_state;
 }
 
+// Handle USB stream stats update
+static AppState handle_usb_stream_stats(const AppState* state, const Action* action) {
+    if (state->usb_stream.run_state != TEST_RUNNING ||
+        (state->usb_stream.fps == action->payload.usb_stream.fps &&
+         state->usb_stream.frames == action->payload.usb_stream.frames)) {
+        return *state;  // No change
+    }
+
+    AppState new_state = app_state_new_version(state);
+    new_state.usb_stream.fps = action->payload.usb_stream.fps;
+    new_state.usb_stream.frames = action->payload.usb_stream.frames;
+    return new_state;
+}
+
+// Handle flash cache status poll
+static AppState handle_flash_cache_status(const AppState* state, const Action* action) {
+    const FlashCacheState* fc = &state->flash_cache;
+    bool running = fc->run_state == TEST_RUNNING;
+    bool finished = running && !action->payload.flash_cache.installing;
+
+    bool same_msg = true;
+    for (int i = 0; i < 24; i++) {
+        if (fc->status_msg[i] != action->payload.flash_cache.message[i]) {
+            same_msg = false;
+            break;
+        }
+    }
+
+    if (!finished && same_msg &&
+        fc->progress == action->payload.flash_cache.progress &&
+        fc->cached_count == action->payload.flash_cache.cached_count &&
+        fc->free_kb == action->payload.flash_cache.free_kb) {
+        return *state;  // No change
+    }
+
+    AppState new_state = app_state_new_version(state);
+    if (finished) {
+        new_state.flash_cache.run_state = TEST_STOPPED;
+    }
+    new_state.flash_cache.progress = action->payload.flash_cache.progress;
+    new_state.flash_cache.cached_count = action->payload.flash_cache.cached_count;
+    new_state.flash_cache.free_kb = action->payload.flash_cache.free_kb;
+    for (int i = 0; i < 24; i++) {
+        new_state.flash_cache.status_msg[i] = action->payload.flash_cache.message[i];
+    }
+    return new_state;
+}
+
+// Handle playback health update
+static AppState handle_perf_stats(const AppState* state, const Action* action) {
+    const PerfViewState* p = &state->perf;
+    if (p->fps == action->payload.perf.fps &&
+        p->target_fps == action->payload.perf.target_fps &&
+        p->late == action->payload.perf.late &&
+        p->dropped == action->payload.perf.dropped &&
+        p->sd_kbps == action->payload.perf.sd_kbps &&
+        p->read_us == action->payload.perf.read_us &&
+        p->decode_us == action->payload.perf.decode_us &&
+        p->encode_us == action->payload.perf.encode_us &&
+        p->core1_pct == action->payload.perf.core1_pct) {
+        return *state;  // No change
+    }
+
+    AppState new_state = app_state_new_version(state);
+    new_state.perf.fps = action->payload.perf.fps;
+    new_state.perf.target_fps = action->payload.perf.target_fps;
+    new_state.perf.late = action->payload.perf.late;
+    new_state.perf.dropped = action->payload.perf.dropped;
+    new_state.perf.sd_kbps = action->payload.perf.sd_kbps;
+    new_state.perf.read_us = action->payload.perf.read_us;
+    new_state.perf.decode_us = action->payload.perf.decode_us;
+    new_state.perf.encode_us = action->payload.perf.encode_us;
+    new_state.perf.core1_pct = action->payload.perf.core1_pct;
+    return new_state;
+}
+
+// Handle effect start from the remote (any view)
+static AppState handle_effects_start(const AppState* state, const Action* action) {
+    if (action->payload.effects_start.effect >= EFFECT_COUNT) {
+        return *state;
+    }
+
+    AppState new_state = app_state_new_version(state);
+    new_state = stop_all_output(new_state);
+    new_state.sd_card.auto_play_pending = false;
+    new_state.effects.run_state = TEST_RUNNING;
+    new_state.effects.effect = action->payload.effects_start.effect;
+    new_state.effects.cycle = action->payload.effects_start.cycle;
+    if (state->effects.run_state != TEST_RUNNING) {
+        new_state.effects.fps = 0;
+    }
+    new_state.menu_selection = MENU_EFFECTS;
+    new_state.in_detail_view = true;
+    return new_state;
+}
+
+// Handle effects stats update
+static AppState handle_effects_stats(const AppState* state, const Action* action) {
+    const EffectsState* e = &state->effects;
+    if (e->run_state != TEST_RUNNING ||
+        (e->fps == action->payload.effects.fps &&
+         e->render_us == action->payload.effects.render_us &&
+         e->encode_us == action->payload.effects.encode_us &&
+         e->load_pct == action->payload.effects.load_pct)) {
+        return *state;  // No change
+    }
+
+    AppState new_state = app_state_new_version(state);
+    new_state.effects.fps = action->payload.effects.fps;
+    new_state.effects.render_us = action->payload.effects.render_us;
+    new_state.effects.encode_us = action->payload.effects.encode_us;
+    new_state.effects.load_pct = action->payload.effects.load_pct;
+    return new_state;
+}
+
+// Handle string discovery results saved (or failed)
+static AppState handle_string_discovery_saved(const AppState* state, const Action* action) {
+    AppState new_state = app_state_new_version(state);
+    new_state.string_discovery.save_pending = false;
+    for (int i = 0; i < 24; i++) {
+        new_state.string_discovery.status_msg[i] = action->payload.string_discovery.message[i];
+    }
+    return new_state;
+}
+
 // Handle power toggle (on/off)
 static AppState handle_power_toggle(const AppState* state) {
     AppState new_state = app_state_new_version(state);
@@ -389,6 +715,13 @@ static AppState handle_auto_toggle(const AppState* state) {
     return new_state;
 }
 
+// Handle frame interpolation toggle
+static AppState handle_interp_toggle(const AppState* state) {
+    AppState new_state = app_state_new_version(state);
+    new_state.sd_card.interpolate = !state->sd_card.interpolate;
+    return new_state;
+}
+
 // Handle FSEQ loop complete - advance to next file if auto_loop enabled
 static AppState handle_fseq_loop_complete(const AppState* state) {
     // Only advance if auto_loop is enabled and we're playing
@@ -450,6 +783,26 @@ AppState reduce(const AppState* state, const Action* action) {
         case ACTION_RAINBOW_FRAME_COMPLETE:
             return handle_rainbow_frame_complete(state, action);
 
+        case ACTION_USB_STREAM_STATS:
+            return handle_usb_stream_stats(state, action);
+
+        case ACTION_FLASH_CACHE_STATUS:
+            return handle_flash_cache_status(state, action);
+
+        case ACTION_PERF_STATS:
+            return handle_perf_stats(state, action);
+
+        case ACTION_STRING_DISCOVERY_SAVED:
+            return handle_string_discovery_saved(state, action);
+        case ACTION_STRING_DISCOVERY_ANSWER_ROUND:
+            return handle_string_discovery_answer_round(state, action);
+
+        case ACTION_EFFECTS_START:
+            return handle_effects_start(state, action);
+
+        case ACTION_EFFECTS_STATS:
+            return handle_effects_stats(state, action);
+
         case ACTION_FSEQ_NEXT:
             return handle_fseq_next(state);
 
@@ -462,6 +815,9 @@ AppState reduce(const AppState* state, const Action* action) {
         case ACTION_AUTO_TOGGLE:
             return handle_auto_toggle(state);
 
+        case ACTION_INTERP_TOGGLE:
+            return handle_interp_toggle(state);
+
         case ACTION_FSEQ_LOOP_COMPLETE:
             return handle_fseq_loop_complete(state);
 
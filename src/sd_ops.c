@@ -4,22 +4,189 @@
 #include "ff.h"
 #include "sd_card.h"
 #include "hw_config.h"
+#include "flash_cache.h"
 
 #include <stdio.h>
 #include <string.h>
 
+// Show metadata, parallel to sd_file_list
+static show_index_entry_t g_shows[SD_MAX_FILES];
+static uint8_t g_show_count = 0;
+
+// Stored index entries read at a time while matching (512 bytes of stack)
+#define SD_INDEX_CHUNK 8
+
+// Listed files whose entry came from the stored index (scan only)
+static bool g_reused[SD_MAX_FILES];
+
+// Directory info of each listed file (scan only)
+static uint32_t g_sizes[SD_MAX_FILES];
+static uint16_t g_fdates[SD_MAX_FILES];
+static uint16_t g_ftimes[SD_MAX_FILES];
+
+static bool is_fseq_name(const char *name) {
+    const char *dot = strrchr(name, '.');
+    return dot &&
+           (dot[1] == 'f' || dot[1] == 'F') &&
+           (dot[2] == 's' || dot[2] == 'S') &&
+           (dot[3] == 'e' || dot[3] == 'E') &&
+           (dot[4] == 'q' || dot[4] == 'Q') &&
+           dot[5] == 0;
+}
+
+// Open the stored index and read its header. Returns false if missing or
+// too big; the entries are checked as they're read.
+static bool open_index(FIL *file, show_index_header_t *header) {
+    if (f_open(file, SHOW_INDEX_PATH, FA_READ) != FR_OK) return false;
+
+    UINT n;
+    if (f_read(file, header, sizeof(*header), &n) == FR_OK && n == sizeof(*header) &&
+        header->count <= SD_MAX_FILES) {
+        return true;
+    }
+    f_close(file);
+    return false;
+}
+
+// Read an unchanged directory's stored entries straight into g_shows
+static bool load_index(FIL *file, const show_index_header_t *header) {
+    UINT n;
+    UINT len = header->count * sizeof(show_index_entry_t);
+    return f_read(file, g_shows, len, &n) == FR_OK && n == len &&
+           show_index_header_valid(header, g_shows, SD_MAX_FILES);
+}
+
+// Carry stored entries over to the listed files they still describe, reading
+// the index a chunk at a time. Nothing is carried over if its CRC fails.
+static void reuse_entries(FIL *file, const show_index_header_t *header, uint8_t count) {
+    show_index_entry_t chunk[SD_INDEX_CHUNK];
+    uint32_t crc = 0;
+    bool ok = true;
+
+    for (uint16_t done = 0; ok && done < header->count; ) {
+        uint16_t k = header->count - done;
+        if (k > SD_INDEX_CHUNK) k = SD_INDEX_CHUNK;
+        UINT n;
+        UINT len = k * sizeof(show_index_entry_t);
+        ok = f_read(file, chunk, len, &n) == FR_OK && n == len;
+        if (!ok) break;
+        crc = show_index_crc_add(crc, chunk, k);
+
+        for (uint16_t j = 0; j < k; j++) {
+            for (uint8_t i = 0; i < count; i++) {
+                if (!g_reused[i] &&
+                    show_index_entry_matches(&chunk[j], sd_file_list[i],
+                                             g_sizes[i], g_fdates[i], g_ftimes[i])) {
+                    g_shows[i] = chunk[j];
+                    g_reused[i] = true;
+                    break;
+                }
+            }
+        }
+        done += k;
+    }
+
+    if (!ok || !show_index_header_check(header, crc, SD_MAX_FILES)) {
+        memset(g_reused, 0, count);
+    }
+}
+
+static void save_index(uint8_t count, uint32_t signature) {
+    show_index_header_t header;
+    show_index_header_init(&header, g_shows, count, signature);
+
+    FIL file;
+    if (f_open(&file, SHOW_INDEX_PATH, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) {
+        printf("SD: Can't write show index\n");
+        return;
+    }
+    UINT n;
+    f_write(&file, &header, sizeof(header), &n);
+    f_write(&file, g_shows, count * sizeof(show_index_entry_t), &n);
+    f_close(&file);
+}
+
+// Open a show and read its header into a fresh index entry
+static void index_file(uint8_t i) {
+    char path[SD_FILENAME_LEN + 1];
+    snprintf(path, sizeof(path), "/%s", sd_file_list[i]);
+
+    uint8_t header[32];
+    UINT n = 0;
+    FIL file;
+    if (f_open(&file, path, FA_READ) == FR_OK) {
+        if (f_read(&file, header, sizeof(header), &n) != FR_OK) n = 0;
+        f_close(&file);
+    }
+    show_index_entry_init(&g_shows[i], sd_file_list[i], g_sizes[i], g_fdates[i], g_ftimes[i],
+                          header, n);
+}
+
+// Bring g_shows up to date with the listed files, reusing stored entries for
+// files that haven't changed
+static void update_index(uint8_t count, uint32_t signature) {
+    memset(g_reused, 0, count);
+
+    FIL file;
+    show_index_header_t header;
+    if (open_index(&file, &header)) {
+        if (header.dir_signature == signature && header.count == count) {
+            bool ok = load_index(&file, &header);
+            f_close(&file);
+            if (ok) {
+                printf("SD: Show index up to date (%u shows)\n", count);
+                return;
+            }
+        } else {
+            reuse_entries(&file, &header, count);
+            f_close(&file);
+        }
+    }
+
+    uint8_t reopened = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!g_reused[i]) {
+            index_file(i);
+            reopened++;
+        }
+    }
+
+    save_index(count, signature);
+    printf("SD: Show index rebuilt (%u shows, %u read)\n", count, reopened);
+}
+
 sd_ops_scan_result_t sd_ops_scan_fseq_files(void) {
     sd_ops_scan_result_t result = {
         .result = SD_OPS_OK,
         .file_count = 0,
     };
 
+    g_show_count = 0;
+
     sd_card_t *sd = sd_get_by_num(0);
     printf("SD: Mounting...\n");
     FRESULT fr = f_mount(&sd->fatfs, sd->pcName, 1);
     printf("SD: Mount Result = %d\n", fr);
 
     if (fr != FR_OK) {
+        // No card: offer the sequences installed in flash instead
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < flash_cache_count() && count < SD_MAX_FILES; i++) {
+            const char *name = flash_cache_name(i);
+            const seq_cache_entry_t *entry = flash_cache_lookup(name);
+            if (!entry) continue;  // Installed for another layout
+            strncpy(sd_file_list[count], name, SD_FILENAME_LEN - 1);
+            sd_file_list[count][SD_FILENAME_LEN - 1] = 0;
+            show_index_entry_init_bare(&g_shows[count], name, entry->frame_count,
+                                       (uint8_t)entry->step_time_ms);
+            printf("SD: Cached: %s\n", sd_file_list[count]);
+            count++;
+        }
+        if (count > 0) {
+            g_show_count = count;
+            result.file_count = count;
+            return result;
+        }
         result.result = SD_OPS_MOUNT_FAILED;
         return result;
     }
@@ -35,38 +202,39 @@ sd_ops_scan_result_t sd_ops_scan_fseq_files(void) {
         return result;
     }
 
-    // Read up to SD_MAX_FILES .fseq files into static buffer
+    // Read up to SD_MAX_FILES .fseq files into static buffer, hashing the
+    // directory entries as we go
     uint8_t count = 0;
+    uint32_t signature = show_index_signature_init();
 
     while (count < SD_MAX_FILES) {
         fr = f_readdir(&dir, &fno);
         if (fr != FR_OK || fno.fname[0] == 0) break;
 
-        // Skip hidden files and macOS resource forks (._*)
+        // Skip hidden files (including the index) and macOS resource forks (._*)
         if (fno.fname[0] == '.') continue;
+        if (!is_fseq_name(fno.fname)) continue;
 
-        // Check extension .fseq (case-insensitive)
-        char *dot = strrchr(fno.fname, '.');
-        if (dot) {
-            if ((dot[1] == 'f' || dot[1] == 'F') &&
-                (dot[2] == 's' || dot[2] == 'S') &&
-                (dot[3] == 'e' || dot[3] == 'E') &&
-                (dot[4] == 'q' || dot[4] == 'Q') &&
-                dot[5] == 0) {
-
-                // Copy filename to static buffer
-                for (int i = 0; i < SD_FILENAME_LEN - 1 && fno.fname[i]; i++) {
-                    sd_file_list[count][i] = fno.fname[i];
-                    sd_file_list[count][i+1] = 0;
-                }
-                printf("SD: Found: %s\n", sd_file_list[count]);
-                count++;
-            }
-        }
+        // Copy filename to static buffer
+        strncpy(sd_file_list[count], fno.fname, SD_FILENAME_LEN - 1);
+        sd_file_list[count][SD_FILENAME_LEN - 1] = 0;
+        g_sizes[count] = (uint32_t)fno.fsize;
+        g_fdates[count] = fno.fdate;
+        g_ftimes[count] = fno.ftime;
+        signature = show_index_signature_add(signature, sd_file_list[count],
+                                             g_sizes[count], fno.fdate, fno.ftime);
+        count++;
     }
     f_closedir(&dir);
 
     printf("SD: Total .fseq files: %d\n", count);
+    update_index(count, signature);
+    g_show_count = count;
     result.file_count = count;
     return result;
 }
+
+const show_index_entry_t *sd_ops_show_info(uint8_t index) {
+    if (index >= g_show_count) return NULL;
+    return &g_shows[index];
+}
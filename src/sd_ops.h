@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "show_index.h"
 
 // Result codes for SD operations
 typedef enum {
@@ -18,4 +19,10 @@ typedef struct {
 
 // Scan the SD card for .fseq files
 // Populates sd_file_list[] with filenames and returns result
+// If the card won't mount, lists the sequences cached in flash instead
+// Show metadata comes from the card's show index (see show_index.h),
+// which is rebuilt here when the directory has changed
 sd_ops_scan_result_t sd_ops_scan_fseq_files(void);
+
+// Metadata for sd_file_list[index] from the last scan, NULL if out of range
+const show_index_entry_t* sd_ops_show_info(uint8_t index);
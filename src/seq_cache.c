@@ -0,0 +1,320 @@
+#include "seq_cache.h"
+#include <string.h>
+#include <stddef.h>
+
+#define SECTOR_ALIGN_UP(x) (((x) + SEQ_CACHE_SECTOR_SIZE - 1) & ~(uint32_t)(SEQ_CACHE_SECTOR_SIZE - 1))
+
+// CRC32 (polynomial 0xEDB88320), incremental form. Start with 0xFFFFFFFF,
+// invert at the end.
+static uint32_t crc32_update(uint32_t crc, const uint8_t* data, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return crc;
+}
+
+static uint32_t crc32(const uint8_t* data, uint32_t len) {
+    return ~crc32_update(0xFFFFFFFF, data, len);
+}
+
+static uint32_t dir_crc(const seq_cache_dir_t* dir) {
+    return crc32((const uint8_t*)dir, offsetof(seq_cache_dir_t, crc));
+}
+
+static uint32_t entry_span(const seq_cache_entry_t* e) {
+    return SECTOR_ALIGN_UP(e->frame_size * e->frame_count);
+}
+
+static void dir_init_empty(seq_cache_dir_t* dir) {
+    memset(dir, 0, sizeof(*dir));
+    dir->magic = SEQ_CACHE_MAGIC;
+    dir->version = SEQ_CACHE_VERSION;
+}
+
+// Validate a directory copy read from flash
+static bool dir_valid(const seq_cache_dir_t* dir, uint32_t partition_size) {
+    if (dir->magic != SEQ_CACHE_MAGIC || dir->version != SEQ_CACHE_VERSION) return false;
+    if (dir->count > SEQ_CACHE_MAX_ENTRIES) return false;
+    if (dir->crc != dir_crc(dir)) return false;
+
+    for (uint16_t i = 0; i < dir->count; i++) {
+        const seq_cache_entry_t* e = &dir->entries[i];
+        uint64_t size = (uint64_t)e->frame_size * e->frame_count;
+        if (e->offset < SEQ_CACHE_DATA_OFFSET || size == 0) return false;
+        if ((uint64_t)e->offset + size > partition_size) return false;
+    }
+    return true;
+}
+
+void seq_cache_mount(seq_cache_t* c, const seq_cache_flash_t* flash) {
+    memset(c, 0, sizeof(*c));
+    c->flash = *flash;
+
+    // Pick the valid copy with the newest generation
+    bool found = false;
+    for (uint8_t slot = 0; slot < SEQ_CACHE_DIR_SECTORS; slot++) {
+        seq_cache_dir_t copy;
+        memcpy(&copy, c->flash.base + slot * SEQ_CACHE_SECTOR_SIZE, sizeof(copy));
+        if (!dir_valid(&copy, c->flash.size)) continue;
+        if (!found || (int32_t)(copy.generation - c->dir.generation) > 0) {
+            c->dir = copy;
+            c->dir_slot = slot;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        // First commit goes to slot 0
+        dir_init_empty(&c->dir);
+        c->dir_slot = 1;
+    }
+}
+
+const seq_cache_entry_t* seq_cache_find(const seq_cache_t* c, const char* name) {
+    if (!c || !name) return NULL;
+    for (uint16_t i = 0; i < c->dir.count; i++) {
+        if (strncmp(c->dir.entries[i].name, name, SEQ_CACHE_NAME_LEN) == 0) {
+            return &c->dir.entries[i];
+        }
+    }
+    return NULL;
+}
+
+const uint8_t* seq_cache_frame(const seq_cache_t* c, const seq_cache_entry_t* e,
+                               uint32_t frame) {
+    if (!c || !e || frame >= e->frame_count) return NULL;
+    return c->flash.base + e->offset + frame * e->frame_size;
+}
+
+uint8_t seq_cache_count(const seq_cache_t* c) {
+    return c ? (uint8_t)c->dir.count : 0;
+}
+
+// Find the first gap of at least need bytes, or the largest gap if need is 0.
+// Returns the gap offset and stores its size in gap_size.
+static uint32_t find_gap(const seq_cache_t* c, uint32_t need, uint32_t* gap_size) {
+    // Sort occupied ranges by offset (insertion sort, at most 16 entries)
+    const seq_cache_entry_t* sorted[SEQ_CACHE_MAX_ENTRIES];
+    uint16_t n = 0;
+    for (uint16_t i = 0; i < c->dir.count; i++) {
+        const seq_cache_entry_t* e = &c->dir.entries[i];
+        uint16_t j = n++;
+        while (j > 0 && sorted[j - 1]->offset > e->offset) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = e;
+    }
+
+    uint32_t best_offset = 0;
+    uint32_t best_size = 0;
+    uint32_t cursor = SEQ_CACHE_DATA_OFFSET;
+    for (uint16_t i = 0; i <= n; i++) {
+        uint32_t end = (i < n) ? sorted[i]->offset : c->flash.size;
+        uint32_t size = end > cursor ? end - cursor : 0;
+        if (need != 0 && size >= need) {
+            *gap_size = size;
+            return cursor;
+        }
+        if (size > best_size) {
+            best_size = size;
+            best_offset = cursor;
+        }
+        if (i < n) {
+            uint32_t next = sorted[i]->offset + entry_span(sorted[i]);
+            if (next > cursor) cursor = next;
+        }
+    }
+
+    *gap_size = (need == 0) ? best_size : 0;
+    return best_offset;
+}
+
+uint32_t seq_cache_largest_free(const seq_cache_t* c) {
+    if (!c) return 0;
+    uint32_t size = 0;
+    find_gap(c, 0, &size);
+    return size;
+}
+
+seq_cache_result_t seq_cache_begin(seq_cache_t* c, const char* name,
+                                   uint32_t frame_size, uint32_t frame_count,
+                                   uint16_t step_time_ms, uint32_t layout_hash) {
+    if (!c || !name || !name[0] || frame_size == 0 || frame_count == 0) {
+        return SEQ_CACHE_ERR_ARG;
+    }
+    if (strlen(name) >= SEQ_CACHE_NAME_LEN) return SEQ_CACHE_ERR_ARG;
+    if (c->writing) return SEQ_CACHE_ERR_STATE;
+
+    uint64_t size = (uint64_t)frame_size * frame_count;
+    if (size > c->flash.size) return SEQ_CACHE_ERR_FULL;
+
+    // Replacing keeps the slot count; a new name needs a free slot
+    if (!seq_cache_find(c, name) && c->dir.count >= SEQ_CACHE_MAX_ENTRIES) {
+        return SEQ_CACHE_ERR_FULL;
+    }
+
+    uint32_t need = SECTOR_ALIGN_UP((uint32_t)size);
+    uint32_t gap = 0;
+    uint32_t offset = find_gap(c, need, &gap);
+    if (gap < need) return SEQ_CACHE_ERR_FULL;
+
+    memset(&c->pending, 0, sizeof(c->pending));
+    strncpy(c->pending.name, name, SEQ_CACHE_NAME_LEN - 1);
+    c->pending.offset = offset;
+    c->pending.frame_size = frame_size;
+    c->pending.frame_count = frame_count;
+    c->pending.step_time_ms = step_time_ms;
+    c->pending.layout_hash = layout_hash;
+
+    c->writing = true;
+    c->write_pos = 0;
+    c->erased_end = offset;
+    c->crc = 0xFFFFFFFF;
+    c->page_len = 0;
+    return SEQ_CACHE_OK;
+}
+
+// Program the page buffer at the current write position, erasing ahead
+static seq_cache_result_t flush_page(seq_cache_t* c) {
+    uint32_t page_offset = c->pending.offset +
+                           ((c->write_pos - c->page_len) & ~(uint32_t)(SEQ_CACHE_PAGE_SIZE - 1));
+
+    if (page_offset >= c->erased_end) {
+        if (!c->flash.erase(c->flash.user, c->erased_end, SEQ_CACHE_SECTOR_SIZE)) {
+            return SEQ_CACHE_ERR_FLASH;
+        }
+        c->erased_end += SEQ_CACHE_SECTOR_SIZE;
+    }
+
+    // Pad a short final page with erased bytes
+    memset(&c->page[c->page_len], 0xFF, SEQ_CACHE_PAGE_SIZE - c->page_len);
+    if (!c->flash.program(c->flash.user, page_offset, c->page, SEQ_CACHE_PAGE_SIZE)) {
+        return SEQ_CACHE_ERR_FLASH;
+    }
+    c->page_len = 0;
+    return SEQ_CACHE_OK;
+}
+
+seq_cache_result_t seq_cache_write(seq_cache_t* c, const uint8_t* data, uint32_t len) {
+    if (!c || !c->writing) return SEQ_CACHE_ERR_STATE;
+    if (!data && len) return SEQ_CACHE_ERR_ARG;
+
+    uint32_t total = c->pending.frame_size * c->pending.frame_count;
+    if (len > total - c->write_pos) return SEQ_CACHE_ERR_ARG;
+
+    c->crc = crc32_update(c->crc, data, len);
+    while (len > 0) {
+        uint32_t n = SEQ_CACHE_PAGE_SIZE - c->page_len;
+        if (n > len) n = len;
+        memcpy(&c->page[c->page_len], data, n);
+        c->page_len += (uint16_t)n;
+        c->write_pos += n;
+        data += n;
+        len -= n;
+
+        if (c->page_len == SEQ_CACHE_PAGE_SIZE) {
+            seq_cache_result_t r = flush_page(c);
+            if (r != SEQ_CACHE_OK) {
+                c->writing = false;
+                return r;
+            }
+        }
+    }
+    return SEQ_CACHE_OK;
+}
+
+// Write a directory copy into the given slot and read it back
+static seq_cache_result_t write_dir(seq_cache_t* c, uint8_t slot, const seq_cache_dir_t* dir) {
+    uint32_t base = slot * SEQ_CACHE_SECTOR_SIZE;
+    if (!c->flash.erase(c->flash.user, base, SEQ_CACHE_SECTOR_SIZE)) {
+        return SEQ_CACHE_ERR_FLASH;
+    }
+
+    const uint8_t* src = (const uint8_t*)dir;
+    uint8_t page[SEQ_CACHE_PAGE_SIZE];
+    for (uint32_t pos = 0; pos < sizeof(*dir); pos += SEQ_CACHE_PAGE_SIZE) {
+        uint32_t n = sizeof(*dir) - pos;
+        if (n > SEQ_CACHE_PAGE_SIZE) n = SEQ_CACHE_PAGE_SIZE;
+        memset(page, 0xFF, sizeof(page));
+        memcpy(page, src + pos, n);
+        if (!c->flash.program(c->flash.user, base + pos, page, SEQ_CACHE_PAGE_SIZE)) {
+            return SEQ_CACHE_ERR_FLASH;
+        }
+    }
+
+    if (memcmp(c->flash.base + base, dir, sizeof(*dir)) != 0) {
+        return SEQ_CACHE_ERR_VERIFY;
+    }
+    return SEQ_CACHE_OK;
+}
+
+seq_cache_result_t seq_cache_commit(seq_cache_t* c) {
+    if (!c || !c->writing) return SEQ_CACHE_ERR_STATE;
+
+    uint32_t total = c->pending.frame_size * c->pending.frame_count;
+    if (c->write_pos != total) return SEQ_CACHE_ERR_STATE;
+
+    c->writing = false;
+    if (c->page_len > 0) {
+        seq_cache_result_t r = flush_page(c);
+        if (r != SEQ_CACHE_OK) return r;
+    }
+
+    // Verify the data as the player will see it
+    c->pending.data_crc = ~c->crc;
+    if (crc32(c->flash.base + c->pending.offset, total) != c->pending.data_crc) {
+        return SEQ_CACHE_ERR_VERIFY;
+    }
+
+    // Build the next directory: drop any entry with the same name, append
+    seq_cache_dir_t next;
+    dir_init_empty(&next);
+    for (uint16_t i = 0; i < c->dir.count; i++) {
+        if (strncmp(c->dir.entries[i].name, c->pending.name, SEQ_CACHE_NAME_LEN) != 0) {
+            next.entries[next.count++] = c->dir.entries[i];
+        }
+    }
+    next.entries[next.count++] = c->pending;
+    next.generation = c->dir.generation + 1;
+    next.crc = dir_crc(&next);
+
+    uint8_t slot = (uint8_t)(c->dir_slot ^ 1);
+    seq_cache_result_t r = write_dir(c, slot, &next);
+    if (r != SEQ_CACHE_OK) return r;
+
+    c->dir = next;
+    c->dir_slot = slot;
+    return SEQ_CACHE_OK;
+}
+
+void seq_cache_abort(seq_cache_t* c) {
+    if (!c) return;
+    c->writing = false;
+    c->page_len = 0;
+}
+
+seq_cache_result_t seq_cache_clear(seq_cache_t* c) {
+    if (!c) return SEQ_CACHE_ERR_ARG;
+    c->writing = false;
+    for (uint8_t slot = 0; slot < SEQ_CACHE_DIR_SECTORS; slot++) {
+        if (!c->flash.erase(c->flash.user, slot * SEQ_CACHE_SECTOR_SIZE, SEQ_CACHE_SECTOR_SIZE)) {
+            return SEQ_CACHE_ERR_FLASH;
+        }
+    }
+    dir_init_empty(&c->dir);
+    c->dir_slot = 1;
+    return SEQ_CACHE_OK;
+}
+
+uint32_t seq_cache_layout_hash(const uint16_t* string_lengths, uint8_t num_strings) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < num_strings; i++) {
+        hash = (hash ^ (uint8_t)string_lengths[i]) * 16777619u;
+        hash = (hash ^ (uint8_t)(string_lengths[i] >> 8)) * 16777619u;
+    }
+    return hash;
+}
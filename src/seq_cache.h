@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Flash-resident sequence cache.
+//
+// Stores this board's slice of one or more FSEQ sequences in a flash
+// partition so playback can run straight from XIP without touching the SD
+// card. Each entry holds frame_count frames of frame_size bytes, already
+// trimmed to this board's channels in FSEQ order (string 0 first, RGB).
+//
+// Partition layout (offsets relative to the partition):
+//   sector 0, 1   Directory, two copies (A/B) with generation + CRC
+//   sector 2..    Entry data, each entry sector aligned
+//
+// The directory is only rewritten once an entry's data has been programmed
+// and verified, and always into the copy that isn't current. A power cut at
+// any point leaves the previous directory intact; a replaced entry stays
+// playable until the new one commits.
+//
+// Flash access goes through seq_cache_flash_t so the same code runs against
+// the real XIP flash on target and a simulated image in host tests.
+
+#define SEQ_CACHE_MAGIC          0x43514553  // "SEQC"
+#define SEQ_CACHE_VERSION        1
+#define SEQ_CACHE_MAX_ENTRIES    16
+#define SEQ_CACHE_NAME_LEN       32
+#define SEQ_CACHE_SECTOR_SIZE    4096
+#define SEQ_CACHE_PAGE_SIZE      256
+#define SEQ_CACHE_DIR_SECTORS    2
+#define SEQ_CACHE_DATA_OFFSET    (SEQ_CACHE_DIR_SECTORS * SEQ_CACHE_SECTOR_SIZE)
+
+typedef enum {
+    SEQ_CACHE_OK = 0,
+    SEQ_CACHE_ERR_ARG,        // Bad name, zero-sized sequence, ...
+    SEQ_CACHE_ERR_STATE,      // Write/commit without begin, begin while writing
+    SEQ_CACHE_ERR_FULL,       // No free gap large enough / directory full
+    SEQ_CACHE_ERR_FLASH,      // Erase or program failed
+    SEQ_CACHE_ERR_VERIFY,     // Read-back didn't match what was written
+} seq_cache_result_t;
+
+// Flash backend. base is the memory-mapped partition (XIP on target).
+// erase() takes sector-aligned ranges, program() page-aligned ranges.
+typedef struct {
+    const uint8_t* base;
+    uint32_t size;
+    bool (*erase)(void* user, uint32_t offset, uint32_t len);
+    bool (*program)(void* user, uint32_t offset, const uint8_t* data, uint32_t len);
+    void* user;
+} seq_cache_flash_t;
+
+typedef struct {
+    char name[SEQ_CACHE_NAME_LEN];
+    uint32_t offset;          // Partition offset of frame 0 (sector aligned)
+    uint32_t frame_size;      // Bytes per frame (this board's channels)
+    uint32_t frame_count;
+    uint16_t step_time_ms;
+    uint16_t reserved;
+    uint32_t layout_hash;     // seq_cache_layout_hash() at install time
+    uint32_t data_crc;        // CRC32 of all frame data
+} seq_cache_entry_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t generation;      // Higher wins when both copies are valid
+    seq_cache_entry_t entries[SEQ_CACHE_MAX_ENTRIES];
+    uint32_t crc;             // CRC32 of everything above
+} seq_cache_dir_t;
+
+typedef struct {
+    seq_cache_flash_t flash;
+    seq_cache_dir_t dir;      // RAM copy of the current directory
+    uint8_t dir_slot;         // Directory sector holding dir (0 or 1)
+
+    // Install in progress
+    bool writing;
+    seq_cache_entry_t pending;
+    uint32_t write_pos;       // Data bytes accepted so far
+    uint32_t erased_end;      // Partition offset erased up to
+    uint32_t crc;             // Running CRC32 state
+    uint16_t page_len;
+    uint8_t page[SEQ_CACHE_PAGE_SIZE];
+} seq_cache_t;
+
+// Load the newest valid directory. An erased or corrupt partition mounts as
+// empty; nothing is written until the first commit.
+void seq_cache_mount(seq_cache_t* c, const seq_cache_flash_t* flash);
+
+// Look up an entry by name (exact match). NULL if not cached.
+const seq_cache_entry_t* seq_cache_find(const seq_cache_t* c, const char* name);
+
+// Pointer to one frame's data (frame_size bytes) in mapped flash.
+const uint8_t* seq_cache_frame(const seq_cache_t* c, const seq_cache_entry_t* e,
+                               uint32_t frame);
+
+// Number of committed entries
+uint8_t seq_cache_count(const seq_cache_t* c);
+
+// Largest contiguous free space, in bytes
+uint32_t seq_cache_largest_free(const seq_cache_t* c);
+
+// Start installing a sequence. An existing entry with the same name is
+// replaced at commit; its space is only reused by later installs.
+seq_cache_result_t seq_cache_begin(seq_cache_t* c, const char* name,
+                                   uint32_t frame_size, uint32_t frame_count,
+                                   uint16_t step_time_ms, uint32_t layout_hash);
+
+// Append frame data. Any chunking is fine; total must not exceed
+// frame_size * frame_count.
+seq_cache_result_t seq_cache_write(seq_cache_t* c, const uint8_t* data, uint32_t len);
+
+// Flush, verify and publish the entry. All data must have been written.
+seq_cache_result_t seq_cache_commit(seq_cache_t* c);
+
+// Drop an install in progress. Already-programmed sectors are simply left
+// unreferenced.
+void seq_cache_abort(seq_cache_t* c);
+
+// Erase both directory copies, forgetting every entry.
+seq_cache_result_t seq_cache_clear(seq_cache_t* c);
+
+// Hash of the string layout (FNV-1a over the pixel counts). Entries
+// installed under a different layout must not be played.
+uint32_t seq_cache_layout_hash(const uint16_t* string_lengths, uint8_t num_strings);
@@ -0,0 +1,165 @@
+#include "settings_log.h"
+#include <string.h>
+#include <stddef.h>
+
+_Static_assert(sizeof(settings_log_record_t) == SETTINGS_LOG_RECORD_SIZE,
+               "Settings log record must be 64 bytes");
+
+// Simple CRC32 (polynomial 0xEDB88320)
+static uint32_t crc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t record_crc(const settings_log_record_t* r) {
+    return crc32((const uint8_t*)r, offsetof(settings_log_record_t, crc));
+}
+
+static bool slot_blank(const settings_log_t* log, uint32_t offset) {
+    const uint8_t* p = log->flash.base + offset;
+    for (uint32_t i = 0; i < SETTINGS_LOG_RECORD_SIZE; i++) {
+        if (p[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+static bool record_valid(const settings_log_record_t* r) {
+    return r->magic == SETTINGS_LOG_MAGIC &&
+           r->length <= SETTINGS_LOG_MAX_PAYLOAD &&
+           r->crc == record_crc(r);
+}
+
+static bool sector_blank(const settings_log_t* log, uint32_t offset) {
+    for (uint32_t off = offset; off < offset + SETTINGS_LOG_SECTOR_SIZE; off += SETTINGS_LOG_RECORD_SIZE) {
+        if (!slot_blank(log, off)) return false;
+    }
+    return true;
+}
+
+static bool at_sector_start(uint32_t offset) {
+    return (offset % SETTINGS_LOG_SECTOR_SIZE) == 0;
+}
+
+void settings_log_mount(settings_log_t* log, const settings_log_flash_t* flash) {
+    memset(log, 0, sizeof(*log));
+    log->flash = *flash;
+
+    for (uint32_t off = 0; off < log->flash.size; off += SETTINGS_LOG_RECORD_SIZE) {
+        settings_log_record_t r;
+        memcpy(&r, log->flash.base + off, sizeof(r));
+        if (!record_valid(&r)) continue;
+        if (!log->has_latest || (int32_t)(r.seq - log->latest_seq) > 0) {
+            log->has_latest = true;
+            log->latest_seq = r.seq;
+            log->latest_offset = off;
+        }
+    }
+
+    // Continue after the newest record; a fresh log starts in sector 0
+    log->write_offset = log->has_latest ? log->latest_offset + SETTINGS_LOG_RECORD_SIZE : 0;
+}
+
+bool settings_log_read(const settings_log_t* log, void* out, uint16_t max_len,
+                       uint16_t* length) {
+    if (!log || !log->has_latest || !out) return false;
+
+    settings_log_record_t r;
+    memcpy(&r, log->flash.base + log->latest_offset, sizeof(r));
+    if (!record_valid(&r)) return false;  // Changed underneath us
+
+    uint16_t n = r.length < max_len ? r.length : max_len;
+    memcpy(out, r.payload, n);
+    if (length) *length = r.length;
+    return true;
+}
+
+// Erase the sector at offset and count it
+static bool erase_sector(settings_log_t* log, uint32_t offset) {
+    if (!log->flash.erase(log->flash.user, offset, SETTINGS_LOG_SECTOR_SIZE)) {
+        return false;
+    }
+    log->stats.erases++;
+    return true;
+}
+
+// Make sure the sector at offset is blank, erasing it if not
+static bool claim_sector(settings_log_t* log, uint32_t offset) {
+    return sector_blank(log, offset) || erase_sector(log, offset);
+}
+
+// Find the next blank slot, moving into (and erasing) the next sector in the
+// ring when the current one is used up
+static bool prepare_slot(settings_log_t* log, uint32_t* slot) {
+    uint32_t off = log->write_offset % log->flash.size;
+
+    if (!at_sector_start(off)) {
+        // Skip torn records left by a power cut
+        while (!at_sector_start(off) && !slot_blank(log, off)) {
+            off += SETTINGS_LOG_RECORD_SIZE;
+        }
+        off %= log->flash.size;
+    }
+
+    // Entering a sector: anything in it is older than the latest record
+    if (at_sector_start(off) && !claim_sector(log, off)) return false;
+
+    *slot = off;
+    return true;
+}
+
+bool settings_log_append(settings_log_t* log, const void* data, uint16_t length) {
+    if (!log || (!data && length) || length > SETTINGS_LOG_MAX_PAYLOAD) return false;
+
+    uint32_t slot;
+    if (!prepare_slot(log, &slot)) return false;
+
+    // Program the whole page; bytes outside the record stay 0xFF, which
+    // leaves already-programmed neighbours untouched
+    uint8_t page[SETTINGS_LOG_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+
+    settings_log_record_t* r = (settings_log_record_t*)&page[slot % SETTINGS_LOG_PAGE_SIZE];
+    settings_log_record_t record;
+    memset(&record, 0, sizeof(record));
+    record.magic = SETTINGS_LOG_MAGIC;
+    record.seq = log->has_latest ? log->latest_seq + 1 : 1;
+    record.length = length;
+    if (length) memcpy(record.payload, data, length);
+    record.crc = record_crc(&record);
+    memcpy(r, &record, sizeof(record));
+
+    uint32_t page_offset = slot - (slot % SETTINGS_LOG_PAGE_SIZE);
+    bool ok = log->flash.program(log->flash.user, page_offset, page, SETTINGS_LOG_PAGE_SIZE);
+
+    // Whatever happened, the slot is no longer blank
+    log->write_offset = slot + SETTINGS_LOG_RECORD_SIZE;
+    if (!ok) return false;
+
+    if (memcmp(log->flash.base + slot, &record, sizeof(record)) != 0) {
+        return false;
+    }
+
+    log->has_latest = true;
+    log->latest_seq = record.seq;
+    log->latest_offset = slot;
+    log->stats.appends++;
+    return true;
+}
+
+bool settings_log_erase_all(settings_log_t* log) {
+    if (!log) return false;
+    for (uint32_t off = 0; off < log->flash.size; off += SETTINGS_LOG_SECTOR_SIZE) {
+        if (!erase_sector(log, off)) return false;
+    }
+    log->has_latest = false;
+    log->latest_seq = 0;
+    log->latest_offset = 0;
+    log->write_offset = 0;
+    return true;
+}
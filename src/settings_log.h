@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Append-only settings log.
+//
+// Each save appends one 64-byte record (full snapshot + CRC) to a ring of
+// flash sectors instead of erasing and rewriting a sector. A sector is only
+// erased when the writer moves into it, so with 64 records per sector a
+// setting change costs one page program and an erase happens once every 64
+// saves.
+//
+// On mount the valid record with the highest sequence number wins. Torn
+// records (power lost mid-program) fail their CRC and are skipped; a torn
+// erase only ever hits the sector being moved into, never the one holding
+// the latest record.
+
+#define SETTINGS_LOG_MAGIC        0x4C534250  // "PBSL"
+#define SETTINGS_LOG_RECORD_SIZE  64
+#define SETTINGS_LOG_MAX_PAYLOAD  48
+#define SETTINGS_LOG_SECTOR_SIZE  4096
+#define SETTINGS_LOG_PAGE_SIZE    256
+#define SETTINGS_LOG_SLOTS        (SETTINGS_LOG_SECTOR_SIZE / SETTINGS_LOG_RECORD_SIZE)
+
+// Flash backend. base is the memory-mapped region (XIP on target).
+// erase() takes sector-aligned ranges, program() page-aligned ranges.
+typedef struct {
+    const uint8_t* base;
+    uint32_t size;            // Multiple of SETTINGS_LOG_SECTOR_SIZE, >= 2 sectors
+    bool (*erase)(void* user, uint32_t offset, uint32_t len);
+    bool (*program)(void* user, uint32_t offset, const uint8_t* data, uint32_t len);
+    void* user;
+} settings_log_flash_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;             // Increments with every append
+    uint16_t length;          // Payload bytes used
+    uint16_t reserved;
+    uint8_t payload[SETTINGS_LOG_MAX_PAYLOAD];
+    uint32_t crc;             // CRC32 of everything above
+} settings_log_record_t;
+
+typedef struct {
+    uint32_t appends;         // Records written since mount
+    uint32_t erases;          // Sectors erased since mount
+} settings_log_stats_t;
+
+typedef struct {
+    settings_log_flash_t flash;
+    bool has_latest;
+    uint32_t latest_offset;   // Region offset of the newest valid record
+    uint32_t latest_seq;
+    uint32_t write_offset;    // Next slot to try
+    settings_log_stats_t stats;
+} settings_log_t;
+
+// Scan the region for the newest valid record. Never writes.
+void settings_log_mount(settings_log_t* log, const settings_log_flash_t* flash);
+
+// Copy the newest record's payload to out (up to max_len bytes).
+// Returns false if the log holds no valid record.
+bool settings_log_read(const settings_log_t* log, void* out, uint16_t max_len,
+                       uint16_t* length);
+
+// Append a snapshot. Returns false on flash failure or oversized payload;
+// the previous record stays current in that case.
+bool settings_log_append(settings_log_t* log, const void* data, uint16_t length);
+
+// Erase every sector, forgetting all records.
+bool settings_log_erase_all(settings_log_t* log);
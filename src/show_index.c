@@ -0,0 +1,120 @@
+#include "show_index.h"
+#include "fseq_parser.h"
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert(sizeof(show_index_entry_t) == 64, "Show index entry must be 64 bytes");
+#define FSEQ_MAGIC        0x51455350  // "PSEQ"
+#define FSEQ_FIXED_HEADER 32          // Bytes covered by the content hash
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME  16777619u
+
+static uint32_t fnv1a(uint32_t hash, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Simple CRC32 (polynomial 0xEDB88320), continuing from crc (0 to start)
+static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static void copy_name(show_index_entry_t* entry, const char* name) {
+    strncpy(entry->name, name ? name : "", SHOW_INDEX_NAME_LEN - 1);
+    entry->name[SHOW_INDEX_NAME_LEN - 1] = '\0';
+}
+
+uint32_t show_index_signature_init(void) {
+    return FNV_OFFSET;
+}
+
+uint32_t show_index_signature_add(uint32_t signature, const char* name, uint32_t size,
+                                  uint16_t fdate, uint16_t ftime) {
+    // Name including its terminator, so "ab"+"c" differs from "a"+"bc"
+    signature = fnv1a(signature, name, strlen(name) + 1);
+    signature = fnv1a(signature, &size, sizeof(size));
+    signature = fnv1a(signature, &fdate, sizeof(fdate));
+    return fnv1a(signature, &ftime, sizeof(ftime));
+}
+
+bool show_index_entry_init(show_index_entry_t* entry, const char* name, uint32_t size,
+                           uint16_t fdate, uint16_t ftime,
+                           const uint8_t* header, uint32_t header_len) {
+    memset(entry, 0, sizeof(*entry));
+    copy_name(entry, name);
+    entry->size = size;
+    entry->fdate = fdate;
+    entry->ftime = ftime;
+
+    if (!header || header_len < FSEQ_FIXED_HEADER) return false;
+
+    fseq_header_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(&h, header, header_len < sizeof(h) ? header_len : sizeof(h));
+    if (h.magic != FSEQ_MAGIC || h.major_version != 2) return false;
+
+    entry->frame_count = h.frame_count;
+    entry->channel_count = h.channel_count;
+    entry->step_time_ms = h.step_time_ms;
+    entry->compression_type = h.compression_type & 0x0F;
+    entry->channel_data_offset = h.channel_data_offset;
+    entry->duration_ms = h.frame_count * h.step_time_ms;
+    entry->content_hash = fnv1a(fnv1a(FNV_OFFSET, header, FSEQ_FIXED_HEADER), &size, sizeof(size));
+    return true;
+}
+
+void show_index_entry_init_bare(show_index_entry_t* entry, const char* name,
+                                uint32_t frame_count, uint8_t step_time_ms) {
+    memset(entry, 0, sizeof(*entry));
+    copy_name(entry, name);
+    entry->frame_count = frame_count;
+    entry->step_time_ms = step_time_ms;
+    entry->duration_ms = frame_count * step_time_ms;
+}
+
+bool show_index_entry_matches(const show_index_entry_t* entry, const char* name,
+                              uint32_t size, uint16_t fdate, uint16_t ftime) {
+    return entry->size == size && entry->fdate == fdate && entry->ftime == ftime &&
+           strncmp(entry->name, name, SHOW_INDEX_NAME_LEN - 1) == 0;
+}
+
+void show_index_header_init(show_index_header_t* header, const show_index_entry_t* entries,
+                            uint16_t count, uint32_t dir_signature) {
+    memset(header, 0, sizeof(*header));
+    header->magic = SHOW_INDEX_MAGIC;
+    header->version = SHOW_INDEX_VERSION;
+    header->count = count;
+    header->dir_signature = dir_signature;
+    header->crc = show_index_crc_add(0, entries, count);
+}
+
+uint32_t show_index_crc_add(uint32_t crc, const show_index_entry_t* entries, uint16_t count) {
+    return crc32(crc, (const uint8_t*)entries, (size_t)count * sizeof(show_index_entry_t));
+}
+
+bool show_index_header_check(const show_index_header_t* header, uint32_t crc,
+                             uint16_t max_entries) {
+    if (header->magic != SHOW_INDEX_MAGIC || header->version != SHOW_INDEX_VERSION) {
+        return false;
+    }
+    if (header->count > max_entries) return false;
+    return header->crc == crc;
+}
+
+bool show_index_header_valid(const show_index_header_t* header,
+                             const show_index_entry_t* entries, uint16_t max_entries) {
+    return show_index_header_check(header, show_index_crc_add(0, entries, header->count),
+                                   max_entries);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// SD show library index.
+//
+// Opening every FSEQ to learn its length is slow, so the scan keeps a
+// metadata record per show in a hidden index file on the card:
+//
+//   show_index_header_t   magic, version, count, directory signature, CRC
+//   show_index_entry_t    x count, in directory order (fixed size, so entry
+//                         i is at a known offset)
+//
+// The directory signature is a hash of every .fseq directory entry (name,
+// size, modification stamp) in readdir order. Adding, removing, replacing
+// or touching a show changes it, which invalidates the index; entries for
+// files that didn't change are carried over without reopening them.
+
+#define SHOW_INDEX_MAGIC      0x58494250  // "PBIX"
+#define SHOW_INDEX_VERSION    1
+#define SHOW_INDEX_NAME_LEN   32
+#define SHOW_INDEX_PATH       "/.pbindex"
+
+typedef struct {
+    char name[SHOW_INDEX_NAME_LEN];
+    uint32_t size;            // File size in bytes
+    uint16_t fdate;           // FAT modification date/time
+    uint16_t ftime;
+    uint32_t frame_count;     // 0 if the header isn't a valid FSEQ v2 header
+    uint32_t channel_count;
+    uint32_t duration_ms;     // frame_count x step_time_ms
+    uint32_t content_hash;    // FSEQ header + size (header carries a per-render unique ID)
+    uint16_t channel_data_offset;
+    uint8_t step_time_ms;
+    uint8_t compression_type;
+    uint32_t reserved;
+} show_index_entry_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;           // Entries that follow
+    uint32_t dir_signature;   // See show_index_signature_add
+    uint32_t crc;             // CRC32 of the entries
+} show_index_header_t;
+
+// Directory signature: start with show_index_signature_init() and add each
+// .fseq directory entry in readdir order
+uint32_t show_index_signature_init(void);
+uint32_t show_index_signature_add(uint32_t signature, const char* name, uint32_t size,
+                                  uint16_t fdate, uint16_t ftime);
+
+// Fill an entry from a file's directory info and its first header_len bytes.
+// Returns false (entry still named, frame_count 0) if they aren't a valid
+// FSEQ v2 header.
+bool show_index_entry_init(show_index_entry_t* entry, const char* name, uint32_t size,
+                           uint16_t fdate, uint16_t ftime,
+                           const uint8_t* header, uint32_t header_len);
+
+// Initialise an entry for a show with no file behind it (e.g. flash cache)
+void show_index_entry_init_bare(show_index_entry_t* entry, const char* name,
+                                uint32_t frame_count, uint8_t step_time_ms);
+
+// True if the entry was built from this exact directory entry
+bool show_index_entry_matches(const show_index_entry_t* entry, const char* name,
+                              uint32_t size, uint16_t fdate, uint16_t ftime);
+
+// Build the header for count entries
+void show_index_header_init(show_index_header_t* header, const show_index_entry_t* entries,
+                            uint16_t count, uint32_t dir_signature);
+
+// Entry CRC a run at a time, for reading the index in chunks: start from 0
+// and add the entries in order
+uint32_t show_index_crc_add(uint32_t crc, const show_index_entry_t* entries, uint16_t count);
+
+// Check magic, version and entry CRC
+bool show_index_header_valid(const show_index_header_t* header,
+                             const show_index_entry_t* entries, uint16_t max_entries);
+
+// Same, against a CRC accumulated with show_index_crc_add
+bool show_index_header_check(const show_index_header_t* header, uint32_t crc,
+                             uint16_t max_entries);
@@ -31,6 +31,39 @@ static bool string_length_position_changed(const AppState* old, const AppState*
            old->string_length.current_pixel != new->string_length.current_pixel;
 }
 
+static bool string_discovery_changed(const AppState* old, const AppState* new) {
+    return old->string_discovery.run_state != new->string_discovery.run_state;
+}
+
+static bool string_discovery_answered(const AppState* old, const AppState* new) {
+    return old->string_discovery.search.cursor != new->string_discovery.search.cursor ||
+           old->string_discovery.search.round != new->string_discovery.search.round;
+}
+
+static bool usb_stream_changed(const AppState* old, const AppState* new) {
+    return old->usb_stream.run_state != new->usb_stream.run_state;
+}
+
+static bool effects_changed(const AppState* old, const AppState* new) {
+    return old->effects.run_state != new->effects.run_state;
+}
+
+static bool effect_selection_changed(const AppState* old, const AppState* new) {
+    return old->effects.effect != new->effects.effect;
+}
+
+static bool flash_install_changed(const AppState* old, const AppState* new) {
+    return old->flash_cache.run_state != new->flash_cache.run_state;
+}
+
+static bool flash_clear_requested(const AppState* old, const AppState* new) {
+    return old->flash_cache.clear_requests != new->flash_cache.clear_requests;
+}
+
+// Saved playback position, used by the first start of that file after boot
+static uint8_t resume_index = 0;
+static uint32_t resume_frame = 0;
+
 static bool fseq_playback_changed(const AppState* old, const AppState* new) {
     return old->sd_card.is_playing != new->sd_card.is_playing;
 }
@@ -42,6 +75,14 @@ static bool fseq_file_changed(const AppState* old, const AppState* new) {
            old->sd_card.playing_index != new->sd_card.playing_index;
 }
 
+static bool fseq_next_changed(const AppState* old, const AppState* new) {
+    // Anything that changes which file follows the current one
+    return old->sd_card.is_playing != new->sd_card.is_playing ||
+           old->sd_card.playing_index != new->sd_card.playing_index ||
+           old->sd_card.auto_loop != new->sd_card.auto_loop ||
+           old->sd_card.file_count != new->sd_card.file_count;
+}
+
 static bool power_state_changed(const AppState* old, const AppState* new) {
     return old->is_powered_on != new->is_powered_on;
 }
@@ -147,7 +188,9 @@ void side_effects_apply(const HardwareContext* hw,
         if (new_state->sd_card.is_playing) {
             // Start playback - look up filename from static buffer
             const char* filename = sd_file_list[new_state->sd_card.playing_index];
-            core1_start_fseq(filename);
+            uint32_t frame = new_state->sd_card.playing_index == resume_index ? resume_frame : 0;
+            resume_frame = 0;
+            core1_start_fseq_at(filename, frame);
         } else {
             core1_stop_and_wait();
         }
@@ -155,17 +198,98 @@ void side_effects_apply(const HardwareContext* hw,
 
     // Handle skip to next file during playback
     if (fseq_file_changed(old_state, new_state)) {
-        // Start new file (core1_start_fseq stops current task first)
+        // Auto-advance usually finds Core 1 already playing the queued file
         const char* filename = sd_file_list[new_state->sd_card.playing_index];
-        core1_start_fseq(filename);
+        if (!core1_fseq_is_playing(filename)) {
+            // Start new file (core1_start_fseq stops current task first)
+            core1_start_fseq(filename);
+        }
+    }
+
+    // Queue the file that follows so Core 1 can switch to it without a gap
+    if (fseq_next_changed(old_state, new_state)) {
+        const char* next = NULL;
+        uint8_t count = new_state->sd_card.file_count;
+        if (new_state->sd_card.is_playing && new_state->sd_card.auto_loop && count >= 2) {
+            next = sd_file_list[(new_state->sd_card.playing_index + 1) % count];
+        }
+        core1_set_next_fseq(next);
+    }
+
+    // Frame interpolation switch (Core 1 picks it up on the next frame)
+    if (old_state->sd_card.interpolate != new_state->sd_card.interpolate) {
+        core1_set_interpolation(new_state->sd_card.interpolate);
+    }
+
+    // Handle USB stream state changes - runs on Core 1
+    // Handled after FSEQ so a stream->FSEQ switch doesn't stop the new file
+    if (usb_stream_changed(old_state, new_state)) {
+        if (new_state->usb_stream.run_state == TEST_RUNNING) {
+            core1_start_stream();
+        } else if (core1_get_current_task() == CORE1_TASK_STREAM) {
+            core1_stop_and_wait();
+        }
+    }
+
+    // Handle effects state changes - runs on Core 1
+    // Handled after FSEQ so the fallback show giving way to a file doesn't stop it
+    if (effects_changed(old_state, new_state)) {
+        if (new_state->effects.run_state == TEST_RUNNING) {
+            core1_start_effects(new_state->effects.effect);
+        } else if (core1_get_current_task() == CORE1_TASK_EFFECTS) {
+            core1_stop_and_wait();
+        }
+    } else if (new_state->effects.run_state == TEST_RUNNING &&
+               effect_selection_changed(old_state, new_state)) {
+        core1_set_effect(new_state->effects.effect);
+    }
+
+    // Handle flash cache install - runs on Core 1
+    // Handled after FSEQ so stopping playback doesn't cancel the new install
+    if (flash_install_changed(old_state, new_state)) {
+        if (new_state->flash_cache.run_state == TEST_RUNNING) {
+            const char* filename = sd_file_list[new_state->flash_cache.install_index];
+            core1_start_flash_install(filename);
+        } else if (core1_get_current_task() == CORE1_TASK_FLASH_INSTALL) {
+            core1_stop_and_wait();
+        }
+    }
+
+    // Handle string discovery - shares the string length tool's driver
+    // Handled after FSEQ so Core 1 has let go of the LEDs first
+    if (string_discovery_changed(old_state, new_state)) {
+        if (new_state->string_discovery.run_state == TEST_RUNNING) {
+            string_length_test_start(hw->string_length_test);
+            string_length_test_show_markers(hw->string_length_test,
+                                            &new_state->string_discovery.search);
+        } else if (new_state->string_length.run_state == TEST_RUNNING) {
+            // String length tool took over the driver in the same batch
+            string_length_test_update(hw->string_length_test,
+                                      new_state->string_length.current_string,
+                                      new_state->string_length.current_pixel);
+        } else {
+            string_length_test_stop(hw->string_length_test);
+        }
+    } else if (new_state->string_discovery.run_state == TEST_RUNNING &&
+               string_discovery_answered(old_state, new_state)) {
+        string_length_test_show_markers(hw->string_length_test,
+                                        &new_state->string_discovery.search);
+    }
+
+    // Handle flash cache erase (reducer already stopped playback)
+    if (flash_clear_requested(old_state, new_state)) {
+        core1_stop_and_wait();
+        flash_cache_clear(hw->flash_cache);
     }
 
     // Always render view on state change
     views_render(hw->display, new_state);
 
     // Check if settings need saving (debounced)
+    // A show waiting for the SD card (fallback effects running) still counts
     flash_settings_check_save(new_state->brightness_level,
-                              new_state->sd_card.is_playing,
+                              new_state->sd_card.is_playing ||
+                              new_state->sd_card.auto_play_pending,
                               new_state->sd_card.playing_index,
                               new_state->sd_card.auto_loop);
 }
@@ -186,6 +310,11 @@ bool side_effects_tick(const HardwareContext* hw, const AppState* state) {
         toggle_test_task(hw->toggle_test);
     }
 
+    // Checkpoint the playback position for resume after power loss
+    if (state->sd_card.is_playing) {
+        flash_settings_check_position(core1_get_fseq_frame());
+    }
+
     // Rainbow test and FSEQ run on Core 1, no tick needed here
     return state->rainbow_test.run_state == TEST_RUNNING;
 }
@@ -193,3 +322,8 @@ bool side_effects_tick(const HardwareContext* hw, const AppState* state) {
 uint16_t side_effects_get_rainbow_fps(const HardwareContext* hw) {
     return rainbow_test_get_fps(hw->rainbow_test);
 }
+
+void side_effects_set_resume(uint8_t playing_index, uint32_t frame) {
+    resume_index = playing_index;
+    resume_frame = frame;
+}
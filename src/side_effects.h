@@ -6,6 +6,8 @@
 #include "../rainbow_test.h"
 #include "../string_length_test.h"
 #include "../fseq_player.h"
+#include "../usb_stream.h"
+#include "../flash_cache.h"
 #include "../sh1106.h"
 
 // Hardware context passed to side effects
@@ -16,6 +18,8 @@ typedef struct {
     rainbow_test_t* rainbow_test;
     string_length_test_t* string_length_test;
     fseq_player_t* fseq_player;
+    usb_stream_t* usb_stream;
+    flash_cache_t* flash_cache;
 } HardwareContext;
 
 // Initialize hardware context
@@ -33,3 +37,6 @@ bool side_effects_tick(const HardwareContext* hw, const AppState* state);
 
 // Get current rainbow FPS
 uint16_t side_effects_get_rainbow_fps(const HardwareContext* hw);
+
+// Position to resume at when playing_index first starts (from saved settings)
+void side_effects_set_resume(uint8_t playing_index, uint32_t frame);
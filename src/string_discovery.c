@@ -0,0 +1,67 @@
+#include "string_discovery.h"
+#include <string.h>
+
+void string_discovery_init(string_discovery_t* d, uint16_t max_pixels) {
+    memset(d, 0, sizeof(*d));
+    for (int i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        d->hi[i] = max_pixels;
+    }
+    d->round = 1;
+}
+
+bool string_discovery_resolved(const string_discovery_t* d, uint8_t string) {
+    return d->lo[string] >= d->hi[string];
+}
+
+bool string_discovery_done(const string_discovery_t* d) {
+    return string_discovery_remaining(d) == 0;
+}
+
+uint8_t string_discovery_remaining(const string_discovery_t* d) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        if (!string_discovery_resolved(d, i)) n++;
+    }
+    return n;
+}
+
+bool string_discovery_marker(const string_discovery_t* d, uint8_t string, uint16_t* pixel) {
+    if (string_discovery_resolved(d, string)) return false;
+    // Upper midpoint, so lo always moves when the marker is lit
+    uint16_t probe = (uint16_t)((d->lo[string] + d->hi[string] + 1) / 2);
+    *pixel = probe - 1;
+    return true;
+}
+
+void string_discovery_answer(string_discovery_t* d, bool lit) {
+    uint8_t s = d->cursor;
+    uint16_t pixel;
+    if (!string_discovery_marker(d, s, &pixel)) return;  // Done
+
+    if (lit) {
+        d->lo[s] = pixel + 1;
+    } else {
+        d->hi[s] = pixel;
+    }
+
+    // Next open string, wrapping into the next round
+    for (int step = 1; step <= STRING_DISCOVERY_NUM_STRINGS; step++) {
+        uint8_t next = (uint8_t)((s + step) % STRING_DISCOVERY_NUM_STRINGS);
+        if (!string_discovery_resolved(d, next)) {
+            if (next <= s) d->round++;
+            d->cursor = next;
+            return;
+        }
+    }
+}
+
+void string_discovery_answer_round(string_discovery_t* d, uint8_t round, bool lit) {
+    // The round ticks over when the cursor wraps past the last open string
+    while (d->round == round && !string_discovery_done(d)) {
+        string_discovery_answer(d, lit);
+    }
+}
+
+uint16_t string_discovery_length(const string_discovery_t* d, uint8_t string) {
+    return d->lo[string];
+}
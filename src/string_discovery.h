@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// String length discovery.
+//
+// Finds the length of all strings at once with one binary search per
+// string. Each string lights a marker at the midpoint of what its length
+// could still be; the operator says whether that marker is lit, which halves
+// the range. With every string showing its marker in the same frame, a
+// 512-pixel board is done in about ten passes over the strings.
+//
+// The cursor walks the strings that are still open, one answer each, and
+// wraps to the next round after the last one. On a uniformly wired board
+// every marker in a round looks the same, so the rest of a round can be
+// answered at once.
+
+#define STRING_DISCOVERY_NUM_STRINGS 32
+#define STRING_DISCOVERY_MAX_PIXELS  512  // Must match PB_MAX_PIXELS
+
+typedef struct {
+    uint16_t lo[STRING_DISCOVERY_NUM_STRINGS];  // Length is at least lo...
+    uint16_t hi[STRING_DISCOVERY_NUM_STRINGS];  // ...and at most hi
+    uint8_t cursor;                // String being asked about
+    uint8_t round;                 // Passes over the strings so far (from 1)
+} string_discovery_t;
+
+// Every string 0..max_pixels long, cursor on string 0
+void string_discovery_init(string_discovery_t* d, uint16_t max_pixels);
+
+// True once the string's length is known
+bool string_discovery_resolved(const string_discovery_t* d, uint8_t string);
+
+// True once every string's length is known
+bool string_discovery_done(const string_discovery_t* d);
+
+// Strings still open
+uint8_t string_discovery_remaining(const string_discovery_t* d);
+
+// Pixel index the string's marker goes on: lit means the string is at least
+// pixel + 1 long. Returns false for a resolved string.
+bool string_discovery_marker(const string_discovery_t* d, uint8_t string, uint16_t* pixel);
+
+// Answer for the cursor string (marker lit or not), then move the cursor to
+// the next open string. Does nothing once done.
+void string_discovery_answer(string_discovery_t* d, bool lit);
+
+// Give the same answer for every open string from the cursor to the end of
+// round. Does nothing if the search has already moved past that round.
+void string_discovery_answer_round(string_discovery_t* d, uint8_t round, bool lit);
+
+// Length found so far: exact once resolved, a lower bound before
+uint16_t string_discovery_length(const string_discovery_t* d, uint8_t string);
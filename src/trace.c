@@ -0,0 +1,154 @@
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef TRACE_TEST_BUILD
+#include "pb_led_driver.h"
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+#include "hardware/irq.h"
+#endif
+
+// Orders slot contents against seq on both sides (a DMB on the M33)
+#define TRACE_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+static const char* const event_names[TRACE_EVENT_COUNT] = {
+    [TRACE_DISPATCH]       = "dispatch",
+    [TRACE_CORE1_STOP]     = "core1_stop_and_wait",
+    [TRACE_DISPLAY_RENDER] = "sh1106_render",
+    [TRACE_FLASH_OP]       = "flash_op",
+    [TRACE_SD_READ]        = "sd_read",
+    [TRACE_FRAME_SHOW]     = "frame_show",
+    [TRACE_LED_DMA_IRQ]    = "led_dma_irq",
+    [TRACE_SD_DMA_IRQ]     = "sd_dma_irq",
+};
+
+// ============================================================================
+// Pure functions (no I/O, testable on host)
+// ============================================================================
+
+void trace_buffer_init(trace_buffer_t* buf) {
+    memset(buf, 0, sizeof(*buf));
+    buf->enabled = true;
+}
+
+void trace_buffer_record(trace_buffer_t* buf, uint8_t id, trace_phase_t phase,
+                         uint32_t time_us, uint8_t core, bool isr) {
+    if (!buf->enabled) return;
+
+    uint32_t n = __atomic_fetch_add(&buf->head, 1, __ATOMIC_RELAXED);
+    trace_event_t* ev = &buf->events[n & (TRACE_BUFFER_SIZE - 1)];
+
+    ev->seq = 0;
+    TRACE_BARRIER();
+    ev->time_us = time_us;
+    ev->id = id;
+    ev->phase = (uint8_t)phase;
+    ev->core = core;
+    ev->isr = isr ? 1 : 0;
+    TRACE_BARRIER();
+    ev->seq = n + 1;
+}
+
+uint32_t trace_buffer_snapshot(const trace_buffer_t* buf, trace_event_t* out,
+                               uint32_t max, uint32_t* lost) {
+    uint32_t head = __atomic_load_n(&buf->head, __ATOMIC_ACQUIRE);
+    uint32_t n = head < TRACE_BUFFER_SIZE ? head : TRACE_BUFFER_SIZE;
+    if (n > max) n = max;
+
+    uint32_t count = 0;
+    for (uint32_t i = head - n; i != head; i++) {
+        const trace_event_t* ev = &buf->events[i & (TRACE_BUFFER_SIZE - 1)];
+        if (ev->seq != i + 1) continue;  // Overwritten or still being written
+        TRACE_BARRIER();
+        out[count] = *ev;
+        TRACE_BARRIER();
+        if (ev->seq != i + 1) continue;  // Overwritten while copying
+        out[count].seq = i + 1;
+        count++;
+    }
+
+    if (lost) *lost = head - count;
+    return count;
+}
+
+const char* trace_event_name(uint8_t id) {
+    return id < TRACE_EVENT_COUNT ? event_names[id] : "unknown";
+}
+
+int trace_format_event(const trace_event_t* ev, char* line, size_t len) {
+    return snprintf(line, len, "E %lu %u %c %u %u",
+                    (unsigned long)ev->time_us, (unsigned)ev->core, (char)ev->phase,
+                    (unsigned)ev->id, (unsigned)ev->isr);
+}
+
+// ============================================================================
+// Hardware-dependent functions (only compiled for target)
+// ============================================================================
+
+#ifndef TRACE_TEST_BUILD
+
+trace_buffer_t g_trace;
+
+void trace_init(void) {
+    trace_buffer_init(&g_trace);
+}
+
+static void record(trace_event_id_t id, trace_phase_t phase) {
+    trace_buffer_record(&g_trace, id, phase, time_us_32(), (uint8_t)get_core_num(),
+                        __get_current_exception() != 0);
+}
+
+void trace_begin(trace_event_id_t id) {
+    record(id, TRACE_PHASE_BEGIN);
+}
+
+void trace_end(trace_event_id_t id) {
+    record(id, TRACE_PHASE_END);
+}
+
+void trace_instant(trace_event_id_t id) {
+    record(id, TRACE_PHASE_INSTANT);
+}
+
+// LED driver DMA handler hook (weak no-op in pb_led_driver_hw.c)
+void pb_trace_dma_irq(bool begin) {
+    record(TRACE_LED_DMA_IRQ, begin ? TRACE_PHASE_BEGIN : TRACE_PHASE_END);
+}
+
+// Shared handlers run in priority order: these run first and last
+static void sd_irq_begin(void) {
+    record(TRACE_SD_DMA_IRQ, TRACE_PHASE_BEGIN);
+}
+
+static void sd_irq_end(void) {
+    record(TRACE_SD_DMA_IRQ, TRACE_PHASE_END);
+}
+
+void trace_install_sd_irq_hooks(void) {
+    irq_add_shared_handler(DMA_IRQ_1, sd_irq_begin, PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY);
+    irq_add_shared_handler(DMA_IRQ_1, sd_irq_end, PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY);
+}
+
+void trace_dump(void) {
+    static trace_event_t events[TRACE_BUFFER_SIZE];
+
+    g_trace.enabled = false;
+    uint32_t lost;
+    uint32_t n = trace_buffer_snapshot(&g_trace, events, TRACE_BUFFER_SIZE, &lost);
+
+    printf("TRACE BEGIN %lu %lu\n", (unsigned long)n, (unsigned long)lost);
+    for (uint8_t id = 0; id < TRACE_EVENT_COUNT; id++) {
+        printf("N %u %s\n", (unsigned)id, trace_event_name(id));
+    }
+    char line[TRACE_LINE_MAX];
+    for (uint32_t i = 0; i < n; i++) {
+        trace_format_event(&events[i], line, sizeof(line));
+        printf("%s\n", line);
+    }
+    printf("TRACE END\n");
+
+    trace_buffer_init(&g_trace);
+}
+
+#endif // TRACE_TEST_BUILD
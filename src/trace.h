@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Timeline trace of firmware events.
+//
+// Begin/end pairs and instants from both cores and from interrupt handlers
+// go into one shared ring, newest overwriting oldest. A writer claims a slot
+// with an atomic increment (RP2350 has exclusive monitors across cores) and
+// marks it complete last, so a dump taken while the other core keeps
+// recording skips half-written slots instead of printing garbage.
+//
+// Dumped as text over USB (USB console `TD`):
+//
+//   TRACE BEGIN <events> <lost>
+//   N <id> <name>                          one per event id
+//   E <time_us> <core> <B|E|I> <id> <isr>  one per event, oldest first
+//   TRACE END
+//
+// tools/trace_to_chrome.py turns a captured log into Chrome trace JSON for
+// Perfetto (ui.perfetto.dev) or chrome://tracing.
+
+#define TRACE_BUFFER_SIZE 1024   // Events kept (power of two)
+#define TRACE_LINE_MAX    40
+
+_Static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0,
+               "TRACE_BUFFER_SIZE must be a power of two");
+
+typedef enum {
+    TRACE_DISPATCH = 0,       // Core 0 action dispatch (reduce + side effects)
+    TRACE_CORE1_STOP,         // core1_stop_and_wait
+    TRACE_DISPLAY_RENDER,     // sh1106_render (I2C transfer)
+    TRACE_FLASH_OP,           // Flash erase/program, other core paused
+    TRACE_SD_READ,            // Playback f_read
+    TRACE_FRAME_SHOW,         // LED frame handed to DMA
+    TRACE_LED_DMA_IRQ,        // DMA_IRQ_0 (LED driver)
+    TRACE_SD_DMA_IRQ,         // DMA_IRQ_1 (SD card SPI)
+    TRACE_EVENT_COUNT
+} trace_event_id_t;
+
+typedef enum {
+    TRACE_PHASE_BEGIN = 'B',
+    TRACE_PHASE_END = 'E',
+    TRACE_PHASE_INSTANT = 'I',
+} trace_phase_t;
+
+typedef struct {
+    volatile uint32_t seq;    // Event number + 1 once the slot is complete
+    uint32_t time_us;
+    uint8_t id;
+    uint8_t phase;
+    uint8_t core;
+    uint8_t isr;
+} trace_event_t;
+
+typedef struct {
+    trace_event_t events[TRACE_BUFFER_SIZE];
+    uint32_t head;            // Events claimed (atomic)
+    volatile bool enabled;
+} trace_buffer_t;
+
+void trace_buffer_init(trace_buffer_t* buf);
+
+// Record one event (from any core or interrupt)
+void trace_buffer_record(trace_buffer_t* buf, uint8_t id, trace_phase_t phase,
+                         uint32_t time_us, uint8_t core, bool isr);
+
+// Copy complete events, oldest first. *lost gets the number of events
+// overwritten or skipped. Returns the number copied.
+uint32_t trace_buffer_snapshot(const trace_buffer_t* buf, trace_event_t* out,
+                               uint32_t max, uint32_t* lost);
+
+const char* trace_event_name(uint8_t id);
+
+// Format one event as an "E ..." dump line (no newline)
+int trace_format_event(const trace_event_t* ev, char* line, size_t len);
+
+// ============================================================================
+// Hardware-dependent functions (target only)
+// ============================================================================
+
+#ifndef TRACE_TEST_BUILD
+
+extern trace_buffer_t g_trace;
+
+void trace_init(void);
+void trace_begin(trace_event_id_t id);
+void trace_end(trace_event_id_t id);
+void trace_instant(trace_event_id_t id);
+
+// Bracket the SD library's DMA_IRQ_1 handler with begin/end events. Call
+// after the SD card is initialised (the IRQ is shared).
+void trace_install_sd_irq_hooks(void);
+
+// Print the buffer (recording pauses meanwhile) and start a fresh trace
+void trace_dump(void);
+
+#endif // TRACE_TEST_BUILD
@@ -0,0 +1,95 @@
+#include "usb_cmd.h"
+#include <ctype.h>
+#include <string.h>
+
+void usb_cmd_reader_init(usb_cmd_reader_t* r) {
+    memset(r, 0, sizeof(*r));
+}
+
+bool usb_cmd_feed(usb_cmd_reader_t* r, char c, usb_cmd_t* out) {
+    if (c == '\r' || c == '\n') {
+        bool overflow = r->overflow;
+        r->line[r->len] = '\0';
+        r->len = 0;
+        r->overflow = false;
+
+        if (overflow) {
+            out->type = USB_CMD_INVALID;
+            out->value = 0;
+        } else {
+            *out = usb_cmd_parse(r->line);
+        }
+        return true;
+    }
+
+    if (r->len < USB_CMD_LINE_MAX - 1) {
+        r->line[r->len++] = c;
+    } else {
+        r->overflow = true;
+    }
+    return false;
+}
+
+static const char* skip_spaces(const char* p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+// Unsigned decimal filling the rest of the line
+static bool parse_number(const char* p, uint32_t* value) {
+    p = skip_spaces(p);
+    if (!isdigit((unsigned char)*p)) return false;
+
+    uint64_t v = 0;
+    while (isdigit((unsigned char)*p)) {
+        v = v * 10 + (uint64_t)(*p - '0');
+        if (v > UINT32_MAX) return false;
+        p++;
+    }
+    if (*skip_spaces(p) != '\0') return false;
+    *value = (uint32_t)v;
+    return true;
+}
+
+static bool keyword(const char** p, const char* word) {
+    const char* s = *p;
+    while (*word) {
+        if (toupper((unsigned char)*s) != *word) return false;
+        s++;
+        word++;
+    }
+    if (*s != '\0' && *s != ' ' && *s != '\t') return false;
+    *p = s;
+    return true;
+}
+
+usb_cmd_t usb_cmd_parse(const char* line) {
+    usb_cmd_t cmd = { USB_CMD_INVALID, 0 };
+    const char* p = skip_spaces(line);
+
+    if (*p == '\0') {
+        cmd.type = USB_CMD_NONE;
+    } else if (keyword(&p, "TC")) {
+        const char* rest = skip_spaces(p);
+        if (keyword(&rest, "OFF") && *skip_spaces(rest) == '\0') {
+            cmd.type = USB_CMD_CHASE_OFF;
+        } else if (parse_number(p, &cmd.value)) {
+            cmd.type = USB_CMD_TIMECODE_MS;
+        }
+    } else if (keyword(&p, "TF")) {
+        if (parse_number(p, &cmd.value)) cmd.type = USB_CMD_TIMECODE_FRAME;
+    } else if (keyword(&p, "GT")) {
+        if (parse_number(p, &cmd.value)) cmd.type = USB_CMD_SEEK_MS;
+    } else if (keyword(&p, "GF")) {
+        if (parse_number(p, &cmd.value)) cmd.type = USB_CMD_SEEK_FRAME;
+    } else if (keyword(&p, "TS")) {
+        if (*skip_spaces(p) == '\0') cmd.type = USB_CMD_CHASE_STATUS;
+    } else if (keyword(&p, "PS")) {
+        if (*skip_spaces(p) == '\0') cmd.type = USB_CMD_POWER_STATUS;
+    } else if (keyword(&p, "PD")) {
+        if (*skip_spaces(p) == '\0') cmd.type = USB_CMD_PERF_DUMP;
+    } else if (keyword(&p, "TD")) {
+        if (*skip_spaces(p) == '\0') cmd.type = USB_CMD_TRACE_DUMP;
+    }
+    return cmd;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Text commands on the USB CDC console (when not live streaming).
+//
+// One command per line, case-insensitive:
+//
+//   TC <ms>     Timecode: master is <ms> milliseconds into the show
+//   TF <frame>  Timecode as a frame number of the playing show
+//   TC OFF      Stop chasing, free-run at the show rate
+//   GT <ms>     Jump the playing show to <ms> milliseconds in (no chase)
+//   GF <frame>  Jump the playing show to a frame
+//   TS          Print chase statistics
+//   PS          Print LED current estimate
+//   PD          Print frame timing telemetry (perf.h)
+//   TD          Dump the event trace (trace.h) and start a new one
+
+#define USB_CMD_LINE_MAX 32
+
+typedef enum {
+    USB_CMD_NONE = 0,
+    USB_CMD_TIMECODE_MS,
+    USB_CMD_TIMECODE_FRAME,
+    USB_CMD_CHASE_OFF,
+    USB_CMD_SEEK_MS,
+    USB_CMD_SEEK_FRAME,
+    USB_CMD_CHASE_STATUS,
+    USB_CMD_POWER_STATUS,
+    USB_CMD_PERF_DUMP,
+    USB_CMD_TRACE_DUMP,
+    USB_CMD_INVALID,          // Complete line that didn't parse
+} usb_cmd_type_t;
+
+typedef struct {
+    usb_cmd_type_t type;
+    uint32_t value;
+} usb_cmd_t;
+
+typedef struct {
+    char line[USB_CMD_LINE_MAX];
+    uint8_t len;
+    bool overflow;            // Discard the rest of an over-long line
+} usb_cmd_reader_t;
+
+void usb_cmd_reader_init(usb_cmd_reader_t* r);
+
+// Feed one received character. Returns true when a line completed, with the
+// parsed command in out (USB_CMD_NONE for a blank line).
+bool usb_cmd_feed(usb_cmd_reader_t* r, char c, usb_cmd_t* out);
+
+// Parse one line (no terminator)
+usb_cmd_t usb_cmd_parse(const char* line);
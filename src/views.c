@@ -1,28 +1,23 @@
 #include "views.h"
 #include "board_config.h"
+#include "flash_cache.h"
+#include "sd_ops.h"
 #include <stdio.h>
 #include <string.h>
 
-static const char* color_order_name(pb_color_order_t order) {
-    switch (order) {
-        case PB_COLOR_ORDER_RGB: return "RGB";
-        case PB_COLOR_ORDER_GRB: return "GRB";
-        case PB_COLOR_ORDER_BGR: return "BGR";
-        case PB_COLOR_ORDER_RBG: return "RBG";
-        case PB_COLOR_ORDER_GBR: return "GBR";
-        case PB_COLOR_ORDER_BRG: return "BRG";
-        default: return "???";
-    }
-}
-
 static const char* menu_labels[MENU_COUNT] = {
     "Info",
     "Board Address",
     "SD Card",
+    "Flash Cache",
+    "USB Stream",
+    "Effects",
+    "Perf",
     "String Test",
     "Toggle Test",
     "Rainbow Test",
     "String Length",
+    "Find Lengths",
     "Brightness",
     "Shutdown",
 };
@@ -80,7 +75,7 @@ static void render_info_detail(sh1106_t* display, const AppState* state) {
             snprintf(line, sizeof(line), "S%02d: %3upx %s",
                      item_idx,
                      g_board_config.strings[item_idx].pixel_count,
-                     color_order_name(g_board_config.strings[item_idx].color_order));
+                     board_config_color_order_name(g_board_config.strings[item_idx].color_order));
             sh1106_draw_string(display, 0, y, line, is_selected);
         } else {
             sh1106_draw_string(display, 0, y, "[ Exit ]", is_selected);
@@ -101,6 +96,9 @@ static void render_board_address_detail(sh1106_t* display, const AppState* state
     sh1106_draw_string(display, 0, 24, line, false);
     snprintf(line, sizeof(line), "Err:%u M:%u", state->board_address.error, state->board_address.margin);
     sh1106_draw_string(display, 0, 32, line, false);
+    snprintf(line, sizeof(line), "ID: %u (%s)", g_board_config.board_id,
+             g_board_config.board_id_from_config ? "config" : "ladder");
+    sh1106_draw_string(display, 0, 40, line, false);
     sh1106_draw_string(display, 0, 48, "Next exits", false);
     sh1106_render(display);
 }
@@ -111,17 +109,24 @@ static void render_sd_card_detail(sh1106_t* display, const AppState* state) {
 
     // Show playback state
     if (state->sd_card.is_playing) {
-        // Show PLAYING with AUTO indicator if enabled
-        if (state->sd_card.auto_loop) {
-            sh1106_draw_string(display, 0, 0, "PLAYING [AUTO]", true);
-        } else {
-            sh1106_draw_string(display, 0, 0, "PLAYING", true);
-        }
+        // Show PLAYING with AUTO / interpolation indicators if enabled
+        snprintf(line, sizeof(line), "PLAYING%s%s",
+                 state->sd_card.auto_loop ? " [AUTO]" : "",
+                 state->sd_card.interpolate ? " [LERP]" : "");
+        sh1106_draw_string(display, 0, 0, line, true);
         // Look up filename from static buffer using playing_index
         sh1106_draw_string(display, 0, 16, sd_file_list[state->sd_card.playing_index], false);
-        // Show file position in playlist
-        snprintf(line, sizeof(line), "File %d/%d",
-                 state->sd_card.playing_index + 1, state->sd_card.file_count);
+        // Show file position in playlist, plus length from the show index
+        const show_index_entry_t* info = sd_ops_show_info(state->sd_card.playing_index);
+        if (info && info->duration_ms > 0) {
+            uint32_t secs = info->duration_ms / 1000;
+            snprintf(line, sizeof(line), "File %d/%d  %lu:%02lu",
+                     state->sd_card.playing_index + 1, state->sd_card.file_count,
+                     (unsigned long)(secs / 60), (unsigned long)(secs % 60));
+        } else {
+            snprintf(line, sizeof(line), "File %d/%d",
+                     state->sd_card.playing_index + 1, state->sd_card.file_count);
+        }
         sh1106_draw_string(display, 0, 32, line, false);
         sh1106_draw_string(display, 0, 48, "Any btn: stop", false);
         sh1106_render(display);
@@ -169,6 +174,127 @@ static void render_sd_card_detail(sh1106_t* display, const AppState* state) {
     sh1106_render(display);
 }
 
+static void render_flash_cache_detail(sh1106_t* display, const AppState* state) {
+    char line[24];
+    sh1106_clear(display);
+
+    // Show install progress
+    if (state->flash_cache.run_state == TEST_RUNNING) {
+        sh1106_draw_string(display, 0, 0, "INSTALLING", true);
+        sh1106_draw_string(display, 0, 16, sd_file_list[state->flash_cache.install_index], false);
+        snprintf(line, sizeof(line), "Progress: %u%%", state->flash_cache.progress);
+        sh1106_draw_string(display, 0, 32, line, false);
+        sh1106_draw_string(display, 0, 48, "Any btn: cancel", false);
+        sh1106_render(display);
+        return;
+    }
+
+    snprintf(line, sizeof(line), "Cached:%u Free:%luK", state->flash_cache.cached_count,
+             (unsigned long)state->flash_cache.free_kb);
+    sh1106_draw_string(display, 0, 0, line, false);
+
+    // Calculate visible window (5 items max)
+    int scroll_idx = state->flash_cache.scroll_index;
+    int file_count = state->sd_card.file_count;
+    int total_items = file_count + 2; // +2 for [Clear Cache] and [Main Menu]
+
+    int start_idx = 0;
+    if (scroll_idx > 2) start_idx = scroll_idx - 2;
+    if (start_idx + 5 > total_items) start_idx = total_items - 5;
+    if (start_idx < 0) start_idx = 0;
+
+    for (int i = 0; i < 5; i++) {
+        int item_idx = start_idx + i;
+        if (item_idx >= total_items) break;
+
+        bool is_selected = (item_idx == scroll_idx);
+        int y = 10 + i * 9;
+
+        if (item_idx < file_count) {
+            // '*' marks files already installed for this layout
+            bool cached = flash_cache_lookup(sd_file_list[item_idx]) != NULL;
+            snprintf(line, sizeof(line), "%c%s", cached ? '*' : ' ', sd_file_list[item_idx]);
+            sh1106_draw_string(display, 0, y, line, is_selected);
+        } else if (item_idx == file_count) {
+            sh1106_draw_string(display, 0, y, "[ Clear Cache ]", is_selected);
+        } else {
+            sh1106_draw_string(display, 0, y, "[ Main Menu ]", is_selected);
+        }
+    }
+
+    if (state->flash_cache.status_msg[0]) {
+        sh1106_draw_string(display, 0, 56, state->flash_cache.status_msg, false);
+    } else {
+        sh1106_draw_string(display, 0, 56, "Sel:inst Nxt:scrl", false);
+    }
+    sh1106_render(display);
+}
+
+static void render_usb_stream_detail(sh1106_t* display, const AppState* state) {
+    char line[24];
+    sh1106_clear(display);
+    sh1106_draw_string(display, 0, 0, "USB Stream", false);
+    bool running = state->usb_stream.run_state == TEST_RUNNING;
+    if (running && state->usb_stream.fps == 0) {
+        sh1106_draw_string(display, 0, 16, "WAITING", true);
+    } else {
+        sh1106_draw_string(display, 0, 16, running ? "RUNNING" : "STOPPED", running);
+    }
+    snprintf(line, sizeof(line), "FPS: %u", state->usb_stream.fps);
+    sh1106_draw_string(display, 0, 28, line, false);
+    snprintf(line, sizeof(line), "Frames: %lu", (unsigned long)state->usb_stream.frames);
+    sh1106_draw_string(display, 0, 38, line, false);
+    sh1106_draw_string(display, 0, 56, "Any btn: stop", false);
+    sh1106_render(display);
+}
+
+static void render_effects_detail(sh1106_t* display, const AppState* state) {
+    char line[24];
+    const EffectsState* e = &state->effects;
+    sh1106_clear(display);
+    sh1106_draw_string(display, 0, 0, e->cycle ? "Effects: show" : "Effects", false);
+    bool running = e->run_state == TEST_RUNNING;
+    sh1106_draw_string(display, 0, 12, running ? effects_name(e->effect) : "STOPPED", running);
+    snprintf(line, sizeof(line), "FPS %u  Load %u%%", e->fps, e->load_pct);
+    sh1106_draw_string(display, 0, 24, line, false);
+    snprintf(line, sizeof(line), "us: Rnd%u Enc%u", e->render_us, e->encode_us);
+    sh1106_draw_string(display, 0, 34, line, false);
+    sh1106_draw_string(display, 0, 48, "Select: next effect", false);
+    sh1106_draw_string(display, 0, 56, "Next: exit", false);
+    sh1106_render(display);
+}
+
+static void render_perf_detail(sh1106_t* display, const AppState* state) {
+    char line[24];
+    const PerfViewState* p = &state->perf;
+    sh1106_clear(display);
+
+    if (!state->sd_card.is_playing) {
+        sh1106_draw_string(display, 0, 0, "Perf", false);
+        sh1106_draw_string(display, 0, 16, "NOT PLAYING", false);
+        sh1106_draw_string(display, 0, 32, "Start a show first", false);
+        sh1106_draw_string(display, 0, 56, "Any btn: exit", false);
+        sh1106_render(display);
+        return;
+    }
+
+    // Highlight the header when the show can't keep up
+    bool behind = p->target_fps > 0 && p->fps + 1 < p->target_fps;
+    snprintf(line, sizeof(line), "FPS %u/%u  CPU %u%%", p->fps, p->target_fps, p->core1_pct);
+    sh1106_draw_string(display, 0, 0, line, behind);
+    snprintf(line, sizeof(line), "Late %lu Drop %lu",
+             (unsigned long)p->late, (unsigned long)p->dropped);
+    sh1106_draw_string(display, 0, 12, line, false);
+    snprintf(line, sizeof(line), "SD %lu.%02lu MB/s",
+             (unsigned long)(p->sd_kbps / 1000), (unsigned long)(p->sd_kbps % 1000 / 10));
+    sh1106_draw_string(display, 0, 22, line, false);
+    sh1106_draw_string(display, 0, 34, "us/frame:", false);
+    snprintf(line, sizeof(line), "Rd%u Dec%u Enc%u", p->read_us, p->decode_us, p->encode_us);
+    sh1106_draw_string(display, 0, 44, line, false);
+    sh1106_draw_string(display, 0, 56, "Any btn: exit", false);
+    sh1106_render(display);
+}
+
 static void render_string_test_detail(sh1106_t* display, const AppState* state) {
     sh1106_clear(display);
     sh1106_draw_string(display, 0, 0, "String Test", false);
@@ -227,6 +353,45 @@ static void render_string_length_detail(sh1106_t* display, const AppState* state
     sh1106_render(display);
 }
 
+static void render_string_discovery_detail(sh1106_t* display, const AppState* state) {
+    const StringDiscoveryState* sd = &state->string_discovery;
+    const string_discovery_t* search = &sd->search;
+    char line[24];
+    sh1106_clear(display);
+    sh1106_draw_string(display, 0, 0, "Find Lengths", false);
+
+    if (sd->run_state != TEST_RUNNING) {
+        sh1106_draw_string(display, 0, 16, sd->save_pending ? "Saving..." : sd->status_msg, false);
+        snprintf(line, sizeof(line), BOARD_CONFIG_LENGTHS_PATH, g_board_config.board_id);
+        sh1106_draw_string(display, 0, 26, line + 1, false);  // Without the leading /
+        sh1106_draw_string(display, 0, 48, "Select: exit", false);
+        sh1106_render(display);
+        return;
+    }
+
+    snprintf(line, sizeof(line), "Round %u  Left %u",
+             search->round, string_discovery_remaining(search));
+    sh1106_draw_string(display, 0, 10, line, false);
+
+    uint16_t pixel = 0;
+    string_discovery_marker(search, search->cursor, &pixel);
+    snprintf(line, sizeof(line), "String %u: %u lit?", search->cursor, pixel + 1);
+    sh1106_draw_string(display, 0, 20, line, false);
+
+    // 2 rows of 16 strings: # found, . open, cursor highlighted
+    for (int row = 0; row < 2; row++) {
+        for (int col = 0; col < 16; col++) {
+            uint8_t s = (uint8_t)(row * 16 + col);
+            char cell[2] = {string_discovery_resolved(search, s) ? '#' : '.', 0};
+            sh1106_draw_string(display, col * 6, 32 + row * 8, cell, s == search->cursor);
+        }
+    }
+
+    sh1106_draw_string(display, 0, 48, "Hold: whole round", false);
+    sh1106_draw_string(display, 0, 56, "Sel:lit  Nxt:dark", false);
+    sh1106_render(display);
+}
+
 static void render_brightness_detail(sh1106_t* display, const AppState* state) {
     char line[24];
     sh1106_clear(display);
@@ -271,6 +436,18 @@ void views_render(sh1106_t* display, const AppState* state) {
         case MENU_SD_CARD:
             render_sd_card_detail(display, state);
             break;
+        case MENU_FLASH_CACHE:
+            render_flash_cache_detail(display, state);
+            break;
+        case MENU_USB_STREAM:
+            render_usb_stream_detail(display, state);
+            break;
+        case MENU_EFFECTS:
+            render_effects_detail(display, state);
+            break;
+        case MENU_PERF:
+            render_perf_detail(display, state);
+            break;
         case MENU_STRING_TEST:
             render_string_test_detail(display, state);
             break;
@@ -283,6 +460,9 @@ void views_render(sh1106_t* display, const AppState* state) {
         case MENU_STRING_LENGTH:
             render_string_length_detail(display, state);
             break;
+        case MENU_STRING_DISCOVERY:
+            render_string_discovery_detail(display, state);
+            break;
         case MENU_BRIGHTNESS:
             render_brightness_detail(display, state);
             break;
@@ -35,6 +35,10 @@ static bool create_driver(string_length_test_t *ctx) {
         return false;
     }
 
+    pb_power_config_t power;
+    board_config_power(&g_board_config, &power);
+    pb_set_power_config(ctx->driver, &power);
+
     return true;
 }
 
@@ -101,6 +105,24 @@ void string_length_test_update(string_length_test_t *ctx, uint8_t string, uint16
     pb_show(ctx->driver);
 }
 
+void string_length_test_show_markers(string_length_test_t *ctx, const string_discovery_t *search) {
+    if (!ctx || !ctx->running || !ctx->driver) return;
+
+    pb_clear_all(ctx->driver, 0x000000);
+
+    // All strings share the frame, so one show covers every marker
+    for (uint8_t s = 0; s < STRING_LENGTH_TEST_NUM_STRINGS; s++) {
+        uint16_t pixel;
+        if (string_discovery_marker(search, s, &pixel)) {
+            pb_set_pixel(ctx->driver, 0, s, pixel, s == search->cursor ? 0xFFFFFF : 0xFF0000);
+        } else if (string_discovery_length(search, s) > 0) {
+            pb_set_pixel(ctx->driver, 0, s, string_discovery_length(search, s) - 1, 0x00FF00);
+        }
+    }
+
+    pb_show(ctx->driver);
+}
+
 bool string_length_test_is_running(const string_length_test_t *ctx) {
     return ctx && ctx->running;
 }
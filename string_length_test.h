@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include "pico/types.h"
 #include "pb_led_driver.h"
+#include "string_discovery.h"
 
 #define STRING_LENGTH_TEST_NUM_STRINGS 32
 #define STRING_LENGTH_TEST_MAX_PIXELS 512  // Must match PB_MAX_PIXELS
@@ -27,5 +28,10 @@ void string_length_test_stop(string_length_test_t *ctx);
 // Update the current position (called when state changes)
 void string_length_test_update(string_length_test_t *ctx, uint8_t string, uint16_t pixel);
 
+// Light the discovery markers on every string in one frame: white on the
+// cursor string, red on the other open strings, green on the last pixel of
+// strings already resolved
+void string_length_test_show_markers(string_length_test_t *ctx, const string_discovery_t *search);
+
 // Check if running
 bool string_length_test_is_running(const string_length_test_t *ctx);
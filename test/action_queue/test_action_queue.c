@@ -0,0 +1,246 @@
+/**
+ * test_action_queue.c - Tests for batched action dispatch
+ *
+ * Covers the queue itself and checks that reducing a burst of actions in
+ * batches ends in the same state as reducing them one at a time.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_action_queue
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "action_queue.h"
+#include "reducer.h"
+#include "board_config.h"
+
+board_config_t g_board_config = {.loaded = true, .string_count = 4};
+char sd_file_list[SD_MAX_FILES][SD_FILENAME_LEN];
+
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static action_queue_t q;
+
+static bool states_equal(const AppState* a, const AppState* b) {
+    return a->version == b->version &&
+           a->is_powered_on == b->is_powered_on &&
+           a->brightness_level == b->brightness_level &&
+           a->menu_selection == b->menu_selection &&
+           a->in_detail_view == b->in_detail_view &&
+           a->uptime_seconds == b->uptime_seconds &&
+           a->board_address.adc_value == b->board_address.adc_value &&
+           a->board_address.code == b->board_address.code &&
+           a->info_view.scroll_index == b->info_view.scroll_index &&
+           a->sd_card.is_playing == b->sd_card.is_playing &&
+           a->sd_card.playing_index == b->sd_card.playing_index &&
+           a->sd_card.needs_scan == b->sd_card.needs_scan &&
+           a->sd_card.auto_loop == b->sd_card.auto_loop &&
+           a->string_test.run_state == b->string_test.run_state &&
+           a->rainbow_test.run_state == b->rainbow_test.run_state &&
+           a->rainbow_test.current_string == b->rainbow_test.current_string &&
+           a->rainbow_test.fps == b->rainbow_test.fps &&
+           a->string_length.current_pixel == b->string_length.current_pixel &&
+           memcmp(a->string_length.lengths, b->string_length.lengths,
+                  sizeof(a->string_length.lengths)) == 0;
+}
+
+// A busy main loop: menu navigation, IR brightness repeat, ticks and board
+// address samples interleaved, a test started and stopped
+static int burst(Action* out) {
+    int n = 0;
+    out[n++] = action_tick_1s(0);
+    for (int i = 0; i < MENU_RAINBOW_TEST; i++) out[n++] = action_button_next(1);
+    out[n++] = action_board_address_updated(2, 3000, 0x4, 10, 200);
+    out[n++] = action_button_select(3);                             // start rainbow
+    out[n++] = action_rainbow_frame_complete(4, 60);
+    out[n++] = action_button_select(5);                             // next string
+    for (int i = 0; i < 7; i++) out[n++] = action_brightness_down(6);
+    out[n++] = action_tick_1s(7);
+    for (int i = 0; i < 3; i++) out[n++] = action_brightness_up(8);
+    out[n++] = action_board_address_updated(9, 3001, 0x4, 11, 199);
+    out[n++] = action_button_next(10);                              // exit, stop
+    out[n++] = action_auto_toggle(11);
+    out[n++] = action_power_toggle(12);
+    out[n++] = action_button_select(13);                            // wake
+    out[n++] = action_tick_1s(14);
+    return n;
+}
+
+// Reduce actions through the queue in batches of up to batch
+static AppState reduce_batched(const Action* actions, int n, int batch) {
+    AppState state = app_state_init();
+    action_queue_init(&q);
+    for (int i = 0; i < n; i++) {
+        ASSERT_TRUE(action_queue_push(&q, &actions[i]));
+        if (q.count == batch) action_queue_reduce(&q, &state);
+    }
+    action_queue_reduce(&q, &state);
+    return state;
+}
+
+// ============================================================================
+// Queue
+// ============================================================================
+
+TEST(fifo_order) {
+    action_queue_init(&q);
+    Action a = action_tick_1s(1), b = action_button_next(2), out;
+    ASSERT_TRUE(action_queue_push(&q, &a));
+    ASSERT_TRUE(action_queue_push(&q, &b));
+    ASSERT_TRUE(action_queue_pop(&q, &out));
+    ASSERT_EQ(ACTION_TICK_1S, out.type);
+    ASSERT_TRUE(action_queue_pop(&q, &out));
+    ASSERT_EQ(ACTION_BUTTON_NEXT, out.type);
+    ASSERT_TRUE(!action_queue_pop(&q, &out));
+}
+
+TEST(full_rejects) {
+    action_queue_init(&q);
+    Action a = action_tick_1s(0);
+    for (int i = 0; i < ACTION_QUEUE_SIZE; i++) ASSERT_TRUE(action_queue_push(&q, &a));
+    ASSERT_TRUE(!action_queue_push(&q, &a));
+    ASSERT_EQ(ACTION_QUEUE_SIZE, q.count);
+}
+
+TEST(wraps_around) {
+    action_queue_init(&q);
+    Action out;
+    for (uint32_t i = 0; i < ACTION_QUEUE_SIZE * 3; i++) {
+        Action a = action_tick_1s(i);
+        ASSERT_TRUE(action_queue_push(&q, &a));
+        ASSERT_TRUE(action_queue_pop(&q, &out));
+        ASSERT_EQ(i, out.timestamp);
+    }
+    ASSERT_EQ(0, q.count);
+}
+
+TEST(reduce_empties_queue) {
+    action_queue_init(&q);
+    AppState state = app_state_init();
+    Action a = action_tick_1s(0);
+    action_queue_push(&q, &a);
+    action_queue_push(&q, &a);
+    ASSERT_EQ(2, action_queue_reduce(&q, &state));
+    ASSERT_EQ(0, q.count);
+    ASSERT_EQ(2, state.uptime_seconds);
+    ASSERT_EQ(0, action_queue_reduce(&q, &state));
+}
+
+// ============================================================================
+// Batching
+// ============================================================================
+
+TEST(batches_match_one_at_a_time) {
+    Action actions[64];
+    int n = burst(actions);
+
+    AppState expected = app_state_init();
+    for (int i = 0; i < n; i++) expected = reduce(&expected, &actions[i]);
+    ASSERT_EQ(3, expected.uptime_seconds);
+    ASSERT_EQ(6, expected.brightness_level);
+    ASSERT_EQ(1, expected.rainbow_test.current_string);
+    ASSERT_EQ(TEST_STOPPED, expected.rainbow_test.run_state);
+
+    int batches[] = {1, 2, 3, 5, ACTION_QUEUE_SIZE};
+    for (int b = 0; b < 5; b++) {
+        AppState got = reduce_batched(actions, n, batches[b]);
+        ASSERT_TRUE(states_equal(&expected, &got));
+    }
+}
+
+TEST(batch_reports_net_change_only) {
+    AppState state = app_state_init();
+    state.menu_selection = MENU_STRING_TEST;
+    AppState old_state = state;
+
+    // Start then stop inside one batch: side effects see no run state change
+    action_queue_init(&q);
+    Action sel = action_button_select(0), next = action_button_next(1);
+    action_queue_push(&q, &sel);
+    action_queue_push(&q, &next);
+    action_queue_reduce(&q, &state);
+
+    ASSERT_TRUE(app_state_dirty(&old_state, &state));
+    ASSERT_EQ(old_state.string_test.run_state, state.string_test.run_state);
+    ASSERT_TRUE(!state.in_detail_view);
+}
+
+TEST(unchanged_batch_not_dirty) {
+    AppState state = app_state_init();
+    AppState old_state = state;
+    action_queue_init(&q);
+    // Same sample twice and a no-op brightness up at max
+    Action addr = action_board_address_updated(0, 0, 0, 0, 0);
+    Action up = action_brightness_up(1);
+    action_queue_push(&q, &addr);
+    action_queue_push(&q, &up);
+    action_queue_push(&q, &addr);
+    action_queue_reduce(&q, &state);
+    ASSERT_TRUE(!app_state_dirty(&old_state, &state));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Action Queue Tests ===\n\n");
+
+    printf("Queue:\n");
+    RUN_TEST(fifo_order);
+    RUN_TEST(full_rejects);
+    RUN_TEST(wraps_around);
+    RUN_TEST(reduce_empties_queue);
+
+    printf("\nBatching:\n");
+    RUN_TEST(batches_match_one_at_a_time);
+    RUN_TEST(batch_reports_net_change_only);
+    RUN_TEST(unchanged_batch_not_dirty);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
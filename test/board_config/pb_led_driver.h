@@ -1,6 +1,6 @@
 /**
  * pb_led_driver.h - Minimal stub for host testing
- * Only includes the color order enum needed by board_config
+ * Only includes the color order enum and power budget types needed by board_config
  */
 
 #ifndef PB_LED_DRIVER_H
@@ -18,4 +18,14 @@ typedef enum {
     PB_COLOR_ORDER_BRG,
 } pb_color_order_t;
 
+#define PB_MAX_STRINGS 32
+#define PB_POWER_DEFAULT_CHANNEL_MA 20
+
+/** Current budgets (0 = unlimited) */
+typedef struct {
+    uint16_t channel_ma;
+    uint32_t budget_ma;
+    uint16_t string_budget_ma[PB_MAX_STRINGS];
+} pb_power_config_t;
+
 #endif // PB_LED_DRIVER_H
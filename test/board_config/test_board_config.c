@@ -353,6 +353,32 @@ TEST(parse_buffer_board_1_few_strings) {
     ASSERT_EQ(PB_COLOR_ORDER_BGR, config.strings[1].color_order);
     ASSERT_EQ(90, config.strings[4].pixel_count);
     ASSERT_EQ(PB_COLOR_ORDER_GBR, config.strings[4].color_order);
+    ASSERT_EQ(32 * 10 * 3, config.start_channel);
+}
+
+TEST(parse_buffer_start_channel_skips_comments_and_disabled) {
+    const char* csv =
+        "# Board 0\n"
+        "100,GRB\n"
+        "0\n"
+        "\n"
+        "25,RGB\n"
+        "0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n"
+        "0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n"
+        "0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n"
+        "0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n0,GRB\n"
+        "# Board 1\n"
+        "40,GRB\n";
+
+    board_config_t config;
+    board_config_parse_result_t result = board_config_parse_buffer(csv, strlen(csv), 0, &config);
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(0, config.start_channel);
+
+    result = board_config_parse_buffer(csv, strlen(csv), 1, &config);
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(40, config.strings[0].pixel_count);
+    ASSERT_EQ((100 + 25) * 3, config.start_channel);
 }
 
 TEST(parse_buffer_board_2_full_32_strings) {
@@ -383,6 +409,7 @@ TEST(parse_buffer_board_2_full_32_strings) {
     ASSERT_EQ(PB_COLOR_ORDER_RGB, config.strings[0].color_order);
     ASSERT_EQ(10, config.strings[1].pixel_count);
     ASSERT_EQ(PB_COLOR_ORDER_GRB, config.strings[1].color_order);
+    ASSERT_EQ((32 * 10 + 32 * 20) * 3, config.start_channel);
 }
 
 TEST(parse_buffer_board_with_zero_in_middle) {
@@ -625,6 +652,222 @@ TEST(sample_config_malformed) {
     ASSERT_EQ(2, result.error_line);  // Line 2 is malformed
 }
 
+// ============================================================================
+// Config hash tests
+// ============================================================================
+
+TEST(config_hash_known_value) {
+    // FNV-1a reference values
+    ASSERT_TRUE(board_config_hash("", 0) == 0x811C9DC5u);
+    ASSERT_TRUE(board_config_hash("a", 1) == 0xE40C292Cu);
+}
+
+TEST(config_hash_detects_edit) {
+    const char* a = "50,GRB\n100,RGB\n";
+    const char* b = "50,GRB\n101,RGB\n";
+    ASSERT_TRUE(board_config_hash(a, strlen(a)) == board_config_hash(a, strlen(a)));
+    ASSERT_TRUE(board_config_hash(a, strlen(a)) != board_config_hash(b, strlen(b)));
+}
+
+// ============================================================================
+// Power budget tests
+// ============================================================================
+
+TEST(power_defaults_to_unlimited) {
+    const char* csv = "50,GRB\n";
+
+    board_config_t config;
+    board_config_parse_result_t result = board_config_parse_buffer(csv, strlen(csv), 0, &config);
+
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(0, config.power_budget_ma);
+    ASSERT_EQ(PB_POWER_DEFAULT_CHANNEL_MA, config.channel_ma);
+    ASSERT_EQ(0, config.strings[0].max_ma);
+}
+
+TEST(power_string_budget_column) {
+    const char* csv =
+        "50,GRB,1500\n"
+        "100,RGB\n"
+        "0\n";
+
+    board_config_t config;
+    board_config_parse_result_t result = board_config_parse_buffer(csv, strlen(csv), 0, &config);
+
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(1500, config.strings[0].max_ma);
+    ASSERT_EQ(PB_COLOR_ORDER_GRB, config.strings[0].color_order);
+    ASSERT_EQ(0, config.strings[1].max_ma);
+}
+
+TEST(power_keywords_are_not_rows) {
+    const char* csv =
+        "channel_ma,12\n"
+        "50,GRB\n"
+        "power,0,4000\n"
+        "power,1,9000\n"
+        "100,RGB\n";
+
+    board_config_t config;
+    board_config_parse_result_t result = board_config_parse_buffer(csv, strlen(csv), 0, &config);
+
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(2, config.string_count);
+    ASSERT_EQ(100, config.strings[1].pixel_count);
+    ASSERT_EQ(4000, config.power_budget_ma);
+    ASSERT_EQ(12, config.channel_ma);
+}
+
+TEST(power_keyword_after_board_section) {
+    // Board 1's budget is found even though its rows come first
+    char csv[1024];
+    char* p = csv;
+    for (int i = 0; i < 33; i++) p += sprintf(p, "10,GRB\n");
+    p += sprintf(p, "power,1,2500\n");
+
+    board_config_t config;
+    board_config_parse_result_t result = board_config_parse_buffer(csv, strlen(csv), 1, &config);
+
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(1, config.string_count);
+    ASSERT_EQ(10 * 32 * 3, config.start_channel);
+    ASSERT_EQ(2500, config.power_budget_ma);
+}
+
+TEST(power_fills_driver_config) {
+    const char* csv =
+        "power,0,3000\n"
+        "50,GRB,800\n"
+        "50,GRB\n"
+        "50,GRB,600\n";
+
+    board_config_t config;
+    board_config_parse_buffer(csv, strlen(csv), 0, &config);
+
+    pb_power_config_t power;
+    board_config_power(&config, &power);
+    ASSERT_EQ(PB_POWER_DEFAULT_CHANNEL_MA, power.channel_ma);
+    ASSERT_EQ(3000, power.budget_ma);
+    ASSERT_EQ(800, power.string_budget_ma[0]);
+    ASSERT_EQ(0, power.string_budget_ma[1]);
+    ASSERT_EQ(600, power.string_budget_ma[2]);
+}
+
+// ============================================================================
+// Board ID keyword
+// ============================================================================
+
+TEST(board_id_keyword_overrides_ladder) {
+    // Board 1's rows are picked by the keyword, not the ladder's 0
+    char csv[1024];
+    char* p = csv;
+    p += sprintf(p, "board_id,1\n");
+    for (int i = 0; i < 32; i++) p += sprintf(p, "10,GRB\n");
+    p += sprintf(p, "100,RGB\n");
+
+    board_config_t config;
+    board_config_parse_result_t result = board_config_parse_buffer(csv, strlen(csv), 0, &config);
+
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(1, config.board_id);
+    ASSERT_TRUE(config.board_id_from_config);
+    ASSERT_EQ(1, config.string_count);
+    ASSERT_EQ(100, config.strings[0].pixel_count);
+    ASSERT_EQ(10 * 32 * 3, config.start_channel);
+}
+
+TEST(board_id_keyword_anywhere) {
+    const char* csv =
+        "# shared by every board\n"
+        "50,GRB\n"
+        "  board_id,7\r\n";
+    uint8_t id = 0;
+    ASSERT_TRUE(board_config_parse_board_id(csv, strlen(csv), &id));
+    ASSERT_EQ(7, id);
+}
+
+TEST(board_id_without_keyword_uses_ladder) {
+    const char* csv = "50,GRB\n60,GRB\n";
+    board_config_t config;
+    board_config_parse_result_t result = board_config_parse_buffer(csv, strlen(csv), 0, &config);
+
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(0, config.board_id);
+    ASSERT_TRUE(!config.board_id_from_config);
+    ASSERT_EQ(2, config.string_count);
+}
+
+TEST(board_id_out_of_range_ignored) {
+    uint8_t id = 3;
+    ASSERT_TRUE(!board_config_parse_board_id("board_id,256\n", 13, &id));
+    ASSERT_TRUE(!board_config_parse_board_id("board_id,x\n", 11, &id));
+    ASSERT_EQ(3, id);
+}
+
+// ============================================================================
+// Discovered lengths export
+// ============================================================================
+
+TEST(format_csv_round_trips) {
+    const char* csv =
+        "50,RGB,800\n"
+        "50,BGR\n";
+    board_config_t config;
+    board_config_parse_buffer(csv, strlen(csv), 0, &config);
+
+    uint16_t lengths[BOARD_CONFIG_MAX_STRINGS] = {0};
+    lengths[0] = 150;
+    lengths[1] = 512;
+    lengths[31] = 7;
+
+    char out[1024];
+    size_t len = board_config_format_csv(&config, lengths, out, sizeof(out));
+    ASSERT_TRUE(len > 0);
+    ASSERT_EQ(strlen(out), len);
+
+    board_config_t parsed;
+    board_config_parse_result_t result = board_config_parse_buffer(out, len, 0, &parsed);
+    ASSERT_TRUE(result.success);
+    ASSERT_EQ(32, parsed.string_count);
+    ASSERT_EQ(150, parsed.strings[0].pixel_count);
+    ASSERT_EQ(PB_COLOR_ORDER_RGB, parsed.strings[0].color_order);
+    ASSERT_EQ(800, parsed.strings[0].max_ma);
+    ASSERT_EQ(512, parsed.strings[1].pixel_count);
+    ASSERT_EQ(PB_COLOR_ORDER_BGR, parsed.strings[1].color_order);
+    ASSERT_EQ(0, parsed.strings[1].max_ma);
+    ASSERT_EQ(0, parsed.strings[2].pixel_count);
+    ASSERT_EQ(7, parsed.strings[31].pixel_count);
+}
+
+TEST(format_csv_one_row_per_string) {
+    board_config_t config;
+    board_config_parse_buffer("", 0, 0, &config);
+    config.board_id = 3;
+    uint16_t lengths[BOARD_CONFIG_MAX_STRINGS] = {0};
+
+    char out[1024];
+    size_t len = board_config_format_csv(&config, lengths, out, sizeof(out));
+
+    // Lines that aren't comments
+    int rows = 0;
+    for (size_t i = 0; i < len; i++) {
+        bool line_start = i == 0 || out[i - 1] == '\n';
+        if (line_start && out[i] != '#') rows++;
+    }
+    ASSERT_EQ(32, rows);
+    ASSERT_TRUE(strstr(out, "# Board 3") == out);
+    ASSERT_TRUE(strstr(out, "\n0,GRB\n") != NULL);
+}
+
+TEST(format_csv_too_small) {
+    board_config_t config;
+    board_config_parse_buffer("", 0, 0, &config);
+    uint16_t lengths[BOARD_CONFIG_MAX_STRINGS] = {0};
+
+    char out[64];
+    ASSERT_EQ(0, board_config_format_csv(&config, lengths, out, sizeof(out)));
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -667,6 +910,7 @@ int main(void) {
     RUN_TEST(parse_buffer_board_1_few_strings);
     RUN_TEST(parse_buffer_board_2_full_32_strings);
     RUN_TEST(parse_buffer_board_with_zero_in_middle);
+    RUN_TEST(parse_buffer_start_channel_skips_comments_and_disabled);
 
     printf("\nError handling:\n");
     RUN_TEST(parse_buffer_malformed_line);
@@ -684,6 +928,28 @@ int main(void) {
     RUN_TEST(sample_config_two_boards_board1);
     RUN_TEST(sample_config_malformed);
 
+    printf("\nConfig hash:\n");
+    RUN_TEST(config_hash_known_value);
+    RUN_TEST(config_hash_detects_edit);
+
+    printf("\nPower budgets:\n");
+    RUN_TEST(power_defaults_to_unlimited);
+    RUN_TEST(power_string_budget_column);
+    RUN_TEST(power_keywords_are_not_rows);
+    RUN_TEST(power_keyword_after_board_section);
+    RUN_TEST(power_fills_driver_config);
+
+    printf("\nBoard ID:\n");
+    RUN_TEST(board_id_keyword_overrides_ladder);
+    RUN_TEST(board_id_keyword_anywhere);
+    RUN_TEST(board_id_without_keyword_uses_ladder);
+    RUN_TEST(board_id_out_of_range_ignored);
+
+    printf("\nDiscovered lengths export:\n");
+    RUN_TEST(format_csv_round_trips);
+    RUN_TEST(format_csv_one_row_per_string);
+    RUN_TEST(format_csv_too_small);
+
     printf("\n=================================\n");
     printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
     printf("=================================\n\n");
@@ -0,0 +1,245 @@
+/**
+ * test_chase.c - Tests for timecode chase
+ *
+ * Drives the controller against a simulated master clock and a simulated
+ * player that shows frames at whatever interval the controller asks for,
+ * with transport jitter, drift, master jumps and sample loss.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_chase
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "chase.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Simulation
+// ============================================================================
+
+#define STEP_US     25000      // 40 fps
+#define FRAMES      2400       // 60 s show
+
+typedef struct {
+    chase_t chase;
+    uint64_t now_us;           // Local clock
+    uint32_t frame;            // Frame just shown
+    int64_t master_start_us;   // Local time at which master was at 0
+    int32_t drift_ppm;         // Master clock rate error
+    uint32_t jitter_us;        // Max transport delay on samples
+    uint32_t sample_every;     // Frames between samples (0 = none)
+    uint32_t rng;
+    uint32_t frames_run;
+} sim_t;
+
+static uint32_t sim_rand(sim_t* s) {
+    s->rng = s->rng * 1103515245u + 12345u;
+    return (s->rng >> 8) & 0xFFFFFF;
+}
+
+static uint32_t sim_master_ms(const sim_t* s, uint64_t local_us) {
+    int64_t elapsed = (int64_t)local_us - s->master_start_us;
+    elapsed += elapsed * s->drift_ppm / 1000000;
+    if (elapsed < 0) elapsed = 0;
+    return (uint32_t)(elapsed / 1000);
+}
+
+// Signed distance (us) from the frame shown to where the master is
+static int64_t sim_error_us(const sim_t* s) {
+    int64_t len = (int64_t)FRAMES * STEP_US;
+    int64_t elapsed = (int64_t)s->now_us - s->master_start_us;
+    elapsed += elapsed * s->drift_ppm / 1000000;
+    int64_t e = (elapsed % len) - (int64_t)s->frame * STEP_US;
+    if (e > len / 2) e -= len;
+    if (e < -len / 2) e += len;
+    return e;
+}
+
+static void sim_init(sim_t* s, uint32_t start_frame, int64_t master_start_us) {
+    memset(s, 0, sizeof(*s));
+    chase_init(&s->chase);
+    s->now_us = 1000000;
+    s->frame = start_frame;
+    s->master_start_us = master_start_us;
+    s->sample_every = 4;
+    s->rng = 1;
+}
+
+// Show frames for n frames, feeding samples. Returns worst |error| seen in
+// the last `tail` frames.
+static int64_t sim_run(sim_t* s, uint32_t n, uint32_t tail) {
+    int64_t worst = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (s->sample_every && (s->frames_run % s->sample_every) == 0) {
+            uint32_t delay = s->jitter_us ? sim_rand(s) % s->jitter_us : 0;
+            // Sample taken now, arrives (and is stamped) delay later
+            chase_sample(&s->chase, sim_master_ms(s, s->now_us), s->now_us + delay);
+        }
+
+        chase_output_t out;
+        chase_frame(&s->chase, s->now_us, s->frame, FRAMES, STEP_US, &out);
+        if (i >= n - tail) {
+            int64_t e = sim_error_us(s);
+            if (e < 0) e = -e;
+            if (e > worst) worst = e;
+        }
+
+        s->now_us += out.interval_us;
+        s->frame = out.seek ? out.seek_frame : (s->frame + 1) % FRAMES;
+        s->frames_run++;
+    }
+    return worst;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST(no_samples_free_runs) {
+    chase_t c;
+    chase_init(&c);
+    chase_output_t out;
+    chase_frame(&c, 1000, 5, FRAMES, STEP_US, &out);
+    ASSERT_TRUE(!out.seek);
+    ASSERT_EQ(STEP_US, out.interval_us);
+    ASSERT_TRUE(!chase_active(&c, 1000));
+}
+
+TEST(far_off_seeks_then_holds_within_frame) {
+    sim_t s;
+    sim_init(&s, 0, 1000000 - 12 * 1000000LL);  // Master 12 s in
+    int64_t worst = sim_run(&s, 400, 300);
+    ASSERT_TRUE(s.chase.stats.seeks >= 1);
+    ASSERT_TRUE(worst < STEP_US);
+}
+
+TEST(small_offset_slews_without_seeking) {
+    sim_t s;
+    sim_init(&s, 0, 1000000 - 30000);  // Master 30 ms (1.2 frames) ahead
+    int64_t worst = sim_run(&s, 200, 100);
+    ASSERT_EQ(0, s.chase.stats.seeks);
+    ASSERT_TRUE(s.chase.stats.slews > 0);
+    ASSERT_TRUE(worst < STEP_US / 4);
+}
+
+TEST(tracks_drift_and_jitter) {
+    sim_t s;
+    sim_init(&s, 0, 1000000);
+    s.drift_ppm = 500;         // Master runs 0.05% fast
+    s.jitter_us = 8000;        // Up to 8 ms transport jitter
+    int64_t worst = sim_run(&s, 4000, 3000);
+    ASSERT_TRUE(worst < STEP_US);
+    ASSERT_TRUE(s.chase.stats.seeks <= 1);
+}
+
+TEST(outlier_rejected) {
+    sim_t s;
+    sim_init(&s, 0, 1000000);
+    sim_run(&s, 100, 1);
+
+    // One wildly late sample
+    chase_sample(&s.chase, sim_master_ms(&s, s.now_us), s.now_us + 500000);
+    ASSERT_EQ(1, s.chase.stats.outliers);
+    int64_t worst = sim_run(&s, 100, 100);
+    ASSERT_EQ(0, s.chase.stats.seeks);
+    ASSERT_TRUE(worst < STEP_US);
+}
+
+TEST(master_jump_relocks_and_seeks) {
+    sim_t s;
+    sim_init(&s, 0, 1000000);
+    sim_run(&s, 100, 1);
+
+    s.master_start_us -= 20 * 1000000LL;  // Operator jumps the master 20 s
+    int64_t worst = sim_run(&s, 200, 150);
+    ASSERT_EQ(1, s.chase.stats.relocks);
+    ASSERT_TRUE(s.chase.stats.seeks >= 1);
+    ASSERT_TRUE(worst < STEP_US);
+}
+
+TEST(loop_boundary_no_spurious_seek) {
+    sim_t s;
+    // Master about to wrap from the last frame to the first
+    sim_init(&s, FRAMES - 20, 1000000 - (int64_t)(FRAMES - 20) * STEP_US);
+    int64_t worst = sim_run(&s, 100, 100);
+    ASSERT_EQ(0, s.chase.stats.seeks);
+    ASSERT_TRUE(worst < STEP_US);
+}
+
+TEST(timeout_returns_to_free_run) {
+    sim_t s;
+    sim_init(&s, 0, 1000000);
+    sim_run(&s, 50, 1);
+    ASSERT_TRUE(chase_active(&s.chase, s.now_us));
+
+    s.sample_every = 0;
+    sim_run(&s, (CHASE_TIMEOUT_US / STEP_US) + 2, 1);
+    ASSERT_TRUE(!chase_active(&s.chase, s.now_us));
+    chase_output_t out;
+    chase_frame(&s.chase, s.now_us, s.frame, FRAMES, STEP_US, &out);
+    ASSERT_EQ(STEP_US, out.interval_us);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Chase Tests ===\n\n");
+
+    printf("Controller:\n");
+    RUN_TEST(no_samples_free_runs);
+    RUN_TEST(far_off_seeks_then_holds_within_frame);
+    RUN_TEST(small_offset_slews_without_seeking);
+    RUN_TEST(tracks_drift_and_jitter);
+
+    printf("\nFiltering:\n");
+    RUN_TEST(outlier_rejected);
+    RUN_TEST(master_jump_relocks_and_seeks);
+    RUN_TEST(loop_boundary_no_spurious_seek);
+    RUN_TEST(timeout_returns_to_free_run);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
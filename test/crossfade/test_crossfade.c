@@ -0,0 +1,270 @@
+/**
+ * test_crossfade.c - Tests for show-to-show crossfades
+ *
+ * Covers the fixed-point weight ramp and blend, the up-front budget check,
+ * and decoding two sequences at once with the parser pool.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_crossfade
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crossfade.h"
+#include "fseq_parser.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Budget for a 40 fps show that fits easily
+static crossfade_budget_t easy_budget(void) {
+    crossfade_budget_t b = {
+        .frame_bytes = 1500,
+        .buffer_bytes = 4096,
+        .frame_us = 25000,
+        .decode_us = 4000,
+        .current_channels = 1500,
+        .next_channels = 1500,
+        .sd_bytes_per_frame = 3000,
+        .sd_bytes_per_sec = 1000000,
+    };
+    return b;
+}
+
+// Pixel sink: one frame per parser, 2 strings x 2 pixels
+typedef struct {
+    uint32_t pixels[2][2];
+    int count;
+} sink_t;
+
+static void sink_pixel(void* user_data, uint8_t string, uint16_t pixel, uint32_t color) {
+    sink_t* sink = (sink_t*)user_data;
+    if (string < 2 && pixel < 2) sink->pixels[string][pixel] = color;
+    sink->count++;
+}
+
+static void make_header(uint8_t* buf, uint32_t channels, uint32_t frames) {
+    fseq_header_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = 0x51455350;  // "PSEQ"
+    h.major_version = 2;
+    h.channel_data_offset = 32;
+    h.header_length = 32;
+    h.channel_count = channels;
+    h.frame_count = frames;
+    h.step_time_ms = 25;
+    memcpy(buf, &h, 32);
+}
+
+// ============================================================================
+// Weight and blend tests
+// ============================================================================
+
+TEST(weight_ramps_without_reaching_ends) {
+    ASSERT_EQ(256 / 5, crossfade_weight(1, 4));
+    ASSERT_EQ(256 * 4 / 5, crossfade_weight(4, 4));
+    ASSERT_EQ(256 * 4 / 5, crossfade_weight(9, 4));  // Clamped
+    uint16_t prev = 0;
+    for (uint32_t i = 1; i <= 40; i++) {
+        uint16_t w = crossfade_weight(i, 40);
+        ASSERT_TRUE(w > prev);
+        ASSERT_TRUE(w < CROSSFADE_WEIGHT_ONE);
+        prev = w;
+    }
+    ASSERT_EQ(CROSSFADE_WEIGHT_ONE, crossfade_weight(0, 0));
+}
+
+TEST(blend_endpoints_and_midpoint) {
+    uint8_t dst[4] = {0, 255, 100, 7};
+    uint8_t src[4] = {255, 0, 100, 9};
+
+    uint8_t a[4];
+    memcpy(a, dst, 4);
+    crossfade_blend(a, src, 4, 0);
+    ASSERT_TRUE(memcmp(a, dst, 4) == 0);
+
+    memcpy(a, dst, 4);
+    crossfade_blend(a, src, 4, CROSSFADE_WEIGHT_ONE);
+    ASSERT_TRUE(memcmp(a, src, 4) == 0);
+
+    memcpy(a, dst, 4);
+    crossfade_blend(a, src, 4, 128);
+    ASSERT_EQ(128, a[0]);
+    ASSERT_EQ(128, a[1]);
+    ASSERT_EQ(100, a[2]);  // Equal inputs stay put
+    ASSERT_EQ(8, a[3]);
+}
+
+TEST(blend_is_monotonic) {
+    for (uint16_t w = 1; w < CROSSFADE_WEIGHT_ONE; w++) {
+        uint8_t lo = 10, hi = 10;
+        uint8_t up = 250, down = 0;
+        crossfade_blend(&lo, &up, 1, w - 1);
+        crossfade_blend(&hi, &up, 1, w);
+        ASSERT_TRUE(hi >= lo);
+        uint8_t x = 250, y = 250;
+        crossfade_blend(&x, &down, 1, w - 1);
+        crossfade_blend(&y, &down, 1, w);
+        ASSERT_TRUE(y <= x);
+    }
+}
+
+// ============================================================================
+// Budget tests
+// ============================================================================
+
+TEST(budget_accepts_easy_fade) {
+    crossfade_budget_t b = easy_budget();
+    ASSERT_EQ(CROSSFADE_OK, crossfade_check(&b));
+}
+
+TEST(budget_rejects_large_frame) {
+    crossfade_budget_t b = easy_budget();
+    b.frame_bytes = 5000;
+    ASSERT_EQ(CROSSFADE_NO_BUFFER, crossfade_check(&b));
+}
+
+TEST(budget_rejects_sd_bandwidth) {
+    crossfade_budget_t b = easy_budget();
+    b.sd_bytes_per_frame = 30000;  // 1.2 MB/s at 40 fps
+    ASSERT_EQ(CROSSFADE_SD_BANDWIDTH, crossfade_check(&b));
+
+    b.sd_bytes_per_frame = 0;      // Both shows in flash
+    ASSERT_EQ(CROSSFADE_OK, crossfade_check(&b));
+}
+
+TEST(budget_rejects_cpu) {
+    crossfade_budget_t b = easy_budget();
+    b.decode_us = 9000;            // 9 + 9 + 4.5 ms > 80% of 25 ms
+    ASSERT_EQ(CROSSFADE_CPU, crossfade_check(&b));
+
+    b.decode_us = 6000;
+    b.next_channels = 6000;        // Incoming show 4x the channels
+    ASSERT_EQ(CROSSFADE_CPU, crossfade_check(&b));
+}
+
+// ============================================================================
+// Parser pool tests
+// ============================================================================
+
+TEST(parser_pool_two_instances) {
+    uint16_t lengths[2] = {2, 2};
+    fseq_layout_t layout = { .num_strings = 2, .string_lengths = lengths };
+    sink_t sa = {0}, sb = {0};
+
+    fseq_parser_ctx_t* a = fseq_parser_init(&sa, sink_pixel, layout);
+    fseq_parser_ctx_t* b = fseq_parser_init(&sb, sink_pixel, layout);
+    ASSERT_TRUE(a != NULL && b != NULL && a != b);
+    ASSERT_TRUE(fseq_parser_init(&sa, sink_pixel, layout) == NULL);  // Pool exhausted
+
+    fseq_parser_deinit(a);
+    fseq_parser_ctx_t* c = fseq_parser_init(&sa, sink_pixel, layout);
+    ASSERT_TRUE(c == a);  // Slot reused
+
+    fseq_parser_deinit(b);
+    fseq_parser_deinit(c);
+}
+
+TEST(parsers_decode_independently) {
+    uint16_t lengths[2] = {2, 2};
+    fseq_layout_t layout = { .num_strings = 2, .string_lengths = lengths };
+    sink_t sa = {0}, sb = {0};
+    fseq_parser_ctx_t* a = fseq_parser_init(&sa, sink_pixel, layout);
+    fseq_parser_ctx_t* b = fseq_parser_init(&sb, sink_pixel, layout);
+
+    uint8_t hdr[32];
+    fseq_header_t h;
+    make_header(hdr, 12, 2);
+    ASSERT_TRUE(fseq_parser_read_header(a, hdr, &h));
+    ASSERT_TRUE(fseq_parser_read_header(b, hdr, &h));
+
+    uint8_t fa[12], fb[12];
+    for (int i = 0; i < 12; i++) {
+        fa[i] = (uint8_t)(i + 1);
+        fb[i] = (uint8_t)(0xF0 - i);
+    }
+
+    // Interleave pushes split at odd offsets so pixels straddle chunks
+    ASSERT_TRUE(!fseq_parser_push(a, fa, 5));
+    ASSERT_TRUE(!fseq_parser_push(b, fb, 7));
+    ASSERT_TRUE(fseq_parser_push(a, fa + 5, 7));
+    ASSERT_TRUE(fseq_parser_push(b, fb + 7, 5));
+
+    ASSERT_EQ(4, sa.count);
+    ASSERT_EQ(4, sb.count);
+    ASSERT_EQ(0x010203, sa.pixels[0][0]);
+    ASSERT_EQ(0x0A0B0C, sa.pixels[1][1]);
+    ASSERT_EQ(0xF0EFEE, sb.pixels[0][0]);
+    ASSERT_EQ(0xE7E6E5, sb.pixels[1][1]);
+
+    fseq_parser_deinit(a);
+    fseq_parser_deinit(b);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Crossfade Tests ===\n\n");
+
+    printf("Weight and blend:\n");
+    RUN_TEST(weight_ramps_without_reaching_ends);
+    RUN_TEST(blend_endpoints_and_midpoint);
+    RUN_TEST(blend_is_monotonic);
+
+    printf("\nBudget:\n");
+    RUN_TEST(budget_accepts_easy_fade);
+    RUN_TEST(budget_rejects_large_frame);
+    RUN_TEST(budget_rejects_sd_bandwidth);
+    RUN_TEST(budget_rejects_cpu);
+
+    printf("\nParser pool:\n");
+    RUN_TEST(parser_pool_two_instances);
+    RUN_TEST(parsers_decode_independently);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
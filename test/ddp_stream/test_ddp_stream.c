@@ -0,0 +1,316 @@
+/**
+ * test_ddp_stream.c - Loopback tests for the USB DDP stream path
+ *
+ * Frames are packed exactly like tools/ddp_usb_bridge.py does (DDP packets
+ * back to back on a byte stream), then fed to the framer in arbitrary chunk
+ * sizes, as the USB CDC endpoint would deliver them. Framed packets go through
+ * the pixel_proto assembler just like usb_stream.c does.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_ddp_stream
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ddp_stream.h"
+#include "pixel_proto.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Simulated LED buffer (span callback target)
+// ============================================================================
+
+#define T_STRINGS 4
+#define T_MAX_PIXELS 600
+
+static uint32_t leds[T_STRINGS][T_MAX_PIXELS];
+static uint32_t pixel_writes;
+
+static void span_cb(void* user_data, uint8_t string, uint16_t first_pixel,
+                    const uint8_t* rgb, uint16_t count) {
+    (void)user_data;
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t pixel = first_pixel + i;
+        if (string < T_STRINGS && pixel < T_MAX_PIXELS) {
+            leds[string][pixel] = ((uint32_t)rgb[i * 3] << 16) |
+                                  ((uint32_t)rgb[i * 3 + 1] << 8) |
+                                  rgb[i * 3 + 2];
+        }
+        pixel_writes++;
+    }
+}
+
+static uint16_t lengths[T_STRINGS] = {50, 100, 7, 513};
+
+static void reset_leds(void) {
+    memset(leds, 0, sizeof(leds));
+    pixel_writes = 0;
+}
+
+static uint32_t total_channels(void) {
+    uint32_t n = 0;
+    for (int i = 0; i < T_STRINGS; i++) n += lengths[i] * 3u;
+    return n;
+}
+
+// Deterministic frame content
+static uint8_t frame_byte(uint32_t frame, uint32_t channel) {
+    return (uint8_t)(channel * 7u + frame * 31u + (channel >> 8));
+}
+
+// Host-side packer - mirrors tools/ddp_usb_bridge.py
+static size_t pack_frame(uint8_t* out, uint32_t frame, uint16_t max_payload) {
+    uint32_t channels = total_channels();
+    size_t pos = 0;
+    uint8_t seq = 1;
+    for (uint32_t off = 0; off < channels; off += max_payload) {
+        uint16_t len = (uint16_t)((channels - off) < max_payload ? (channels - off) : max_payload);
+        bool last = (off + len) >= channels;
+        pos += ddp_stream_write_header(&out[pos], seq, off, len, last);
+        for (uint16_t i = 0; i < len; i++) {
+            out[pos++] = frame_byte(frame, off + i);
+        }
+        seq = (uint8_t)((seq % 15) + 1);
+    }
+    return pos;
+}
+
+static void verify_frame(uint32_t frame) {
+    uint32_t ch = 0;
+    for (int s = 0; s < T_STRINGS; s++) {
+        for (uint16_t p = 0; p < lengths[s]; p++) {
+            uint32_t expected = ((uint32_t)frame_byte(frame, ch) << 16) |
+                                ((uint32_t)frame_byte(frame, ch + 1) << 8) |
+                                frame_byte(frame, ch + 2);
+            ASSERT_EQ(expected, leds[s][p]);
+            ch += 3;
+        }
+    }
+}
+
+static ddp_stream_t dec;
+static pp_assembler_t assembler;
+static uint8_t stream_buf[64 * 1024];
+
+// Frame one packet's worth of bytes; returns bytes used and the assembler result
+static uint32_t push_packet(const uint8_t* data, uint32_t len, bool* frame_done) {
+    bool ready;
+    uint32_t used = ddp_stream_push(&dec, data, len, &ready);
+    *frame_done = ready &&
+                  pp_assembler_push_raw(&assembler, dec.packet, dec.packet_len, 0) == PP_PUSH_FRAME;
+    return used;
+}
+
+// Feed a buffer in full, counting completed frames
+static uint32_t feed(const uint8_t* data, uint32_t len) {
+    uint32_t frames = 0;
+    while (len > 0) {
+        bool done;
+        uint32_t used = push_packet(data, len, &done);
+        if (done) frames++;
+        data += used;
+        len -= used;
+    }
+    return frames;
+}
+
+static void init_decoder(void) {
+    pp_layout_t layout = {
+        .num_strings = T_STRINGS,
+        .string_lengths = lengths,
+        .start_channel = 0,
+    };
+    ddp_stream_init(&dec);
+    pp_assembler_init(&assembler, &layout, span_cb, NULL);
+    reset_leds();
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST(single_frame_whole_buffer) {
+    init_decoder();
+    size_t n = pack_frame(stream_buf, 0, DDP_STREAM_MAX_DATA);
+    ASSERT_EQ(1, feed(stream_buf, (uint32_t)n));
+    verify_frame(0);
+    ASSERT_EQ(total_channels() / 3, pixel_writes);
+    ASSERT_EQ(0, dec.stats.resyncs);
+}
+
+TEST(byte_at_a_time) {
+    init_decoder();
+    size_t n = pack_frame(stream_buf, 3, DDP_STREAM_MAX_DATA);
+    uint32_t frames = 0;
+    for (size_t i = 0; i < n; i++) {
+        frames += feed(&stream_buf[i], 1);
+    }
+    ASSERT_EQ(1, frames);
+    verify_frame(3);
+}
+
+TEST(odd_chunks_and_pixel_split_across_packets) {
+    // 1000-byte payloads split pixels across packets (1000 % 3 != 0)
+    init_decoder();
+    size_t n = pack_frame(stream_buf, 5, 1000);
+    uint32_t frames = 0;
+    size_t pos = 0;
+    size_t chunk = 1;
+    while (pos < n) {
+        size_t c = (n - pos) < chunk ? (n - pos) : chunk;
+        frames += feed(&stream_buf[pos], (uint32_t)c);
+        pos += c;
+        chunk = (chunk * 7 + 3) % 97 + 1;
+    }
+    ASSERT_EQ(1, frames);
+    verify_frame(5);
+}
+
+TEST(multiple_frames_back_to_back) {
+    init_decoder();
+    size_t n = 0;
+    for (uint32_t f = 0; f < 4; f++) {
+        n += pack_frame(&stream_buf[n], f, DDP_STREAM_MAX_DATA);
+    }
+    // Framer stops after each packet so the caller can latch a frame
+    // before the next one overwrites the back buffer
+    uint32_t used = 0;
+    bool done = false;
+    while (!done) {
+        used += push_packet(&stream_buf[used], (uint32_t)(n - used), &done);
+    }
+    ASSERT_TRUE(used < n);
+    verify_frame(0);
+    ASSERT_EQ(3, feed(&stream_buf[used], (uint32_t)(n - used)));
+    verify_frame(3);
+    ASSERT_EQ(4, assembler.stats.frames);
+}
+
+TEST(resync_after_garbage) {
+    init_decoder();
+    // Leading garbage, e.g. bytes left from an aborted transfer
+    const uint8_t garbage[] = {0x00, 0xFF, 0x13, 0x37, 0x41, 0xF0, 0x99};
+    memcpy(stream_buf, garbage, sizeof(garbage));
+    size_t n = sizeof(garbage) + pack_frame(&stream_buf[sizeof(garbage)], 9, DDP_STREAM_MAX_DATA);
+    ASSERT_EQ(1, feed(stream_buf, (uint32_t)n));
+    verify_frame(9);
+    ASSERT_TRUE(dec.stats.resyncs >= 5);
+}
+
+TEST(oversized_length_is_rejected) {
+    init_decoder();
+    uint8_t bad[PP_DDP_HEADER_LEN];
+    ddp_stream_write_header(bad, 1, 0, 100, true);
+    bad[8] = 0xFF;  // Length 0xFF64 > max payload
+    memcpy(stream_buf, bad, sizeof(bad));
+    size_t n = sizeof(bad) + pack_frame(&stream_buf[sizeof(bad)], 2, DDP_STREAM_MAX_DATA);
+    ASSERT_EQ(1, feed(stream_buf, (uint32_t)n));
+    verify_frame(2);
+}
+
+TEST(query_packets_are_skipped) {
+    init_decoder();
+    size_t pos = ddp_stream_write_header(stream_buf, 1, 0, 3, true);
+    stream_buf[0] |= PP_DDP_FLAG_QUERY;
+    stream_buf[pos++] = 0xAA;
+    stream_buf[pos++] = 0xBB;
+    stream_buf[pos++] = 0xCC;
+    ASSERT_EQ(0, feed(stream_buf, (uint32_t)pos));
+    ASSERT_EQ(0, pixel_writes);
+    ASSERT_EQ(1, dec.stats.packets);
+    ASSERT_EQ(1, assembler.stats.ignored);
+}
+
+TEST(timecode_header_is_skipped) {
+    init_decoder();
+    size_t pos = ddp_stream_write_header(stream_buf, 2, 3, 3, true);
+    stream_buf[0] |= PP_DDP_FLAG_TIME;
+    memset(&stream_buf[pos], 0x12, 4);  // Timecode
+    pos += 4;
+    stream_buf[pos++] = 0x10;
+    stream_buf[pos++] = 0x20;
+    stream_buf[pos++] = 0x30;
+    ASSERT_EQ(1, feed(stream_buf, (uint32_t)pos));
+    ASSERT_EQ(0x102030, leds[0][1]);
+}
+
+TEST(data_beyond_layout_is_ignored) {
+    init_decoder();
+    uint32_t off = total_channels();
+    size_t pos = ddp_stream_write_header(stream_buf, 1, off, 6, true);
+    memset(&stream_buf[pos], 0x55, 6);
+    pos += 6;
+    ASSERT_EQ(1, feed(stream_buf, (uint32_t)pos));
+    ASSERT_EQ(0, pixel_writes);
+}
+
+TEST(zero_length_push_latches_frame) {
+    init_decoder();
+    size_t pos = ddp_stream_write_header(stream_buf, 1, 0, 0, true);
+    ASSERT_EQ(1, feed(stream_buf, (uint32_t)pos));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== DDP Stream Tests ===\n\n");
+
+    printf("Framing:\n");
+    RUN_TEST(single_frame_whole_buffer);
+    RUN_TEST(byte_at_a_time);
+    RUN_TEST(odd_chunks_and_pixel_split_across_packets);
+    RUN_TEST(multiple_frames_back_to_back);
+
+    printf("\nRobustness:\n");
+    RUN_TEST(resync_after_garbage);
+    RUN_TEST(oversized_length_is_rejected);
+    RUN_TEST(query_packets_are_skipped);
+    RUN_TEST(timecode_header_is_skipped);
+    RUN_TEST(data_beyond_layout_is_ignored);
+    RUN_TEST(zero_length_push_latches_frame);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
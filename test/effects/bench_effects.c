@@ -0,0 +1,67 @@
+/**
+ * bench_effects.c - Host render-cost benchmark for the effects engine
+ *
+ * Renders every effect on a fully populated board (32 strings x 512 pixels)
+ * and reports time per frame against the 16.6 ms budget of 60 fps. Host
+ * numbers only rank the effects and catch regressions; the RP2350 is several
+ * times slower, so anything above a few percent here needs checking on
+ * target with the Effects view's render time.
+ *
+ * Build: mkdir build && cd build && cmake .. && make
+ * Run: ./bench_effects [frames]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "effects.h"
+
+#define B_STRINGS 32
+#define B_PIXELS 512
+#define FRAME_BUDGET_US 16667.0
+
+static uint8_t frame[B_STRINGS * B_PIXELS * 3];
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void run(effects_t* fx, effect_id_t effect, int frames) {
+    uint32_t checksum = 0;
+    double start = now_sec();
+    for (int f = 0; f < frames; f++) {
+        // 60 fps time steps, so time-dependent paths (twinkle fade) run as live
+        effects_render(fx, effect, (uint32_t)f * 1000u / 60u, frame);
+        checksum += frame[(uint32_t)f * 97u % sizeof(frame)];
+    }
+    double elapsed = now_sec() - start;
+
+    double us = elapsed * 1e6 / frames;
+    printf("  %-11s %8.1f us/frame  %5.1f%% of budget  %7.1f ns/pixel  (%08x)\n",
+           effects_name(effect), us, us * 100.0 / FRAME_BUDGET_US,
+           us * 1e3 / (B_STRINGS * B_PIXELS), checksum);
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 500;
+    if (frames <= 0) frames = 500;
+
+    uint16_t lengths[B_STRINGS];
+    for (int s = 0; s < B_STRINGS; s++) lengths[s] = B_PIXELS;
+
+    effects_init_tables();
+    static effects_t fx;
+    effects_init(&fx, lengths, B_STRINGS, 1);
+
+    printf("\n=== effects benchmark: %d x %d pixels, %d frames ===\n\n",
+           B_STRINGS, B_PIXELS, frames);
+
+    for (int e = 0; e < EFFECT_COUNT; e++) {
+        run(&fx, (effect_id_t)e, frames);
+    }
+
+    printf("\n");
+    return 0;
+}
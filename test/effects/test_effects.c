@@ -0,0 +1,279 @@
+/**
+ * test_effects.c - Tests for the procedural effects engine
+ *
+ * Covers the lookup tables, frame layout, and what each effect draws at
+ * known times on a small simulated board.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_effects
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "effects.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+#define STRINGS 4
+#define LEN     100
+#define GUARD   16
+
+static const uint16_t lengths[STRINGS] = {LEN, LEN, LEN, LEN};
+static uint8_t frame[STRINGS * LEN * 3 + GUARD];
+
+static uint32_t pixel(const effects_t* fx, uint8_t s, uint32_t i) {
+    const uint8_t* p = frame + fx->offsets[s] + i * 3;
+    return ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+}
+
+static uint32_t level(const effects_t* fx, uint8_t s, uint32_t i) {
+    const uint8_t* p = frame + fx->offsets[s] + i * 3;
+    return p[0] + p[1] + p[2];
+}
+
+static void setup(effects_t* fx) {
+    effects_init(fx, lengths, STRINGS, 1234);
+    memset(frame, 0, sizeof(frame));
+}
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+TEST(sin8_quadrants) {
+    ASSERT_EQ(128, effects_sin8(0));
+    ASSERT_EQ(255, effects_sin8(64));
+    ASSERT_EQ(0, effects_sin8(192));
+    ASSERT_TRUE(effects_sin8(128) >= 127 && effects_sin8(128) <= 128);
+    ASSERT_EQ(effects_sin8(32), effects_sin8(96));
+}
+
+TEST(hue_primaries) {
+    ASSERT_EQ(0xFF0000, effects_hue(0));
+    ASSERT_EQ(0x00FF00, effects_hue(86));
+    ASSERT_EQ(0x0000FF, effects_hue(172));
+}
+
+TEST(heat_ramp) {
+    ASSERT_EQ(0x000000, effects_heat(0));
+    ASSERT_EQ(0xFFFFFF, effects_heat(255));
+
+    // Never gets darker as heat rises
+    uint32_t prev = 0;
+    for (int h = 0; h < 256; h++) {
+        uint32_t c = effects_heat((uint8_t)h);
+        uint32_t sum = (c >> 16) + ((c >> 8) & 0xFF) + (c & 0xFF);
+        ASSERT_TRUE(sum >= prev);
+        prev = sum;
+    }
+}
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+TEST(layout_offsets) {
+    const uint16_t mixed[3] = {10, 0, 25};
+    effects_t fx;
+    effects_init(&fx, mixed, 3, 1);
+    ASSERT_EQ(0, fx.offsets[0]);
+    ASSERT_EQ(30, fx.offsets[1]);
+    ASSERT_EQ(30, fx.offsets[2]);
+    ASSERT_EQ(105, fx.frame_bytes);
+    ASSERT_EQ(35, fx.total_pixels);
+}
+
+TEST(every_effect_stays_in_frame) {
+    effects_t fx;
+    setup(&fx);
+    memset(frame + fx.frame_bytes, 0xA5, GUARD);
+
+    for (int e = 0; e < EFFECT_COUNT; e++) {
+        for (uint32_t t = 0; t < 5000; t += 357) {
+            effects_render(&fx, (effect_id_t)e, t, frame);
+        }
+    }
+    for (int i = 0; i < GUARD; i++) {
+        ASSERT_EQ(0xA5, frame[fx.frame_bytes + i]);
+    }
+}
+
+TEST(names) {
+    for (int e = 0; e < EFFECT_COUNT; e++) {
+        ASSERT_TRUE(strcmp(effects_name((uint8_t)e), "?") != 0);
+    }
+    ASSERT_TRUE(strcmp(effects_name(EFFECT_COUNT), "?") == 0);
+}
+
+// ============================================================================
+// Effects
+// ============================================================================
+
+TEST(color_wipe_front) {
+    effects_t fx;
+    setup(&fx);
+
+    // Halfway through the first wipe: red up to the middle, the hue before
+    // it past there
+    effects_render(&fx, EFFECT_COLOR_WIPE, 1000, frame);
+    for (uint8_t s = 0; s < STRINGS; s++) {
+        ASSERT_EQ(effects_hue(0), pixel(&fx, s, 0));
+        ASSERT_EQ(effects_hue(0), pixel(&fx, s, 49));
+        ASSERT_EQ(effects_hue(256 - 48), pixel(&fx, s, 50));
+        ASSERT_EQ(effects_hue(256 - 48), pixel(&fx, s, LEN - 1));
+    }
+}
+
+TEST(chase_every_fourth_moves) {
+    effects_t fx;
+    setup(&fx);
+
+    effects_render(&fx, EFFECT_CHASE, 0, frame);
+    int lit = 0;
+    for (uint32_t i = 0; i < LEN; i++) {
+        if (level(&fx, 2, i)) lit++;
+    }
+    ASSERT_EQ(LEN / 4, lit);
+    ASSERT_TRUE(level(&fx, 2, 0) > 0);
+    ASSERT_EQ(0, level(&fx, 2, 1));
+
+    // One step later the lit pixels have moved along by one
+    effects_render(&fx, EFFECT_CHASE, 50, frame);
+    ASSERT_EQ(0, level(&fx, 2, 0));
+    ASSERT_TRUE(level(&fx, 2, 1) > 0);
+}
+
+TEST(twinkle_fades_and_sparks) {
+    effects_t fx;
+    setup(&fx);
+    memset(frame, 200, fx.frame_bytes);
+
+    effects_render(&fx, EFFECT_TWINKLE, 16, frame);
+
+    // 16 ms: everything faded to 200 * 224 / 256, a few new sparks
+    int faded = 0;
+    for (uint32_t i = 0; i < fx.frame_bytes; i++) {
+        if (frame[i] == 175) faded++;
+    }
+    ASSERT_TRUE(faded > (int)fx.frame_bytes * 9 / 10);
+    ASSERT_TRUE(faded < (int)fx.frame_bytes);
+
+    // A long run with nothing new fades back to black
+    effects_t quiet;
+    effects_init(&quiet, lengths, STRINGS, 99);
+    quiet.total_pixels = 0;
+    for (uint32_t t = 116; t < 5000; t += 100) {
+        effects_render(&quiet, EFFECT_TWINKLE, t, frame);
+    }
+    for (uint32_t i = 0; i < fx.frame_bytes; i++) {
+        ASSERT_EQ(0, frame[i]);
+    }
+}
+
+TEST(fire_cools_toward_end) {
+    effects_t fx;
+    setup(&fx);
+
+    uint32_t start = 0, end = 0;
+    for (uint32_t t = 0; t < 4000; t += 100) {
+        effects_render(&fx, EFFECT_FIRE, t, frame);
+        for (uint8_t s = 0; s < STRINGS; s++) {
+            for (uint32_t i = 0; i < LEN / 4; i++) {
+                start += level(&fx, s, i);
+                end += level(&fx, s, LEN - 1 - i);
+            }
+        }
+    }
+    ASSERT_TRUE(start > end * 4);
+}
+
+TEST(plasma_and_noise_animate) {
+    static uint8_t first[STRINGS * LEN * 3];
+    effects_t fx;
+    setup(&fx);
+
+    effect_id_t animated[] = {EFFECT_PLASMA, EFFECT_NOISE, EFFECT_FIRE};
+    for (int k = 0; k < 3; k++) {
+        effects_render(&fx, animated[k], 1000, frame);
+        memcpy(first, frame, fx.frame_bytes);
+
+        // Same time draws the same frame, later time a different one
+        effects_render(&fx, animated[k], 1000, frame);
+        ASSERT_TRUE(memcmp(first, frame, fx.frame_bytes) == 0);
+        effects_render(&fx, animated[k], 1500, frame);
+        ASSERT_TRUE(memcmp(first, frame, fx.frame_bytes) != 0);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Effects Tests ===\n\n");
+
+    effects_init_tables();
+
+    printf("Tables:\n");
+    RUN_TEST(sin8_quadrants);
+    RUN_TEST(hue_primaries);
+    RUN_TEST(heat_ramp);
+
+    printf("\nLayout:\n");
+    RUN_TEST(layout_offsets);
+    RUN_TEST(every_effect_stays_in_frame);
+    RUN_TEST(names);
+
+    printf("\nEffects:\n");
+    RUN_TEST(color_wipe_front);
+    RUN_TEST(chase_every_fourth_moves);
+    RUN_TEST(twinkle_fades_and_sparks);
+    RUN_TEST(fire_cools_toward_end);
+    RUN_TEST(plasma_and_noise_animate);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+/**
+ * test_frame_diff.c - Tests for identical-frame detection
+ *
+ * Covers chunk matching against the previous frame, invalidation, frames
+ * too large to track, and the parser skipping unchanged chunks.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_frame_diff
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "frame_diff.h"
+#include "fseq_parser.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Run one frame of `chunks` chunks through the tracker; returns a bitmask
+// of chunks that matched, *unchanged gets the frame result
+static uint32_t run_frame(frame_diff_t* d, const uint8_t* frame, uint32_t chunk_len,
+                          uint32_t chunks, bool* unchanged) {
+    uint32_t matched = 0;
+    for (uint32_t i = 0; i < chunks; i++) {
+        if (frame_diff_chunk(d, i, frame + i * chunk_len, chunk_len)) matched |= 1u << i;
+    }
+    *unchanged = frame_diff_end_frame(d);
+    return matched;
+}
+
+// Pixel sink for the parser: counts callbacks
+static int pixels_seen = 0;
+
+static void count_pixel(void* user, uint8_t string, uint16_t pixel, uint32_t color) {
+    (void)user; (void)string; (void)pixel; (void)color;
+    pixels_seen++;
+}
+
+static void make_header(uint8_t* hdr, uint32_t channels, uint32_t frames) {
+    memset(hdr, 0, 32);
+    memcpy(hdr, "PSEQ", 4);
+    hdr[4] = 32;                    // channel_data_offset
+    hdr[7] = 2;                     // major version
+    memcpy(&hdr[10], &channels, 4);
+    memcpy(&hdr[14], &frames, 4);
+    hdr[18] = 50;                   // step_time_ms
+}
+
+// ============================================================================
+// Chunk tracking
+// ============================================================================
+
+TEST(hash_is_fnv1a) {
+    ASSERT_EQ(2166136261u, frame_diff_hash((const uint8_t*)"", 0));
+    ASSERT_EQ(0xE40C292Cu, frame_diff_hash((const uint8_t*)"a", 1));
+}
+
+TEST(first_frame_is_changed) {
+    frame_diff_t d;
+    frame_diff_init(&d);
+    uint8_t frame[64] = {0};
+    bool unchanged;
+
+    ASSERT_EQ(0, run_frame(&d, frame, 16, 4, &unchanged));
+    ASSERT_TRUE(!unchanged);
+    ASSERT_EQ(1, d.stats.frames);
+    ASSERT_EQ(0, d.stats.unchanged);
+}
+
+TEST(repeat_frame_is_unchanged) {
+    frame_diff_t d;
+    frame_diff_init(&d);
+    uint8_t frame[64];
+    for (int i = 0; i < 64; i++) frame[i] = (uint8_t)i;
+    bool unchanged;
+
+    run_frame(&d, frame, 16, 4, &unchanged);
+    ASSERT_EQ(0xF, run_frame(&d, frame, 16, 4, &unchanged));
+    ASSERT_TRUE(unchanged);
+    ASSERT_EQ(1, d.stats.unchanged);
+    ASSERT_EQ(4, d.stats.chunks_skipped);
+}
+
+TEST(changed_chunk_only_is_decoded) {
+    frame_diff_t d;
+    frame_diff_init(&d);
+    uint8_t frame[64] = {0};
+    bool unchanged;
+
+    run_frame(&d, frame, 16, 4, &unchanged);
+    frame[37] = 1;  // Chunk 2
+    ASSERT_EQ(0xB, run_frame(&d, frame, 16, 4, &unchanged));
+    ASSERT_TRUE(!unchanged);
+
+    // The new content is what the next frame compares against
+    ASSERT_EQ(0xF, run_frame(&d, frame, 16, 4, &unchanged));
+    ASSERT_TRUE(unchanged);
+}
+
+TEST(invalidate_forgets_previous_frame) {
+    frame_diff_t d;
+    frame_diff_init(&d);
+    uint8_t frame[64] = {0};
+    bool unchanged;
+
+    run_frame(&d, frame, 16, 4, &unchanged);
+
+    // Invalidated mid-frame: nothing matches and the frame can't be unchanged
+    ASSERT_TRUE(frame_diff_chunk(&d, 0, frame, 16));
+    frame_diff_invalidate(&d);
+    ASSERT_TRUE(!frame_diff_chunk(&d, 1, frame + 16, 16));
+    ASSERT_TRUE(!frame_diff_end_frame(&d));
+
+    // Only chunk 1 was seen, so a full frame next is still changed
+    ASSERT_EQ(0x2, run_frame(&d, frame, 16, 4, &unchanged));
+    ASSERT_TRUE(!unchanged);
+    ASSERT_EQ(0xF, run_frame(&d, frame, 16, 4, &unchanged));
+    ASSERT_TRUE(unchanged);
+}
+
+TEST(untracked_chunks_always_change) {
+    frame_diff_t d;
+    frame_diff_init(&d);
+    static uint8_t frame[(FRAME_DIFF_MAX_CHUNKS + 1) * 8];
+    memset(frame, 0x55, sizeof(frame));
+    bool unchanged;
+
+    run_frame(&d, frame, 8, FRAME_DIFF_MAX_CHUNKS + 1, &unchanged);
+    for (uint32_t i = 0; i < FRAME_DIFF_MAX_CHUNKS; i++) {
+        ASSERT_TRUE(frame_diff_chunk(&d, i, frame + i * 8, 8));
+    }
+    ASSERT_TRUE(!frame_diff_chunk(&d, FRAME_DIFF_MAX_CHUNKS, frame, 8));
+    ASSERT_TRUE(!frame_diff_end_frame(&d));
+}
+
+TEST(last_tracked_chunk_is_compared) {
+    frame_diff_t d;
+    frame_diff_init(&d);
+    static uint8_t frame[FRAME_DIFF_MAX_CHUNKS * 8];
+    memset(frame, 0x55, sizeof(frame));
+    bool unchanged;
+    uint32_t last = FRAME_DIFF_MAX_CHUNKS - 1;
+
+    run_frame(&d, frame, 8, FRAME_DIFF_MAX_CHUNKS, &unchanged);
+    run_frame(&d, frame, 8, FRAME_DIFF_MAX_CHUNKS, &unchanged);
+    ASSERT_TRUE(unchanged);
+
+    frame[last * 8] ^= 1;
+    for (uint32_t i = 0; i < last; i++) {
+        ASSERT_TRUE(frame_diff_chunk(&d, i, frame + i * 8, 8));
+    }
+    ASSERT_TRUE(!frame_diff_chunk(&d, last, frame + last * 8, 8));
+    ASSERT_TRUE(!frame_diff_end_frame(&d));
+}
+
+TEST(short_chunk_never_matches_longer) {
+    frame_diff_t d;
+    frame_diff_init(&d);
+    uint8_t frame[16] = {0};
+
+    frame_diff_chunk(&d, 0, frame, 16);
+    frame_diff_end_frame(&d);
+    ASSERT_TRUE(!frame_diff_chunk(&d, 0, frame, 15));
+}
+
+// ============================================================================
+// Parser skip
+// ============================================================================
+
+TEST(parser_skip_keeps_frame_position) {
+    // 2 strings x 2 pixels = 12 channels per frame
+    uint16_t lengths[2] = {2, 2};
+    fseq_layout_t layout = { .num_strings = 2, .string_lengths = lengths };
+    fseq_parser_ctx_t* p = fseq_parser_init(NULL, count_pixel, layout);
+    ASSERT_TRUE(p != NULL);
+
+    uint8_t hdr[32];
+    fseq_header_t h;
+    make_header(hdr, 12, 4);
+    ASSERT_TRUE(fseq_parser_read_header(p, hdr, &h));
+
+    uint8_t frame[12] = {0};
+    pixels_seen = 0;
+
+    // Half decoded, half skipped, then a full decode lines up on the next frame
+    ASSERT_TRUE(!fseq_parser_push(p, frame, 6));
+    ASSERT_TRUE(fseq_parser_skip(p, frame + 6, 6));
+    ASSERT_EQ(2, pixels_seen);
+    ASSERT_TRUE(fseq_parser_push(p, frame, 12));
+    ASSERT_EQ(6, pixels_seen);
+
+    // Skipped frames complete without callbacks
+    ASSERT_TRUE(fseq_parser_skip(p, frame, 12));
+    ASSERT_EQ(6, pixels_seen);
+
+    fseq_parser_deinit(p);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Frame Diff Tests ===\n\n");
+
+    printf("Chunk tracking:\n");
+    RUN_TEST(hash_is_fnv1a);
+    RUN_TEST(first_frame_is_changed);
+    RUN_TEST(repeat_frame_is_unchanged);
+    RUN_TEST(changed_chunk_only_is_decoded);
+    RUN_TEST(invalidate_forgets_previous_frame);
+    RUN_TEST(untracked_chunks_always_change);
+    RUN_TEST(last_tracked_chunk_is_compared);
+    RUN_TEST(short_chunk_never_matches_longer);
+
+    printf("\nParser skip:\n");
+    RUN_TEST(parser_skip_keeps_frame_position);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
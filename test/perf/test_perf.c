@@ -0,0 +1,219 @@
+/**
+ * test_perf.c - Tests for the frame timing telemetry ring
+ *
+ * Covers stage laps, commits, wraparound of the ring, snapshots and the
+ * min/avg/p99/max summaries.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_perf
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "perf.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static const char* const names[3] = {"read", "decode", "show"};
+static perf_ring_t ring;
+static perf_record_t snap[PERF_RING_SIZE];
+
+// One frame at clock *t: read, decode and show take the given cycles
+static void frame(uint32_t* t, uint32_t read, uint32_t decode, uint32_t show) {
+    *t += read;
+    perf_ring_lap(&ring, 0, *t);
+    *t += decode;
+    perf_ring_lap(&ring, 1, *t);
+    *t += show;
+    perf_ring_lap(&ring, 2, *t);
+    perf_ring_commit(&ring, *t);
+}
+
+// ============================================================================
+// Ring tests
+// ============================================================================
+
+TEST(laps_charge_stages) {
+    perf_ring_init(&ring, "test", names, 3);
+    uint32_t t = 1000;
+    perf_ring_reset(&ring, t);
+    frame(&t, 10, 20, 30);
+
+    ASSERT_EQ(1, perf_ring_snapshot(&ring, snap, PERF_RING_SIZE));
+    ASSERT_EQ(10, snap[0].cycles[0]);
+    ASSERT_EQ(20, snap[0].cycles[1]);
+    ASSERT_EQ(30, snap[0].cycles[2]);
+}
+
+TEST(repeated_laps_accumulate) {
+    perf_ring_init(&ring, "test", names, 3);
+    uint32_t t = 0;
+
+    // Chunked reads: read, decode, read, decode, then show
+    for (int i = 0; i < 3; i++) {
+        t += 5;
+        perf_ring_lap(&ring, 0, t);
+        t += 7;
+        perf_ring_lap(&ring, 1, t);
+    }
+    t += 1;
+    perf_ring_lap(&ring, 2, t);
+    perf_ring_commit(&ring, t);
+
+    ASSERT_EQ(1, perf_ring_snapshot(&ring, snap, PERF_RING_SIZE));
+    ASSERT_EQ(15, snap[0].cycles[0]);
+    ASSERT_EQ(21, snap[0].cycles[1]);
+    ASSERT_EQ(1, snap[0].cycles[2]);
+}
+
+TEST(cycle_counter_wrap) {
+    perf_ring_init(&ring, "test", names, 3);
+    uint32_t t = 0xFFFFFFF0u;
+    perf_ring_reset(&ring, t);
+    frame(&t, 0x20, 1, 1);
+
+    perf_ring_snapshot(&ring, snap, PERF_RING_SIZE);
+    ASSERT_EQ(0x20, snap[0].cycles[0]);
+}
+
+TEST(snapshot_newest_oldest_first) {
+    perf_ring_init(&ring, "test", names, 3);
+    uint32_t t = 0;
+    for (uint32_t i = 1; i <= 5; i++) frame(&t, i, 0, 0);
+
+    ASSERT_EQ(3, perf_ring_snapshot(&ring, snap, 3));
+    ASSERT_EQ(3, snap[0].cycles[0]);
+    ASSERT_EQ(5, snap[2].cycles[0]);
+}
+
+TEST(snapshot_after_wrap) {
+    perf_ring_init(&ring, "test", names, 3);
+    uint32_t t = 0;
+    for (uint32_t i = 1; i <= PERF_RING_SIZE * 2 + 10; i++) frame(&t, i, 0, 0);
+
+    // The oldest slot is the one the writer fills next, so it's left out
+    uint32_t n = perf_ring_snapshot(&ring, snap, PERF_RING_SIZE);
+    ASSERT_EQ(PERF_RING_SIZE - 1, n);
+    ASSERT_EQ(PERF_RING_SIZE * 2 + 10, snap[n - 1].cycles[0]);
+    ASSERT_EQ(PERF_RING_SIZE + 12, snap[0].cycles[0]);
+}
+
+// ============================================================================
+// Summary tests
+// ============================================================================
+
+TEST(summary_min_avg_max) {
+    perf_ring_init(&ring, "test", names, 3);
+    uint32_t t = 0;
+    frame(&t, 10, 1, 100);
+    frame(&t, 20, 2, 100);
+    frame(&t, 30, 3, 100);
+
+    uint32_t n = perf_ring_snapshot(&ring, snap, PERF_RING_SIZE);
+    perf_summary_t s;
+    perf_summarize(snap, n, 0, &s);
+    ASSERT_EQ(3, s.count);
+    ASSERT_EQ(10, s.min);
+    ASSERT_EQ(20, s.avg);
+    ASSERT_EQ(30, s.max);
+    ASSERT_EQ(30, s.p99);
+
+    // Total is the whole frame period
+    perf_summarize(snap, n, PERF_TOTAL, &s);
+    ASSERT_EQ(111, s.min);
+    ASSERT_EQ(133, s.max);
+}
+
+TEST(summary_p99_catches_stutter) {
+    perf_ring_init(&ring, "test", names, 3);
+    uint32_t t = 0;
+
+    // 100 frames: one slow SD read among steady ones
+    for (int i = 0; i < 100; i++) frame(&t, i == 50 ? 5000 : 100, 0, 0);
+
+    uint32_t n = perf_ring_snapshot(&ring, snap, PERF_RING_SIZE);
+    perf_summary_t s;
+    perf_summarize(snap, n, 0, &s);
+    ASSERT_EQ(100, s.count);
+    ASSERT_EQ(5000, s.max);
+    ASSERT_EQ(100, s.p99);     // 1 in 100 is within the top percent
+
+    // Two slow frames push it into p99
+    frame(&t, 4000, 0, 0);
+    n = perf_ring_snapshot(&ring, snap, PERF_RING_SIZE);
+    perf_summarize(snap, n, 0, &s);
+    ASSERT_EQ(4000, s.p99);
+}
+
+TEST(summary_empty) {
+    perf_summary_t s;
+    perf_summarize(snap, 0, 0, &s);
+    ASSERT_EQ(0, s.count);
+    ASSERT_EQ(0, s.max);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Perf Telemetry Tests ===\n\n");
+
+    printf("Ring:\n");
+    RUN_TEST(laps_charge_stages);
+    RUN_TEST(repeated_laps_accumulate);
+    RUN_TEST(cycle_counter_wrap);
+    RUN_TEST(snapshot_newest_oldest_first);
+    RUN_TEST(snapshot_after_wrap);
+
+    printf("\nSummaries:\n");
+    RUN_TEST(summary_min_avg_max);
+    RUN_TEST(summary_p99_catches_stutter);
+    RUN_TEST(summary_empty);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * test_play_stats.c - Tests for the playback health counters
+ *
+ * Covers late and dropped frame counting, and the SD rate and Core 1
+ * utilization windows.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_play_stats
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "play_stats.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+#define SLOT_US 33333   // 30 fps
+
+static play_tracker_t t;
+
+// Output n frames exactly on their slots from start_us; returns the next slot
+static uint64_t on_time(uint64_t start_us, int n, uint32_t busy_us) {
+    for (int i = 0; i < n; i++) {
+        play_tracker_frame(&t, start_us + (uint64_t)i * SLOT_US, SLOT_US, busy_us);
+    }
+    return start_us + (uint64_t)n * SLOT_US;
+}
+
+// ============================================================================
+// Frame timing
+// ============================================================================
+
+TEST(on_time_frames_not_late) {
+    play_tracker_reset(&t, 1000);
+    on_time(1000, 10, 0);
+    ASSERT_EQ(10, t.stats.frames);
+    ASSERT_EQ(0, t.stats.late);
+    ASSERT_EQ(0, t.stats.dropped);
+}
+
+TEST(small_jitter_tolerated) {
+    play_tracker_reset(&t, 1000);
+    uint64_t next = on_time(1000, 2, 0);
+    play_tracker_frame(&t, next + SLOT_US / 10, SLOT_US, 0);
+    ASSERT_EQ(0, t.stats.late);
+}
+
+TEST(late_frame_without_drop) {
+    play_tracker_reset(&t, 1000);
+    uint64_t next = on_time(1000, 2, 0);
+    play_tracker_frame(&t, next + SLOT_US / 3, SLOT_US, 0);
+    ASSERT_EQ(1, t.stats.late);
+    ASSERT_EQ(0, t.stats.dropped);
+}
+
+TEST(stall_drops_whole_slots) {
+    play_tracker_reset(&t, 1000);
+    uint64_t next = on_time(1000, 2, 0);
+    // Previous frame went out one slot before next; this one 3 slots after it
+    play_tracker_frame(&t, next + 2 * SLOT_US, SLOT_US, 0);
+    ASSERT_EQ(1, t.stats.late);
+    ASSERT_EQ(2, t.stats.dropped);
+}
+
+TEST(first_frame_after_reset_not_late) {
+    play_tracker_reset(&t, 1000);
+    play_tracker_frame(&t, 5000000, SLOT_US, 0);
+    ASSERT_EQ(1, t.stats.frames);
+    ASSERT_EQ(0, t.stats.late);
+}
+
+// ============================================================================
+// Windows
+// ============================================================================
+
+TEST(sd_rate_over_window) {
+    play_tracker_reset(&t, 0);
+    // 30 frames of 15000 bytes across one second
+    for (int i = 1; i <= 30; i++) {
+        play_tracker_read(&t, 15000);
+        play_tracker_frame(&t, (uint64_t)i * SLOT_US + (i == 30 ? 10 : 0), SLOT_US, 0);
+    }
+    ASSERT_EQ(450, t.stats.sd_kbps);
+    ASSERT_EQ(0, t.window_bytes);
+}
+
+TEST(rates_hold_until_window_ends) {
+    play_tracker_reset(&t, 0);
+    for (int i = 1; i <= 10; i++) {
+        play_tracker_read(&t, 15000);
+        play_tracker_frame(&t, (uint64_t)i * SLOT_US, SLOT_US, 20000);
+    }
+    ASSERT_EQ(0, t.stats.sd_kbps);
+    ASSERT_EQ(0, t.stats.core1_pct);
+}
+
+TEST(core1_utilization) {
+    play_tracker_reset(&t, 0);
+    // 20 ms of work per 33 ms frame = 60%
+    on_time(SLOT_US, 31, 20000);
+    ASSERT_EQ(60, t.stats.core1_pct);
+}
+
+TEST(utilization_capped) {
+    play_tracker_reset(&t, 0);
+    play_tracker_frame(&t, PLAY_STATS_WINDOW_US, SLOT_US, 2 * PLAY_STATS_WINDOW_US);
+    ASSERT_EQ(100, t.stats.core1_pct);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Play Stats Tests ===\n\n");
+
+    printf("Frame timing:\n");
+    RUN_TEST(on_time_frames_not_late);
+    RUN_TEST(small_jitter_tolerated);
+    RUN_TEST(late_frame_without_drop);
+    RUN_TEST(stall_drops_whole_slots);
+    RUN_TEST(first_frame_after_reset_not_late);
+
+    printf("\nWindows:\n");
+    RUN_TEST(sd_rate_over_window);
+    RUN_TEST(rates_hold_until_window_ends);
+    RUN_TEST(core1_utilization);
+    RUN_TEST(utilization_capped);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+/**
+ * test_seq_cache.c - Tests for the flash-resident sequence cache
+ *
+ * Runs seq_cache against a simulated NOR flash image: erase sets a sector to
+ * 0xFF, program can only clear bits, and misaligned operations fail. A
+ * "power cut" can be scheduled after N flash operations to check that the
+ * A/B directory always leaves a consistent cache behind.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_seq_cache
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "seq_cache.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Simulated NOR flash
+// ============================================================================
+
+#define SIM_SIZE (64 * SEQ_CACHE_SECTOR_SIZE)   // 256 KB partition
+
+typedef struct {
+    uint8_t mem[SIM_SIZE];
+    int ops;             // Erase/program calls so far
+    int fail_after;      // Power cut once ops reaches this (-1 = never)
+    int erases;
+} sim_flash_t;
+
+static sim_flash_t sim;
+
+static bool sim_powered(void) {
+    if (sim.fail_after >= 0 && sim.ops >= sim.fail_after) return false;
+    sim.ops++;
+    return true;
+}
+
+static bool sim_erase(void* user, uint32_t offset, uint32_t len) {
+    sim_flash_t* s = (sim_flash_t*)user;
+    if (offset % SEQ_CACHE_SECTOR_SIZE || len % SEQ_CACHE_SECTOR_SIZE) return false;
+    if (offset + len > SIM_SIZE) return false;
+    if (!sim_powered()) return false;
+    memset(&s->mem[offset], 0xFF, len);
+    s->erases++;
+    return true;
+}
+
+static bool sim_program(void* user, uint32_t offset, const uint8_t* data, uint32_t len) {
+    sim_flash_t* s = (sim_flash_t*)user;
+    if (offset % SEQ_CACHE_PAGE_SIZE || len % SEQ_CACHE_PAGE_SIZE) return false;
+    if (offset + len > SIM_SIZE) return false;
+    if (!sim_powered()) {
+        // Torn write: first half of the range lands
+        for (uint32_t i = 0; i < len / 2; i++) s->mem[offset + i] &= data[i];
+        return false;
+    }
+    for (uint32_t i = 0; i < len; i++) s->mem[offset + i] &= data[i];  // NOR: 1 -> 0 only
+    return true;
+}
+
+static seq_cache_flash_t sim_reset(void) {
+    memset(sim.mem, 0xFF, sizeof(sim.mem));
+    sim.ops = 0;
+    sim.fail_after = -1;
+    sim.erases = 0;
+    return (seq_cache_flash_t){
+        .base = sim.mem,
+        .size = SIM_SIZE,
+        .erase = sim_erase,
+        .program = sim_program,
+        .user = &sim,
+    };
+}
+
+// Deterministic frame content: depends on sequence seed, frame and byte
+static uint8_t pattern(uint8_t seed, uint32_t frame, uint32_t i) {
+    return (uint8_t)(seed * 31 + frame * 7 + i);
+}
+
+// Install a whole sequence, writing one frame at a time
+static seq_cache_result_t install(seq_cache_t* c, const char* name, uint8_t seed,
+                                  uint32_t frame_size, uint32_t frame_count) {
+    seq_cache_result_t r = seq_cache_begin(c, name, frame_size, frame_count, 25, 0x1234);
+    if (r != SEQ_CACHE_OK) return r;
+
+    uint8_t frame[2048];
+    for (uint32_t f = 0; f < frame_count; f++) {
+        for (uint32_t i = 0; i < frame_size; i++) frame[i] = pattern(seed, f, i);
+        r = seq_cache_write(c, frame, frame_size);
+        if (r != SEQ_CACHE_OK) return r;
+    }
+    return seq_cache_commit(c);
+}
+
+static bool frames_match(const seq_cache_t* c, const seq_cache_entry_t* e, uint8_t seed) {
+    for (uint32_t f = 0; f < e->frame_count; f++) {
+        const uint8_t* data = seq_cache_frame(c, e, f);
+        if (!data) return false;
+        for (uint32_t i = 0; i < e->frame_size; i++) {
+            if (data[i] != pattern(seed, f, i)) return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST(erased_flash_mounts_empty) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+    ASSERT_EQ(0, seq_cache_count(&c));
+    ASSERT_TRUE(seq_cache_find(&c, "show.fseq") == NULL);
+    ASSERT_EQ(SIM_SIZE - SEQ_CACHE_DATA_OFFSET, seq_cache_largest_free(&c));
+    ASSERT_EQ(0, sim.ops);  // Mount never writes
+}
+
+TEST(install_and_read_back) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "show.fseq", 1, 450, 40));
+    const seq_cache_entry_t* e = seq_cache_find(&c, "show.fseq");
+    ASSERT_TRUE(e != NULL);
+    ASSERT_EQ(450, e->frame_size);
+    ASSERT_EQ(40, e->frame_count);
+    ASSERT_EQ(25, e->step_time_ms);
+    ASSERT_EQ(0x1234, e->layout_hash);
+    ASSERT_EQ(0, e->offset % SEQ_CACHE_SECTOR_SIZE);
+    ASSERT_TRUE(frames_match(&c, e, 1));
+    ASSERT_TRUE(seq_cache_frame(&c, e, 40) == NULL);
+
+    // Survives a remount
+    seq_cache_t c2;
+    seq_cache_mount(&c2, &flash);
+    ASSERT_EQ(1, seq_cache_count(&c2));
+    e = seq_cache_find(&c2, "show.fseq");
+    ASSERT_TRUE(e != NULL);
+    ASSERT_TRUE(frames_match(&c2, e, 1));
+}
+
+TEST(odd_sized_writes) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+
+    // 3 frames of 1000 bytes written in 7-byte chunks
+    uint8_t all[3000];
+    for (uint32_t f = 0; f < 3; f++) {
+        for (uint32_t i = 0; i < 1000; i++) all[f * 1000 + i] = pattern(9, f, i);
+    }
+    ASSERT_EQ(SEQ_CACHE_OK, seq_cache_begin(&c, "odd.fseq", 1000, 3, 50, 0));
+    for (uint32_t pos = 0; pos < sizeof(all); pos += 7) {
+        uint32_t n = sizeof(all) - pos < 7 ? sizeof(all) - pos : 7;
+        ASSERT_EQ(SEQ_CACHE_OK, seq_cache_write(&c, &all[pos], n));
+    }
+    ASSERT_EQ(SEQ_CACHE_OK, seq_cache_commit(&c));
+    ASSERT_TRUE(frames_match(&c, seq_cache_find(&c, "odd.fseq"), 9));
+}
+
+TEST(writer_rejects_misuse) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+    uint8_t buf[16] = {0};
+
+    ASSERT_EQ(SEQ_CACHE_ERR_STATE, seq_cache_write(&c, buf, sizeof(buf)));
+    ASSERT_EQ(SEQ_CACHE_ERR_STATE, seq_cache_commit(&c));
+    ASSERT_EQ(SEQ_CACHE_ERR_ARG, seq_cache_begin(&c, "", 16, 1, 25, 0));
+    ASSERT_EQ(SEQ_CACHE_ERR_ARG, seq_cache_begin(&c, "a.fseq", 0, 1, 25, 0));
+    ASSERT_EQ(SEQ_CACHE_ERR_ARG,
+              seq_cache_begin(&c, "a_name_that_is_far_too_long_to_fit.fseq", 16, 1, 25, 0));
+
+    ASSERT_EQ(SEQ_CACHE_OK, seq_cache_begin(&c, "a.fseq", 16, 1, 25, 0));
+    ASSERT_EQ(SEQ_CACHE_ERR_STATE, seq_cache_begin(&c, "b.fseq", 16, 1, 25, 0));
+    ASSERT_EQ(SEQ_CACHE_ERR_ARG, seq_cache_write(&c, buf, 17));     // Past the end
+    ASSERT_EQ(SEQ_CACHE_OK, seq_cache_write(&c, buf, 8));
+    ASSERT_EQ(SEQ_CACHE_ERR_STATE, seq_cache_commit(&c));           // Short
+    seq_cache_abort(&c);
+    ASSERT_EQ(0, seq_cache_count(&c));
+}
+
+TEST(replace_keeps_old_until_commit) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "show.fseq", 1, 300, 20));
+    uint32_t old_offset = seq_cache_find(&c, "show.fseq")->offset;
+
+    // Abandoned reinstall leaves the original playable
+    uint8_t frame[300];
+    memset(frame, 0, sizeof(frame));
+    ASSERT_EQ(SEQ_CACHE_OK, seq_cache_begin(&c, "show.fseq", 300, 20, 25, 0x1234));
+    ASSERT_EQ(SEQ_CACHE_OK, seq_cache_write(&c, frame, sizeof(frame)));
+    seq_cache_abort(&c);
+    ASSERT_TRUE(frames_match(&c, seq_cache_find(&c, "show.fseq"), 1));
+
+    // Completed reinstall swaps in the new data at a new offset
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "show.fseq", 2, 300, 20));
+    const seq_cache_entry_t* e = seq_cache_find(&c, "show.fseq");
+    ASSERT_EQ(1, seq_cache_count(&c));
+    ASSERT_TRUE(e->offset != old_offset);
+    ASSERT_TRUE(frames_match(&c, e, 2));
+}
+
+TEST(freed_space_is_reused) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+
+    // Two sectors each
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "a.fseq", 1, 1024, 8));
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "b.fseq", 2, 1024, 8));
+    uint32_t a_offset = seq_cache_find(&c, "a.fseq")->offset;
+    ASSERT_EQ(SEQ_CACHE_DATA_OFFSET, a_offset);
+
+    // Replacing a moves it past b; its old gap then takes a same-sized install
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "a.fseq", 3, 1024, 8));
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "c.fseq", 4, 1024, 8));
+    ASSERT_EQ(a_offset, seq_cache_find(&c, "c.fseq")->offset);
+
+    ASSERT_TRUE(frames_match(&c, seq_cache_find(&c, "a.fseq"), 3));
+    ASSERT_TRUE(frames_match(&c, seq_cache_find(&c, "b.fseq"), 2));
+    ASSERT_TRUE(frames_match(&c, seq_cache_find(&c, "c.fseq"), 4));
+}
+
+TEST(full_partition_is_reported) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+
+    uint32_t free_bytes = seq_cache_largest_free(&c);
+    ASSERT_EQ(SEQ_CACHE_ERR_FULL, seq_cache_begin(&c, "big.fseq", free_bytes + 1, 1, 25, 0));
+
+    // Exactly fills the partition
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "fill.fseq", 5, 2048, free_bytes / 2048));
+    ASSERT_EQ(0, seq_cache_largest_free(&c));
+    ASSERT_EQ(SEQ_CACHE_ERR_FULL, seq_cache_begin(&c, "more.fseq", 16, 1, 25, 0));
+}
+
+TEST(directory_slots_are_limited) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+
+    char name[16];
+    for (int i = 0; i < SEQ_CACHE_MAX_ENTRIES; i++) {
+        snprintf(name, sizeof(name), "s%02d.fseq", i);
+        ASSERT_EQ(SEQ_CACHE_OK, install(&c, name, (uint8_t)i, 64, 4));
+    }
+    ASSERT_EQ(SEQ_CACHE_ERR_FULL, seq_cache_begin(&c, "extra.fseq", 64, 4, 25, 0));
+    // Replacing an existing name still works
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "s03.fseq", 99, 64, 4));
+    ASSERT_EQ(SEQ_CACHE_MAX_ENTRIES, seq_cache_count(&c));
+}
+
+TEST(power_cut_at_every_step_is_consistent) {
+    // Baseline: how many flash ops does a second install take?
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "a.fseq", 1, 700, 12));
+    int before = sim.ops;
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "a.fseq", 2, 700, 12));
+    int steps = sim.ops - before;
+    ASSERT_TRUE(steps > 3);
+
+    // Cut power at each step of the reinstall; after a remount the cache
+    // must hold either the old or the new sequence, never a mix
+    for (int cut = 0; cut <= steps; cut++) {
+        flash = sim_reset();
+        seq_cache_mount(&c, &flash);
+        ASSERT_EQ(SEQ_CACHE_OK, install(&c, "a.fseq", 1, 700, 12));
+
+        sim.fail_after = sim.ops + cut;
+        seq_cache_result_t r = install(&c, "a.fseq", 2, 700, 12);
+        ASSERT_EQ(cut == steps ? SEQ_CACHE_OK : SEQ_CACHE_ERR_FLASH, r);
+        sim.fail_after = -1;
+
+        seq_cache_t after;
+        seq_cache_mount(&after, &flash);
+        ASSERT_EQ(1, seq_cache_count(&after));
+        const seq_cache_entry_t* e = seq_cache_find(&after, "a.fseq");
+        ASSERT_TRUE(e != NULL);
+        uint8_t expect_seed = (cut == steps) ? 2 : 1;
+        ASSERT_TRUE(frames_match(&after, e, expect_seed));
+    }
+}
+
+TEST(corrupt_newer_directory_falls_back) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "a.fseq", 1, 128, 4));
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "b.fseq", 2, 128, 4));
+    uint8_t newest = c.dir_slot;
+
+    // Flip a bit in the newest copy: the older one (only a.fseq) is used
+    sim.mem[newest * SEQ_CACHE_SECTOR_SIZE + 40] ^= 0x01;
+    seq_cache_t after;
+    seq_cache_mount(&after, &flash);
+    ASSERT_EQ(1, seq_cache_count(&after));
+    ASSERT_TRUE(seq_cache_find(&after, "a.fseq") != NULL);
+    ASSERT_TRUE(seq_cache_find(&after, "b.fseq") == NULL);
+
+    // Next commit overwrites the corrupt copy
+    ASSERT_EQ(SEQ_CACHE_OK, install(&after, "c.fseq", 3, 128, 4));
+    ASSERT_EQ(newest, after.dir_slot);
+}
+
+TEST(clear_forgets_everything) {
+    seq_cache_flash_t flash = sim_reset();
+    seq_cache_t c;
+    seq_cache_mount(&c, &flash);
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "a.fseq", 1, 128, 4));
+    ASSERT_EQ(SEQ_CACHE_OK, install(&c, "b.fseq", 2, 128, 4));
+
+    ASSERT_EQ(SEQ_CACHE_OK, seq_cache_clear(&c));
+    ASSERT_EQ(0, seq_cache_count(&c));
+
+    seq_cache_t after;
+    seq_cache_mount(&after, &flash);
+    ASSERT_EQ(0, seq_cache_count(&after));
+    ASSERT_EQ(SIM_SIZE - SEQ_CACHE_DATA_OFFSET, seq_cache_largest_free(&after));
+}
+
+TEST(layout_hash_tracks_string_lengths) {
+    uint16_t a[3] = {50, 100, 150};
+    uint16_t b[3] = {50, 100, 151};
+    uint16_t c[4] = {50, 100, 150, 0};
+    ASSERT_EQ(seq_cache_layout_hash(a, 3), seq_cache_layout_hash(a, 3));
+    ASSERT_TRUE(seq_cache_layout_hash(a, 3) != seq_cache_layout_hash(b, 3));
+    ASSERT_TRUE(seq_cache_layout_hash(a, 3) != seq_cache_layout_hash(c, 4));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Sequence Cache Tests ===\n\n");
+
+    printf("Directory:\n");
+    RUN_TEST(erased_flash_mounts_empty);
+    RUN_TEST(install_and_read_back);
+    RUN_TEST(odd_sized_writes);
+    RUN_TEST(writer_rejects_misuse);
+    RUN_TEST(layout_hash_tracks_string_lengths);
+
+    printf("\nAllocation:\n");
+    RUN_TEST(replace_keeps_old_until_commit);
+    RUN_TEST(freed_space_is_reused);
+    RUN_TEST(full_partition_is_reported);
+    RUN_TEST(directory_slots_are_limited);
+
+    printf("\nPower loss:\n");
+    RUN_TEST(power_cut_at_every_step_is_consistent);
+    RUN_TEST(corrupt_newer_directory_falls_back);
+    RUN_TEST(clear_forgets_everything);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,362 @@
+/**
+ * test_settings_log.c - Tests for the append-only settings log
+ *
+ * Runs settings_log against a simulated NOR flash region: erase sets a sector
+ * to 0xFF, program can only clear bits, and misaligned operations fail. A
+ * power cut can be scheduled after N flash operations; a cut program lands
+ * only part of the record and a cut erase clears half the sector.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_settings_log
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "settings_log.h"
+#include "flash_settings.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Simulated NOR flash
+// ============================================================================
+
+#define SIM_SECTORS 4
+#define SIM_SIZE (SIM_SECTORS * SETTINGS_LOG_SECTOR_SIZE)
+
+typedef struct {
+    uint8_t mem[SIM_SIZE];
+    int ops;             // Erase/program calls so far
+    int fail_after;      // Power cut once ops reaches this (-1 = never)
+    int erases;
+    int programs;
+} sim_flash_t;
+
+static sim_flash_t sim;
+
+static bool sim_powered(void) {
+    if (sim.fail_after >= 0 && sim.ops >= sim.fail_after) return false;
+    sim.ops++;
+    return true;
+}
+
+static bool sim_erase(void* user, uint32_t offset, uint32_t len) {
+    sim_flash_t* s = (sim_flash_t*)user;
+    if (offset % SETTINGS_LOG_SECTOR_SIZE || len % SETTINGS_LOG_SECTOR_SIZE) return false;
+    if (offset + len > SIM_SIZE) return false;
+    if (!sim_powered()) {
+        memset(&s->mem[offset], 0xFF, len / 2);  // Torn erase
+        return false;
+    }
+    memset(&s->mem[offset], 0xFF, len);
+    s->erases++;
+    return true;
+}
+
+static bool sim_program(void* user, uint32_t offset, const uint8_t* data, uint32_t len) {
+    sim_flash_t* s = (sim_flash_t*)user;
+    if (offset % SETTINGS_LOG_PAGE_SIZE || len % SETTINGS_LOG_PAGE_SIZE) return false;
+    if (offset + len > SIM_SIZE) return false;
+    if (!sim_powered()) {
+        // Torn write: only the first 16 data bytes land
+        int landed = 0;
+        for (uint32_t i = 0; i < len && landed < 16; i++) {
+            if (data[i] == 0xFF) continue;
+            s->mem[offset + i] &= data[i];
+            landed++;
+        }
+        return false;
+    }
+    for (uint32_t i = 0; i < len; i++) s->mem[offset + i] &= data[i];  // NOR: 1 -> 0 only
+    s->programs++;
+    return true;
+}
+
+static settings_log_flash_t sim_flash(void) {
+    return (settings_log_flash_t){
+        .base = sim.mem,
+        .size = SIM_SIZE,
+        .erase = sim_erase,
+        .program = sim_program,
+        .user = &sim,
+    };
+}
+
+static settings_log_flash_t sim_reset(void) {
+    memset(sim.mem, 0xFF, sizeof(sim.mem));
+    sim.ops = 0;
+    sim.fail_after = -1;
+    sim.erases = 0;
+    sim.programs = 0;
+    return sim_flash();
+}
+
+// Settings snapshot as flash_settings.c stores it
+static flash_settings_t make_settings(uint32_t n) {
+    flash_settings_t s;
+    memset(&s, 0, sizeof(s));
+    s.magic = FLASH_SETTINGS_MAGIC;
+    s.version = FLASH_SETTINGS_VERSION;
+    s.brightness = (uint8_t)(1 + n % 10);
+    s.was_playing = (uint8_t)(n & 1);
+    s.playing_index = (uint8_t)(n % 16);
+    s.auto_loop = (uint8_t)((n >> 1) & 1);
+    s.crc = n;  // Unique per snapshot so reads can tell them apart
+    return s;
+}
+
+// Remount and return the latest snapshot's tag (make_settings n), -1 if none
+static long remount_latest(void) {
+    settings_log_flash_t flash = sim_flash();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+    flash_settings_t s;
+    uint16_t len = 0;
+    if (!settings_log_read(&log, &s, sizeof(s), &len)) return -1;
+    if (len != sizeof(s)) return -2;
+    return (long)s.crc;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST(fresh_region_has_no_record) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+    flash_settings_t s;
+    ASSERT_TRUE(!settings_log_read(&log, &s, sizeof(s), NULL));
+    ASSERT_EQ(0, sim.ops);  // Mount never writes
+}
+
+TEST(append_then_read_latest) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+
+    for (uint32_t n = 1; n <= 5; n++) {
+        flash_settings_t s = make_settings(n);
+        ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    }
+
+    flash_settings_t out;
+    uint16_t len = 0;
+    ASSERT_TRUE(settings_log_read(&log, &out, sizeof(out), &len));
+    ASSERT_EQ(sizeof(out), len);
+    ASSERT_EQ(5, out.crc);
+    ASSERT_EQ(6, out.brightness);
+
+    ASSERT_EQ(5, remount_latest());
+    ASSERT_EQ(0, sim.erases);        // Fresh flash needs no erase
+    ASSERT_EQ(5, sim.programs);      // One page program per save
+}
+
+TEST(erases_once_per_sector_of_saves) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+
+    const uint32_t saves = 1000;
+    for (uint32_t n = 1; n <= saves; n++) {
+        flash_settings_t s = make_settings(n);
+        ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    }
+
+    // First pass over the ring is free; after that one erase per 64 saves
+    // (a whole-sector rewrite would have erased 1000 times)
+    uint32_t expected = (saves - SIM_SECTORS * SETTINGS_LOG_SLOTS + SETTINGS_LOG_SLOTS - 1) /
+                        SETTINGS_LOG_SLOTS;
+    ASSERT_EQ((long)expected, (long)sim.erases);
+    ASSERT_EQ(expected, log.stats.erases);
+    ASSERT_EQ(saves, log.stats.appends);
+    ASSERT_EQ((long)saves, remount_latest());
+}
+
+TEST(remount_continues_where_it_left_off) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+
+    // Remount between every save, across several ring wraps
+    for (uint32_t n = 1; n <= 600; n++) {
+        settings_log_mount(&log, &flash);
+        flash_settings_t s = make_settings(n);
+        ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    }
+    ASSERT_EQ(600, remount_latest());
+    ASSERT_TRUE(sim.erases <= 600 / SETTINGS_LOG_SLOTS);
+}
+
+TEST(power_cut_during_program_keeps_previous) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+    flash_settings_t s = make_settings(1);
+    ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+
+    sim.fail_after = sim.ops;  // Next operation is cut
+    s = make_settings(2);
+    ASSERT_TRUE(!settings_log_append(&log, &s, sizeof(s)));
+    sim.fail_after = -1;
+    ASSERT_EQ(1, remount_latest());
+
+    // Torn slot is skipped after reboot
+    settings_log_mount(&log, &flash);
+    s = make_settings(3);
+    ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    ASSERT_EQ(3, remount_latest());
+}
+
+TEST(power_cut_during_erase_keeps_previous) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+
+    // Fill the whole ring so the next save must erase sector 0
+    uint32_t n = 1;
+    for (; n <= SIM_SECTORS * SETTINGS_LOG_SLOTS; n++) {
+        flash_settings_t s = make_settings(n);
+        ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    }
+    ASSERT_EQ(0, sim.erases);
+
+    sim.fail_after = sim.ops;
+    flash_settings_t s = make_settings(n);
+    ASSERT_TRUE(!settings_log_append(&log, &s, sizeof(s)));
+    sim.fail_after = -1;
+    ASSERT_EQ((long)(n - 1), remount_latest());
+
+    // Half-erased sector is erased again on the next save
+    settings_log_mount(&log, &flash);
+    ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    ASSERT_EQ(1, sim.erases);
+    ASSERT_EQ((long)n, remount_latest());
+}
+
+TEST(power_cut_sweep) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+
+    // Every fifth save loses power at its first or second flash operation;
+    // the log must always come back with the last completed save
+    long last_good = -1;
+    for (uint32_t n = 1; n <= 700; n++) {
+        bool cut = (n % 5) == 0;
+        if (cut) sim.fail_after = sim.ops + (int)((n / 5) % 2);
+
+        flash_settings_t s = make_settings(n);
+        bool ok = settings_log_append(&log, &s, sizeof(s));
+        sim.fail_after = -1;
+        if (ok) last_good = n;
+
+        ASSERT_EQ(last_good, remount_latest());
+        if (!ok) settings_log_mount(&log, &flash);  // Reboot
+    }
+}
+
+TEST(corrupt_latest_falls_back_to_previous) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+    for (uint32_t n = 1; n <= 3; n++) {
+        flash_settings_t s = make_settings(n);
+        ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    }
+
+    // Clear a bit in the newest record's payload
+    sim.mem[log.latest_offset + 12] &= 0xFE;
+    ASSERT_EQ(2, remount_latest());
+}
+
+TEST(rejects_oversized_payload) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+    uint8_t big[SETTINGS_LOG_MAX_PAYLOAD + 1];
+    memset(big, 0x5A, sizeof(big));
+    ASSERT_TRUE(!settings_log_append(&log, big, sizeof(big)));
+    ASSERT_TRUE(settings_log_append(&log, big, SETTINGS_LOG_MAX_PAYLOAD));
+    ASSERT_EQ(0, sim.erases);
+}
+
+TEST(erase_all_forgets_records) {
+    settings_log_flash_t flash = sim_reset();
+    settings_log_t log;
+    settings_log_mount(&log, &flash);
+    flash_settings_t s = make_settings(7);
+    ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+
+    ASSERT_TRUE(settings_log_erase_all(&log));
+    ASSERT_EQ(-1, remount_latest());
+
+    s = make_settings(8);
+    ASSERT_TRUE(settings_log_append(&log, &s, sizeof(s)));
+    ASSERT_EQ(8, remount_latest());
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Settings Log Tests ===\n\n");
+
+    printf("Records:\n");
+    RUN_TEST(fresh_region_has_no_record);
+    RUN_TEST(append_then_read_latest);
+    RUN_TEST(rejects_oversized_payload);
+    RUN_TEST(erase_all_forgets_records);
+
+    printf("\nWear:\n");
+    RUN_TEST(erases_once_per_sector_of_saves);
+    RUN_TEST(remount_continues_where_it_left_off);
+
+    printf("\nPower loss:\n");
+    RUN_TEST(power_cut_during_program_keeps_previous);
+    RUN_TEST(power_cut_during_erase_keeps_previous);
+    RUN_TEST(power_cut_sweep);
+    RUN_TEST(corrupt_latest_falls_back_to_previous);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
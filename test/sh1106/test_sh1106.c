@@ -0,0 +1,234 @@
+/**
+ * test_sh1106.c - Tests for OLED dirty-page tracking and transfer building
+ *
+ * Transfers are decoded by a model of the panel (page/column commands and
+ * data bytes), then the panel's memory is compared with the framebuffer.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_sh1106
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sh1106.h"
+
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Panel model
+// ============================================================================
+
+#define FRAME_BYTES (SH1106_WIDTH * SH1106_PAGES)
+#define COLUMN_OFFSET 2
+
+typedef struct {
+    uint8_t ram[FRAME_BYTES];
+    int page;
+    int column;
+    int transactions;
+} panel_t;
+
+// Apply I2C data command words as the controller would: each transaction
+// starts with a control byte (0x00 commands, 0x40 data) and ends on STOP
+static void panel_apply(panel_t* p, const uint32_t* words, size_t n) {
+    bool start = true;
+    bool data = false;
+    for (size_t i = 0; i < n; i++) {
+        uint8_t b = (uint8_t)words[i];
+        if (start) {
+            ASSERT_TRUE(b == 0x00 || b == 0x40);
+            data = b == 0x40;
+            p->transactions++;
+        } else if (data) {
+            int col = p->column - COLUMN_OFFSET;
+            ASSERT_TRUE(col >= 0 && col < SH1106_WIDTH);
+            p->ram[p->page * SH1106_WIDTH + col] = b;
+            p->column++;
+        } else if ((b & 0xF0) == 0xB0) {
+            p->page = b & 0x0F;
+        } else if ((b & 0xF0) == 0x10) {
+            p->column = (p->column & 0x0F) | ((b & 0x0F) << 4);
+        } else if ((b & 0xF0) == 0x00) {
+            p->column = (p->column & 0xF0) | (b & 0x0F);
+        }
+        start = (words[i] & SH1106_WORD_STOP) != 0;
+    }
+    ASSERT_TRUE(start);  // Last transaction was closed
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static sh1106_t dev;
+static uint32_t words[SH1106_PAGES * SH1106_PAGE_WORDS];
+static panel_t panel;
+
+// What the driver does when a render starts: send dirty pages, remember them
+static size_t refresh(void) {
+    uint8_t mask = sh1106_dirty_pages(dev.buffer, dev.sent);
+    size_t n = sh1106_build_transfer(dev.buffer, mask, words);
+    panel_apply(&panel, words, n);
+    memcpy(dev.sent, dev.buffer, FRAME_BYTES);
+    return n;
+}
+
+static void reset(void) {
+    memset(&dev, 0, sizeof(dev));
+    memset(&panel, 0, sizeof(panel));
+}
+
+// ============================================================================
+// Dirty pages
+// ============================================================================
+
+TEST(identical_frames_clean) {
+    reset();
+    sh1106_draw_string(&dev, 0, 0, "Pixel Blit", false);
+    memcpy(dev.sent, dev.buffer, FRAME_BYTES);
+    ASSERT_EQ(0, sh1106_dirty_pages(dev.buffer, dev.sent));
+}
+
+TEST(text_dirties_its_page) {
+    reset();
+    sh1106_draw_string(&dev, 0, 16, "FPS: 30", false);
+    ASSERT_EQ(1 << 2, sh1106_dirty_pages(dev.buffer, dev.sent));
+}
+
+TEST(last_column_change_detected) {
+    reset();
+    dev.buffer[7 * SH1106_WIDTH + SH1106_WIDTH - 1] = 0x80;
+    ASSERT_EQ(1 << 7, sh1106_dirty_pages(dev.buffer, dev.sent));
+}
+
+TEST(redraw_same_view_clean) {
+    reset();
+    sh1106_draw_string(&dev, 0, 0, "Brightness", false);
+    sh1106_draw_string(&dev, 0, 16, "Level: 5 / 10", true);
+    memcpy(dev.sent, dev.buffer, FRAME_BYTES);
+
+    // Views clear and redraw everything on each state change
+    sh1106_clear(&dev);
+    sh1106_draw_string(&dev, 0, 0, "Brightness", false);
+    sh1106_draw_string(&dev, 0, 16, "Level: 6 / 10", true);
+    ASSERT_EQ(1 << 2, sh1106_dirty_pages(dev.buffer, dev.sent));
+}
+
+// ============================================================================
+// Transfers
+// ============================================================================
+
+TEST(one_page_transfer_layout) {
+    reset();
+    sh1106_draw_string(&dev, 0, 24, "A", false);
+    size_t n = sh1106_build_transfer(dev.buffer, 1 << 3, words);
+    ASSERT_EQ(SH1106_PAGE_WORDS, n);
+    ASSERT_EQ(0x00, words[0]);
+    ASSERT_EQ(0xB3, words[1]);
+    ASSERT_EQ(0x10 | SH1106_WORD_STOP, words[3]);
+    ASSERT_EQ(0x40, words[4]);
+    ASSERT_EQ(dev.buffer[3 * SH1106_WIDTH], words[5]);
+    ASSERT_TRUE(words[n - 1] & SH1106_WORD_STOP);
+    ASSERT_EQ(0, words[n - 2] & SH1106_WORD_STOP);
+}
+
+TEST(empty_mask_no_words) {
+    reset();
+    ASSERT_EQ(0, sh1106_build_transfer(dev.buffer, 0, words));
+}
+
+TEST(full_refresh_matches_framebuffer) {
+    reset();
+    memset(panel.ram, 0x55, FRAME_BYTES);  // Power-on garbage
+    for (int i = 0; i < FRAME_BYTES; i++) dev.buffer[i] = (uint8_t)(i * 7);
+    size_t n = sh1106_build_transfer(dev.buffer, 0xFF, words);
+    ASSERT_EQ(SH1106_PAGES * SH1106_PAGE_WORDS, n);
+    panel_apply(&panel, words, n);
+    ASSERT_EQ(16, panel.transactions);
+    ASSERT_EQ(0, memcmp(panel.ram, dev.buffer, FRAME_BYTES));
+}
+
+TEST(partial_refreshes_keep_panel_in_sync) {
+    reset();
+    const char* views[][3] = {
+        {"Pixel Blit v1.1", "Info", "SD Card"},
+        {"Pixel Blit v1.1", "Info", "Flash Cache"},
+        {"Rainbow Test", "String: 3  FPS: 60", "RUNNING"},
+        {"Rainbow Test", "String: 3  FPS: 59", "RUNNING"},
+        {"Rainbow Test", "String: 3  FPS: 59", "RUNNING"},
+    };
+    size_t expected[] = {3, 1, 3, 1, 0};  // Pages sent per refresh
+
+    for (int v = 0; v < 5; v++) {
+        sh1106_clear(&dev);
+        for (int line = 0; line < 3; line++) {
+            sh1106_draw_string(&dev, 0, line * 16, views[v][line], line == 2);
+        }
+        size_t n = refresh();
+        ASSERT_EQ(expected[v] * SH1106_PAGE_WORDS, n);
+        ASSERT_EQ(0, memcmp(panel.ram, dev.buffer, FRAME_BYTES));
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== SH1106 Display Tests ===\n\n");
+
+    printf("Dirty pages:\n");
+    RUN_TEST(identical_frames_clean);
+    RUN_TEST(text_dirties_its_page);
+    RUN_TEST(last_column_change_detected);
+    RUN_TEST(redraw_same_view_clean);
+
+    printf("\nTransfers:\n");
+    RUN_TEST(one_page_transfer_layout);
+    RUN_TEST(empty_mask_no_words);
+    RUN_TEST(full_refresh_matches_framebuffer);
+    RUN_TEST(partial_refreshes_keep_panel_in_sync);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
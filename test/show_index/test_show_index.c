@@ -0,0 +1,267 @@
+/**
+ * test_show_index.c - Tests for the SD show library index format
+ *
+ * Covers FSEQ header extraction, the directory signature used to invalidate
+ * the index, and the header CRC that guards the stored entries.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_show_index
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "show_index.h"
+#include "fseq_parser.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void make_header(uint8_t* buf, uint32_t frames, uint8_t step_ms, uint8_t uid) {
+    fseq_header_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = 0x51455350;  // "PSEQ"
+    h.channel_data_offset = 32;
+    h.major_version = 2;
+    h.header_length = 32;
+    h.channel_count = 300;
+    h.frame_count = frames;
+    h.step_time_ms = step_ms;
+    memcpy(buf, &h, 32);
+    buf[31] = uid;  // Last byte of the per-render unique ID
+}
+
+static uint32_t signature_of(const char* const* names, const uint32_t* sizes, int n) {
+    uint32_t sig = show_index_signature_init();
+    for (int i = 0; i < n; i++) {
+        sig = show_index_signature_add(sig, names[i], sizes[i], 0x5A21, 0x6000);
+    }
+    return sig;
+}
+
+// ============================================================================
+// Entry tests
+// ============================================================================
+
+TEST(entry_from_header) {
+    uint8_t buf[32];
+    make_header(buf, 1500, 25, 1);
+
+    show_index_entry_t e;
+    ASSERT_TRUE(show_index_entry_init(&e, "show.fseq", 450032, 0x5A21, 0x6000, buf, sizeof(buf)));
+    ASSERT_TRUE(strcmp(e.name, "show.fseq") == 0);
+    ASSERT_EQ(1500, e.frame_count);
+    ASSERT_EQ(300, e.channel_count);
+    ASSERT_EQ(25, e.step_time_ms);
+    ASSERT_EQ(37500, e.duration_ms);
+    ASSERT_EQ(32, e.channel_data_offset);
+    ASSERT_TRUE(show_index_entry_matches(&e, "show.fseq", 450032, 0x5A21, 0x6000));
+    ASSERT_TRUE(!show_index_entry_matches(&e, "show.fseq", 450033, 0x5A21, 0x6000));
+    ASSERT_TRUE(!show_index_entry_matches(&e, "show.fseq", 450032, 0x5A21, 0x6001));
+}
+
+TEST(entry_invalid_header_keeps_name) {
+    uint8_t buf[32];
+    make_header(buf, 100, 25, 1);
+    buf[0] = 'X';
+
+    show_index_entry_t e;
+    ASSERT_TRUE(!show_index_entry_init(&e, "bad.fseq", 1000, 1, 2, buf, sizeof(buf)));
+    ASSERT_TRUE(strcmp(e.name, "bad.fseq") == 0);
+    ASSERT_EQ(0, e.frame_count);
+    ASSERT_EQ(0, e.duration_ms);
+
+    // Truncated file
+    ASSERT_TRUE(!show_index_entry_init(&e, "short.fseq", 10, 1, 2, buf, 10));
+}
+
+TEST(content_hash_tracks_render) {
+    uint8_t a[32], b[32];
+    make_header(a, 100, 25, 1);
+    make_header(b, 100, 25, 2);  // Same length, re-rendered
+
+    show_index_entry_t ea, eb, ea2;
+    show_index_entry_init(&ea, "x.fseq", 30032, 1, 2, a, sizeof(a));
+    show_index_entry_init(&eb, "x.fseq", 30032, 1, 2, b, sizeof(b));
+    show_index_entry_init(&ea2, "x.fseq", 30032, 3, 4, a, sizeof(a));
+    ASSERT_TRUE(ea.content_hash != eb.content_hash);
+    ASSERT_TRUE(ea.content_hash == ea2.content_hash);
+}
+
+TEST(long_name_truncated) {
+    show_index_entry_t e;
+    show_index_entry_init_bare(&e, "a_very_long_sequence_name_that_overflows.fseq", 10, 50);
+    ASSERT_EQ(SHOW_INDEX_NAME_LEN - 1, strlen(e.name));
+    ASSERT_EQ(500, e.duration_ms);
+}
+
+// ============================================================================
+// Directory signature tests
+// ============================================================================
+
+TEST(signature_changes_with_directory) {
+    const char* names[] = {"a.fseq", "b.fseq", "c.fseq"};
+    uint32_t sizes[] = {100, 200, 300};
+    uint32_t base = signature_of(names, sizes, 3);
+
+    ASSERT_TRUE(base == signature_of(names, sizes, 3));
+    ASSERT_TRUE(base != signature_of(names, sizes, 2));        // Removed
+
+    uint32_t grown[] = {100, 201, 300};
+    ASSERT_TRUE(base != signature_of(names, grown, 3));        // Replaced
+
+    const char* renamed[] = {"a.fseq", "b2.fseq", "c.fseq"};
+    ASSERT_TRUE(base != signature_of(renamed, sizes, 3));
+
+    uint32_t touched = show_index_signature_init();
+    touched = show_index_signature_add(touched, "a.fseq", 100, 0x5A21, 0x6000);
+    touched = show_index_signature_add(touched, "b.fseq", 200, 0x5A21, 0x6001);
+    touched = show_index_signature_add(touched, "c.fseq", 300, 0x5A21, 0x6000);
+    ASSERT_TRUE(base != touched);
+}
+
+TEST(signature_name_boundaries) {
+    uint32_t a = show_index_signature_init();
+    a = show_index_signature_add(a, "ab", 0, 0, 0);
+    a = show_index_signature_add(a, "c", 0, 0, 0);
+    uint32_t b = show_index_signature_init();
+    b = show_index_signature_add(b, "a", 0, 0, 0);
+    b = show_index_signature_add(b, "bc", 0, 0, 0);
+    ASSERT_TRUE(a != b);
+}
+
+// ============================================================================
+// Header tests
+// ============================================================================
+
+static show_index_entry_t entries[300];
+
+TEST(header_roundtrip_hundreds) {
+    uint8_t buf[32];
+    for (int i = 0; i < 300; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "show%03d.fseq", i);
+        make_header(buf, 100 + i, 25, i);
+        show_index_entry_init(&entries[i], name, 1000 + i, 1, 2, buf, sizeof(buf));
+    }
+
+    show_index_header_t h;
+    show_index_header_init(&h, entries, 300, 0x1234);
+    ASSERT_EQ(SHOW_INDEX_MAGIC, h.magic);
+    ASSERT_EQ(300, h.count);
+    ASSERT_TRUE(show_index_header_valid(&h, entries, 300));
+    ASSERT_TRUE(!show_index_header_valid(&h, entries, 299));  // Doesn't fit
+
+    // Fixed-size entries: entry i is directly addressable
+    ASSERT_EQ(100 + 257, entries[257].frame_count);
+}
+
+TEST(header_rejects_corruption) {
+    uint8_t buf[32];
+    make_header(buf, 10, 25, 0);
+    show_index_entry_init(&entries[0], "a.fseq", 1, 1, 2, buf, sizeof(buf));
+    show_index_entry_init(&entries[1], "b.fseq", 1, 1, 2, buf, sizeof(buf));
+
+    show_index_header_t h;
+    show_index_header_init(&h, entries, 2, 0);
+
+    entries[1].frame_count++;
+    ASSERT_TRUE(!show_index_header_valid(&h, entries, 16));
+    entries[1].frame_count--;
+    ASSERT_TRUE(show_index_header_valid(&h, entries, 16));
+
+    h.version++;
+    ASSERT_TRUE(!show_index_header_valid(&h, entries, 16));
+    h.version--;
+    h.magic = 0;
+    ASSERT_TRUE(!show_index_header_valid(&h, entries, 16));
+}
+
+TEST(header_crc_in_chunks) {
+    uint8_t buf[32];
+    for (int i = 0; i < 20; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "show%02d.fseq", i);
+        make_header(buf, 50 + i, 25, i);
+        show_index_entry_init(&entries[i], name, 500 + i, 1, 2, buf, sizeof(buf));
+    }
+
+    show_index_header_t h;
+    show_index_header_init(&h, entries, 20, 0);
+
+    // 8 + 8 + 4, as the scan reads it
+    uint32_t crc = 0;
+    for (int i = 0; i < 20; i += 8) {
+        crc = show_index_crc_add(crc, &entries[i], i + 8 <= 20 ? 8 : 20 - i);
+    }
+    ASSERT_TRUE(show_index_header_check(&h, crc, 20));
+    ASSERT_TRUE(!show_index_header_check(&h, crc ^ 1, 20));
+    ASSERT_TRUE(!show_index_header_check(&h, crc, 19));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Show Index Tests ===\n\n");
+
+    printf("Entries:\n");
+    RUN_TEST(entry_from_header);
+    RUN_TEST(entry_invalid_header_keeps_name);
+    RUN_TEST(content_hash_tracks_render);
+    RUN_TEST(long_name_truncated);
+
+    printf("\nDirectory signature:\n");
+    RUN_TEST(signature_changes_with_directory);
+    RUN_TEST(signature_name_boundaries);
+
+    printf("\nIndex header:\n");
+    RUN_TEST(header_roundtrip_hundreds);
+    RUN_TEST(header_rejects_corruption);
+    RUN_TEST(header_crc_in_chunks);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,288 @@
+/**
+ * test_string_discovery.c - Tests for parallel string length discovery
+ *
+ * Runs the binary search against simulated strings: the "operator" answers
+ * lit when the marker falls on one of the string's pixels.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_string_discovery
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "string_discovery.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Answer for the cursor string as an operator looking at a string of len
+static bool marker_lit(const string_discovery_t* d, const uint16_t* lengths) {
+    uint16_t pixel;
+    ASSERT_TRUE(string_discovery_marker(d, d->cursor, &pixel));
+    return pixel < lengths[d->cursor];
+}
+
+// Answer until done; returns the number of answers given
+static int run_to_done(string_discovery_t* d, const uint16_t* lengths) {
+    int answers = 0;
+    while (!string_discovery_done(d)) {
+        string_discovery_answer(d, marker_lit(d, lengths));
+        answers++;
+        ASSERT_TRUE(answers <= 32 * 16);
+    }
+    return answers;
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+TEST(init_all_open) {
+    string_discovery_t d;
+    string_discovery_init(&d, STRING_DISCOVERY_MAX_PIXELS);
+    ASSERT_EQ(32, string_discovery_remaining(&d));
+    ASSERT_EQ(0, d.cursor);
+    ASSERT_EQ(1, d.round);
+    ASSERT_TRUE(!string_discovery_done(&d));
+
+    // First marker splits 0..512 in half
+    uint16_t pixel;
+    ASSERT_TRUE(string_discovery_marker(&d, 7, &pixel));
+    ASSERT_EQ(255, pixel);
+}
+
+TEST(finds_every_length) {
+    uint16_t lengths[STRING_DISCOVERY_NUM_STRINGS];
+    for (int i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        lengths[i] = (uint16_t)(i * 37 % 300);
+    }
+    lengths[1] = 1;
+    lengths[2] = 511;
+    lengths[3] = 512;
+    lengths[4] = 256;
+
+    string_discovery_t d;
+    string_discovery_init(&d, STRING_DISCOVERY_MAX_PIXELS);
+    run_to_done(&d, lengths);
+
+    for (uint8_t i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        ASSERT_TRUE(string_discovery_resolved(&d, i));
+        ASSERT_EQ(lengths[i], string_discovery_length(&d, i));
+    }
+}
+
+TEST(ten_rounds_for_512) {
+    // 513 possible lengths: at most 10 answers per string
+    uint16_t lengths[STRING_DISCOVERY_NUM_STRINGS];
+    for (int i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        lengths[i] = (uint16_t)(500 - i);
+    }
+
+    string_discovery_t d;
+    string_discovery_init(&d, STRING_DISCOVERY_MAX_PIXELS);
+    int answers = run_to_done(&d, lengths);
+    ASSERT_TRUE(answers <= 32 * 10);
+    ASSERT_TRUE(d.round <= 10);
+}
+
+TEST(resolved_has_no_marker) {
+    string_discovery_t d;
+    string_discovery_init(&d, 1);
+    uint16_t pixel;
+    ASSERT_TRUE(string_discovery_marker(&d, 0, &pixel));
+    ASSERT_EQ(0, pixel);
+
+    string_discovery_answer(&d, false);
+    ASSERT_TRUE(string_discovery_resolved(&d, 0));
+    ASSERT_TRUE(!string_discovery_marker(&d, 0, &pixel));
+    ASSERT_EQ(0, string_discovery_length(&d, 0));
+}
+
+// ============================================================================
+// Cursor
+// ============================================================================
+
+TEST(cursor_skips_resolved) {
+    string_discovery_t d;
+    string_discovery_init(&d, 1);
+    string_discovery_answer(&d, true);      // String 0 done (length 1)
+    ASSERT_EQ(1, d.cursor);
+    string_discovery_answer(&d, false);     // String 1 done (length 0)
+    ASSERT_EQ(2, d.cursor);
+    ASSERT_EQ(30, string_discovery_remaining(&d));
+}
+
+TEST(round_advances_on_wrap) {
+    string_discovery_t d;
+    string_discovery_init(&d, STRING_DISCOVERY_MAX_PIXELS);
+    for (int i = 0; i < STRING_DISCOVERY_NUM_STRINGS - 1; i++) {
+        string_discovery_answer(&d, true);
+    }
+    ASSERT_EQ(31, d.cursor);
+    ASSERT_EQ(1, d.round);
+
+    string_discovery_answer(&d, true);
+    ASSERT_EQ(0, d.cursor);
+    ASSERT_EQ(2, d.round);
+
+    // Second round markers: upper half of 256..512
+    uint16_t pixel;
+    ASSERT_TRUE(string_discovery_marker(&d, 0, &pixel));
+    ASSERT_EQ(383, pixel);
+}
+
+TEST(last_string_stays_on_cursor) {
+    string_discovery_t d;
+    string_discovery_init(&d, 4);
+    for (int i = 1; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        d.lo[i] = d.hi[i] = 2;
+    }
+    string_discovery_answer(&d, true);
+    ASSERT_EQ(0, d.cursor);
+    ASSERT_EQ(2, d.round);
+    ASSERT_TRUE(!string_discovery_done(&d));
+}
+
+TEST(answer_after_done_ignored) {
+    uint16_t lengths[STRING_DISCOVERY_NUM_STRINGS] = {0};
+    string_discovery_t d;
+    string_discovery_init(&d, 8);
+    run_to_done(&d, lengths);
+
+    string_discovery_t before = d;
+    string_discovery_answer(&d, true);
+    ASSERT_EQ(before.cursor, d.cursor);
+    ASSERT_EQ(before.round, d.round);
+    ASSERT_EQ(0, string_discovery_length(&d, d.cursor));
+}
+
+// ============================================================================
+// Whole rounds
+// ============================================================================
+
+// One press on the cursor string, then a hold that repeats its answer for
+// the rest of the round, as on a uniformly wired board
+static int run_by_rounds(string_discovery_t* d, const uint16_t* lengths) {
+    int holds = 0;
+    while (!string_discovery_done(d)) {
+        uint8_t round = d->round;
+        bool lit = marker_lit(d, lengths);
+        string_discovery_answer(d, lit);
+        string_discovery_answer_round(d, round, lit);
+        holds++;
+        ASSERT_TRUE(holds <= 32 * 16);
+    }
+    return holds;
+}
+
+TEST(uniform_board_ten_holds) {
+    uint16_t lengths[STRING_DISCOVERY_NUM_STRINGS];
+    for (int i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) lengths[i] = 300;
+
+    string_discovery_t d;
+    string_discovery_init(&d, STRING_DISCOVERY_MAX_PIXELS);
+    int holds = run_by_rounds(&d, lengths);
+    ASSERT_TRUE(holds <= 10);
+    for (uint8_t i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        ASSERT_EQ(300, string_discovery_length(&d, i));
+    }
+}
+
+TEST(round_answer_stops_at_wrap) {
+    string_discovery_t d;
+    string_discovery_init(&d, STRING_DISCOVERY_MAX_PIXELS);
+    for (int i = 0; i < 5; i++) string_discovery_answer(&d, false);
+
+    // Strings 5..31 lit, string 0..4 keep their own answers
+    string_discovery_answer_round(&d, 1, true);
+    ASSERT_EQ(0, d.cursor);
+    ASSERT_EQ(2, d.round);
+    ASSERT_EQ(0, string_discovery_length(&d, 4));
+    ASSERT_EQ(256, string_discovery_length(&d, 5));
+    ASSERT_EQ(256, string_discovery_length(&d, 31));
+}
+
+TEST(round_answer_after_wrap_ignored) {
+    string_discovery_t d;
+    string_discovery_init(&d, STRING_DISCOVERY_MAX_PIXELS);
+    for (int i = 0; i < STRING_DISCOVERY_NUM_STRINGS; i++) {
+        string_discovery_answer(&d, true);
+    }
+    ASSERT_EQ(2, d.round);
+
+    // The press that closed round 1 leaves nothing for its hold to answer
+    string_discovery_t before = d;
+    string_discovery_answer_round(&d, 1, false);
+    ASSERT_EQ(before.cursor, d.cursor);
+    ASSERT_EQ(before.round, d.round);
+    ASSERT_EQ(before.hi[0], d.hi[0]);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== String Discovery Tests ===\n\n");
+
+    printf("Search:\n");
+    RUN_TEST(init_all_open);
+    RUN_TEST(finds_every_length);
+    RUN_TEST(ten_rounds_for_512);
+    RUN_TEST(resolved_has_no_marker);
+
+    printf("\nCursor:\n");
+    RUN_TEST(cursor_skips_resolved);
+    RUN_TEST(round_advances_on_wrap);
+    RUN_TEST(last_string_stays_on_cursor);
+    RUN_TEST(answer_after_done_ignored);
+
+    printf("\nWhole rounds:\n");
+    RUN_TEST(uniform_board_ten_holds);
+    RUN_TEST(round_answer_stops_at_wrap);
+    RUN_TEST(round_answer_after_wrap_ignored);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
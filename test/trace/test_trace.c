@@ -0,0 +1,168 @@
+/**
+ * test_trace.c - Tests for the event trace buffer
+ *
+ * Covers recording order, wraparound, skipping slots that aren't complete,
+ * pausing, and the dump line format read by tools/trace_to_chrome.py.
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_trace
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual) \
+    do { \
+        if (strcmp((expected), (actual)) != 0) { \
+            printf("FAIL\n    Expected: \"%s\", Got: \"%s\" at line %d\n", \
+                   (expected), (actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+static trace_buffer_t buf;
+static trace_event_t events[TRACE_BUFFER_SIZE];
+
+// ============================================================================
+// Buffer tests
+// ============================================================================
+
+TEST(records_in_order) {
+    trace_buffer_init(&buf);
+    trace_buffer_record(&buf, TRACE_SD_READ, TRACE_PHASE_BEGIN, 100, 1, false);
+    trace_buffer_record(&buf, TRACE_LED_DMA_IRQ, TRACE_PHASE_INSTANT, 150, 0, true);
+    trace_buffer_record(&buf, TRACE_SD_READ, TRACE_PHASE_END, 400, 1, false);
+
+    uint32_t lost;
+    ASSERT_EQ(3, trace_buffer_snapshot(&buf, events, TRACE_BUFFER_SIZE, &lost));
+    ASSERT_EQ(0, lost);
+    ASSERT_EQ(TRACE_SD_READ, events[0].id);
+    ASSERT_EQ('B', events[0].phase);
+    ASSERT_EQ(1, events[0].core);
+    ASSERT_EQ(1, events[1].isr);
+    ASSERT_EQ(400, events[2].time_us);
+}
+
+TEST(wraparound_keeps_newest) {
+    trace_buffer_init(&buf);
+    for (uint32_t i = 0; i < TRACE_BUFFER_SIZE + 10; i++) {
+        trace_buffer_record(&buf, TRACE_FRAME_SHOW, TRACE_PHASE_INSTANT, i, 1, false);
+    }
+
+    uint32_t lost;
+    uint32_t n = trace_buffer_snapshot(&buf, events, TRACE_BUFFER_SIZE, &lost);
+    ASSERT_EQ(TRACE_BUFFER_SIZE, n);
+    ASSERT_EQ(10, lost);
+    ASSERT_EQ(10, events[0].time_us);
+    ASSERT_EQ(TRACE_BUFFER_SIZE + 9, events[n - 1].time_us);
+}
+
+TEST(incomplete_slot_skipped) {
+    trace_buffer_init(&buf);
+    for (uint32_t i = 0; i < 4; i++) {
+        trace_buffer_record(&buf, TRACE_DISPATCH, TRACE_PHASE_INSTANT, i, 0, false);
+    }
+
+    // A writer on the other core has claimed slot 2 but not finished it
+    buf.events[2].seq = 0;
+
+    uint32_t lost;
+    ASSERT_EQ(3, trace_buffer_snapshot(&buf, events, TRACE_BUFFER_SIZE, &lost));
+    ASSERT_EQ(1, lost);
+    ASSERT_EQ(3, events[2].time_us);
+}
+
+TEST(disabled_records_nothing) {
+    trace_buffer_init(&buf);
+    buf.enabled = false;
+    trace_buffer_record(&buf, TRACE_DISPATCH, TRACE_PHASE_BEGIN, 1, 0, false);
+
+    uint32_t lost;
+    ASSERT_EQ(0, trace_buffer_snapshot(&buf, events, TRACE_BUFFER_SIZE, &lost));
+}
+
+// ============================================================================
+// Format tests
+// ============================================================================
+
+TEST(event_line_format) {
+    trace_event_t ev = {
+        .time_us = 4294967295u, .id = TRACE_SD_DMA_IRQ,
+        .phase = TRACE_PHASE_END, .core = 0, .isr = 1,
+    };
+    char line[TRACE_LINE_MAX];
+    trace_format_event(&ev, line, sizeof(line));
+    ASSERT_STR_EQ("E 4294967295 0 E 7 1", line);
+}
+
+TEST(event_names) {
+    ASSERT_STR_EQ("core1_stop_and_wait", trace_event_name(TRACE_CORE1_STOP));
+    ASSERT_STR_EQ("sh1106_render", trace_event_name(TRACE_DISPLAY_RENDER));
+    ASSERT_STR_EQ("unknown", trace_event_name(TRACE_EVENT_COUNT));
+    for (uint8_t id = 0; id < TRACE_EVENT_COUNT; id++) {
+        ASSERT_TRUE(trace_event_name(id) != NULL);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== Trace Buffer Tests ===\n\n");
+
+    printf("Buffer:\n");
+    RUN_TEST(records_in_order);
+    RUN_TEST(wraparound_keeps_newest);
+    RUN_TEST(incomplete_slot_skipped);
+    RUN_TEST(disabled_records_nothing);
+
+    printf("\nDump format:\n");
+    RUN_TEST(event_line_format);
+    RUN_TEST(event_names);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+/**
+ * test_usb_cmd.c - Tests for the USB console command parser
+ *
+ * Build: mkdir build_test && cd build_test && cmake .. && make
+ * Run: ./test_usb_cmd
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "usb_cmd.h"
+
+// ============================================================================
+// Test utilities
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    static void test_##name(void); \
+    static void run_test_##name(void) { \
+        printf("  TEST: %s ... ", #name); \
+        tests_run++; \
+        test_##name(); \
+        tests_passed++; \
+        printf("PASS\n"); \
+    } \
+    static void test_##name(void)
+
+#define RUN_TEST(name) run_test_##name()
+
+#define ASSERT_EQ(expected, actual) \
+    do { \
+        if ((expected) != (actual)) { \
+            printf("FAIL\n    Expected: %ld, Got: %ld at line %d\n", \
+                   (long)(expected), (long)(actual), __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL\n    Condition false at line %d\n", __LINE__); \
+            exit(1); \
+        } \
+    } while(0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Feed a string; returns the number of completed lines, last command in out
+static int feed(usb_cmd_reader_t* r, const char* text, usb_cmd_t* out) {
+    int lines = 0;
+    for (const char* p = text; *p; p++) {
+        if (usb_cmd_feed(r, *p, out)) lines++;
+    }
+    return lines;
+}
+
+// ============================================================================
+// Parse tests
+// ============================================================================
+
+TEST(parse_timecode) {
+    usb_cmd_t c = usb_cmd_parse("TC 123456");
+    ASSERT_EQ(USB_CMD_TIMECODE_MS, c.type);
+    ASSERT_EQ(123456, c.value);
+
+    c = usb_cmd_parse("  tc\t42  ");
+    ASSERT_EQ(USB_CMD_TIMECODE_MS, c.type);
+    ASSERT_EQ(42, c.value);
+
+    c = usb_cmd_parse("TF 900");
+    ASSERT_EQ(USB_CMD_TIMECODE_FRAME, c.type);
+    ASSERT_EQ(900, c.value);
+}
+
+TEST(parse_seek) {
+    usb_cmd_t c = usb_cmd_parse("GT 61000");
+    ASSERT_EQ(USB_CMD_SEEK_MS, c.type);
+    ASSERT_EQ(61000, c.value);
+
+    c = usb_cmd_parse("gf 25");
+    ASSERT_EQ(USB_CMD_SEEK_FRAME, c.type);
+    ASSERT_EQ(25, c.value);
+
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("GT").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("GF off").type);
+}
+
+TEST(parse_control) {
+    ASSERT_EQ(USB_CMD_CHASE_OFF, usb_cmd_parse("tc off").type);
+    ASSERT_EQ(USB_CMD_CHASE_STATUS, usb_cmd_parse("TS").type);
+    ASSERT_EQ(USB_CMD_POWER_STATUS, usb_cmd_parse("ps").type);
+    ASSERT_EQ(USB_CMD_PERF_DUMP, usb_cmd_parse("PD").type);
+    ASSERT_EQ(USB_CMD_TRACE_DUMP, usb_cmd_parse("td").type);
+    ASSERT_EQ(USB_CMD_NONE, usb_cmd_parse("   ").type);
+}
+
+TEST(parse_rejects_garbage) {
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("TC").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("TC 12x").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("TC -5").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("TC 99999999999").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("TCX 5").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("TS now").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("PS 1").type);
+    ASSERT_EQ(USB_CMD_INVALID, usb_cmd_parse("hello").type);
+}
+
+// ============================================================================
+// Reader tests
+// ============================================================================
+
+TEST(reader_lines_and_crlf) {
+    usb_cmd_reader_t r;
+    usb_cmd_reader_init(&r);
+    usb_cmd_t c;
+
+    ASSERT_EQ(0, feed(&r, "TC 1", &c));
+    ASSERT_EQ(1, feed(&r, "00\r", &c));
+    ASSERT_EQ(USB_CMD_TIMECODE_MS, c.type);
+    ASSERT_EQ(100, c.value);
+
+    ASSERT_EQ(1, feed(&r, "\n", &c));  // LF of CRLF is a blank line
+    ASSERT_EQ(USB_CMD_NONE, c.type);
+
+    ASSERT_EQ(2, feed(&r, "TF 7\nTS\n", &c));
+    ASSERT_EQ(USB_CMD_CHASE_STATUS, c.type);
+}
+
+TEST(reader_overlong_line_discarded) {
+    usb_cmd_reader_t r;
+    usb_cmd_reader_init(&r);
+    usb_cmd_t c;
+
+    char line[100];
+    memset(line, '1', sizeof(line) - 2);
+    memcpy(line, "TC ", 3);
+    line[sizeof(line) - 2] = '\n';
+    line[sizeof(line) - 1] = '\0';
+    ASSERT_EQ(1, feed(&r, line, &c));
+    ASSERT_EQ(USB_CMD_INVALID, c.type);
+
+    // Next line is fine
+    ASSERT_EQ(1, feed(&r, "TC 5\n", &c));
+    ASSERT_EQ(USB_CMD_TIMECODE_MS, c.type);
+    ASSERT_EQ(5, c.value);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void) {
+    printf("\n=== USB Command Tests ===\n\n");
+
+    printf("Parse:\n");
+    RUN_TEST(parse_timecode);
+    RUN_TEST(parse_seek);
+    RUN_TEST(parse_control);
+    RUN_TEST(parse_rejects_garbage);
+
+    printf("\nReader:\n");
+    RUN_TEST(reader_lines_and_crlf);
+    RUN_TEST(reader_overlong_line_discarded);
+
+    printf("\n=================================\n");
+    printf("Tests: %d passed / %d total\n", tests_passed, tests_run);
+    printf("=================================\n\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""
+Forward live pixel data to a Pixel Blit board over its USB serial port.
+
+The firmware's "USB Stream" menu mode decodes DDP packets sent back to back
+on the USB CDC port. This bridge produces that stream from one of:
+
+  udp   - listen for DDP on UDP (xLights "DDP" controller output) and forward
+  test  - generate a moving rainbow test pattern
+  fseq  - play an uncompressed FSEQ v2 file at its native frame rate
+
+Examples:
+  ddp_usb_bridge.py --port /dev/tty.usbmodem1101 udp
+  ddp_usb_bridge.py --port COM5 test --channels 4800 --fps 30
+  ddp_usb_bridge.py --output capture.bin fseq show.fseq
+
+Requires pyserial (pip install pyserial) unless --output is used.
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+DDP_PORT = 4048
+DDP_HEADER_LEN = 10
+DDP_MAX_DATA = 1440           # Must match DDP_STREAM_MAX_DATA in firmware
+DDP_FLAG_VER1 = 0x40
+DDP_FLAG_TIME = 0x10
+DDP_FLAG_PUSH = 0x01
+DDP_TYPE_RGB8 = 0x01
+DDP_ID_DISPLAY = 1
+
+
+def ddp_header(seq, offset, length, push):
+    flags = DDP_FLAG_VER1 | (DDP_FLAG_PUSH if push else 0)
+    return struct.pack(">BBBBIH", flags, seq & 0x0F, DDP_TYPE_RGB8,
+                       DDP_ID_DISPLAY, offset, length)
+
+
+def ddp_packets(frame, seq):
+    """Split one frame of RGB channel data into DDP packets."""
+    packets = []
+    for offset in range(0, max(len(frame), 1), DDP_MAX_DATA):
+        chunk = frame[offset:offset + DDP_MAX_DATA]
+        push = offset + DDP_MAX_DATA >= len(frame)
+        packets.append(ddp_header(seq, offset, len(chunk), push) + chunk)
+        seq = (seq % 15) + 1
+    return packets, seq
+
+
+def is_ddp(packet):
+    if len(packet) < DDP_HEADER_LEN or (packet[0] & 0xC0) != DDP_FLAG_VER1:
+        return False
+    header_len = 14 if packet[0] & DDP_FLAG_TIME else DDP_HEADER_LEN
+    (length,) = struct.unpack(">H", packet[8:10])
+    return length <= DDP_MAX_DATA and len(packet) == header_len + length
+
+
+class Sink:
+    """Serial port or capture file, with throughput accounting."""
+
+    def __init__(self, port, baud, output):
+        if output:
+            self.out = open(output, "wb")
+        else:
+            try:
+                import serial
+            except ImportError:
+                sys.exit("pyserial is required: pip install pyserial")
+            # Baud rate is ignored by USB CDC but required by the API
+            self.out = serial.Serial(port, baud, write_timeout=1)
+        self.bytes = 0
+        self.frames = 0
+        self.last_report = time.monotonic()
+
+    def write(self, data, frame_done):
+        self.out.write(data)
+        self.bytes += len(data)
+        if frame_done:
+            self.frames += 1
+        now = time.monotonic()
+        if now - self.last_report >= 1.0:
+            elapsed = now - self.last_report
+            print("{:5.1f} fps  {:7.1f} KB/s".format(
+                self.frames / elapsed, self.bytes / elapsed / 1024), flush=True)
+            self.frames = 0
+            self.bytes = 0
+            self.last_report = now
+
+
+def run_udp(sink, args):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((args.bind, args.udp_port))
+    print("Listening for DDP on {}:{}".format(args.bind, args.udp_port))
+    while True:
+        packet, _ = sock.recvfrom(2048)
+        if is_ddp(packet):
+            sink.write(packet, bool(packet[0] & DDP_FLAG_PUSH))
+
+
+def hsv_byte(h):
+    """Cheap rainbow: hue 0-255 to (r, g, b)."""
+    region, rem = divmod(h, 43)
+    up, down = rem * 6, 255 - rem * 6
+    return [(255, up, 0), (down, 255, 0), (0, 255, up),
+            (0, down, 255), (up, 0, 255), (255, 0, down)][region % 6]
+
+
+def run_test(sink, args):
+    pixels = args.channels // 3
+    seq = 1
+    hue = 0
+    period = 1.0 / args.fps
+    next_time = time.monotonic()
+    while True:
+        frame = bytearray()
+        for p in range(pixels):
+            frame.extend(hsv_byte((hue + p * 4) & 0xFF))
+        packets, seq = ddp_packets(bytes(frame), seq)
+        for i, pkt in enumerate(packets):
+            sink.write(pkt, i == len(packets) - 1)
+        hue = (hue + 3) & 0xFF
+        next_time += period
+        time.sleep(max(0.0, next_time - time.monotonic()))
+
+
+def run_fseq(sink, args):
+    with open(args.file, "rb") as f:
+        header = f.read(32)
+        if header[0:4] not in (b"PSEQ", b"FSEQ"):
+            sys.exit("Not an FSEQ file")
+        data_offset, = struct.unpack("<H", header[4:6])
+        major = header[7]
+        channel_count, frame_count = struct.unpack("<II", header[10:18])
+        step_ms = header[18]
+        if major == 2 and (header[20] & 0x0F) != 0:
+            sys.exit("Compressed FSEQ files are not supported")
+
+        print("{}: {} frames, {} channels @ {} ms".format(
+            args.file, frame_count, channel_count, step_ms))
+        seq = 1
+        period = max(step_ms, 1) / 1000.0
+        next_time = time.monotonic()
+        while True:
+            f.seek(data_offset)
+            for _ in range(frame_count):
+                frame = f.read(channel_count)
+                if len(frame) < channel_count:
+                    break
+                packets, seq = ddp_packets(frame, seq)
+                for i, pkt in enumerate(packets):
+                    sink.write(pkt, i == len(packets) - 1)
+                next_time += period
+                time.sleep(max(0.0, next_time - time.monotonic()))
+            if not args.loop:
+                return
+
+
+def main():
+    parser = argparse.ArgumentParser(description="DDP to USB bridge for Pixel Blit")
+    parser.add_argument("--port", "-p", help="USB serial port of the board")
+    parser.add_argument("--baud", default=115200, type=int,
+                        help="Ignored by USB CDC. Default 115200")
+    parser.add_argument("--output", "-o",
+                        help="Write the byte stream to a file instead of a port")
+    sub = parser.add_subparsers(dest="mode", required=True)
+
+    udp = sub.add_parser("udp", help="Forward DDP received over UDP")
+    udp.add_argument("--bind", default="0.0.0.0", help="Default 0.0.0.0")
+    udp.add_argument("--udp-port", default=DDP_PORT, type=int,
+                     help="Default {}".format(DDP_PORT))
+
+    test = sub.add_parser("test", help="Send a rainbow test pattern")
+    test.add_argument("--channels", default=32 * 50 * 3, type=int,
+                      help="Channels per frame. Default 4800 (32 x 50 pixels)")
+    test.add_argument("--fps", default=30, type=float, help="Default 30")
+
+    fseq = sub.add_parser("fseq", help="Play an uncompressed FSEQ file")
+    fseq.add_argument("file")
+    fseq.add_argument("--loop", action="store_true", help="Repeat forever")
+
+    args = parser.parse_args()
+    if not args.port and not args.output:
+        parser.error("one of --port or --output is required")
+
+    sink = Sink(args.port, args.baud, args.output)
+    try:
+        {"udp": run_udp, "test": run_test, "fseq": run_fseq}[args.mode](sink, args)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
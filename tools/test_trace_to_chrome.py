@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""Tests for trace_to_chrome.py. Run: python3 -m unittest test_trace_to_chrome"""
+
+import os
+import sys
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import trace_to_chrome as t2c
+
+DUMP = """\
+FSEQ: Frame 0 complete after 1 reads (4800 bytes)
+TRACE BEGIN 5 2
+N 0 dispatch
+N 4 sd_read
+N 6 led_dma_irq
+E 1000 1 B 4 0
+E 1100 0 I 6 1
+E 1800 1 E 4 0
+E 1900 0 B 0 0
+E 2500 0 E 0 0
+TRACE END
+"""
+
+
+class ParseTests(unittest.TestCase):
+    def test_parses_names_and_events(self):
+        names, events, lost = t2c.parse_dump(DUMP.splitlines())
+        self.assertEqual(names[4], "sd_read")
+        self.assertEqual(len(events), 5)
+        self.assertEqual(events[0], (1000, 1, "B", 4, 0))
+        self.assertEqual(lost, 2)
+
+    def test_uses_last_complete_dump(self):
+        second = DUMP.replace("E 1000 1 B 4 0", "E 5 1 B 4 0")
+        lines = (DUMP + second + "TRACE BEGIN 1 0\nE 1 0 I 0 0\n").splitlines()
+        _, events, _ = t2c.parse_dump(lines)
+        self.assertEqual(events[0][0], 5)
+
+    def test_skips_interleaved_console_lines(self):
+        lines = DUMP.replace("E 1800 1 E 4 0", "Core1: hello\nE 1800 1 E 4 0\nE 12x").splitlines()
+        _, events, _ = t2c.parse_dump(lines)
+        self.assertEqual(len(events), 5)
+
+    def test_no_dump_is_an_error(self):
+        with self.assertRaises(ValueError):
+            t2c.parse_dump(["TRACE BEGIN 1 0", "E 1 0 I 0 0"])
+
+
+class TimeTests(unittest.TestCase):
+    def test_relative_to_first_event(self):
+        events = [(1000, 0, "I", 0, 0), (1500, 0, "I", 0, 0)]
+        self.assertEqual(t2c.unwrap_times(events), [0, 500])
+
+    def test_counter_wrap(self):
+        events = [(0xFFFFFF00, 0, "I", 0, 0), (0x100, 0, "I", 0, 0)]
+        self.assertEqual(t2c.unwrap_times(events), [0, 0x200])
+
+    def test_cross_core_reorder_across_wrap(self):
+        # Core 1's event was recorded after core 0's but happened just before
+        # the wrap
+        events = [(0xFFFFFFF0, 0, "I", 0, 0), (0x10, 1, "I", 0, 0),
+                  (0xFFFFFFF8, 1, "I", 0, 0)]
+        self.assertEqual(t2c.unwrap_times(events), [0, 0x20, 0x8])
+
+
+class ChromeTests(unittest.TestCase):
+    def convert(self, dump=DUMP):
+        names, events, _ = t2c.parse_dump(dump.splitlines())
+        return t2c.to_chrome(names, events)["traceEvents"]
+
+    def test_threads_per_core_and_irq(self):
+        meta = {e["tid"]: e["args"]["name"] for e in self.convert()
+                if e["ph"] == "M" and e["name"] == "thread_name"}
+        self.assertEqual(meta, {0: "core0", 1: "core0 irq", 2: "core1"})
+
+    def test_spans_and_instants(self):
+        events = [e for e in self.convert() if e["ph"] != "M"]
+        self.assertEqual([e["ph"] for e in events], ["B", "i", "E", "B", "E"])
+        read = events[0]
+        self.assertEqual((read["name"], read["tid"], read["ts"]), ("sd_read", 2, 0))
+        self.assertEqual(events[2]["ts"], 800)
+        self.assertEqual(events[1]["s"], "t")
+
+    def test_end_without_begin_dropped(self):
+        dump = DUMP.replace("E 1000 1 B 4 0\n", "")
+        events = [e for e in self.convert(dump) if e["ph"] != "M"]
+        self.assertEqual([e["ph"] for e in events], ["i", "B", "E"])
+
+    def test_unknown_id_gets_a_name(self):
+        dump = DUMP.replace("E 1100 0 I 6 1", "E 1100 0 I 9 1")
+        events = [e for e in self.convert(dump) if e["ph"] == "i"]
+        self.assertEqual(events[0]["name"], "event_9")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+Convert a Pixel Blit event trace to Chrome trace JSON.
+
+The firmware prints its trace buffer when it receives `TD` on the USB
+console (see src/trace.h for the format). Open the JSON in Perfetto
+(https://ui.perfetto.dev) or chrome://tracing to see both cores and their
+interrupt handlers on one timeline.
+
+Examples:
+  trace_to_chrome.py console.log -o trace.json
+  trace_to_chrome.py --port /dev/tty.usbmodem1101 -o trace.json
+
+Input may contain other console output; only the last complete
+TRACE BEGIN ... TRACE END block is used. --port requires pyserial
+(pip install pyserial).
+"""
+
+import argparse
+import json
+import sys
+import time
+
+WRAP = 1 << 32          # Firmware timestamps are 32-bit microseconds
+PID = 1
+
+
+def parse_dump(lines):
+    """Return (names, events, lost) from the last complete dump in lines.
+
+    events are (time_us, core, phase, id, isr) tuples in recorded order.
+    """
+    result = None
+    block = None
+    for raw in lines:
+        line = raw.strip()
+        fields = line.split()
+        if line.startswith("TRACE BEGIN"):
+            lost = int(fields[3]) if len(fields) > 3 else 0
+            block = ({}, [], lost)
+        elif line == "TRACE END":
+            if block is not None:
+                result = block
+            block = None
+        elif block is None:
+            continue
+        elif fields[:1] == ["N"] and len(fields) == 3:
+            block[0][int(fields[1])] = fields[2]
+        elif fields[:1] == ["E"] and len(fields) == 6 and fields[3] in ("B", "E", "I"):
+            try:
+                block[1].append((int(fields[1]), int(fields[2]), fields[3],
+                                 int(fields[4]), int(fields[5])))
+            except ValueError:
+                pass  # Line mangled by console output from the other core
+    if result is None:
+        raise ValueError("no complete TRACE BEGIN ... TRACE END block found")
+    return result
+
+
+def unwrap_times(events):
+    """Timestamps as microseconds since the first event, across counter wraps.
+
+    Events are in the order they were recorded, which can put one core's
+    event slightly before the other's in time, so only a jump of more than
+    half the counter range counts as a wrap.
+    """
+    out = []
+    base = 0
+    prev = None
+    for ev in events:
+        t = ev[0]
+        if prev is not None:
+            if t - prev < -WRAP // 2:
+                base += WRAP
+            elif t - prev > WRAP // 2:
+                base -= WRAP
+        prev = t
+        out.append(t + base)
+    start = min(out) if out else 0
+    return [t - start for t in out]
+
+
+def thread_id(core, isr):
+    return core * 2 + (1 if isr else 0)
+
+
+def to_chrome(names, events):
+    """Build the Chrome trace object. Ends whose begin was overwritten are
+    dropped so the viewer doesn't mis-nest the rest of the track."""
+    trace = [{"name": "process_name", "ph": "M", "pid": PID,
+              "args": {"name": "pixel_blit"}}]
+    threads = sorted({thread_id(ev[1], ev[4]) for ev in events})
+    for tid in threads:
+        label = "core{}{}".format(tid // 2, " irq" if tid % 2 else "")
+        trace.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": tid,
+                      "args": {"name": label}})
+
+    open_spans = {}
+    for ts, (_, core, phase, event_id, isr) in zip(unwrap_times(events), events):
+        tid = thread_id(core, isr)
+        name = names.get(event_id, "event_{}".format(event_id))
+        key = (tid, event_id)
+        entry = {"name": name, "pid": PID, "tid": tid, "ts": ts}
+        if phase == "B":
+            open_spans[key] = open_spans.get(key, 0) + 1
+            entry["ph"] = "B"
+        elif phase == "E":
+            if not open_spans.get(key):
+                continue
+            open_spans[key] -= 1
+            entry["ph"] = "E"
+        else:
+            entry["ph"] = "i"
+            entry["s"] = "t"
+        trace.append(entry)
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def capture(port, timeout):
+    """Ask the board for a dump and return the console lines."""
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial is required: pip install pyserial")
+    # Baud rate is ignored by USB CDC but required by the API
+    with serial.Serial(port, 115200, timeout=0.5) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"TD\n")
+        lines = []
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            line = ser.readline().decode("ascii", errors="replace")
+            if line:
+                lines.append(line)
+                if line.strip() == "TRACE END":
+                    break
+        return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pixel Blit trace to Chrome JSON")
+    parser.add_argument("input", nargs="?", help="Captured console log. Default stdin")
+    parser.add_argument("--port", "-p", help="Capture a dump from this USB serial port")
+    parser.add_argument("--timeout", default=5.0, type=float,
+                        help="Seconds to wait for a dump from --port. Default 5")
+    parser.add_argument("--output", "-o", help="JSON file. Default stdout")
+    args = parser.parse_args()
+
+    if args.port:
+        lines = capture(args.port, args.timeout)
+    elif args.input:
+        with open(args.input, errors="replace") as f:
+            lines = f.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    try:
+        names, events, lost = parse_dump(lines)
+    except ValueError as e:
+        sys.exit(str(e))
+    if lost:
+        print("{} events were overwritten or skipped".format(lost), file=sys.stderr)
+
+    trace = to_chrome(names, events)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,220 @@
+#include "usb_stream.h"
+#include "ddp_stream.h"
+#include "pixel_proto.h"
+#include "board_config.h"
+#include "flash_io.h"
+#include "pico/stdlib.h"
+#include "pico/stdio.h"
+#include <stdio.h>
+#include <string.h>
+
+// How long to block waiting for USB data before re-checking for stop
+#define USB_STREAM_READ_TIMEOUT_US 2000
+
+// Framer and frame assembler state (persists across start/run_loop/stop)
+static ddp_stream_t g_framer;
+static pp_assembler_t g_assembler;
+
+// Assembler layout - MUST be static so pointer remains valid after start() returns
+static uint16_t g_string_lengths[BOARD_CONFIG_MAX_STRINGS];
+
+// GPIO base for driver creation
+static uint g_gpio_base = 0;
+
+// Span callback - called by the assembler with runs of pixels on one string
+static void span_callback(void *user_data, uint8_t string, uint16_t first_pixel,
+                          const uint8_t *rgb, uint16_t count) {
+    usb_stream_t *ctx = (usb_stream_t *)user_data;
+    if (ctx && ctx->driver) {
+        pb_set_pixels(ctx->driver, 0, string, first_pixel, rgb, count);
+    }
+}
+
+// Create driver with the board_config layout (same as FSEQ playback)
+static bool create_driver(usb_stream_t *ctx) {
+    if (ctx->driver) {
+        return true;  // Already created
+    }
+
+    uint8_t num_strings = 0;
+    uint16_t max_pixels = 0;
+
+    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
+        uint16_t pixel_count = board_config_get_pixel_count(i);
+        if (pixel_count > 0) {
+            num_strings = i + 1;
+            if (pixel_count > max_pixels) {
+                max_pixels = pixel_count;
+            }
+        }
+    }
+
+    if (num_strings == 0 || max_pixels == 0) {
+        printf("USB: No strings configured in board_config\n");
+        return false;
+    }
+
+    pb_driver_config_t config = {
+        .board_id = g_board_config.board_id,
+        .num_boards = 1,
+        .gpio_base = g_gpio_base,
+        .num_strings = num_strings,
+        .max_pixel_length = max_pixels,
+        .frequency_hz = 800000,
+        .color_order = PB_COLOR_ORDER_RGB,  // Pass-through: let xLights handle color order
+        .reset_us = 200,
+        .pio_index = 1,  // Use PIO1
+    };
+
+    for (int i = 0; i < num_strings; i++) {
+        uint16_t pixel_count = board_config_get_pixel_count(i);
+        config.strings[i].length = pixel_count;
+        config.strings[i].enabled = (pixel_count > 0);
+    }
+
+    ctx->driver = pb_driver_init(&config);
+    if (ctx->driver == NULL) {
+        printf("USB: Failed to create pb_driver\n");
+        return false;
+    }
+
+    pb_power_config_t power;
+    board_config_power(&g_board_config, &power);
+    pb_set_power_config(ctx->driver, &power);
+
+    printf("USB: Driver created (%d strings, max %d pixels)\n",
+           num_strings, max_pixels);
+    return true;
+}
+
+bool usb_stream_init(usb_stream_t *ctx, uint first_pin) {
+    if (!ctx) {
+        return false;
+    }
+
+    memset(ctx, 0, sizeof(usb_stream_t));
+    g_gpio_base = first_pin;
+    return true;
+}
+
+bool usb_stream_start(usb_stream_t *ctx) {
+    if (!ctx) {
+        return false;
+    }
+
+    if (!create_driver(ctx)) {
+        return false;
+    }
+
+    // Assembler layout from board_config - using STATIC array
+    uint8_t num_strings = 0;
+    for (int i = 0; i < BOARD_CONFIG_MAX_STRINGS; i++) {
+        g_string_lengths[i] = board_config_get_pixel_count(i);
+        if (g_string_lengths[i] > 0) {
+            num_strings = i + 1;
+        }
+    }
+
+    // DDP offsets are relative to this controller, so the board starts at 0
+    pp_layout_t layout = {
+        .board_id = g_board_config.board_id,
+        .num_strings = num_strings,
+        .string_lengths = g_string_lengths,
+        .start_channel = 0,
+    };
+    ddp_stream_init(&g_framer);
+    pp_assembler_init(&g_assembler, &layout, span_callback, ctx);
+
+    ctx->fps = 0;
+    ctx->frames = 0;
+    ctx->packets = 0;
+    ctx->resyncs = 0;
+    ctx->running = true;
+
+    printf("USB: Streaming started (DDP over CDC)\n");
+    return true;
+}
+
+void usb_stream_run_loop(usb_stream_t *ctx, usb_stream_stop_check_fn stop_check) {
+    if (!ctx || !ctx->running || !ctx->driver) {
+        return;
+    }
+
+    uint8_t buffer[512];
+    uint32_t fps_frame_count = 0;
+    uint64_t last_fps_time = time_us_64();
+
+    while (!(stop_check && stop_check())) {
+        // Short timeout so stop requests are seen promptly when the host is idle
+        int n = stdio_get_until((char *)buffer, sizeof(buffer),
+                                make_timeout_time_us(USB_STREAM_READ_TIMEOUT_US));
+
+        uint32_t pos = 0;
+        while (n > 0 && pos < (uint32_t)n) {
+            bool packet_ready;
+            pos += ddp_stream_push(&g_framer, &buffer[pos], (uint32_t)n - pos, &packet_ready);
+            if (!packet_ready) continue;
+
+            uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+            pp_push_result_t r = pp_assembler_push_raw(&g_assembler, g_framer.packet,
+                                                       g_framer.packet_len, now_ms);
+            if (r == PP_PUSH_OK) continue;
+
+            // Host paces the stream - output as soon as the frame is complete
+            pb_show(ctx->driver);
+            if (flash_io_pending()) {
+                pb_show_wait(ctx->driver);  // Flash writes go after the frame is out
+                flash_io_service();
+            }
+            fps_frame_count++;
+            ctx->frames = g_assembler.stats.frames;
+
+            if (r == PP_PUSH_FRAME_REPLAY) {
+                pp_assembler_push_raw(&g_assembler, g_framer.packet, g_framer.packet_len, now_ms);
+            }
+        }
+
+        ctx->packets = g_framer.stats.packets;
+        ctx->resyncs = g_framer.stats.resyncs;
+
+        // Update FPS every second (drops to 0 when the host stops sending)
+        uint64_t now = time_us_64();
+        if (now - last_fps_time >= 1000000) {
+            ctx->fps = fps_frame_count;
+            fps_frame_count = 0;
+            last_fps_time = now;
+        }
+    }
+
+    printf("USB: Stream stopped (%lu frames, %lu packets, %lu resyncs, %lu lost)\n",
+           (unsigned long)g_assembler.stats.frames,
+           (unsigned long)g_framer.stats.packets,
+           (unsigned long)g_framer.stats.resyncs,
+           (unsigned long)g_assembler.stats.lost);
+}
+
+void usb_stream_stop(usb_stream_t *ctx) {
+    if (!ctx) return;
+
+    if (ctx->driver) {
+        pb_show_wait(ctx->driver);
+        pb_clear_all(ctx->driver, 0x000000);
+        pb_show(ctx->driver);
+        pb_show_wait(ctx->driver);
+        pb_driver_deinit(ctx->driver);
+        ctx->driver = NULL;
+    }
+
+    ddp_stream_reset(&g_framer);
+    pp_assembler_reset(&g_assembler);
+    ctx->running = false;
+    ctx->fps = 0;
+}
+
+bool usb_stream_is_running(const usb_stream_t *ctx) {
+    return ctx && ctx->running;
+}
+
+uint16_t usb_stream_get_fps(const usb_stream_t *ctx) {
+    return ctx ? ctx->fps : 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/types.h"
+#include "pb_led_driver.h"
+#include "board_config.h"
+
+// Live pixel streaming over the USB CDC port.
+//
+// A host bridge (tools/ddp_usb_bridge.py) forwards DDP packets from xLights
+// (or any DDP source) down the same USB serial port used for stdio. Each
+// packet carrying the PUSH flag latches a frame to the LEDs.
+
+// Stop check callback type - returns true if streaming should stop
+typedef bool (*usb_stream_stop_check_fn)(void);
+
+typedef struct {
+    pb_driver_t *driver;
+    volatile bool running;
+    uint16_t fps;
+    volatile uint32_t frames;      // Frames latched since start
+    volatile uint32_t packets;     // DDP packets decoded since start
+    volatile uint32_t resyncs;     // Bytes discarded hunting for a header
+} usb_stream_t;
+
+// Initialize the stream context
+bool usb_stream_init(usb_stream_t *ctx, uint first_pin);
+
+// Start streaming (creates driver, resets decoder)
+// Called from Core 1 task manager
+bool usb_stream_start(usb_stream_t *ctx);
+
+// Read from USB and output frames until stop_check returns true
+// Called from Core 1 task manager
+void usb_stream_run_loop(usb_stream_t *ctx, usb_stream_stop_check_fn stop_check);
+
+// Clear LEDs and destroy the driver
+// Called from Core 1 task manager
+void usb_stream_stop(usb_stream_t *ctx);
+
+// Check if running
+bool usb_stream_is_running(const usb_stream_t *ctx);
+
+// Get current FPS
+uint16_t usb_stream_get_fps(const usb_stream_t *ctx);